@@ -1,7 +1,11 @@
 #include "AudioEngine.h"
 
+#include "AudioEngine/Parameters/ValueTreeManager.h"
 #include "Core/Edit/Edit.h"
 #include "Core/Plugin/PluginRegistry.h"
+#include "Core/Track/RecordTrack.h"
+
+#include <algorithm>
 
 // ------------------------ MainComponent Implementation ------------------------
 
@@ -23,8 +27,27 @@ AudioEngine::AudioEngine(const std::weak_ptr<Edit>& edit):edit(edit) {
     pluginRegistry = std::make_unique<PluginRegistry>();
     pluginRegistry->scan();
 
+    auto outputFormat = ChannelsFormat::Stereo;
+    if (!graphInstances.empty() && graphInstances.front()) {
+        outputFormat = graphInstances.front()->getGraphManager().getOutputFormat();
+    }
     audioOutputEngine = std::make_unique<AudioOutputEngine>(graphInstances, transport);
-    audioOutputEngine->initialise(ChannelsFormat::Mono, 48000.0, 512);
+    auto& inputRouter = audioOutputEngine->getOutputManager().getInputRouter();
+    inputRouter.setRoutes(buildInputRoutes());
+    for (auto& instance : graphInstances) {
+        if (instance) {
+            instance->getRecordSession().setInputRouter(&inputRouter);
+        }
+    }
+    audioOutputEngine->initialise(outputFormat,
+                                  transport->getSampleRate(),
+                                  transport->getCurrentBlockSize(),
+                                  inputRouter.getRequiredInputChannels());
+
+    if (auto editPtr = edit.lock()) {
+        editStateRoot = editPtr->getState().getRoot();
+        editStateRoot.addListener(this);
+    }
 }
 
 AudioEngine::~AudioEngine()
@@ -32,9 +55,87 @@ AudioEngine::~AudioEngine()
     shutdown();
 }
 
+void AudioEngine::refreshInputRoutes()
+{
+    if (!audioOutputEngine) {
+        return;
+    }
+    auto& inputRouter = audioOutputEngine->getOutputManager().getInputRouter();
+    inputRouter.setRoutes(buildInputRoutes());
+    // Reopening the device restarts it, dropping audio from every take; inputs opened later
+    // read as silence until the pass ends.
+    if (isRecording()) {
+        inputChannelsPending = true;
+        return;
+    }
+    inputChannelsPending = false;
+    audioOutputEngine->setInputChannels(inputRouter.getRequiredInputChannels());
+}
+
+bool AudioEngine::isRecording() const
+{
+    return std::any_of(graphInstances.begin(), graphInstances.end(), [](const auto& instance) {
+        return instance != nullptr && instance->isRecording();
+    });
+}
+
+void AudioEngine::valueTreePropertyChanged(juce::ValueTree&, const juce::Identifier& property)
+{
+    if (EditState::isInputRoutingProperty(property)) {
+        refreshInputRoutes();
+    }
+}
+
+void AudioEngine::valueTreeChildAdded(juce::ValueTree& parent, juce::ValueTree&)
+{
+    // Only track states matter; view and selection nodes come and go far more often.
+    if (EditState::isTrackStateContainer(parent)) {
+        refreshInputRoutes();
+    }
+}
+
+void AudioEngine::valueTreeChildRemoved(juce::ValueTree& parent, juce::ValueTree&, int)
+{
+    if (EditState::isTrackStateContainer(parent)) {
+        refreshInputRoutes();
+    }
+}
+
+std::vector<InputRouter::RouteDescription> AudioEngine::buildInputRoutes() const
+{
+    std::vector<InputRouter::RouteDescription> routes;
+    const auto editPtr = edit.lock();
+    if (!editPtr) {
+        return routes;
+    }
+    // The fader parameters live in the graph, so monitoring shares the track's gain.
+    const auto* valueTreeManager = !graphInstances.empty() && graphInstances.front()
+        ? &graphInstances.front()->getGraphManager().getValueTreeManager()
+        : nullptr;
+    for (const auto& track : editPtr->getTracks()) {
+        const auto recordTrack = std::dynamic_pointer_cast<RecordTrack>(track);
+        if (recordTrack == nullptr) {
+            continue;
+        }
+        // Idle inputs stay closed on the device.
+        if (recordTrack->getArmState() != TrackArmState::Active
+            && recordTrack->getInputMonitoringState() != TrackInputMonitoringState::Active) {
+            continue;
+        }
+        routes.push_back({ recordTrack->getId(),
+                           recordTrack,
+                           recordTrack->getInputChannel(),
+                           ChannelCount(recordTrack->getFormat()),
+                           valueTreeManager != nullptr
+                               ? valueTreeManager->getRawParameterValue(recordTrack->getId(), ParameterKey::Volume)
+                               : nullptr });
+    }
+    return routes;
+}
+
 void AudioEngine::start()
 {
-    transport->prepare(48000.0);
+    transport->prepare(audioOutputEngine->getOutputManager().getSampleRate());
     transport->rewind();
     transport->play();
 }
@@ -55,10 +156,14 @@ void AudioEngine::stopRecording()
             instance->stopRecording();
         }
     }
+    if (inputChannelsPending) {
+        refreshInputRoutes();
+    }
 }
 
 void AudioEngine::shutdown()
 {
+    editStateRoot.removeListener(this);
     if (audioOutputEngine) {
         audioOutputEngine->shutdown();
     }
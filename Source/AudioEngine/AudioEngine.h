@@ -14,7 +14,10 @@ class PluginRegistry;
 class PluginInstanceStore;
 
 /// Top-level audio engine coordinating graphs and output.
-class AudioEngine{
+/// Device input routes follow the edit: adding or removing tracks, arming, toggling input
+/// monitoring or changing a record track's input rebuilds them. Reopening the device for a
+/// different input count waits until no take is recording.
+class AudioEngine : private juce::ValueTree::Listener {
 public:
     /// Create an engine bound to an edit.
     /// @param edit edit containing tracks and routing
@@ -71,7 +74,25 @@ public:
         return *audioOutputEngine;
     }
 
+    /// Rebuild the device input routes from the edit and reopen the inputs they need.
+    void refreshInputRoutes();
+
+    /// True while any graph instance is recording.
+    bool isRecording() const;
+
 private:
+    /// Map every armed or monitored record track to its device inputs.
+    std::vector<InputRouter::RouteDescription> buildInputRoutes() const;
+
+    void valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property) override;
+    void valueTreeChildAdded(juce::ValueTree& parent, juce::ValueTree& child) override;
+    void valueTreeChildRemoved(juce::ValueTree& parent, juce::ValueTree& child, int index) override;
+
+    /// Edit state observed for input routing changes.
+    juce::ValueTree editStateRoot;
+    /// True when the device inputs changed during a take and are reopened once it ends.
+    bool inputChannelsPending = false;
+
     std::unique_ptr<PluginInstanceFactory> pluginHost;
     std::unique_ptr<PluginRegistry> pluginRegistry;
 
@@ -11,14 +11,14 @@ AudioOutputEngine::~AudioOutputEngine()
     shutdown();
 }
 
-void AudioOutputEngine::initialise(ChannelsFormat format, double rate, int size)
+void AudioOutputEngine::initialise(ChannelsFormat format, double rate, int size, int inputChannels)
 {
     if (initialised) {
         return;
     }
 
     audioOutputManager.configure(format, rate, size);
-    configureDevice(format, rate, size);
+    configureDevice(format, rate, size, inputChannels);
     deviceManager.addAudioCallback(&audioOutputManager);
     initialised = true;
 }
@@ -34,10 +34,31 @@ void AudioOutputEngine::shutdown()
     initialised = false;
 }
 
-void AudioOutputEngine::configureDevice(ChannelsFormat format, double rate, int size)
+void AudioOutputEngine::setInputChannels(int inputChannels)
+{
+    if (!initialised) {
+        return;
+    }
+
+    juce::AudioDeviceManager::AudioDeviceSetup setup;
+    deviceManager.getAudioDeviceSetup(setup);
+    if (setup.inputChannels.countNumberOfSetBits() == inputChannels
+        && setup.inputChannels.getHighestBit() == inputChannels - 1) {
+        return;
+    }
+    setup.inputChannels.clear();
+    setup.inputChannels.setRange(0, inputChannels, true);
+    setup.useDefaultInputChannels = false;
+    auto setupResult = deviceManager.setAudioDeviceSetup(setup, true);
+    if (setupResult.isNotEmpty()) {
+        juce::Logger::writeToLog("Audio device setup error: " + setupResult);
+    }
+}
+
+void AudioOutputEngine::configureDevice(ChannelsFormat format, double rate, int size, int inputChannels)
 {
     const int outputChannels = ChannelCount(format);
-    auto initResult = deviceManager.initialise(0, outputChannels, nullptr, true);
+    auto initResult = deviceManager.initialise(inputChannels, outputChannels, nullptr, true);
     if (initResult.isNotEmpty()) {
         juce::Logger::writeToLog("Audio device init error: " + initResult);
         return;
@@ -48,6 +69,8 @@ void AudioOutputEngine::configureDevice(ChannelsFormat format, double rate, int
     setup.sampleRate = rate;
     setup.bufferSize = size;
     setup.inputChannels.clear();
+    setup.inputChannels.setRange(0, inputChannels, true);
+    setup.useDefaultInputChannels = false;
     setup.outputChannels.clear();
     setup.outputChannels.setRange(0, outputChannels, true);
     auto setupResult = deviceManager.setAudioDeviceSetup(setup, true);
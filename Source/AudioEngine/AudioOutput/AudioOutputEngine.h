@@ -20,15 +20,20 @@ public:
                       const std::weak_ptr<Transport>& transport);
     ~AudioOutputEngine();
 
-    /// Initialise the output device.
-    /// @param format channel format to use
+    /// Initialise the audio device.
+    /// @param format output channel format to use
     /// @param rate sample rate
     /// @param size block size
-    void initialise(ChannelsFormat format, double rate, int size);
+    /// @param inputChannels device inputs to open
+    void initialise(ChannelsFormat format, double rate, int size, int inputChannels = 0);
 
     /// Stop and release the output device.
     void shutdown();
 
+    /// Reopen the device with another number of inputs (no-op when unchanged or not initialised).
+    /// @param inputChannels device inputs to open
+    void setInputChannels(int inputChannels);
+
     /// True when the output device is ready.
     [[nodiscard]] bool isInitialised() const noexcept { return initialised; }
 
@@ -40,10 +45,11 @@ public:
 
 private:
     /// Configure device settings before opening.
-    /// @param format channel format to use
+    /// @param format output channel format to use
     /// @param rate sample rate
     /// @param size block size
-    void configureDevice(ChannelsFormat format, double rate, int size);
+    /// @param inputChannels device inputs to open
+    void configureDevice(ChannelsFormat format, double rate, int size, int inputChannels);
 
     juce::AudioDeviceManager deviceManager;
     AudioOutputManager audioOutputManager;
@@ -25,6 +25,7 @@ void AudioOutputManager::audioDeviceAboutToStart(juce::AudioIODevice* device)
         sampleRate = device->getCurrentSampleRate();
         blockSize = device->getCurrentBufferSizeSamples();
     }
+    inputRouter.prepare(device, blockSize);
     if (auto transportPtr = transport.lock()) {
         transportPtr->prepare(sampleRate);
         transportPtr->setCurrentBlockSize(blockSize);
@@ -42,7 +43,7 @@ void AudioOutputManager::audioDeviceStopped()
 
 void AudioOutputManager::audioDeviceIOCallbackWithContext(
     const float *const*inputChannelData,
-    int,
+    int numInputChannels,
     float *const*outputChannelData,
     int numOutputChannels, int numSamples, const AudioIODeviceCallbackContext &context
     )
@@ -67,7 +68,10 @@ void AudioOutputManager::audioDeviceIOCallbackWithContext(
         }
     }
 
+    // Inputs are captured and monitored after the graph so monitoring skips its inserts entirely.
     if (const auto transportPtr = transport.lock()) {
+        inputRouter.process(inputChannelData, numInputChannels, mixBuffer, numSamples,
+                            transportPtr->getPlayheadSample());
         if (transportPtr->isPlaying())
             transportPtr->advance(numSamples);
     }
@@ -3,6 +3,7 @@
 #include <JuceHeader.h>
 
 #include "Utils/Format.h"
+#include "AudioEngine/Recording/InputRouter.h"
 
 #include <memory>
 #include <vector>
@@ -49,6 +50,9 @@ public:
     /// Current block size.
     [[nodiscard]] int getBlockSize() const noexcept { return blockSize; }
 
+    /// Device input stage (capture and direct monitoring).
+    [[nodiscard]] InputRouter& getInputRouter() noexcept { return inputRouter; }
+
 private:
     std::vector<std::unique_ptr<GraphInstance>>& graphInstances;
     std::weak_ptr<Transport> transport;
@@ -57,4 +61,5 @@ private:
     int blockSize = 512;
     juce::AudioBuffer<float> mixBuffer;
     juce::AudioBuffer<float> tempBuffer;
+    InputRouter inputRouter;
 };
@@ -46,7 +46,7 @@ GraphNode* GraphBuilder::fillGraphNode(
                 if (sendNode != nullptr) {
                     sendNode->tagIsNotGraphStart();
                     newNode->sends.push_back(sendNode);
-                    addUniqueConnection(newNode.get(), sendNode, seenConnections, connections);
+                    addUniqueConnection(newNode.get(), sendNode, seenConnections, connections, send.get());
                 }
             }
         }
@@ -94,14 +94,24 @@ void GraphBuilder::addUniqueConnection(
     GraphNode* input,
     GraphNode* output,
     std::set<std::pair<String, String>>& seenConnections,
-    std::vector<GraphConnectionDescription>& connections)
+    std::vector<GraphConnectionDescription>& connections,
+    const Send* send)
 {
     if (input == nullptr || output == nullptr) {
         return;
     }
 
-    std::pair<String, String> key { input->getId(), output->getId() };
+    // Sends are keyed by their model so a track can both send and output to the same aux.
+    const auto outputKey = send == nullptr
+        ? output->getId()
+        : output->getId() + ":send:" + String::toHexString(static_cast<juce::int64>(reinterpret_cast<juce::pointer_sized_int>(send)));
+    std::pair<String, String> key { input->getId(), outputKey };
     if (seenConnections.insert(key).second) {
-        connections.push_back({ input->getId(), output->getId() });
+        connections.push_back({
+            input->getId(),
+            output->getId(),
+            send == nullptr ? GraphConnectionType::Output : GraphConnectionType::Send,
+            send
+        });
     }
 }
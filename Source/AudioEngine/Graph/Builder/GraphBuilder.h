@@ -6,12 +6,24 @@
 #include "../Model/GraphNode.h"
 
 class Edit;
+class Send;
 class Track;
 
+/// Kind of routing a connection represents.
+enum class GraphConnectionType {
+    /// Track output routed to its output track.
+    Output,
+    /// Send tap summed into an aux track bus.
+    Send
+};
+
 /// Directed connection between two graph node ids.
 struct GraphConnectionDescription {
     String inputId;
     String outputId;
+    GraphConnectionType type = GraphConnectionType::Output;
+    /// Send model for send connections (owned by the source track).
+    const Send* send = nullptr;
 };
 
 /// Snapshot of graph nodes and their connections.
@@ -51,9 +63,11 @@ private:
     /// @param output downstream node
     /// @param seenConnections deduplication set
     /// @param connections accumulator of graph connections
+    /// @param send send model when the connection is a send tap (null for outputs)
     void addUniqueConnection(
         GraphNode* input,
         GraphNode* output,
         std::set<std::pair<String, String>>& seenConnections,
-        std::vector<GraphConnectionDescription>& connections);
+        std::vector<GraphConnectionDescription>& connections,
+        const Send* send = nullptr);
 };
@@ -38,6 +38,9 @@ public:
     /// Access the graph manager (routing/build info).
     GraphManager& getGraphManager() const { return *graphManager; }
 
+    /// True while a record pass is running.
+    bool isRecording() const { return recordSession != nullptr && recordSession->getState().isRecording; }
+
     /// Access the record session for this graph.
     RecordSession& getRecordSession() const { return *recordSession; }
 
@@ -3,6 +3,9 @@
 #include "../Model/GraphNode.h"
 #include "Core/Edit/Edit.h"
 #include "Core/Track/Send.h"
+#include "AudioEngine/Mixing/MixKernels.h"
+#include "AudioEngine/Nodes/ChannelMatrixNode.h"
+#include "AudioEngine/Nodes/SendNode.h"
 #include "AudioEngine/Recording/RecordSession.h"
 
 GraphManager::GraphManager(const std::weak_ptr<Edit>& edit,
@@ -12,9 +15,14 @@ GraphManager::GraphManager(const std::weak_ptr<Edit>& edit,
         graph(graph),
         recordSession(recordSession)
 {
+    if (const auto editPtr = edit.lock()) {
+        if (const auto outputTrack = editPtr->getAudioOutputTrack().lock()) {
+            outputFormat = outputTrack->getFormat();
+        }
+    }
     graph->clear();
-    graph->setPlayConfigDetails(1,
-        1,
+    graph->setPlayConfigDetails(0,
+        ChannelCount(outputFormat),
         48000,
         512);
     pluginFactory = std::make_unique<PluginInstanceFactory>();
@@ -79,7 +87,11 @@ void GraphManager::createFinalGraph(const std::shared_ptr<Transport>& transport)
     for (const auto& connection : graphDescription.connections) {
         auto inputModule = getGraphModuleById(connection.inputId);
         auto outputModule = getGraphModuleById(connection.outputId);
-        buildConnection(inputModule, outputModule, outputModule->virtualGraphNode->format);
+        if (connection.type == GraphConnectionType::Send) {
+            buildSendTap(inputModule, outputModule, connection.send, transport);
+        } else {
+            buildConnection(inputModule, outputModule);
+        }
     }
 }
 
@@ -100,7 +112,8 @@ void GraphManager::attachAudioOutput(std::weak_ptr<Track> track) {
             juce::AudioProcessorGraph::AudioGraphIOProcessor::audioOutputNode)
     );
     auto outputModule = getGraphModuleByTrackId(track.lock()->getId());
-    for (auto i=0; i<ChannelCount(track.lock()->getFormat()); i++) {
+    outputFormat = track.lock()->getFormat();
+    for (auto i=0; i<ChannelCount(outputFormat); i++) {
         graph->addConnection({
             { outputModule->outputNode->nodeID, i },
             { newAudioOutputNode->nodeID, i }
@@ -110,30 +123,90 @@ void GraphManager::attachAudioOutput(std::weak_ptr<Track> track) {
 }
 
 void GraphManager::prepareToPlay(double sampleRate, int blockSize) const {
-    graph->setPlayConfigDetails(2, 2, sampleRate, blockSize);
+    graph->setPlayConfigDetails(0, ChannelCount(outputFormat), sampleRate, blockSize);
     graph->prepareToPlay(sampleRate, blockSize);
 }
 
 void GraphManager::setProcessingFormat(double sampleRate, int blockSize)
 {
-    graph->setPlayConfigDetails(2, 2, sampleRate, blockSize);
+    graph->setPlayConfigDetails(0, ChannelCount(outputFormat), sampleRate, blockSize);
 }
 
 void GraphManager::buildConnection(
     const GraphModule* inputModule,
-    const GraphModule* outputModule,
-    ChannelsFormat format) const
+    const GraphModule* outputModule) const
 {
     if (inputModule == nullptr || outputModule == nullptr) {
         return;
     }
 
-    for (auto i=0; i<ChannelCount(format); i++) {
+    const auto inputChannels = ChannelCount(inputModule->virtualGraphNode->getFormat());
+    const auto outputChannels = ChannelCount(outputModule->virtualGraphNode->getFormat());
+    const auto sourceNodeId = inputModule->outputNode->nodeID;
+    if (!MixKernels::isUnityRouting(inputChannels, outputChannels)) {
+        // Weighted routes (centre split, surround fold) need a node; the graph only sums at unity.
+        auto matrixNode = graph->addNode(std::make_unique<ChannelMatrixNode>(
+            inputChannels, outputChannels, graph->getSampleRate(), graph->getBlockSize()));
+        if (matrixNode == nullptr) {
+            return;
+        }
+        for (auto i=0; i<inputChannels; i++) {
+            graph->addConnection({ { sourceNodeId, i }, { matrixNode->nodeID, i } });
+        }
+        for (auto i=0; i<outputChannels; i++) {
+            graph->addConnection({ { matrixNode->nodeID, i }, { outputModule->inputNode->nodeID, i } });
+        }
+        return;
+    }
+    for (auto s=0; s<inputChannels; s++) {
+        for (auto d=0; d<outputChannels; d++) {
+            if (MixKernels::getRouteGain(inputChannels, outputChannels, s, d) != 0.0f) {
+                graph->addConnection({ { sourceNodeId, s }, { outputModule->inputNode->nodeID, d } });
+            }
+        }
+    }
+}
+
+void GraphManager::buildSendTap(
+    const GraphModule* inputModule,
+    const GraphModule* outputModule,
+    const Send* send,
+    const std::shared_ptr<Transport>& transport) const
+{
+    if (inputModule == nullptr || outputModule == nullptr || send == nullptr) {
+        return;
+    }
+    if (outputModule->sendBus == nullptr) {
+        juce::Logger::writeToLog("GraphManager: send destination has no send bus, routing as a direct connection");
+        buildConnection(inputModule, outputModule);
+        return;
+    }
+
+    const auto& tapNode = send->getType() == SendType::PreFader && inputModule->preFaderNode != nullptr
+        ? inputModule->preFaderNode
+        : inputModule->outputNode;
+    auto sendNode = graph->addNode(std::make_unique<SendNode>(
+        send,
+        inputModule->getTrackById(inputModule->virtualGraphNode->getTrackId()),
+        inputModule->virtualGraphNode,
+        outputModule->sendBus,
+        transport));
+    if (sendNode == nullptr) {
+        return;
+    }
+
+    const auto inputChannels = ChannelCount(inputModule->virtualGraphNode->getFormat());
+    for (auto i=0; i<inputChannels; i++) {
         graph->addConnection({
-            { inputModule->outputNode->nodeID, i },
-            { outputModule->inputNode->nodeID, i }
+            { tapNode->nodeID, i },
+            { sendNode->nodeID, i }
         });
     }
+    // No audio flows along this edge; it only makes the graph render the send before the aux drains its bus.
+    graph->addConnection({
+        { sendNode->nodeID, juce::AudioProcessorGraph::midiChannelIndex },
+        { outputModule->inputNode->nodeID, juce::AudioProcessorGraph::midiChannelIndex }
+    });
 }
 
 void GraphManager::shutdown()
@@ -15,6 +15,7 @@ class Track;
 class Edit;
 class GraphNode;
 class RecordSession;
+class Send;
 
 /// Build and own the runtime audio graph for an Edit.
 class GraphManager {
@@ -92,17 +93,23 @@ public:
     /// Access the parameter store for app-owned params.
     ValueTreeManager& getValueTreeManager() const { return *valueTreeManager; }
 
+    /// Channel format of the graph output (the edit output track format).
+    [[nodiscard]] ChannelsFormat getOutputFormat() const { return outputFormat; }
+
     /// Access the plugin instance store (graph-owned plugins).
     const PluginInstanceStore& getPluginInstanceStore() const { return pluginInstanceStore; }
 
 private:
-    /// Connect two modules for all channels in the format.
+    /// Connect two modules, mapping the upstream format onto the downstream one.
     /// @param inputModule upstream module
     /// @param outputModule downstream module
-    /// @param format channel format to connect
     void buildConnection(const GraphModule* inputModule,
-                         const GraphModule* outputModule,
-                         ChannelsFormat format) const;
+                         const GraphModule* outputModule) const;
+    /// Insert a send tap between a source module and the bus of an aux module.
+    void buildSendTap(const GraphModule* inputModule,
+                      const GraphModule* outputModule,
+                      const Send* send,
+                      const std::shared_ptr<Transport>& transport) const;
 
     juce::AudioProcessorGraph::Node::Ptr audioOutputNode;
     GraphBuilder graphBuilder;
@@ -112,4 +119,5 @@ private:
     std::unique_ptr<PluginChainBuilder> pluginChainBuilder;
     RecordSession* recordSession = nullptr;
     std::unique_ptr<ValueTreeManager> valueTreeManager;
+    ChannelsFormat outputFormat = ChannelsFormat::Stereo;
 };
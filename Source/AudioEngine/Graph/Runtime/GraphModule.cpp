@@ -1,10 +1,14 @@
 #include "GraphModule.h"
 
 #include "AudioEngine/Nodes/AudioTrackNode.h"
+#include "AudioEngine/Nodes/AuxTrackNode.h"
 #include "AudioEngine/Nodes/VolumeNode.h"
 #include "AudioEngine/Plugin/PluginChainBuilder.h"
 #include "AudioEngine/Recording/RecordSession.h"
 #include "AudioEngine/Parameters/ValueTreeManager.h"
+#include "Core/Track/FolderTrack.h"
+
+#include <set>
 
 // ------------------------ MainComponent Implementation ------------------------
 
@@ -41,71 +45,114 @@ GraphModule::GraphModule(
         auto parameters = valueTreeManager
             ? valueTreeManager->buildParamMap(graphNode->getTrackId(), VolumeNode::requiredParameters())
             : std::map<ParameterKey, std::atomic<float>*>{};
-        auto volumeNode = std::make_unique<VolumeNode>(transport, graphNode, trackPtr, parameters);
+        auto volumeNode = std::make_unique<VolumeNode>(
+            transport, graphNode, trackPtr, parameters, buildVcaStages(trackPtr));
+        if (const auto editPtr = edit.lock()) {
+            volumeNode->setMeterTap(editPtr->getMeters()->getOrCreate(
+                graphNode->getTrackId(), ChannelCount(graphNode->getFormat())));
+        }
         auto graphVolumeNode = graphRef->addNode(std::move(volumeNode));
         outputNode = graphVolumeNode;
-
-        if (trackPtr != nullptr) {
-            auto transportPtr = transport.lock();
-            auto sampleRate = transportPtr ? transportPtr->getSampleRate() : 48000.0;
-            auto blockSize = transportPtr ? transportPtr->getCurrentBlockSize() : 512;
-            if (pluginChainBuilder != nullptr) {
-                auto plugins = pluginChainBuilder->createPluginNodes(
-                    trackPtr->getPlugins(),
-                    *graphRef,
-                    graphNode->getTrackId(),
-                    sampleRate,
-                    blockSize);
-                pluginChainBuilder->connectChain(
-                    *graphRef,
-                    graphAudioTrackNode.get(),
-                    graphVolumeNode.get(),
-                    plugins,
-                    graphNode->getFormat());
-            } else {
-                connectNodes(*graphRef, graphAudioTrackNode.get(), graphVolumeNode.get(), graphNode->getFormat());
-            }
-        } else {
-            connectNodes(*graphRef, graphAudioTrackNode.get(), graphVolumeNode.get(), graphNode->getFormat());
-        }
+        preFaderNode = buildInsertChain(trackPtr, graphAudioTrackNode, graphVolumeNode);
     }
     else if (graphNode->getType() == GraphNodeType::AuxTrackGraphNode) {
+        // The aux input node owns the bus every send to this aux sums into.
+        auto auxTrackNode = std::make_unique<AuxTrackNode>(transport, graphNode);
+        auto* auxTrackNodePtr = auxTrackNode.get();
+        auto graphAuxTrackNode = graphRef->addNode(std::move(auxTrackNode));
+        inputNode = graphAuxTrackNode;
+        if (graphAuxTrackNode != nullptr) {
+            sendBus = &auxTrackNodePtr->getSendBus();
+        }
+
         auto trackPtr = getTrackById(graphNode->getTrackId());
         auto parameters = valueTreeManager
             ? valueTreeManager->buildParamMap(graphNode->getTrackId(), VolumeNode::requiredParameters())
             : std::map<ParameterKey, std::atomic<float>*>{};
-        auto volumeNode = std::make_unique<VolumeNode>(transport, graphNode, trackPtr, parameters);
+        auto volumeNode = std::make_unique<VolumeNode>(
+            transport, graphNode, trackPtr, parameters, buildVcaStages(trackPtr));
+        if (const auto editPtr = edit.lock()) {
+            volumeNode->setMeterTap(editPtr->getMeters()->getOrCreate(
+                graphNode->getTrackId(), ChannelCount(graphNode->getFormat())));
+        }
         auto graphVolumeNode = graphRef->addNode(std::move(volumeNode));
         outputNode = graphVolumeNode;
+        preFaderNode = buildInsertChain(trackPtr, graphAuxTrackNode, graphVolumeNode);
+    }
+}
 
-        if (trackPtr != nullptr) {
-            auto transportPtr = transport.lock();
-            auto sampleRate = transportPtr ? transportPtr->getSampleRate() : 48000.0;
-            auto blockSize = transportPtr ? transportPtr->getCurrentBlockSize() : 512;
-            if (pluginChainBuilder != nullptr) {
-                auto plugins = pluginChainBuilder->createPluginNodes(
-                    trackPtr->getPlugins(),
-                    *graphRef,
-                    graphNode->getTrackId(),
-                    sampleRate,
-                    blockSize);
-                if (!plugins.empty()) {
-                    inputNode = plugins.front();
-                    pluginChainBuilder->connectPluginsToOutput(
-                        *graphRef,
-                        graphVolumeNode.get(),
-                        plugins,
-                        graphNode->getFormat());
-                } else {
-                    inputNode = outputNode;
+std::vector<VolumeNode::VcaStage> GraphModule::buildVcaStages(const std::shared_ptr<Track>& trackPtr) const
+{
+    std::vector<VolumeNode::VcaStage> stages;
+    if (trackPtr == nullptr) {
+        return stages;
+    }
+    // Folders downstream of the track already apply their fader to the signal: those on its
+    // output chain sum it, and the enclosing folders of any track on the chain scale it there.
+    std::set<const Track*> appliedDownstream;
+    for (auto output = trackPtr->getOutput().lock(); output != nullptr; output = output->getOutput().lock()) {
+        if (!appliedDownstream.insert(output.get()).second) {
+            // Output routing must not loop.
+            jassertfalse;
+            break;
+        }
+        for (auto* folder = output->getParentFolder(); folder != nullptr; folder = folder->getParentFolder()) {
+            appliedDownstream.insert(folder);
+        }
+    }
+    for (auto* folder = trackPtr->getParentFolder(); folder != nullptr; folder = folder->getParentFolder()) {
+        if (appliedDownstream.count(folder) != 0) {
+            continue;
+        }
+        VolumeNode::VcaStage stage;
+        stage.gain = valueTreeManager ? valueTreeManager->getRawParameterValue(folder->getId(), ParameterKey::Volume) : nullptr;
+        if (valueTreeManager != nullptr && stage.gain == nullptr) {
+            // ValueTreeManager::buildForGraph registers a fader for every enclosing folder.
+            juce::Logger::writeToLog("GraphModule: folder " + folder->getName() + " has no volume parameter, its fader is ignored");
+            jassertfalse;
+        }
+        stage.folder = getTrackById(folder->getId());
+        if (stage.folder.expired() && folder->getParentFolder() != nullptr) {
+            // Nested folders are owned by their parent rather than the edit.
+            for (const auto& child : folder->getParentFolder()->getChildFolders()) {
+                if (child.get() == folder) {
+                    stage.folder = child;
                 }
-            } else {
-                inputNode = outputNode;
             }
-        } else {
-            inputNode = outputNode;
         }
+        stages.push_back(std::move(stage));
     }
+    return stages;
+}
+
+juce::AudioProcessorGraph::Node::Ptr GraphModule::buildInsertChain(
+    const std::shared_ptr<Track>& trackPtr,
+    const juce::AudioProcessorGraph::Node::Ptr& headNode,
+    const juce::AudioProcessorGraph::Node::Ptr& volumeNode)
+{
+    auto* graphRef = getGraphRef();
+    if (trackPtr == nullptr || pluginChainBuilder == nullptr) {
+        connectNodes(*graphRef, headNode.get(), volumeNode.get(), virtualGraphNode->getFormat());
+        return headNode;
+    }
+
+    auto transportPtr = transport.lock();
+    auto sampleRate = transportPtr ? transportPtr->getSampleRate() : 48000.0;
+    auto blockSize = transportPtr ? transportPtr->getCurrentBlockSize() : 512;
+    auto plugins = pluginChainBuilder->createPluginNodes(
+        trackPtr->getPlugins(),
+        *graphRef,
+        virtualGraphNode->getTrackId(),
+        virtualGraphNode->getFormat(),
+        sampleRate,
+        blockSize);
+    pluginChainBuilder->connectChain(
+        *graphRef,
+        headNode.get(),
+        volumeNode.get(),
+        plugins,
+        virtualGraphNode->getFormat());
+    return plugins.empty() ? headNode : plugins.back();
 }
 
 std::weak_ptr<AudioTrack> GraphModule::getAudioTrackById(const String& trackId) const {
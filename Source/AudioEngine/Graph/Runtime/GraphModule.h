@@ -5,10 +5,12 @@
 #include "../Model/GraphNode.h"
 #include "Core/Edit/Edit.h"
 #include "Core/Track/AudioTrack.h"
+#include "AudioEngine/Nodes/VolumeNode.h"
 #include "Utils/Format.h"
 
 class PluginChainBuilder;
 class RecordSession;
+class SendBus;
 class ValueTreeManager;
 
 /// Runtime module wiring nodes and plugins for a single graph node.
@@ -42,6 +44,10 @@ public:
     juce::AudioProcessorGraph::Node::Ptr inputNode;
     /// Last node in this module's processing chain.
     juce::AudioProcessorGraph::Node::Ptr outputNode;
+    /// Last node before the fader (pre-fader send tap point).
+    juce::AudioProcessorGraph::Node::Ptr preFaderNode;
+    /// Bus summing the sends targeting this module (aux modules only).
+    SendBus* sendBus = nullptr;
 
     /// Model node associated with this module.
     GraphNode* virtualGraphNode;
@@ -54,6 +60,20 @@ private:
     /// Access the underlying audio graph (throws if missing).
     AudioProcessorGraph* getGraphRef() const;
 
+    /// Collect the folder faders acting as VCAs on a track, innermost first.
+    /// @param trackPtr track whose enclosing folders are resolved (may be null)
+    std::vector<VolumeNode::VcaStage> buildVcaStages(const std::shared_ptr<Track>& trackPtr) const;
+
+    /// Create the track inserts and connect head -> inserts -> volume.
+    /// @param trackPtr track owning the inserts (may be null)
+    /// @param headNode first node of the module
+    /// @param volumeNode fader node of the module
+    /// @return last node before the fader
+    juce::AudioProcessorGraph::Node::Ptr buildInsertChain(
+        const std::shared_ptr<Track>& trackPtr,
+        const juce::AudioProcessorGraph::Node::Ptr& headNode,
+        const juce::AudioProcessorGraph::Node::Ptr& volumeNode);
+
     /// Connect two nodes for all channels in the format.
     /// @param graph target graph
     /// @param nodeInput upstream node
@@ -0,0 +1,106 @@
+#include "MixKernels.h"
+
+#include <array>
+#include <utility>
+
+namespace MixKernels {
+namespace {
+
+using KernelTable = std::array<std::array<KernelSet, maxChannels>, maxChannels>;
+
+template <int Src, int Dst>
+constexpr KernelSet makeKernelSet()
+{
+    return {
+        &detail::copy<Src, Dst>,
+        &detail::add<Src, Dst>,
+        &detail::addWithGain<Src, Dst>,
+        &detail::addWithRamp<Src, Dst>,
+        &detail::addWithChannelRamps<Src, Dst>
+    };
+}
+
+template <int Src, std::size_t... DstIndex>
+constexpr std::array<KernelSet, maxChannels> makeKernelRow(std::index_sequence<DstIndex...>)
+{
+    return { makeKernelSet<Src, static_cast<int>(DstIndex) + 1>()... };
+}
+
+template <std::size_t... SrcIndex>
+constexpr KernelTable makeKernelTable(std::index_sequence<SrcIndex...>)
+{
+    return { makeKernelRow<static_cast<int>(SrcIndex) + 1>(std::make_index_sequence<maxChannels>{})... };
+}
+
+constexpr KernelTable kernelTable = makeKernelTable(std::make_index_sequence<maxChannels>{});
+
+using MatrixTable = std::array<std::array<detail::Matrix, maxChannels>, maxChannels>;
+
+constexpr MatrixTable makeMatrixTable()
+{
+    MatrixTable table {};
+    for (int src = 1; src <= maxChannels; ++src) {
+        for (int dst = 1; dst <= maxChannels; ++dst) {
+            table[static_cast<size_t>(src - 1)][static_cast<size_t>(dst - 1)] = detail::makeMatrix(src, dst);
+        }
+    }
+    return table;
+}
+
+constexpr MatrixTable matrixTable = makeMatrixTable();
+
+} // namespace
+
+float getRouteGain(int sourceChannels, int destinationChannels, int source, int destination) noexcept
+{
+    const auto src = juce::jlimit(1, maxChannels, sourceChannels);
+    const auto dst = juce::jlimit(1, maxChannels, destinationChannels);
+    // Channel indices must lie inside their layouts.
+    jassert(source >= 0 && source < src && destination >= 0 && destination < dst);
+    return matrixTable[static_cast<size_t>(src - 1)][static_cast<size_t>(dst - 1)]
+                      [static_cast<size_t>(source)][static_cast<size_t>(destination)];
+}
+
+bool isUnityRouting(int sourceChannels, int destinationChannels) noexcept
+{
+    const auto src = juce::jlimit(1, maxChannels, sourceChannels);
+    const auto dst = juce::jlimit(1, maxChannels, destinationChannels);
+    for (int s = 0; s < src; ++s) {
+        for (int d = 0; d < dst; ++d) {
+            const auto gain = getRouteGain(src, dst, s, d);
+            if (gain != 0.0f && gain != 1.0f) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+const KernelSet& select(int sourceChannels, int destinationChannels) noexcept
+{
+    const auto src = juce::jlimit(1, maxChannels, sourceChannels);
+    const auto dst = juce::jlimit(1, maxChannels, destinationChannels);
+    return kernelTable[static_cast<size_t>(src - 1)][static_cast<size_t>(dst - 1)];
+}
+
+void addScalarReference(const juce::AudioBuffer<float>& source,
+                        juce::AudioBuffer<float>& destination,
+                        int startSample,
+                        int numSamples) noexcept
+{
+    const auto src = juce::jlimit(1, maxChannels, source.getNumChannels());
+    const auto dst = juce::jlimit(1, maxChannels, destination.getNumChannels());
+    for (int d = 0; d != dst; d++) {
+        for (int s = 0; s != src; s++) {
+            const auto gain = getRouteGain(src, dst, s, d);
+            if (gain == 0.0f) {
+                continue;
+            }
+            for (int i = startSample; i < startSample + numSamples; i++) {
+                destination.addSample(d, i, source.getSample(s, i) * gain);
+            }
+        }
+    }
+}
+
+} // namespace MixKernels
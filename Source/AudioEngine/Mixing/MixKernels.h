@@ -0,0 +1,293 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <array>
+
+#include "Utils/Format.h"
+
+/// Mixing kernels used to sum a source buffer into a destination buffer of a given channel count.
+/// Kernels are specialised at compile time on the source and destination channel counts and
+/// selected once per source/destination pair.
+///
+/// Channel mapping follows the speaker layout of each channel count (see ChannelsFormat):
+/// - a speaker present in both layouts is routed at unity
+/// - a missing centre is split onto left and right at -3 dB
+/// - missing left/right (mono destination) fold onto the centre at -3 dB
+/// - missing surrounds fold onto the same side front at -3 dB, missing rears onto the surrounds
+/// - a missing LFE is dropped
+/// - a mono source feeds the centre, or left and right at unity when there is no centre
+/// The graph applies the same matrix between tracks of different formats (see getRouteGain).
+namespace MixKernels {
+
+/// Largest channel count handled by the specialised kernels (7.1).
+inline constexpr int maxChannels = ChannelCount(ChannelsFormat::SevenOne);
+
+/// Gain from a source channel to a destination channel (0 when not routed).
+/// @param sourceChannels source channel count
+/// @param destinationChannels destination channel count
+/// @param source source channel index
+/// @param destination destination channel index
+float getRouteGain(int sourceChannels, int destinationChannels, int source, int destination) noexcept;
+
+/// True when every route is at unity, so plain graph connections carry the mapping.
+/// @param sourceChannels source channel count
+/// @param destinationChannels destination channel count
+bool isUnityRouting(int sourceChannels, int destinationChannels) noexcept;
+
+/// Kernel signature. Source and destination share the same sample indexing.
+/// @param source source channel pointers
+/// @param destination destination channel pointers
+/// @param startSample first sample to process in both buffers
+/// @param numSamples number of samples to process
+/// @param startGain gain at startSample (ignored by copy/add)
+/// @param endGain gain reached at startSample + numSamples (only used by ramp)
+using Kernel = void (*)(const float* const* source,
+                        float* const* destination,
+                        int startSample,
+                        int numSamples,
+                        float startGain,
+                        float endGain) noexcept;
+
+/// Kernel signature with an independent linear gain ramp per destination channel
+/// (used for panned sends).
+/// @param source source channel pointers
+/// @param destination destination channel pointers
+/// @param startSample first sample to process in both buffers
+/// @param numSamples number of samples to process
+/// @param startGains gain per destination channel at startSample
+/// @param endGains gain per destination channel at startSample + numSamples
+using ChannelGainKernel = void (*)(const float* const* source,
+                                   float* const* destination,
+                                   int startSample,
+                                   int numSamples,
+                                   const float* startGains,
+                                   const float* endGains) noexcept;
+
+/// Kernels for one source/destination channel pair.
+struct KernelSet {
+    /// Overwrite the destination with the mapped source (unmapped channels are cleared).
+    Kernel copy = nullptr;
+    /// Add the mapped source to the destination.
+    Kernel add = nullptr;
+    /// Add the mapped source scaled by a constant gain.
+    Kernel addWithGain = nullptr;
+    /// Add the mapped source scaled by a linear gain ramp.
+    Kernel addWithRamp = nullptr;
+    /// Add the mapped source scaled by a linear gain ramp per destination channel.
+    ChannelGainKernel addWithChannelRamps = nullptr;
+};
+
+/// Select the kernels for a channel pair (counts are clamped to [1, maxChannels]).
+/// @param sourceChannels source channel count
+/// @param destinationChannels destination channel count
+const KernelSet& select(int sourceChannels, int destinationChannels) noexcept;
+
+/// Scalar reference path: per-sample add through the channel matrix.
+/// Kept for correctness checks against the specialised kernels.
+void addScalarReference(const juce::AudioBuffer<float>& source,
+                        juce::AudioBuffer<float>& destination,
+                        int startSample,
+                        int numSamples) noexcept;
+
+namespace detail {
+
+/// Speaker fed by a channel.
+enum class Speaker : uint8 { Left, Right, Centre, Lfe, SurroundLeft, SurroundRight, RearLeft, RearRight };
+
+/// Gain of one fold step (-3 dB).
+inline constexpr float foldStepGain = 0.70710678f;
+
+/// Route gains indexed by [source][destination].
+using Matrix = std::array<std::array<float, maxChannels>, maxChannels>;
+
+/// Speaker of a channel in the layout with a given channel count (JUCE channel order).
+constexpr Speaker speakerAt(int channels, int index) noexcept
+{
+    using S = Speaker;
+    constexpr S layouts[maxChannels][maxChannels] = {
+        { S::Centre },
+        { S::Left, S::Right },
+        { S::Left, S::Right, S::Centre },
+        { S::Left, S::Right, S::SurroundLeft, S::SurroundRight },
+        { S::Left, S::Right, S::Centre, S::SurroundLeft, S::SurroundRight },
+        { S::Left, S::Right, S::Centre, S::Lfe, S::SurroundLeft, S::SurroundRight },
+        { S::Left, S::Right, S::Centre, S::SurroundLeft, S::SurroundRight, S::RearLeft, S::RearRight },
+        { S::Left, S::Right, S::Centre, S::Lfe, S::SurroundLeft, S::SurroundRight, S::RearLeft, S::RearRight }
+    };
+    return layouts[channels - 1][index];
+}
+
+/// Channel feeding a speaker, or -1 when the layout has none.
+constexpr int channelOf(int channels, Speaker speaker) noexcept
+{
+    for (int i = 0; i < channels; ++i) {
+        if (speakerAt(channels, i) == speaker) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/// Add a source channel's contribution to a speaker, folding it when the destination lacks it.
+constexpr void routeSpeaker(Matrix& matrix, int source, Speaker speaker, int destinationChannels, float weight) noexcept
+{
+    if (const auto destination = channelOf(destinationChannels, speaker); destination >= 0) {
+        matrix[static_cast<size_t>(source)][static_cast<size_t>(destination)] += weight;
+        return;
+    }
+    const auto folded = weight * foldStepGain;
+    switch (speaker) {
+        case Speaker::Centre:
+            routeSpeaker(matrix, source, Speaker::Left, destinationChannels, folded);
+            routeSpeaker(matrix, source, Speaker::Right, destinationChannels, folded);
+            break;
+        // Only a mono layout lacks left and right, and it has a centre.
+        case Speaker::Left:
+        case Speaker::Right:
+            routeSpeaker(matrix, source, Speaker::Centre, destinationChannels, folded);
+            break;
+        case Speaker::SurroundLeft:
+            routeSpeaker(matrix, source, Speaker::Left, destinationChannels, folded);
+            break;
+        case Speaker::SurroundRight:
+            routeSpeaker(matrix, source, Speaker::Right, destinationChannels, folded);
+            break;
+        case Speaker::RearLeft:
+            routeSpeaker(matrix, source, Speaker::SurroundLeft, destinationChannels, folded);
+            break;
+        case Speaker::RearRight:
+            routeSpeaker(matrix, source, Speaker::SurroundRight, destinationChannels, folded);
+            break;
+        case Speaker::Lfe:
+            break;
+    }
+}
+
+/// Route gains for a channel pair (counts in [1, maxChannels]).
+constexpr Matrix makeMatrix(int sourceChannels, int destinationChannels) noexcept
+{
+    Matrix matrix {};
+    if (sourceChannels == 1 && destinationChannels > 1 && channelOf(destinationChannels, Speaker::Centre) < 0) {
+        // Mono tracks sit in the middle of a stereo or quad image at unity, like the pan law does.
+        matrix[0][0] = 1.0f;
+        matrix[0][1] = 1.0f;
+        return matrix;
+    }
+    for (int s = 0; s < sourceChannels; ++s) {
+        routeSpeaker(matrix, s, speakerAt(sourceChannels, s), destinationChannels, 1.0f);
+    }
+    return matrix;
+}
+
+template <int Src, int Dst>
+inline constexpr Matrix matrixFor = makeMatrix(Src, Dst);
+
+/// Add src * (gain .. gain + increment * n) into dst.
+inline void addRamp(float* dst, const float* src, int numSamples, float gain, float increment) noexcept
+{
+    for (int i = 0; i < numSamples; ++i) {
+        dst[i] += src[i] * gain;
+        gain += increment;
+    }
+}
+
+/// Visit every (source, destination, weight) route for a channel pair.
+template <int Src, int Dst, typename Fn>
+inline void forEachRoute(Fn&& fn) noexcept
+{
+    constexpr auto& matrix = matrixFor<Src, Dst>;
+    for (int s = 0; s < Src; ++s) {
+        for (int d = 0; d < Dst; ++d) {
+            const auto weight = matrix[static_cast<size_t>(s)][static_cast<size_t>(d)];
+            if (weight != 0.0f) {
+                fn(s, d, weight);
+            }
+        }
+    }
+}
+
+template <int Src, int Dst>
+void copy(const float* const* source, float* const* destination, int startSample, int numSamples,
+          float, float) noexcept
+{
+    for (int d = 0; d < Dst; ++d) {
+        juce::FloatVectorOperations::clear(destination[d] + startSample, numSamples);
+    }
+    forEachRoute<Src, Dst>([&](int s, int d, float weight) {
+        if (weight == 1.0f) {
+            juce::FloatVectorOperations::add(destination[d] + startSample, source[s] + startSample, numSamples);
+        } else {
+            juce::FloatVectorOperations::addWithMultiply(destination[d] + startSample,
+                                                         source[s] + startSample, weight, numSamples);
+        }
+    });
+}
+
+template <int Src, int Dst>
+void add(const float* const* source, float* const* destination, int startSample, int numSamples,
+         float, float) noexcept
+{
+    forEachRoute<Src, Dst>([&](int s, int d, float weight) {
+        if (weight == 1.0f) {
+            juce::FloatVectorOperations::add(destination[d] + startSample, source[s] + startSample, numSamples);
+        } else {
+            juce::FloatVectorOperations::addWithMultiply(destination[d] + startSample,
+                                                         source[s] + startSample, weight, numSamples);
+        }
+    });
+}
+
+template <int Src, int Dst>
+void addWithGain(const float* const* source, float* const* destination, int startSample, int numSamples,
+                 float gain, float) noexcept
+{
+    forEachRoute<Src, Dst>([&](int s, int d, float weight) {
+        juce::FloatVectorOperations::addWithMultiply(destination[d] + startSample,
+                                                     source[s] + startSample, gain * weight, numSamples);
+    });
+}
+
+template <int Src, int Dst>
+void addWithRamp(const float* const* source, float* const* destination, int startSample, int numSamples,
+                 float startGain, float endGain) noexcept
+{
+    if (numSamples <= 0) {
+        return;
+    }
+    if (startGain == endGain) {
+        addWithGain<Src, Dst>(source, destination, startSample, numSamples, startGain, endGain);
+        return;
+    }
+    const auto increment = (endGain - startGain) / static_cast<float>(numSamples);
+    forEachRoute<Src, Dst>([&](int s, int d, float weight) {
+        addRamp(destination[d] + startSample, source[s] + startSample, numSamples,
+                startGain * weight, increment * weight);
+    });
+}
+
+template <int Src, int Dst>
+void addWithChannelRamps(const float* const* source, float* const* destination, int startSample, int numSamples,
+                         const float* startGains, const float* endGains) noexcept
+{
+    if (numSamples <= 0) {
+        return;
+    }
+    const auto inverseLength = 1.0f / static_cast<float>(numSamples);
+    forEachRoute<Src, Dst>([&](int s, int d, float weight) {
+        const auto startGain = startGains[d] * weight;
+        const auto endGain = endGains[d] * weight;
+        if (startGain == endGain) {
+            if (startGain != 0.0f) {
+                juce::FloatVectorOperations::addWithMultiply(destination[d] + startSample,
+                                                             source[s] + startSample, startGain, numSamples);
+            }
+            return;
+        }
+        addRamp(destination[d] + startSample, source[s] + startSample, numSamples,
+                startGain, (endGain - startGain) * inverseLength);
+    });
+}
+
+} // namespace detail
+} // namespace MixKernels
@@ -5,7 +5,10 @@
 #include <atomic>
 #include <map>
 
+#include "AudioEngine/Graph/Model/GraphNode.h"
 #include "AudioEngine/Parameters/ParameterFactory.h"
+#include "Utils/Format.h"
+#include "Utils/Transport.h"
 
 /// Base audio node with parameter binding and JUCE boilerplate.
 class AudioNode : public juce::AudioProcessor {
@@ -29,6 +32,20 @@ protected:
         return (it != parameters.end()) ? it->second : nullptr;
     }
 
+    /// Configure the node buses from its graph node format and the current engine rate/block size.
+    /// The graph re-prepares the node with the device details once the device starts.
+    /// @param graphNode owning graph node (stereo when null)
+    /// @param transport timeline transport providing rate and block size
+    void setFormatDetails(const GraphNode* graphNode, const std::weak_ptr<Transport>& transport)
+    {
+        const auto format = graphNode != nullptr ? graphNode->getFormat() : ChannelsFormat::Stereo;
+        const auto transportPtr = transport.lock();
+        const auto sampleRate = transportPtr ? transportPtr->getSampleRate() : 48000.0;
+        const auto blockSize = transportPtr ? transportPtr->getCurrentBlockSize() : 512;
+        const auto channels = ChannelCount(format);
+        setPlayConfigDetails(channels, channels, sampleRate, blockSize);
+    }
+
     /// JUCE AudioProcessor no-op overrides required by the base interface.
     void prepareToPlay(double, int) override {}
     void releaseResources() override {}
@@ -1,10 +1,12 @@
 #include "AudioTrackNode.h"
 
 #include "AudioEngine/Graph/Model/GraphNode.h"
+#include "AudioEngine/Mixing/MixKernels.h"
 #include "AudioEngine/Recording/Recorder.h"
 
 #include <Core/Track/AudioTrack.h>
 
+#include <thread>
 #include <utility>
 
 AudioTrackNode::AudioTrackNode(const std::weak_ptr<AudioTrack>& audioTrack,
@@ -14,7 +16,7 @@ AudioTrackNode::AudioTrackNode(const std::weak_ptr<AudioTrack>& audioTrack,
       audioTrack(audioTrack),
       graphNode(graphNode)
 {
-    setPlayConfigDetails(2, 2, 48000.0, 512);
+    setFormatDetails(graphNode, transport);
 }
 
 const juce::String AudioTrackNode::getName() const
@@ -33,9 +35,11 @@ void AudioTrackNode::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBu
         return;
     }
 
-    if (auto* recorder = activeRecorder.load(std::memory_order_relaxed)) {
+    recorderInUse.store(true);
+    if (auto* recorder = activeRecorder.load()) {
         recorder->pushBuffer(buffer, buffer.getNumSamples());
     }
+    recorderInUse.store(false);
 
     for (const auto& audioClip : trackPtr->getAudioClips()) {
         // define all local variable needed to do easy to read computation
@@ -51,19 +55,27 @@ void AudioTrackNode::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBu
 
         if (audioClipStartSample <= currentPlayheadSample + numSamples && currentPlayheadSample < audioClipEndSample) {
             juce::AudioBuffer<float> audioClipBuffer = audioClip->read( currentPlayheadSample - audioClipStartSample, buffer.getNumSamples());
-            for (int c=0; c!= buffer.getNumChannels(); c++) {
-                auto audioClipChannel = std::min(c, audioClipBuffer.getNumChannels() - 1);
-                for (int i=writeStartSample; i < writeEndSample; i++) {
-                    buffer.addSample(c, i, audioClipBuffer.getSample(audioClipChannel,i));
-                }
+            if (audioClipBuffer.getNumChannels() == 0 || writeEndSample <= writeStartSample) {
+                continue;
             }
+            const auto& kernels = MixKernels::select(audioClipBuffer.getNumChannels(), buffer.getNumChannels());
+            kernels.add(audioClipBuffer.getArrayOfReadPointers(),
+                        buffer.getArrayOfWritePointers(),
+                        static_cast<int>(writeStartSample),
+                        static_cast<int>(writeEndSample - writeStartSample),
+                        1.0f,
+                        1.0f);
         }
     }
 }
 
 void AudioTrackNode::setActiveRecorder(Recorder* recorder)
 {
-    activeRecorder.store(recorder, std::memory_order_relaxed);
+    activeRecorder.store(recorder);
+    // Wait for a block that may still hold the previous recorder, so the caller can close it.
+    while (recorderInUse.load()) {
+        std::this_thread::yield();
+    }
 }
 
 bool AudioTrackNode::isTrackArmed() const
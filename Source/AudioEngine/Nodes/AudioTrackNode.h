@@ -27,6 +27,7 @@ public:
     void processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) override;
 
     /// Attach a recorder for the next record pass.
+    /// Returns once the audio thread no longer uses the previous recorder.
     /// @param recorder recorder instance to use
     void setActiveRecorder(Recorder* recorder);
 
@@ -41,4 +42,5 @@ private:
     std::weak_ptr<AudioTrack> audioTrack;
     const GraphNode* graphNode;
     std::atomic<Recorder*> activeRecorder{ nullptr };
+    std::atomic<bool> recorderInUse{ false };
 };
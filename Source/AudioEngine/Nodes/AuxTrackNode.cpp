@@ -6,7 +6,7 @@ AuxTrackNode::AuxTrackNode(const std::weak_ptr<Transport>& transport, const Grap
     : transport(transport),
       graphNode(graphNode)
 {
-    setPlayConfigDetails(2, 2, 48000.0, 512);
+    setFormatDetails(graphNode, transport);
 }
 
 const juce::String AuxTrackNode::getName() const
@@ -17,7 +17,19 @@ const juce::String AuxTrackNode::getName() const
     return "NoName:AuxTrackNode";
 }
 
-void AuxTrackNode::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+void AuxTrackNode::prepareToPlay(double, int blockSize)
 {
-    // Return buffer directly without any processing
+    sendBus.prepare(getTotalNumOutputChannels(), blockSize);
+}
+
+void AuxTrackNode::releaseResources()
+{
+    sendBus.release();
+}
+
+void AuxTrackNode::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
+{
+    // Output routing arrives through graph connections; sends arrive through the shared bus.
+    sendBus.drainInto(buffer, buffer.getNumSamples());
+    midi.clear();
 }
@@ -1,11 +1,13 @@
 #pragma once
 
 #include "AudioNode.h"
+#include "SendBus.h"
 #include "Utils/Transport.h"
 
 class GraphNode;
 
-/// Runtime node for aux/folder track processing.
+/// Runtime input node for aux/folder track processing.
+/// Owns the aux send bus and adds it to the signal routed to the aux by track outputs.
 class AuxTrackNode : public AudioNode {
 public:
     /// Create a node bound to transport.
@@ -16,10 +18,23 @@ public:
     /// Display name for debugging/graph views.
     const juce::String getName() const override;
 
+    /// Allocate the send bus for the aux format and block size.
+    void prepareToPlay(double sampleRate, int blockSize) override;
+
+    /// Release the send bus.
+    void releaseResources() override;
+
     /// Process audio for the aux track node.
     void processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) override;
 
+    /// Send nodes reach this node through MIDI ordering edges.
+    bool acceptsMidi() const override { return true; }
+
+    /// Bus shared by every send targeting this aux.
+    SendBus& getSendBus() noexcept { return sendBus; }
+
 private:
     std::weak_ptr<Transport> transport;
     const GraphNode* graphNode;
+    SendBus sendBus;
 };
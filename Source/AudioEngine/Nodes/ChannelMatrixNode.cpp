@@ -0,0 +1,34 @@
+#include "ChannelMatrixNode.h"
+
+ChannelMatrixNode::ChannelMatrixNode(int sourceChannels, int destinationChannels, double sampleRate, int blockSize)
+    : sourceChannels(sourceChannels),
+      destinationChannels(destinationChannels),
+      kernels(MixKernels::select(sourceChannels, destinationChannels))
+{
+    setPlayConfigDetails(sourceChannels, destinationChannels, sampleRate, blockSize);
+    scratch.setSize(destinationChannels, blockSize);
+}
+
+const juce::String ChannelMatrixNode::getName() const
+{
+    return juce::String(sourceChannels) + "to" + juce::String(destinationChannels) + ":ChannelMatrixNode";
+}
+
+void ChannelMatrixNode::prepareToPlay(double, int blockSize)
+{
+    scratch.setSize(destinationChannels, blockSize, false, false, true);
+}
+
+void ChannelMatrixNode::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&)
+{
+    const auto numSamples = buffer.getNumSamples();
+    // Blocks longer than announced only reallocate if the host broke its promise.
+    scratch.setSize(destinationChannels, numSamples, false, false, true);
+    kernels.copy(buffer.getArrayOfReadPointers(), scratch.getArrayOfWritePointers(), 0, numSamples, 1.0f, 1.0f);
+    for (int c = 0; c < destinationChannels; ++c) {
+        buffer.copyFrom(c, 0, scratch, c, 0, numSamples);
+    }
+    for (int c = destinationChannels; c < buffer.getNumChannels(); ++c) {
+        buffer.clear(c, 0, numSamples);
+    }
+}
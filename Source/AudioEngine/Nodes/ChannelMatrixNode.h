@@ -0,0 +1,32 @@
+#pragma once
+
+#include "AudioNode.h"
+#include "AudioEngine/Mixing/MixKernels.h"
+
+/// Runtime node converting between two channel formats through the MixKernels channel matrix.
+/// Graph connections cannot carry a gain, so GraphManager inserts one between tracks whose
+/// formats need a weighted downmix or upmix (centre split, surround fold).
+class ChannelMatrixNode : public AudioNode {
+public:
+    /// Create a conversion node.
+    /// @param sourceChannels input channel count
+    /// @param destinationChannels output channel count
+    /// @param sampleRate initial sample rate
+    /// @param blockSize initial block size
+    ChannelMatrixNode(int sourceChannels, int destinationChannels, double sampleRate, int blockSize);
+
+    /// Display name for debugging/graph views.
+    const juce::String getName() const override;
+
+    /// Allocate the scratch buffer.
+    void prepareToPlay(double sampleRate, int blockSize) override;
+
+    /// Replace the input channels with the converted output channels.
+    void processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) override;
+
+private:
+    int sourceChannels;
+    int destinationChannels;
+    const MixKernels::KernelSet& kernels;
+    juce::AudioBuffer<float> scratch;
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "AudioEngine/Mixing/MixKernels.h"
+
+/// Preallocated summing bus shared by every send feeding an aux track.
+/// Send nodes accumulate into it and the aux input node drains it once per block.
+class SendBus {
+public:
+    /// Allocate the bus for the aux format and the largest expected block.
+    /// @param numChannels aux channel count
+    /// @param maximumBlockSize largest block the graph will render
+    void prepare(int numChannels, int maximumBlockSize)
+    {
+        buffer.setSize(numChannels, maximumBlockSize, false, true, false);
+        buffer.clear();
+    }
+
+    /// Release the bus storage.
+    void release()
+    {
+        buffer.setSize(0, 0);
+    }
+
+    /// Channel count of the bus (0 until prepared).
+    [[nodiscard]] int getNumChannels() const noexcept { return buffer.getNumChannels(); }
+
+    /// Accumulate a send tap into the bus with a gain ramp per bus channel.
+    /// @param source tapped signal
+    /// @param numSamples samples to accumulate
+    /// @param startGains gain per bus channel at the start of the block
+    /// @param endGains gain per bus channel at the end of the block
+    void add(const juce::AudioBuffer<float>& source,
+             int numSamples,
+             const float* startGains,
+             const float* endGains) noexcept
+    {
+        if (source.getNumChannels() == 0 || buffer.getNumChannels() == 0) {
+            return;
+        }
+        if (numSamples > buffer.getNumSamples()) {
+            // The bus must be prepared for the block size before sends are rendered.
+            jassertfalse;
+            return;
+        }
+        MixKernels::select(source.getNumChannels(), buffer.getNumChannels())
+            .addWithChannelRamps(source.getArrayOfReadPointers(),
+                                 buffer.getArrayOfWritePointers(),
+                                 0,
+                                 numSamples,
+                                 startGains,
+                                 endGains);
+        hasSignal = true;
+    }
+
+    /// Add the accumulated sends to the aux input and clear the bus for the next block.
+    /// @param destination aux input buffer
+    /// @param numSamples samples to drain
+    void drainInto(juce::AudioBuffer<float>& destination, int numSamples) noexcept
+    {
+        if (!hasSignal) {
+            return;
+        }
+        const auto channels = std::min(destination.getNumChannels(), buffer.getNumChannels());
+        const auto samples = std::min(numSamples, buffer.getNumSamples());
+        for (int c = 0; c < channels; ++c) {
+            destination.addFrom(c, 0, buffer, c, 0, samples);
+        }
+        buffer.clear(0, samples);
+        hasSignal = false;
+    }
+
+private:
+    juce::AudioBuffer<float> buffer;
+    bool hasSignal = false;
+};
@@ -0,0 +1,95 @@
+#include "SendNode.h"
+
+#include "SendBus.h"
+#include "AudioEngine/Graph/Model/GraphNode.h"
+#include "Core/Track/Send.h"
+#include "Core/Track/TrackState.h"
+
+namespace {
+constexpr double kSmoothingSeconds = 0.05;
+}
+
+SendNode::SendNode(const Send* send,
+                   const std::weak_ptr<Track>& track,
+                   const GraphNode* graphNode,
+                   SendBus* sendBus,
+                   const std::weak_ptr<Transport>& transport)
+    : send(send),
+      track(track),
+      graphNode(graphNode),
+      sendBus(sendBus)
+{
+    const auto transportPtr = transport.lock();
+    const auto channels = ChannelCount(graphNode != nullptr ? graphNode->getFormat() : ChannelsFormat::Stereo);
+    setPlayConfigDetails(channels,
+                         0,
+                         transportPtr ? transportPtr->getSampleRate() : 48000.0,
+                         transportPtr ? transportPtr->getCurrentBlockSize() : 512);
+}
+
+const juce::String SendNode::getName() const
+{
+    const auto sendName = send != nullptr ? send->getName() : juce::String();
+    if (graphNode != nullptr) {
+        return graphNode->getName() + ":SendNode" + (sendName.isNotEmpty() ? ":" + sendName : "");
+    }
+    return "NoName:SendNode";
+}
+
+void SendNode::prepareToPlay(double sampleRate, int)
+{
+    level.reset(sampleRate, kSmoothingSeconds);
+    pan.reset(sampleRate, kSmoothingSeconds);
+    level.setCurrentAndTargetValue(send != nullptr ? send->getLevel() : 0.0f);
+    pan.setCurrentAndTargetValue(send != nullptr ? send->getPan() : 0.0f);
+}
+
+void SendNode::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
+{
+    midi.clear();
+    if (send == nullptr || sendBus == nullptr || sendBus->getNumChannels() == 0) {
+        return;
+    }
+
+    auto targetLevel = send->getLevel();
+    if (send->getType() == SendType::PreFader) {
+        // Post-fader taps are already silenced by the VolumeNode; pre-fader taps follow the track mute here.
+        if (const auto trackPtr = track.lock()) {
+            const auto muteState = trackPtr->getMuteState();
+            if (muteState == TrackMuteState::Mute || muteState == TrackMuteState::SoloMute) {
+                targetLevel = 0.0f;
+            }
+        }
+    }
+    level.setTargetValue(targetLevel);
+    pan.setTargetValue(send->getPan());
+
+    const auto numSamples = buffer.getNumSamples();
+    const auto levelStart = level.getCurrentValue();
+    const auto panStart = pan.getCurrentValue();
+    level.skip(numSamples);
+    pan.skip(numSamples);
+    const auto levelEnd = level.getCurrentValue();
+    const auto panEnd = pan.getCurrentValue();
+    if (levelStart == 0.0f && levelEnd == 0.0f) {
+        return;
+    }
+
+    const auto busChannels = std::min(sendBus->getNumChannels(), MixKernels::maxChannels);
+    for (int c = 0; c < busChannels; ++c) {
+        startGains[static_cast<size_t>(c)] = levelStart * panGain(panStart, c, busChannels);
+        endGains[static_cast<size_t>(c)] = levelEnd * panGain(panEnd, c, busChannels);
+    }
+    sendBus->add(buffer, numSamples, startGains.data(), endGains.data());
+}
+
+float SendNode::panGain(float pan, int channel, int numChannels) noexcept
+{
+    if (numChannels != 2) {
+        return 1.0f;
+    }
+    if (channel == 0) {
+        return pan > 0.0f ? 1.0f - pan : 1.0f;
+    }
+    return pan < 0.0f ? 1.0f + pan : 1.0f;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "AudioNode.h"
+#include "AudioEngine/Mixing/MixKernels.h"
+#include "Core/Track/Track.h"
+
+#include <array>
+
+class GraphNode;
+class Send;
+class SendBus;
+
+/// Runtime tap rendering one send into its aux track bus.
+/// Fed from before the source VolumeNode (pre-fader) or after it (post-fader); it has no audio
+/// output and signals its aux input node through a MIDI edge so the graph renders it first.
+class SendNode : public AudioNode {
+public:
+    /// Create a send tap.
+    /// @param send send model providing level, pan and type
+    /// @param track source track providing runtime mute state
+    /// @param graphNode source graph node (defines the tap format)
+    /// @param sendBus destination aux bus
+    /// @param transport timeline transport
+    SendNode(const Send* send,
+             const std::weak_ptr<Track>& track,
+             const GraphNode* graphNode,
+             SendBus* sendBus,
+             const std::weak_ptr<Transport>& transport);
+
+    /// Display name for debugging/graph views.
+    const juce::String getName() const override;
+
+    /// Reset level and pan smoothing.
+    void prepareToPlay(double sampleRate, int blockSize) override;
+
+    /// Accumulate the tapped signal into the aux bus.
+    void processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi) override;
+
+    /// The ordering edge towards the aux is a MIDI connection.
+    bool producesMidi() const override { return true; }
+
+private:
+    /// Gain applied to a bus channel for a pan position (balance law, unity at centre).
+    static float panGain(float pan, int channel, int numChannels) noexcept;
+
+    const Send* send;
+    std::weak_ptr<Track> track;
+    const GraphNode* graphNode;
+    SendBus* sendBus;
+    juce::SmoothedValue<float> level;
+    juce::SmoothedValue<float> pan;
+    std::array<float, MixKernels::maxChannels> startGains {};
+    std::array<float, MixKernels::maxChannels> endGains {};
+};
@@ -6,13 +6,15 @@
 VolumeNode::VolumeNode(const std::weak_ptr<Transport>& transport,
                        const GraphNode* graphNode,
                        const std::weak_ptr<Track>& track,
-                       const std::map<ParameterKey, std::atomic<float>*>& parameters)
+                       const std::map<ParameterKey, std::atomic<float>*>& parameters,
+                       std::vector<VcaStage> vcaStages)
     : transport(transport),
       graphNode(graphNode),
-      track(track)
+      track(track),
+      vcaStages(std::move(vcaStages))
 {
     bindParameters(parameters);
-    setPlayConfigDetails(2, 2, 48000.0, 512);
+    setFormatDetails(graphNode, transport);
 }
 
 const std::vector<ParameterKey>& VolumeNode::requiredParameters()
@@ -32,12 +34,42 @@ const juce::String VolumeNode::getName() const
     return "NoName:VolumeNode";
 }
 
+void VolumeNode::prepareToPlay(double sampleRate, int)
+{
+    lastGain = resolveGain();
+    if (meterTap != nullptr) {
+        meterTap->prepare(sampleRate);
+    }
+}
+
+float VolumeNode::resolveGain() const
+{
+    const auto* param = getParameter(ParameterKey::Volume);
+    auto gain = param ? param->load() : 1.0f;
+    for (const auto& stage : vcaStages) {
+        if (const auto folderPtr = stage.folder.lock()) {
+            // Solo-mute is already propagated to the children, only an explicit folder mute applies here.
+            if (folderPtr->getMuteState() == TrackMuteState::Mute) {
+                return 0.0f;
+            }
+        }
+        if (stage.gain != nullptr) {
+            gain *= stage.gain->load();
+        }
+    }
+    return gain;
+}
+
 void VolumeNode::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) {
     if (graphNode != nullptr) {
         if (const auto trackPtr = track.lock()) {
             const auto muteState = trackPtr->getMuteState();
             if (muteState == TrackMuteState::Mute || muteState == TrackMuteState::SoloMute) {
                 buffer.clear();
+                lastGain = 0.0f;
+                if (meterTap != nullptr) {
+                    meterTap->process(buffer, buffer.getNumSamples());
+                }
                 return;
             }
         }
@@ -53,11 +85,15 @@ void VolumeNode::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer
     }
     // We got here because at least one sample was not a finite value
     jassert (!nonFiniteValueAlert);
-    const auto* param = getParameter(ParameterKey::Volume);
-    const float gain = param ? param->load() : 1.0f;
+    const float gain = resolveGain();
     const auto* panParam = getParameter(ParameterKey::StereoPan);
     const float pan = panParam ? panParam->load() : 1.0f;
     // juce::Logger::writeToLog(graphNode->getName() + " - " + String(gain));
     // juce::Logger::writeToLog(graphNode->getName() + " - " + String(pan));
-    buffer.applyGain(gain);
+    // Ramp across the block so riding a folder fader does not zipper every child.
+    buffer.applyGainRamp(0, buffer.getNumSamples(), lastGain, gain);
+    lastGain = gain;
+    if (meterTap != nullptr) {
+        meterTap->process(buffer, buffer.getNumSamples());
+    }
 }
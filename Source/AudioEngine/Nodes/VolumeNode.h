@@ -3,6 +3,7 @@
 #include "AudioNode.h"
 #include "Utils/Transport.h"
 #include "Core/Track/Track.h"
+#include "Utils/Metering/MeterTap.h"
 
 #include <vector>
 
@@ -10,17 +11,29 @@ class GraphNode;
 
 
 /// Runtime node applying track-level gain.
+/// Enclosing folders act as VCAs: their gain and mute are folded into this node's gain,
+/// so a folder fader never adds a summing bus to the graph.
 class VolumeNode : public AudioNode {
 public:
+    /// One enclosing folder whose fader scales this node.
+    struct VcaStage {
+        /// Folder volume parameter (nullable).
+        std::atomic<float>* gain = nullptr;
+        /// Folder providing runtime mute state.
+        std::weak_ptr<Track> folder;
+    };
+
     /// Create a node bound to transport and parameters.
     /// @param transport timeline transport
     /// @param graphNode owning graph node
     /// @param track track providing runtime state
     /// @param parameters bound parameter map for this node
+    /// @param vcaStages enclosing folders, innermost first
     VolumeNode(const std::weak_ptr<Transport>& transport,
                const GraphNode* graphNode,
                const std::weak_ptr<Track>& track,
-               const std::map<ParameterKey, std::atomic<float>*>& parameters);
+               const std::map<ParameterKey, std::atomic<float>*>& parameters,
+               std::vector<VcaStage> vcaStages = {});
 
     /// Parameters required by this node (used by graph wiring).
     static const std::vector<ParameterKey>& requiredParameters();
@@ -28,11 +41,24 @@ public:
     /// Display name for debugging/graph views.
     const juce::String getName() const override;
 
+    /// Attach the tap metering this node's output (set before the graph is prepared).
+    /// @param tap meter tap (nullable)
+    void setMeterTap(std::shared_ptr<MeterTap> tap) { meterTap = std::move(tap); }
+
+    /// Start the next block from the resolved gain without a ramp.
+    void prepareToPlay(double sampleRate, int blockSize) override;
+
     /// Apply gain to the buffer.
     void processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer&) override;
 
 private:
+    /// Track gain multiplied by every enclosing folder gain (0 when a folder is muted).
+    float resolveGain() const;
+
     std::weak_ptr<Transport> transport;
     const GraphNode* graphNode;
     std::weak_ptr<Track> track;
+    std::vector<VcaStage> vcaStages;
+    std::shared_ptr<MeterTap> meterTap;
+    float lastGain = 1.0f;
 };
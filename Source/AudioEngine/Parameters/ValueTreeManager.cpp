@@ -1,7 +1,10 @@
 #include "ValueTreeManager.h"
 
 #include "AudioEngine/Graph/Runtime/GraphManager.h"
+#include "Core/Edit/Edit.h"
+#include "Core/Track/FolderTrack.h"
 
+#include <algorithm>
 #include <set>
 
 ValueTreeManager::ParameterHost::ParameterHost()
@@ -14,10 +17,26 @@ void ValueTreeManager::buildForGraph(const GraphManager& graphManager)
 {
     juce::AudioProcessorValueTreeState::ParameterLayout layout;
 
+    std::vector<juce::String> trackIds;
     for (const auto& node : graphManager.graphNodes) {
+        trackIds.push_back(node->getTrackId());
+    }
+    // Nested folders outside the edit track list get no graph node, but their fader still acts
+    // as a VCA on the tracks inside them.
+    if (const auto editPtr = graphManager.edit.lock()) {
+        for (const auto& track : editPtr->getTracks()) {
+            for (auto* folder = track->getParentFolder(); folder != nullptr; folder = folder->getParentFolder()) {
+                if (std::find(trackIds.begin(), trackIds.end(), folder->getId()) == trackIds.end()) {
+                    trackIds.push_back(folder->getId());
+                }
+            }
+        }
+    }
+
+    for (const auto& trackId : trackIds) {
         const auto& defs = allParamDefs();
         for (const auto& def : defs) {
-            const auto paramId = makeParamId(node->getTrackId(), def.name);
+            const auto paramId = makeParamId(trackId, def.name);
             const juce::ParameterID parameterId(paramId, 1);
             juce::NormalisableRange<float> range(def.minValue, def.maxValue);
             auto parameter = std::make_unique<juce::AudioParameterFloat>(
@@ -45,6 +45,7 @@ std::vector<juce::AudioProcessorGraph::Node::Ptr> PluginChainBuilder::createPlug
     const std::vector<std::shared_ptr<Plugin>>& plugins,
     juce::AudioProcessorGraph& graph,
     const String& trackId,
+    ChannelsFormat format,
     double sampleRate,
     int blockSize) const
 {
@@ -63,6 +64,13 @@ std::vector<juce::AudioProcessorGraph::Node::Ptr> PluginChainBuilder::createPlug
             juce::Logger::writeToLog("Plugin load error: " + error);
             continue;
         }
+        juce::AudioProcessor::BusesLayout layout;
+        layout.inputBuses.add(GetAudioChannelSet(format));
+        layout.outputBuses.add(GetAudioChannelSet(format));
+        if (!instance->setBusesLayout(layout)) {
+            juce::Logger::writeToLog("Plugin " + plugin->getName() + " does not support "
+                                     + ChannelsFormatName(format) + ", keeping its default layout");
+        }
         auto node = graph.addNode(std::move(instance));
         if (node != nullptr) {
             nodes.push_back(node);
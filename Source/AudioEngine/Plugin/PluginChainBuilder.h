@@ -21,12 +21,14 @@ public:
     /// @param plugins list of plugins to instantiate
     /// @param graph target audio processor graph
     /// @param trackId track id owning the plugins
+    /// @param format channel format requested from each plugin
     /// @param sampleRate current engine sample rate
     /// @param blockSize current engine block size
     std::vector<juce::AudioProcessorGraph::Node::Ptr> createPluginNodes(
         const std::vector<std::shared_ptr<Plugin>>& plugins,
         juce::AudioProcessorGraph& graph,
         const String& trackId,
+        ChannelsFormat format,
         double sampleRate,
         int blockSize) const;
 
@@ -0,0 +1,124 @@
+#include "InputRouter.h"
+
+#include "Recorder.h"
+#include "Core/Track/Track.h"
+
+#include <thread>
+
+void InputRouter::setRoutes(const std::vector<RouteDescription>& descriptions)
+{
+    auto newRoutes = std::make_unique<RouteList>();
+    for (const auto& description : descriptions) {
+        auto route = std::make_unique<Route>();
+        route->description = description;
+        route->description.numChannels = juce::jlimit(1, MixKernels::maxChannels, description.numChannels);
+        if (const auto* previous = findRoute(description.trackId)) {
+            route->recorder.store(previous->recorder.load());
+            route->lastGain = previous->lastGain;
+        }
+        newRoutes->push_back(std::move(route));
+    }
+    activeRoutes.store(newRoutes.get());
+    waitForAudioThread();
+    routes = std::move(newRoutes);
+}
+
+int InputRouter::getRequiredInputChannels() const noexcept
+{
+    int required = 0;
+    for (const auto& route : *routes) {
+        required = std::max(required, route->description.firstInputChannel + route->description.numChannels);
+    }
+    return required;
+}
+
+int InputRouter::getRouteChannelCount(const juce::String& trackId) const noexcept
+{
+    const auto* route = findRoute(trackId);
+    return route != nullptr ? route->description.numChannels : 0;
+}
+
+void InputRouter::setRecorder(const juce::String& trackId, Recorder* recorder)
+{
+    auto* route = findRoute(trackId);
+    if (route == nullptr) {
+        return;
+    }
+    route->recorder.store(recorder);
+    waitForAudioThread();
+}
+
+void InputRouter::waitForAudioThread() const noexcept
+{
+    while (processing.load()) {
+        std::this_thread::yield();
+    }
+}
+
+void InputRouter::prepare(juce::AudioIODevice* device, int maximumBlockSize)
+{
+    silence.setSize(1, std::max(1, maximumBlockSize));
+    silence.clear();
+    if (device != nullptr) {
+        roundTripLatency.store(device->getInputLatencyInSamples() + device->getOutputLatencyInSamples(),
+                               std::memory_order_relaxed);
+    }
+}
+
+void InputRouter::process(const float* const* inputChannelData,
+                          int numInputChannels,
+                          juce::AudioBuffer<float>& output,
+                          int numSamples,
+                          int64 timelineSample) noexcept
+{
+    processing.store(true);
+    for (const auto& route : *activeRoutes.load()) {
+        const auto& description = route->description;
+        auto* recorder = route->recorder.load();
+        const auto trackPtr = description.track.lock();
+        const auto muteState = trackPtr != nullptr ? trackPtr->getMuteState() : TrackMuteState::Mute;
+        const auto monitoring = trackPtr != nullptr
+            && trackPtr->getInputMonitoringState() == TrackInputMonitoringState::Active
+            && muteState != TrackMuteState::Mute
+            && muteState != TrackMuteState::SoloMute;
+        const auto targetGain = monitoring
+            ? (description.gain != nullptr ? description.gain->load(std::memory_order_relaxed) : 1.0f)
+            : 0.0f;
+        if (recorder == nullptr && targetGain == 0.0f && route->lastGain == 0.0f) {
+            continue;
+        }
+        if (numSamples > silence.getNumSamples()) {
+            // The device delivered more than it announced in audioDeviceAboutToStart.
+            jassertfalse;
+            continue;
+        }
+
+        for (int c = 0; c < description.numChannels; ++c) {
+            const auto inputChannel = description.firstInputChannel + c;
+            const auto* data = inputChannel < numInputChannels ? inputChannelData[inputChannel] : nullptr;
+            channelPointers[static_cast<size_t>(c)] = data != nullptr ? data : silence.getReadPointer(0);
+        }
+
+        if (recorder != nullptr) {
+            recorder->pushSamples(channelPointers.data(), numSamples, timelineSample);
+        }
+        if (output.getNumChannels() > 0 && (targetGain != 0.0f || route->lastGain != 0.0f)) {
+            // Ramping from the last gain also fades monitoring in and out on mute or solo.
+            MixKernels::select(description.numChannels, output.getNumChannels())
+                .addWithRamp(channelPointers.data(), output.getArrayOfWritePointers(), 0, numSamples,
+                             route->lastGain, targetGain);
+        }
+        route->lastGain = targetGain;
+    }
+    processing.store(false);
+}
+
+InputRouter::Route* InputRouter::findRoute(const juce::String& trackId) const noexcept
+{
+    for (const auto& route : *routes) {
+        if (route->description.trackId == trackId) {
+            return route.get();
+        }
+    }
+    return nullptr;
+}
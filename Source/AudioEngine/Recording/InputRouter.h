@@ -0,0 +1,98 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "AudioEngine/Mixing/MixKernels.h"
+
+class Recorder;
+class Track;
+
+/// Device input stage run inside the audio callback, ahead of and independent from the graph.
+/// Each route maps device input channels to a record track: armed takes are captured from the
+/// hardware input, and monitored inputs are added straight to the device output so monitoring
+/// never goes through the graph or its latency-heavy inserts. Monitoring still follows the
+/// track mute, solo and fader, with a gain ramp per block.
+class InputRouter {
+public:
+    /// Mapping of device inputs to a record track.
+    struct RouteDescription {
+        juce::String trackId;
+        std::weak_ptr<Track> track;
+        /// First device input channel.
+        int firstInputChannel = 0;
+        /// Number of consecutive device inputs captured.
+        int numChannels = 1;
+        /// Track fader applied to the monitored signal (nullable, unity when missing).
+        std::atomic<float>* gain = nullptr;
+    };
+
+    /// Replace the routes (message thread). Safe while the device runs: returns once the audio
+    /// thread no longer uses the previous routes, and recorders carry over by track id.
+    /// @param descriptions routes to install
+    void setRoutes(const std::vector<RouteDescription>& descriptions);
+
+    /// Number of device inputs the routes need.
+    [[nodiscard]] int getRequiredInputChannels() const noexcept;
+
+    /// Channels captured for a track (0 when the track has no device input route).
+    /// @param trackId track id to look up
+    [[nodiscard]] int getRouteChannelCount(const juce::String& trackId) const noexcept;
+
+    /// Capture a track's input into a recorder, or stop capturing with nullptr.
+    /// Returns once the audio thread no longer uses the previous recorder.
+    /// @param trackId routed track id
+    /// @param recorder recorder receiving the input (nullable)
+    void setRecorder(const juce::String& trackId, Recorder* recorder);
+
+    /// Allocate scratch buffers and store the device latency.
+    /// @param device device about to start (nullable)
+    /// @param maximumBlockSize largest callback size
+    void prepare(juce::AudioIODevice* device, int maximumBlockSize);
+
+    /// Input plus output latency of the device, in samples.
+    [[nodiscard]] int getRoundTripLatencySamples() const noexcept
+    {
+        return roundTripLatency.load(std::memory_order_relaxed);
+    }
+
+    /// Capture armed inputs and add monitored inputs to the output (audio thread).
+    /// @param inputChannelData device input pointers
+    /// @param numInputChannels device input count
+    /// @param output device output mix
+    /// @param numSamples samples in this callback
+    /// @param timelineSample timeline position of this callback
+    void process(const float* const* inputChannelData,
+                 int numInputChannels,
+                 juce::AudioBuffer<float>& output,
+                 int numSamples,
+                 int64 timelineSample) noexcept;
+
+private:
+    struct Route {
+        RouteDescription description;
+        std::atomic<Recorder*> recorder{ nullptr };
+        /// Monitoring gain reached by the last block (audio thread).
+        float lastGain = 0.0f;
+    };
+
+    using RouteList = std::vector<std::unique_ptr<Route>>;
+
+    Route* findRoute(const juce::String& trackId) const noexcept;
+
+    /// Wait until the audio thread leaves process().
+    void waitForAudioThread() const noexcept;
+
+    /// Routes owned by the message thread.
+    std::unique_ptr<RouteList> routes = std::make_unique<RouteList>();
+    /// Routes read by the audio thread.
+    std::atomic<RouteList*> activeRoutes{ routes.get() };
+    std::atomic<bool> processing{ false };
+    std::atomic<int> roundTripLatency{ 0 };
+    juce::AudioBuffer<float> silence;
+    std::array<const float*, MixKernels::maxChannels> channelPointers{};
+};
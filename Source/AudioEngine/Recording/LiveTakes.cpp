@@ -0,0 +1,37 @@
+#include "LiveTakes.h"
+
+LiveTakes& LiveTakes::get()
+{
+    static LiveTakes instance;
+    return instance;
+}
+
+void LiveTakes::set(const String& trackId, Take take)
+{
+    {
+        const juce::ScopedLock scopedLock(lock);
+        takes[trackId] = std::move(take);
+    }
+    sendChangeMessage();
+}
+
+void LiveTakes::remove(const String& trackId)
+{
+    {
+        const juce::ScopedLock scopedLock(lock);
+        if (takes.erase(trackId) == 0) {
+            return;
+        }
+    }
+    sendChangeMessage();
+}
+
+std::optional<LiveTakes::Take> LiveTakes::find(const String& trackId) const
+{
+    const juce::ScopedLock scopedLock(lock);
+    const auto it = takes.find(trackId);
+    if (it == takes.end()) {
+        return std::nullopt;
+    }
+    return it->second;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+#include "Utils/Waveform/PeakSource.h"
+
+/// Takes being recorded, published so track rows can draw them before their clips exist.
+/// RecordSession updates each take while it grows and removes it once the clip is added;
+/// a change message is sent on every update.
+/// Thread safe.
+class LiveTakes : public juce::ChangeBroadcaster {
+public:
+    /// A take being recorded on one track.
+    struct Take {
+        /// Peaks of the samples written so far.
+        std::shared_ptr<const PeakSource> peaks;
+        /// Session sample where the first recorded sample lands.
+        int64 sessionStart = 0;
+    };
+
+    static LiveTakes& get();
+
+    /// Publish or update the take recording on a track.
+    /// @param trackId stable track identifier
+    /// @param take peaks and position of the take
+    void set(const String& trackId, Take take);
+
+    /// Stop publishing the take of a track.
+    /// @param trackId stable track identifier
+    void remove(const String& trackId);
+
+    /// Take recording on a track, if any.
+    /// @param trackId stable track identifier
+    std::optional<Take> find(const String& trackId) const;
+
+private:
+    mutable juce::CriticalSection lock;
+    /// Keyed by track id.
+    std::unordered_map<String, Take> takes;
+};
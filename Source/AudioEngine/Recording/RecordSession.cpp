@@ -1,16 +1,39 @@
 #include "RecordSession.h"
 
 #include "AudioEngine/Nodes/AudioTrackNode.h"
+#include "AudioEngine/Recording/InputRouter.h"
+#include "AudioEngine/Recording/LiveTakes.h"
 #include "AudioEngine/Recording/Recorder.h"
 #include "Core/AudioClip/AudioClip.h"
 #include "Core/Track/AudioTrack.h"
 #include "Utils/IO/AudioFile.h"
+#include "Utils/Waveform/PeakCacheManager.h"
 
-RecordSession::RecordSession(int maxRecordSeconds)
-    : maxRecordSeconds(maxRecordSeconds)
+RecordSession::RecordSession(Recorder::SampleFormat sampleFormat)
+    : sampleFormat(sampleFormat)
 {
 }
 
+RecordSession::~RecordSession()
+{
+    writerThread.removeTimeSliceClient(this);
+    for (const auto& [trackId, node] : trackNodes) {
+        if (node != nullptr) {
+            node->setActiveRecorder(nullptr);
+        }
+    }
+    if (inputRouter != nullptr) {
+        for (const auto& activeRecorder : activeRecorders) {
+            inputRouter->setRecorder(activeRecorder.trackId, nullptr);
+        }
+    }
+    for (const auto& activeRecorder : activeRecorders) {
+        LiveTakes::get().remove(activeRecorder.trackId);
+    }
+    activeRecorders.clear();
+    writerThread.stopThread(1000);
+}
+
 void RecordSession::registerTrackNode(const String& trackId, AudioTrackNode* node)
 {
     if (node == nullptr) {
@@ -31,15 +54,17 @@ void RecordSession::clearTrackNodes()
 
 void RecordSession::begin(int64 startSample, double newSampleRate, int newBlockSize)
 {
+    writerThread.removeTimeSliceClient(this);
     state.isRecording = true;
     state.startSample = startSample;
     state.endSample = startSample;
+    state.latencySamples = inputRouter != nullptr ? inputRouter->getRoundTripLatencySamples() : 0;
     sampleRate = newSampleRate;
     blockSize = newBlockSize;
     activeRecorders.clear();
     juce::Logger::writeToLog("RecordSession::begin at sample " + juce::String(startSample));
 
-    const int64 maxSamples = static_cast<int64>(maxRecordSeconds * sampleRate);
+    writerThread.startThread();
     for (const auto& [trackId, node] : trackNodes) {
         if (node == nullptr || !node->isTrackArmed()) {
             if (node != nullptr) {
@@ -52,13 +77,29 @@ void RecordSession::begin(int64 startSample, double newSampleRate, int newBlockS
             node->setActiveRecorder(nullptr);
             continue;
         }
-        const int channels = std::max(1, node->getTotalNumOutputChannels());
-        auto recorder = std::make_unique<Recorder>(channels, maxSamples, sampleRate);
+        const auto inputChannels = inputRouter != nullptr ? inputRouter->getRouteChannelCount(trackId) : 0;
+        const auto fromInput = inputChannels > 0;
+        const int channels = fromInput ? inputChannels : std::max(1, node->getTotalNumOutputChannels());
+        const auto file = recordingsDirectory()
+            .getChildFile(trackId + "_" + juce::String(startSample) + ".wav")
+            .getNonexistentSibling(false);
+        auto recorder = std::make_unique<Recorder>(file, channels, sampleRate, sampleFormat, writerThread);
+        if (!recorder->isOpen()) {
+            node->setActiveRecorder(nullptr);
+            continue;
+        }
         auto* recorderPtr = recorder.get();
-        activeRecorders.push_back({ trackId, track, std::move(recorder) });
-        node->setActiveRecorder(recorderPtr);
+        activeRecorders.push_back({ trackId, track, std::move(recorder), fromInput });
+        if (fromInput) {
+            node->setActiveRecorder(nullptr);
+            inputRouter->setRecorder(trackId, recorderPtr);
+        } else {
+            node->setActiveRecorder(recorderPtr);
+        }
         juce::Logger::writeToLog("RecordSession::begin armed track " + trackId);
     }
+    // Added once the recorders are in place, so the writer thread never sees the list change.
+    writerThread.addTimeSliceClient(this);
 }
 
 void RecordSession::end(int64 endSample)
@@ -66,19 +107,48 @@ void RecordSession::end(int64 endSample)
     state.isRecording = false;
     state.endSample = std::max(endSample, state.startSample);
     juce::Logger::writeToLog("RecordSession::end at sample " + juce::String(endSample));
+    // Waits for a running update, so the recorders can be finalized and cleared safely.
+    writerThread.removeTimeSliceClient(this);
 
     for (const auto& [trackId, node] : trackNodes) {
         if (node != nullptr) {
             node->setActiveRecorder(nullptr);
         }
     }
+    if (inputRouter != nullptr) {
+        for (const auto& activeRecorder : activeRecorders) {
+            inputRouter->setRecorder(activeRecorder.trackId, nullptr);
+        }
+    }
 
     for (const auto& activeRecorder : activeRecorders) {
         finalizeRecorder(activeRecorder);
+        // Removed after the clip is added, so the row never shows the take missing.
+        LiveTakes::get().remove(activeRecorder.trackId);
     }
     activeRecorders.clear();
 }
 
+int64 RecordSession::getTakeSessionStart(const ActiveRecorder& activeRecorder) const
+{
+    if (!activeRecorder.fromInput) {
+        return state.startSample;
+    }
+    // Input takes start at the first captured block, shifted back by the device round trip so the
+    // take lines up with the playback the performer heard.
+    const auto capturedStart = activeRecorder.recorder->getTimelineStartSample();
+    return (capturedStart >= 0 ? capturedStart : state.startSample) - state.latencySamples;
+}
+
+int RecordSession::useTimeSlice()
+{
+    for (const auto& activeRecorder : activeRecorders) {
+        LiveTakes::get().set(activeRecorder.trackId,
+                             { activeRecorder.recorder->getLivePeaks(), getTakeSessionStart(activeRecorder) });
+    }
+    return kLiveTakeIntervalMs;
+}
+
 juce::File RecordSession::recordingsDirectory() const
 {
     auto dir = juce::File("/Users/nico/Music").getChildFile("recordings");
@@ -96,6 +166,11 @@ void RecordSession::finalizeRecorder(const ActiveRecorder& activeRecorder)
     if (!track || !activeRecorder.recorder) {
         return;
     }
+    activeRecorder.recorder->close();
+    if (const auto dropped = activeRecorder.recorder->getNumSamplesDropped(); dropped > 0) {
+        juce::Logger::writeToLog("RecordSession::finalizeRecorder disk writer fell behind, dropped "
+                                 + juce::String(dropped) + " samples for " + activeRecorder.trackId);
+    }
     auto recordedSamples = activeRecorder.recorder->getNumSamplesRecorded();
     const auto requestedSamples = state.endSample - state.startSample;
     if (requestedSamples > 0) {
@@ -103,19 +178,40 @@ void RecordSession::finalizeRecorder(const ActiveRecorder& activeRecorder)
     }
     if (recordedSamples <= 0) {
         juce::Logger::writeToLog("RecordSession::finalizeRecorder no samples for " + activeRecorder.trackId);
+        activeRecorder.recorder->getFile().deleteFile();
         return;
     }
 
-    auto fileName = activeRecorder.trackId + "_" + juce::String(state.startSample) + ".wav";
-    auto file = recordingsDirectory().getChildFile(fileName);
-    activeRecorder.recorder->writeToFile(file);
+    const auto& file = activeRecorder.recorder->getFile();
     juce::Logger::writeToLog("RecordSession::finalizeRecorder wrote " + file.getFullPathName());
 
+    // Peaks were built while the take streamed to disk; writing them now lets AudioFile::get find a
+    // fresh peak file instead of reading the whole take back.
+    auto& peakCache = PeakCacheManager::get();
+    if (activeRecorder.recorder->getPeaks().writePeakFile(peakCache.getPeakFilePath(file), peakCache.getBuildOptions())) {
+        peakCache.addPeakFile(file);
+    } else {
+        juce::Logger::writeToLog("RecordSession::finalizeRecorder could not write peaks for " + file.getFullPathName());
+    }
+
+    auto sessionStart = getTakeSessionStart(activeRecorder);
+    int64 fileStart = 0;
+    if (activeRecorder.fromInput) {
+        if (sessionStart < 0) {
+            fileStart = -sessionStart;
+            sessionStart = 0;
+        }
+        recordedSamples = activeRecorder.recorder->getNumSamplesRecorded() - fileStart;
+        if (recordedSamples <= 0) {
+            return;
+        }
+    }
+
     auto audioFile = AudioFile::get(file);
     auto clip = AudioClip::create(audioFile,
-                                  0,
-                                  state.startSample,
-                                  state.startSample + recordedSamples);
+                                  fileStart,
+                                  sessionStart,
+                                  sessionStart + recordedSamples);
     track->addAudioClip(std::move(clip));
     juce::Logger::writeToLog("RecordSession::finalizeRecorder clip added to " + activeRecorder.trackId);
 }
@@ -8,12 +8,18 @@
 
 class AudioTrack;
 class AudioTrackNode;
+class InputRouter;
 #include "Recorder.h"
 
 /// Orchestrates a single recording pass across multiple track nodes.
-class RecordSession {
+/// Every armed track streams to its own file through a shared disk writer thread, which also
+/// publishes the growing takes to LiveTakes so they are drawn while recording.
+class RecordSession : private juce::TimeSliceClient {
 public:
-    explicit RecordSession(int maxRecordSeconds = 300);
+    /// Create a session writing takes in the given sample format.
+    /// @param sampleFormat on-disk sample format for new takes
+    explicit RecordSession(Recorder::SampleFormat sampleFormat = Recorder::SampleFormat::Int24);
+    ~RecordSession() override;
 
     /// Attach a track node to receive recorder assignment during a take.
     /// @param trackId stable track identifier
@@ -27,6 +33,10 @@ public:
     /// Detach all track nodes from the recording session.
     void clearTrackNodes();
 
+    /// Capture routed tracks from device inputs instead of their node output.
+    /// @param router device input stage (nullable)
+    void setInputRouter(InputRouter* router) { inputRouter = router; }
+
     /// Start a record pass at the given timeline sample.
     /// @param startSample absolute timeline sample where recording starts
     /// @param sampleRate current engine sample rate
@@ -41,26 +51,41 @@ public:
     const RecordState& getState() const { return state; }
 
 private:
+    /// Milliseconds between two live take updates.
+    static constexpr int kLiveTakeIntervalMs = 50;
+
     /// Active recorder tied to a track while recording.
     struct ActiveRecorder {
         String trackId;
         std::weak_ptr<AudioTrack> track;
         std::unique_ptr<Recorder> recorder;
+        /// True when capturing a device input (placed with latency compensation).
+        bool fromInput = false;
     };
 
     /// Registered audio track nodes by track id.
     std::unordered_map<String, AudioTrackNode*> trackNodes;
+    InputRouter* inputRouter = nullptr;
     /// Recorders currently capturing data.
     std::vector<ActiveRecorder> activeRecorders;
     RecordState state;
-    int maxRecordSeconds = 300;
+    Recorder::SampleFormat sampleFormat = Recorder::SampleFormat::Int24;
+    /// Background thread draining every recorder FIFO to disk.
+    juce::TimeSliceThread writerThread { "Record writer" };
     double sampleRate = 0.0;
     int blockSize = 0;
 
     /// Resolve the target folder for recording files.
     juce::File recordingsDirectory() const;
 
-    /// Finish and write a recorder to disk.
+    /// Session sample where a take's first recorded sample lands (may be negative).
+    /// @param activeRecorder recorder of the take
+    int64 getTakeSessionStart(const ActiveRecorder& activeRecorder) const;
+
+    /// Publish every active take to LiveTakes (writer thread while recording).
+    int useTimeSlice() override;
+
+    /// Close a recorder file and add the recorded clip to its track.
     /// @param activeRecorder recorder instance to finalize
     void finalizeRecorder(const ActiveRecorder& activeRecorder);
 };
@@ -10,4 +10,6 @@ struct RecordState {
     int64 startSample = 0;
     /// Absolute timeline sample where recording ended.
     int64 endSample = 0;
+    /// Device round-trip latency compensated when placing input takes.
+    int64 latencySamples = 0;
 };
@@ -1,41 +1,78 @@
 #include "Recorder.h"
 
-Recorder::Recorder(int numChannels, int64 maxSamples, double sampleRate)
-    : recordingBuffer(numChannels, static_cast<int>(maxSamples)),
-      writePosition(0),
+Recorder::Recorder(const juce::File& file,
+                   int numChannels,
+                   double sampleRate,
+                   SampleFormat sampleFormat,
+                   juce::TimeSliceThread& writerThread)
+    : file(file),
+      numChannels(numChannels),
       sampleRate(sampleRate)
 {
-    recordingBuffer.clear();
+    if (!file.deleteFile()) {
+        juce::Logger::writeToLog("Recorder: cannot replace " + file.getFullPathName());
+        return;
+    }
+    auto stream = std::unique_ptr<juce::FileOutputStream>(file.createOutputStream());
+    if (stream == nullptr || stream->failedToOpen()) {
+        juce::Logger::writeToLog("Recorder: cannot open " + file.getFullPathName());
+        return;
+    }
+
+    juce::WavAudioFormat format;
+    const auto bitsPerSample = sampleFormat == SampleFormat::Float32 ? 32 : 24;
+    auto* writer = format.createWriterFor(stream.get(), sampleRate,
+                                          static_cast<unsigned int>(numChannels),
+                                          bitsPerSample, {}, 0);
+    if (writer == nullptr) {
+        juce::Logger::writeToLog("Recorder: no WAV writer for " + file.getFullPathName());
+        return;
+    }
+    stream.release();
+
+    threadedWriter = std::make_unique<juce::AudioFormatWriter::ThreadedWriter>(
+        writer, writerThread, juce::roundToInt(sampleRate * fifoSeconds));
+    threadedWriter->setFlushInterval(juce::roundToInt(sampleRate * flushIntervalSeconds));
+    threadedWriter->setDataReceiver(peaks.get());
+}
+
+Recorder::~Recorder()
+{
+    close();
 }
 
 void Recorder::pushBuffer(const juce::AudioBuffer<float>& buffer, int numSamples)
 {
-    const int available = recordingBuffer.getNumSamples() - static_cast<int>(writePosition);
-    if (available <= 0) {
+    if (threadedWriter == nullptr || numSamples <= 0) {
         return;
     }
-    const int samplesToCopy = std::min(available, numSamples);
-    const int channels = std::min(recordingBuffer.getNumChannels(), buffer.getNumChannels());
-    for (int channel = 0; channel < channels; ++channel) {
-        recordingBuffer.copyFrom(channel, static_cast<int>(writePosition), buffer, channel, 0, samplesToCopy);
+    if (buffer.getNumChannels() < numChannels) {
+        // The FIFO copies numChannels pointers; a narrower buffer cannot be written safely.
+        jassertfalse;
+        samplesDropped.fetch_add(numSamples, std::memory_order_relaxed);
+        return;
     }
-    writePosition += samplesToCopy;
+    pushSamples(buffer.getArrayOfReadPointers(), numSamples);
 }
 
-void Recorder::writeToFile(const juce::File& file) const
+void Recorder::pushSamples(const float* const* channels, int numSamples, int64 timelineSample)
 {
-    if (writePosition <= 0) {
+    if (threadedWriter == nullptr || numSamples <= 0) {
         return;
     }
-    if (auto stream = std::unique_ptr<juce::FileOutputStream>(file.createOutputStream())) {
-        juce::WavAudioFormat format;
-        auto writer = std::unique_ptr<juce::AudioFormatWriter>(
-            format.createWriterFor(stream.get(), sampleRate,
-                                   static_cast<unsigned int>(recordingBuffer.getNumChannels()),
-                                   16, {}, 0));
-        if (writer != nullptr) {
-            stream.release();
-            writer->writeFromAudioSampleBuffer(recordingBuffer, 0, static_cast<int>(writePosition));
-        }
+    if (timelineSample >= 0 && timelineStartSample.load(std::memory_order_relaxed) < 0) {
+        timelineStartSample.store(timelineSample, std::memory_order_release);
     }
+    if (threadedWriter->write(channels, numSamples)) {
+        samplesRecorded.fetch_add(numSamples, std::memory_order_relaxed);
+    } else {
+        samplesDropped.fetch_add(numSamples, std::memory_order_relaxed);
+    }
+}
+
+void Recorder::close()
+{
+    // The threaded writer drains its FIFO, feeding the last blocks to the peaks, and rewrites the
+    // header when destroyed.
+    threadedWriter.reset();
 }
@@ -2,31 +2,95 @@
 
 #include <JuceHeader.h>
 
-/// In-memory audio recorder used during a record pass.
+#include <atomic>
+#include <memory>
+
+#include "Utils/Waveform/IncrementalPeakBuilder.h"
+
+/// Streaming audio recorder used during a record pass.
+/// The audio thread pushes into a lock-free FIFO that a shared writer thread drains to disk,
+/// so memory stays constant whatever the take length. The WAV header is rewritten periodically
+/// so an interrupted take remains readable up to the last flush. Peaks are built from the same
+/// stream as it is written, so the take never needs to be read back to be drawn.
 class Recorder {
 public:
-    Recorder(int numChannels, int64 maxSamples, double sampleRate);
+    /// On-disk sample format.
+    enum class SampleFormat {
+        Int24,
+        Float32
+    };
+
+    /// Seconds of audio the FIFO can hold before the writer thread must catch up.
+    static constexpr double fifoSeconds = 2.0;
+    /// Seconds of audio between two header updates.
+    static constexpr double flushIntervalSeconds = 1.0;
+
+    /// Open the destination file and attach the recorder to the writer thread.
+    /// @param file destination WAV file (replaced if it exists)
+    /// @param numChannels channels to record
+    /// @param sampleRate recording sample rate
+    /// @param sampleFormat on-disk sample format
+    /// @param writerThread background thread draining the FIFO
+    Recorder(const juce::File& file,
+             int numChannels,
+             double sampleRate,
+             SampleFormat sampleFormat,
+             juce::TimeSliceThread& writerThread);
+
+    /// Drain the FIFO and finalise the file (see close()).
+    ~Recorder();
+
+    /// True when the destination file could be opened.
+    bool isOpen() const { return threadedWriter != nullptr; }
 
-    /// Append samples from an incoming buffer.
+    /// Append samples from an incoming buffer (audio thread, never blocks or allocates).
+    /// Samples that do not fit in the FIFO are dropped and counted.
     /// @param buffer source audio buffer
     /// @param numSamples number of samples to copy from buffer
     void pushBuffer(const juce::AudioBuffer<float>& buffer, int numSamples);
 
-    /// Total number of samples captured so far.
-    int64 getNumSamplesRecorded() const { return writePosition; }
+    /// Append samples from raw channel pointers (audio thread, never blocks or allocates).
+    /// @param channels one pointer per recorded channel
+    /// @param numSamples number of samples to copy
+    /// @param timelineSample timeline position of the first sample (stored for the first block only)
+    void pushSamples(const float* const* channels, int numSamples, int64 timelineSample = -1);
 
-    /// Channel count of the internal recording buffer.
-    int getNumChannels() const { return recordingBuffer.getNumChannels(); }
+    /// Timeline position of the first captured sample (-1 when unknown).
+    int64 getTimelineStartSample() const { return timelineStartSample.load(std::memory_order_acquire); }
 
-    /// Sample rate used by the recording buffer.
+    /// Drain the pending samples and write the final header (blocks until done).
+    /// Only call once the recorder is detached from the audio thread.
+    void close();
+
+    /// Total number of samples accepted so far.
+    int64 getNumSamplesRecorded() const { return samplesRecorded.load(std::memory_order_relaxed); }
+
+    /// Number of samples lost because the writer thread fell behind.
+    int64 getNumSamplesDropped() const { return samplesDropped.load(std::memory_order_relaxed); }
+
+    /// Channel count of the recording.
+    int getNumChannels() const { return numChannels; }
+
+    /// Sample rate of the recording.
     double getSampleRate() const { return sampleRate; }
 
-    /// Flush the recorded data to an audio file.
-    /// @param file destination file
-    void writeToFile(const juce::File& file) const;
+    /// Destination file.
+    const juce::File& getFile() const { return file; }
+
+    /// Peaks of the samples written so far (readable from any thread while recording).
+    IncrementalPeakBuilder& getPeaks() { return *peaks; }
+
+    /// Shared handle on the peaks, so a take being drawn keeps them alive past the recorder.
+    std::shared_ptr<const PeakSource> getLivePeaks() const { return peaks; }
 
 private:
-    juce::AudioBuffer<float> recordingBuffer;
-    int64 writePosition = 0;
+    juce::File file;
+    int numChannels = 0;
     double sampleRate = 0.0;
+    /// Declared before the writer, which feeds it until destroyed.
+    std::shared_ptr<IncrementalPeakBuilder> peaks = std::make_shared<IncrementalPeakBuilder>();
+    std::unique_ptr<juce::AudioFormatWriter::ThreadedWriter> threadedWriter;
+    std::atomic<int64> samplesRecorded{ 0 };
+    std::atomic<int64> samplesDropped{ 0 };
+    std::atomic<int64> timelineStartSample{ -1 };
 };
@@ -12,7 +12,7 @@
 
 namespace {
 constexpr float kZoomStep = 0.1f;
-constexpr float kScrollWheelStep = 1.0f;
+constexpr double kScrollWheelStep = 1.0;
 
 int64 getTimelineEndSample(const Edit& edit) {
     int64 timelineEndSample = 0;
@@ -101,6 +101,7 @@ EditCommands::EditCommands(Edit& edit,
                            std::function<void()> saveEdit)
     : edit(edit),
       selectionManager(selectionManager),
+      viewNavigator(edit),
       toggleDebugWatchWindowCallback(std::move(toggleDebugWatchWindow)),
       saveEditCallback(std::move(saveEdit)) {
 }
@@ -323,7 +324,7 @@ bool EditCommands::handlesCommand(juce::CommandID commandID) const {
 }
 
 void EditCommands::zoom(float ratio) {
-    edit.zoom(ratio);
+    viewNavigator.zoom(ratio, edit.getState().getCursorSample());
 }
 
 bool EditCommands::handleWheelCommand(juce::CommandID commandID, float delta) {
@@ -335,25 +336,7 @@ bool EditCommands::handleWheelCommand(juce::CommandID commandID, float delta) {
 }
 
 void EditCommands::scrollView(float delta) {
-    const auto viewStart = edit.getViewStartSample();
-    const auto viewEnd = edit.getViewEndSample();
-    const auto viewLength = viewEnd - viewStart;
-    if (viewLength <= 0) {
-        // View length must be positive to scroll.
-        jassert(false);
-        return;
-    }
-
-    const auto offset = static_cast<int64>(std::llround(static_cast<double>(viewLength)
-                                                        * kScrollWheelStep
-                                                        * static_cast<double>(delta)));
-    auto newStart = viewStart + offset;
-    auto newEnd = viewEnd + offset;
-    if (newStart < 0) {
-        newStart = 0;
-        newEnd = viewLength;
-    }
-    edit.getState().setViewRange(newStart, newEnd, nullptr);
+    viewNavigator.scroll(kScrollWheelStep * static_cast<double>(delta));
 }
 
 void EditCommands::splitClipsAtCursorOrSelection() {
@@ -5,6 +5,7 @@
 #include <functional>
 
 #include "Core/Edit/Edit.h"
+#include "Gui/Utils/ViewNavigator.h"
 
 class SelectionManager;
 
@@ -50,6 +51,8 @@ private:
 
     Edit& edit;
     SelectionManager& selectionManager;
+    /// Wheel and keyboard zoom/scroll go through here so bursts reach the view once per frame.
+    ViewNavigator viewNavigator;
 
     /// TODO: remove debug watch window toggle once commands are split.
     std::function<void()> toggleDebugWatchWindowCallback;
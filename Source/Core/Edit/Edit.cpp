@@ -7,6 +7,7 @@
 
 Edit::Edit()
     : transport(std::make_shared<Transport>()),
+      meters(std::make_shared<MeterRegistry>()),
       projectName(""),
       automationManager(),
       videoStartFrame(0),
@@ -2,6 +2,7 @@
 
 #include <JuceHeader.h>
 #include <Utils/Transport.h>
+#include <Utils/Metering/MeterRegistry.h>
 #include "Scene.h"
 #include <Core/Automation/AutomationManager.h>
 #include <Core/Video/Video.h>
@@ -168,9 +169,16 @@ public:
         return transport;
     }
 
+    /// Access the shared meter taps.
+    std::shared_ptr<MeterRegistry> getMeters() const {
+        return meters;
+    }
+
 private:
     /// Shared transport for timeline state.
     std::shared_ptr<Transport> transport;
+    /// Shared meter taps written by the graph and read by the UI.
+    std::shared_ptr<MeterRegistry> meters;
     std::vector<std::shared_ptr<Scene>> scenes;
     String projectName;
     AutomationManager automationManager;
@@ -23,6 +23,13 @@ EditAction EditAction::makeFrameRate(float frameRate) {
     return action;
 }
 
+EditAction EditAction::makeViewPosition(EditState::ViewPosition position) {
+    EditAction action;
+    action.type = EditActionType::SetViewPosition;
+    action.viewPosition = position;
+    return action;
+}
+
 juce::String getEditActionName(EditActionType type) {
     switch (type) {
         case EditActionType::SetViewRange:
@@ -31,17 +38,28 @@ juce::String getEditActionName(EditActionType type) {
             return "Edit: Zoom";
         case EditActionType::SetFrameRate:
             return "Edit: Set Frame Rate";
+        case EditActionType::SetViewPosition:
+            return "Edit: Set View Position";
         default:
             return "Edit: Action";
     }
 }
 
+bool isViewAction(EditActionType type) {
+    return type == EditActionType::SetViewRange
+        || type == EditActionType::Zoom
+        || type == EditActionType::SetViewPosition;
+}
+
 EditActionStore::EditActionStore(EditState& state, juce::UndoManager& undoManager)
     : state(state), undoManager(undoManager) {
 }
 
 void EditActionStore::dispatch(const EditAction& action) {
-    undoManager.beginNewTransaction(getEditActionName(action.type));
+    // View changes are not undoable; starting a transaction for them would split real edits.
+    if (!isViewAction(action.type)) {
+        undoManager.beginNewTransaction(getEditActionName(action.type));
+    }
     applyAction(action);
     listeners.call([&action](EditActionListener& listener) { listener.editActionDispatched(action); });
 }
@@ -65,6 +83,9 @@ void EditActionStore::applyAction(const EditAction& action) {
         case EditActionType::SetFrameRate:
             state.setFrameRate(action.frameRate, &undoManager);
             break;
+        case EditActionType::SetViewPosition:
+            state.setViewPosition(action.viewPosition, nullptr);
+            break;
         default:
             break;
     }
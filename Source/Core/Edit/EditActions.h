@@ -7,7 +7,8 @@
 enum class EditActionType {
     SetViewRange,
     Zoom,
-    SetFrameRate
+    SetFrameRate,
+    SetViewPosition
 };
 
 /// Action payload for edit state updates.
@@ -18,6 +19,7 @@ struct EditAction {
     float zoomRatio = 0.0f;
     int64 zoomCenterSample = 0;
     float frameRate = 0.0f;
+    EditState::ViewPosition viewPosition;
 
     /// Create a view range update action.
     static EditAction makeViewRange(int64 start, int64 end);
@@ -31,11 +33,18 @@ struct EditAction {
 
     /// Create a frame rate update action.
     static EditAction makeFrameRate(float frameRate);
+
+    /// Create a view start and scale update action.
+    /// @param position view position to apply
+    static EditAction makeViewPosition(EditState::ViewPosition position);
 };
 
 /// Transaction label for an edit action.
 juce::String getEditActionName(EditActionType type);
 
+/// True for actions that only move the view; they never open an undo transaction.
+bool isViewAction(EditActionType type);
+
 /// Listener notified when an edit action is dispatched.
 class EditActionListener {
 public:
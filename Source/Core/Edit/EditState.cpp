@@ -16,13 +16,16 @@ const juce::Identifier kTrackSoloStateId("trackSoloState");
 const juce::Identifier kTrackSoloSafeStateId("trackSoloSafeState");
 const juce::Identifier kTrackMuteStateId("trackMuteState");
 const juce::Identifier kTrackUserMuteStateId("trackUserMuteState");
+const juce::Identifier kTrackInputChannelId("trackInputChannel");
 const juce::Identifier kViewStartSampleFId("viewStartSampleF");
 const juce::Identifier kSamplesPerPixelId("samplesPerPixel");
 const juce::Identifier kViewWidthPixelsId("viewWidthPixels");
+const juce::Identifier kViewInteractiveId("viewInteractive");
 constexpr double kMinSamplesPerPixel = 1.0 / 16.0;
 constexpr double kMaxSamplesPerPixel = 262144.0;
 const juce::Identifier kFrameRateId("frameRate");
 const juce::Identifier kTimelineHeightId("timelineHeight");
+const juce::Identifier kFilmstripHeightId("filmstripHeight");
 const juce::Identifier kHeaderHeightId("headerHeight");
 const juce::Identifier kInsertionFollowsPlaybackId("insertionFollowsPlayback");
 const juce::Identifier kIsLoopingId("isLooping");
@@ -86,6 +89,7 @@ EditState::EditState() {
     viewState.setProperty(kViewWidthPixelsId, static_cast<float>(kDefaultViewWidthPixels), nullptr);
     globals.setProperty(kFrameRateId, 24.0f, nullptr);
     globals.setProperty(kTimelineHeightId, 20, nullptr);
+    globals.setProperty(kFilmstripHeightId, 48, nullptr);
     globals.setProperty(kHeaderHeightId, 90, nullptr);
     globals.setProperty(kWaveformScaleId, 1.0f, nullptr);
     globals.setProperty(kInsertionFollowsPlaybackId, true, nullptr);
@@ -140,6 +144,14 @@ int EditState::getTimelineHeight() const {
     return static_cast<int>(getInt64Property(globals, kTimelineHeightId, 20));
 }
 
+int EditState::getFilmstripHeight() const {
+    return static_cast<int>(getInt64Property(globals, kFilmstripHeightId, 48));
+}
+
+int EditState::getTrackRowsTop() const {
+    return getTimelineHeight() + getFilmstripHeight();
+}
+
 int EditState::getHeaderHeight() const {
     return static_cast<int>(getInt64Property(globals, kHeaderHeightId, 90));
 }
@@ -219,16 +231,27 @@ void EditState::setViewRange(int64 startSample, int64 endSample, juce::UndoManag
     setSamplesPerPixel(lengthSamples / width, undo);
 }
 
-void EditState::zoom(float ratio, int64 centerSample, juce::UndoManager* undo) {
-    const auto width = static_cast<double>(getViewWidthPixels());
-    const auto currentSamplesPerPixel = getSamplesPerPixel();
-    if (width <= 0.0 || currentSamplesPerPixel <= 0.0) {
+EditState::ViewPosition EditState::getViewPosition() const {
+    return { getViewStartSampleF(), getSamplesPerPixel() };
+}
+
+void EditState::setViewPosition(ViewPosition position, juce::UndoManager* undo) {
+    setViewStartSampleF(position.startSampleF, undo);
+    setSamplesPerPixel(position.samplesPerPixel, undo);
+}
+
+EditState::ViewPosition EditState::computeZoom(ViewPosition position,
+                                               double widthPixels,
+                                               float ratio,
+                                               int64 centerSample) {
+    const auto currentSamplesPerPixel = position.samplesPerPixel;
+    if (widthPixels <= 0.0 || currentSamplesPerPixel <= 0.0) {
         // View width and scale must be positive to compute zoom.
         jassert(false);
-        return;
+        return position;
     }
     if (ratio == 0.0f) {
-        return;
+        return position;
     }
 
     const auto zoomOut = ratio > 0.0f;
@@ -237,17 +260,17 @@ void EditState::zoom(float ratio, int64 centerSample, juce::UndoManager* undo) {
         : (currentSamplesPerPixel * 0.5);
     nextSamplesPerPixel = std::clamp(nextSamplesPerPixel, kMinSamplesPerPixel, kMaxSamplesPerPixel);
     if (nextSamplesPerPixel == currentSamplesPerPixel) {
-        return;
+        return position;
     }
     if (nextSamplesPerPixel <= 0.0) {
         // Samples-per-pixel must stay positive.
         jassert(false);
-        return;
+        return position;
     }
 
-    const auto viewStartSampleF = getViewStartSampleF();
-    const auto viewLength = currentSamplesPerPixel * width;
-    const auto nextLength = nextSamplesPerPixel * width;
+    const auto viewStartSampleF = position.startSampleF;
+    const auto viewLength = currentSamplesPerPixel * widthPixels;
+    const auto nextLength = nextSamplesPerPixel * widthPixels;
     auto newStart = viewStartSampleF;
     const auto viewEndSampleF = viewStartSampleF + viewLength;
     const auto centerSampleF = static_cast<double>(centerSample);
@@ -262,9 +285,24 @@ void EditState::zoom(float ratio, int64 centerSample, juce::UndoManager* undo) {
     if (newStart < 0.0) {
         newStart = 0.0;
     }
+    return { newStart, nextSamplesPerPixel };
+}
+
+bool EditState::isViewInteractive() const {
+    return static_cast<bool>(viewState.getProperty(kViewInteractiveId, false));
+}
+
+void EditState::setViewInteractive(bool interactive) {
+    viewState.setProperty(kViewInteractiveId, interactive, nullptr);
+}
 
-    setViewStartSampleF(newStart, undo);
-    setSamplesPerPixel(nextSamplesPerPixel, undo);
+void EditState::zoom(float ratio, int64 centerSample, juce::UndoManager* undo) {
+    const auto current = getViewPosition();
+    const auto next = computeZoom(current, static_cast<double>(getViewWidthPixels()), ratio, centerSample);
+    if (next.startSampleF == current.startSampleF && next.samplesPerPixel == current.samplesPerPixel) {
+        return;
+    }
+    setViewPosition(next, undo);
 }
 
 int64 EditState::mapPixelToSample(float pixelX) const {
@@ -288,6 +326,10 @@ void EditState::setTimelineHeight(int height, juce::UndoManager* undo) {
     globals.setProperty(kTimelineHeightId, height, undo);
 }
 
+void EditState::setFilmstripHeight(int height, juce::UndoManager* undo) {
+    globals.setProperty(kFilmstripHeightId, height, undo);
+}
+
 void EditState::setHeaderHeight(int height, juce::UndoManager* undo) {
     globals.setProperty(kHeaderHeightId, height, undo);
 }
@@ -384,6 +426,24 @@ TrackMuteState EditState::getTrackUserMuteState(const String& trackId) const {
     return static_cast<TrackMuteState>(raw);
 }
 
+int EditState::getTrackInputChannel(const String& trackId) const {
+    const auto trackNode = getTrackState(trackId);
+    if (!trackNode.isValid()) {
+        return 0;
+    }
+    return static_cast<int>(trackNode.getProperty(kTrackInputChannelId, 0));
+}
+
+bool EditState::isInputRoutingProperty(const juce::Identifier& property) {
+    return property == kTrackArmStateId
+        || property == kTrackInputMonitoringStateId
+        || property == kTrackInputChannelId;
+}
+
+bool EditState::isTrackStateContainer(const juce::ValueTree& tree) {
+    return tree.hasType(kTracksType);
+}
+
 void EditState::setTrackArmState(const String& trackId, TrackArmState state, juce::UndoManager* undo) {
     auto trackNode = getOrCreateTrackState(trackId);
     trackNode.setProperty(kTrackArmStateId, static_cast<int>(state), undo);
@@ -414,6 +474,11 @@ void EditState::setTrackUserMuteState(const String& trackId, TrackMuteState stat
     trackNode.setProperty(kTrackUserMuteStateId, static_cast<int>(state), undo);
 }
 
+void EditState::setTrackInputChannel(const String& trackId, int inputChannel, juce::UndoManager* undo) {
+    auto trackNode = getOrCreateTrackState(trackId);
+    trackNode.setProperty(kTrackInputChannelId, inputChannel, undo);
+}
+
 juce::ValueTree EditState::getTrackState(const String& trackId) const {
     return trackState.getChildWithProperty(kTrackIdPropertyId, trackId);
 }
@@ -15,6 +15,12 @@ public:
         Xor = 1
     };
 
+    /// View start and scale, the two properties that place the timeline view.
+    struct ViewPosition {
+        double startSampleF = 0.0;
+        double samplesPerPixel = 1.0;
+    };
+
     /// Create a state tree with default values.
     EditState();
 
@@ -66,6 +72,28 @@ public:
     /// @param undo optional undo manager for transactions
     void setViewRange(int64 startSample, int64 endSample, juce::UndoManager* undo = nullptr);
 
+    /// Current view start and scale.
+    ViewPosition getViewPosition() const;
+
+    /// Set the view start and scale together (UI-only).
+    /// @param position new view position
+    /// @param undo optional undo manager for transactions
+    void setViewPosition(ViewPosition position, juce::UndoManager* undo = nullptr);
+
+    /// View reached by one zoom step from a position, without touching any state.
+    /// @param position view to zoom from
+    /// @param widthPixels view width in pixels
+    /// @param ratio zoom ratio sign (positive to zoom out, negative to zoom in)
+    /// @param centerSample sample around which to anchor the view
+    static ViewPosition computeZoom(ViewPosition position, double widthPixels, float ratio, int64 centerSample);
+
+    /// True while the view is being zoomed interactively (UI-only).
+    bool isViewInteractive() const;
+
+    /// Flag an interactive zoom gesture, so views can draw approximations until it settles.
+    /// @param interactive true while the gesture is running
+    void setViewInteractive(bool interactive);
+
     /// Apply a zoom step to the current view.
     /// @param ratio zoom ratio sign (positive to zoom out, negative to zoom in)
     /// @param centerSample sample around which to anchor the view
@@ -85,6 +113,17 @@ public:
     /// @param undo optional undo manager for transactions
     void setTimelineHeight(int height, juce::UndoManager* undo = nullptr);
 
+    /// Video filmstrip lane height in pixels, below the ruler (0 hides the lane).
+    int getFilmstripHeight() const;
+
+    /// Set the video filmstrip lane height in pixels.
+    /// @param height new lane height in pixels
+    /// @param undo optional undo manager for transactions
+    void setFilmstripHeight(int height, juce::UndoManager* undo = nullptr);
+
+    /// Top of the first track row: ruler plus filmstrip lane.
+    int getTrackRowsTop() const;
+
     /// Header height in pixels.
     int getHeaderHeight() const;
 
@@ -178,6 +217,18 @@ public:
     /// Track user mute state.
     TrackMuteState getTrackUserMuteState(const String& trackId) const;
 
+    /// First device input channel of a record track.
+    int getTrackInputChannel(const String& trackId) const;
+
+    /// True for the track properties that decide device input routing
+    /// (arm, input monitoring and input channel).
+    /// @param property changed property
+    static bool isInputRoutingProperty(const juce::Identifier& property);
+
+    /// True for the node holding one state child per track, whose children come and go with tracks.
+    /// @param tree node to test
+    static bool isTrackStateContainer(const juce::ValueTree& tree);
+
     /// Set the arm state for a track.
     /// @param trackId identifier of the track
     /// @param state new arm state
@@ -214,6 +265,12 @@ public:
     /// @param undo optional undo manager for transactions
     void setTrackUserMuteState(const String& trackId, TrackMuteState state, juce::UndoManager* undo = nullptr);
 
+    /// Set the first device input channel of a record track.
+    /// @param trackId identifier of the track
+    /// @param inputChannel zero-based device input channel
+    /// @param undo optional undo manager for transactions
+    void setTrackInputChannel(const String& trackId, int inputChannel, juce::UndoManager* undo = nullptr);
+
     /// Access the state node for a track.
     /// @param trackId identifier of the track
     juce::ValueTree getTrackState(const String& trackId) const;
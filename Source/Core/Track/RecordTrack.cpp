@@ -1,7 +1,22 @@
 #include "RecordTrack.h"
 
+#include "Core/Edit/EditState.h"
+
 RecordTrack::RecordTrack(const String& name)
     : AudioTrack(name)
 {
     trackType = TrackType::Record;
 }
+
+void RecordTrack::setInputChannel(int newInputChannel)
+{
+    inputChannel = std::max(0, newInputChannel);
+    if (auto* state = getBoundState()) {
+        state->setTrackInputChannel(id, inputChannel);
+    }
+}
+
+void RecordTrack::stateBound()
+{
+    getBoundState()->setTrackInputChannel(id, inputChannel);
+}
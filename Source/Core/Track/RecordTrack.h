@@ -15,4 +15,17 @@ public:
     {
         return std::make_shared<RecordTrack>(name);
     }
+
+    /// First device input channel captured by this track (the track format sets the count).
+    int getInputChannel() const { return inputChannel; }
+
+    /// Assign the first device input channel captured by this track.
+    /// Mirrored into the edit state so the engine rebuilds its input routes.
+    /// @param newInputChannel zero-based device input channel
+    void setInputChannel(int newInputChannel);
+
+private:
+    void stateBound() override;
+
+    int inputChannel = 0;
 };
@@ -5,8 +5,6 @@
 
 Send::Send(const std::weak_ptr<Track> &destinationTrack, String  name)
     : name(std::move(name)),
-      volume(Volume(1.0)),
-      pan(Pan()),
       format(ChannelsFormat::Mono),
       type(SendType::PreFader),
       destinationTrack(destinationTrack)
@@ -16,3 +14,13 @@ Send::Send(const std::weak_ptr<Track> &destinationTrack, String  name)
 ChannelsFormat Send::getFormat() const {
     return format;
 }
+
+void Send::setLevel(float newLevel)
+{
+    level.store(juce::jlimit(0.0f, Volume::MAX_GAIN, newLevel), std::memory_order_relaxed);
+}
+
+void Send::setPan(float newPan)
+{
+    pan.store(juce::jlimit(-1.0f, 1.0f, newPan), std::memory_order_relaxed);
+}
@@ -3,8 +3,9 @@
 #include <JuceHeader.h>
 #include <Utils/Format.h>
 
+#include <atomic>
+
 #include "Utils/Volume.h"
-#include "Utils/Pan/Pan.h"
 
 class Track;
 
@@ -38,10 +39,34 @@ public:
     /// Channel format derived from the destination track.
     ChannelsFormat getFormat() const;
 
+    /// Display name.
+    String getName() const { return name; }
+
+    /// Tap position relative to the source track fader (read when the graph is built).
+    SendType getType() const { return type; }
+
+    /// Set the tap position (takes effect on the next graph build).
+    /// @param newType pre or post fader
+    void setType(SendType newType) { type = newType; }
+
+    /// Send level as a linear gain (safe to read from the audio thread).
+    float getLevel() const { return level.load(std::memory_order_relaxed); }
+
+    /// Set the send level, clamped to [0, Volume::MAX_GAIN].
+    /// @param newLevel linear gain
+    void setLevel(float newLevel);
+
+    /// Send pan position in [-1, 1] (safe to read from the audio thread).
+    float getPan() const { return pan.load(std::memory_order_relaxed); }
+
+    /// Set the send pan position, clamped to [-1, 1].
+    /// @param newPan pan position, -1 left, 0 centre, 1 right
+    void setPan(float newPan);
+
 private:
     String name;
-    Volume volume;
-    Pan pan;
+    std::atomic<float> level { 1.0f };
+    std::atomic<float> pan { 0.0f };
     ChannelsFormat format;
     SendType type;
     std::weak_ptr<Track> destinationTrack;
@@ -49,6 +49,7 @@ void Track::bindState(EditState& editState)
 
     trackStateNode.addListener(this);
     syncFromEditState();
+    stateBound();
 }
 
 TrackArmState Track::getArmState() const
@@ -140,6 +140,12 @@ protected:
     /// @param state new mute state
     void setMuteState(TrackMuteState state);
 
+    /// Called once bindState() attached the track to an edit state.
+    virtual void stateBound() {}
+
+    /// Edit state the track is bound to (null until bindState()).
+    EditState* getBoundState() const noexcept { return boundState; }
+
 protected:
     String id;
     std::vector<std::shared_ptr<Plugin>> plugins;
@@ -1,17 +1,6 @@
 #include "VuMeter.h"
 
-#include <random>
-
-namespace {
-float randomVolume() {
-    static std::random_device device;
-    static std::mt19937 engine(device());
-    static std::uniform_real_distribution<float> distribution(0.0f, 1.0f);
-    return distribution(engine);
-}
-}
-
-VuMeter::VuMeter() : volume(randomVolume()) {
+VuMeter::VuMeter() {
 }
 
 void VuMeter::paint(juce::Graphics& g) {
@@ -44,6 +33,12 @@ void VuMeter::paint(juce::Graphics& g) {
     g.setColour(juce::Colour::fromString("#FFFFFFFF"));
     g.drawLine(0,bounds.getHeight()*0.1,bounds.getWidth(), bounds.getHeight()*0.1, 2.0f);
 
+    if (peakDb > minimumDb) {
+        const auto peakY = bounds.getBottom() - bounds.getHeight() * dbToProportion(peakDb);
+        g.setColour(peakDb > 0.0f ? juce::Colour::fromString("#FFE67A7A") : juce::Colour::fromString("#FF5E5A73"));
+        g.drawLine(bounds.getX() + 1.0f, peakY, bounds.getRight() - 1.0f, peakY, 1.5f);
+    }
+
     g.setColour(juce::Colour::fromString("#60CFCBE3"));
     g.drawRoundedRectangle(bounds, 6.0f, 1.0f);
 }
@@ -52,3 +47,38 @@ void VuMeter::setVolume(float newVolume) {
     volume = newVolume;
     repaint();
 }
+
+void VuMeter::pushLevels(float rmsGain, float peakGain, double elapsedSeconds) {
+    const auto previousPeakDb = peakDb;
+    const auto release = releaseDbPerSecond * static_cast<float>(elapsedSeconds);
+    const auto newLevelDb = juce::Decibels::gainToDecibels(rmsGain, minimumDb);
+    const auto newPeakDb = juce::Decibels::gainToDecibels(peakGain, minimumDb);
+
+    levelDb = newLevelDb >= levelDb ? newLevelDb : juce::jmax(newLevelDb, levelDb - release);
+
+    if (newPeakDb >= peakDb) {
+        peakDb = newPeakDb;
+        peakHeldFor = 0.0;
+    } else {
+        peakHeldFor += elapsedSeconds;
+        if (peakHeldFor > peakHoldSeconds) {
+            peakDb = juce::jmax(newPeakDb, peakDb - release);
+        }
+    }
+
+    const auto newVolume = dbToProportion(levelDb);
+    if (newVolume != volume || peakDb != previousPeakDb) {
+        setVolume(newVolume);
+    }
+}
+
+void VuMeter::reset() {
+    levelDb = minimumDb;
+    peakDb = minimumDb;
+    peakHeldFor = 0.0;
+    setVolume(0.0f);
+}
+
+float VuMeter::dbToProportion(float db) {
+    return juce::jlimit(0.0f, 1.0f, (db - minimumDb) / (maximumDb - minimumDb));
+}
@@ -3,14 +3,37 @@
 #include <JuceHeader.h>
 
 /// Displays a simple VU meter with a colored fill.
+/// Levels pushed through pushLevels() follow meter ballistics: instant attack, a held peak
+/// marker and a constant dB/s release.
 class VuMeter : public juce::Component {
 public:
+    static constexpr float minimumDb = -54.0f;
+    static constexpr float maximumDb = 6.0f;
+    static constexpr double peakHoldSeconds = 1.5;
+    static constexpr float releaseDbPerSecond = 24.0f;
+
     VuMeter();
 
     void paint(juce::Graphics& g) override;
 
+    /// Set the fill directly (0..1, no ballistics).
     void setVolume(float newVolume);
 
+    /// Feed a new measurement and apply ballistics.
+    /// @param rmsGain linear RMS level driving the fill
+    /// @param peakGain linear (true) peak level driving the hold marker
+    /// @param elapsedSeconds time since the previous measurement
+    void pushLevels(float rmsGain, float peakGain, double elapsedSeconds);
+
+    /// Drop the current level and held peak, as when the meter starts following another source.
+    void reset();
+
+    /// Map a dB value onto the meter height (0 dBFS sits on the 90% line).
+    static float dbToProportion(float db);
+
 private:
     float volume = 0.0f;
+    float levelDb = minimumDb;
+    float peakDb = minimumDb;
+    double peakHeldFor = 0.0;
 };
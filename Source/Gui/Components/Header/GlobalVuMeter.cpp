@@ -1,13 +1,16 @@
 #include "GlobalVuMeter.h"
 
 GlobalVuMeter::GlobalVuMeter(const Edit* edit)
-    : SecondaryContainer(edit) {
+    : SecondaryContainer(edit),
+      edit(edit) {
     addAndMakeVisible(vuMeter1);
     addAndMakeVisible(vuMeter2);
     addAndMakeVisible(vuMeter3);
     addAndMakeVisible(vuMeter4);
     addAndMakeVisible(vuMeter5);
     addAndMakeVisible(vuMeter6);
+    lastUpdateMs = juce::Time::getMillisecondCounterHiRes();
+    startTimerHz(30);
 }
 
 void GlobalVuMeter::resized() {
@@ -27,3 +30,34 @@ void GlobalVuMeter::resized() {
 
     grid.performLayout(bounds);
 }
+
+void GlobalVuMeter::timerCallback() {
+    const auto nowMs = juce::Time::getMillisecondCounterHiRes();
+    const auto elapsedSeconds = (nowMs - lastUpdateMs) * 0.001;
+    lastUpdateMs = nowMs;
+
+    // Looked up every tick so a graph rebuild with a new output format is picked up.
+    std::shared_ptr<MeterTap> masterTap;
+    if (edit != nullptr) {
+        if (const auto outputTrack = edit->getAudioOutputTrack().lock()) {
+            masterTap = edit->getMeters()->find(outputTrack->getId());
+        }
+    }
+    if (masterTap != nullptr && masterTap->read(reading)) {
+        silentFor = 0.0;
+    } else {
+        // Nothing published (engine stopped): let the meters fall back to silence.
+        silentFor += elapsedSeconds;
+        if (silentFor > staleReadingSeconds) {
+            reading = {};
+        }
+    }
+
+    VuMeter* meters[] = { &vuMeter1, &vuMeter2, &vuMeter3, &vuMeter4, &vuMeter5, &vuMeter6 };
+    for (size_t i = 0; i < std::size(meters); ++i) {
+        const auto hasChannel = static_cast<int>(i) < reading.numChannels;
+        meters[i]->pushLevels(hasChannel ? reading.rms[i] : 0.0f,
+                              hasChannel ? reading.truePeak[i] : 0.0f,
+                              elapsedSeconds);
+    }
+}
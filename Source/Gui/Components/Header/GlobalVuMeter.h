@@ -6,13 +6,24 @@
 #include "../Common/tools/VuMeter.h"
 
 /// Displays the global VU meters inside a secondary container.
-class GlobalVuMeter : public SecondaryContainer {
+/// Each meter follows one channel of the edit output track tap.
+class GlobalVuMeter : public SecondaryContainer,
+                      private juce::Timer {
 public:
     explicit GlobalVuMeter(const Edit* edit = nullptr);
 
     void resized() override;
 
 private:
+    void timerCallback() override;
+
+    static constexpr double staleReadingSeconds = 0.25;
+
+    const Edit* edit = nullptr;
+    MeterReading reading;
+    double lastUpdateMs = 0.0;
+    double silentFor = 0.0;
+
     VuMeter vuMeter1;
     VuMeter vuMeter2;
     VuMeter vuMeter3;
@@ -5,7 +5,8 @@
 Header::Header(Edit& edit, juce::ApplicationCommandManager& commandManager)
     : edit(edit),
       controlsPanel(edit, commandManager),
-      timecodesDisplay(edit) {
+      timecodesDisplay(edit),
+      globalVuMeter(&edit) {
     addAndMakeVisible(controlsPanel);
     addAndMakeVisible(timecodesDisplay);
     addAndMakeVisible(globalVuMeter);
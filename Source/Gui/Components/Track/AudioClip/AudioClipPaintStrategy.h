@@ -24,4 +24,7 @@ public:
                        float waveformScale,
                        int64 viewStartSample,
                        int64 viewEndSample) = 0;
+
+    /// True when the last paint drew placeholders for data still being prepared.
+    virtual bool isWaitingForData() const { return false; }
 };
@@ -2,93 +2,139 @@
 
 #include <algorithm>
 #include <cmath>
+#include <vector>
 
 #include "Core/AudioClip/AudioClip.h"
 #include "Utils/IO/AudioFile.h"
 #include "Utils/Waveform/PeakFileBuilder.h"
-#include "Utils/Waveform/PeakFile.h"
+#include "Utils/Waveform/PeakSource.h"
+#include "Components/Track/AudioClip/WaveformRenderer.h"
+#include "Components/Track/AudioClip/WaveformTileCache.h"
 #include "Gui/Style/Font.h"
 
-namespace {
-constexpr float kPerceptualK = 9.0f;
-constexpr float kInt16ToFloat = 1.0f / 32768.0f;
-
-float applyPerceptualMapping(float value) {
-    const auto absValue = std::abs(value);
-    const auto mapped = std::log1p(kPerceptualK * absValue) / std::log1p(kPerceptualK);
-    return std::copysign(mapped, value);
-}
-
-float dequantizePeak(int16 value) {
-    return static_cast<float>(value) * kInt16ToFloat;
-}
-
-struct PixelPeak {
-    float min = 0.0f;
-    float max = 0.0f;
-    bool hasValue = false;
-};
-
-
-// Aggregate peak blocks into per-pixel min/max buckets.
-void aggregateBlocksToPixels(const std::vector<PeakFile::PeakBlock>& blocks,
-                             uint32 channelCount,
-                             uint64 startBlock,
-                             uint32 samplesPerBlock,
-                             int64 fileStart,
-                             int64 fileEnd,
-                             int pixelCount,
-                             std::vector<PixelPeak>& outPeaks) {
-    outPeaks.clear();
-    if (pixelCount <= 0 || channelCount == 0 || blocks.empty()) {
-        return;
-    }
-
-    const auto blockCount = static_cast<uint32>(blocks.size() / channelCount);
-    if (blockCount == 0) {
-        return;
-    }
-
-    const auto rangeSamples = fileEnd - fileStart;
-    if (rangeSamples <= 0) {
+void WaveformPaintStrategy::paintTiles(juce::Graphics& g,
+                                       const std::shared_ptr<PeakSource>& peaks,
+                                       const AudioClip& clip,
+                                       const juce::Rectangle<float>& clipBounds,
+                                       const juce::Rectangle<float>& visibleBounds,
+                                       double samplesPerPixel,
+                                       float waveformScale,
+                                       int64 fileStart,
+                                       int64 fileEnd) {
+    auto& tileCache = WaveformTileCache::get();
+    const auto pixelScale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    const auto bucket = WaveformTileCache::getSamplesPerPixelBucket(samplesPerPixel);
+    WaveformTileCache::TileKey key;
+    key.source = peaks.get();
+    key.blockSize = peaks->getBestResolution(WaveformTileCache::getBucketSamplesPerPixel(bucket));
+    key.samplesPerPixelBucket = bucket;
+    key.heightPx = juce::roundToInt(clipBounds.getHeight() * pixelScale);
+    key.waveformScaleMilli = juce::roundToInt(std::max(0.0f, waveformScale) * 1000.0f);
+    key.pixelScaleMilli = juce::roundToInt(pixelScale * 1000.0f);
+    if (key.blockSize == 0 || key.heightPx <= 0) {
         return;
     }
 
-    outPeaks.resize(static_cast<size_t>(pixelCount));
-    const auto lastBlock = startBlock + blockCount;
-
-    for (int pixelIndex = 0; pixelIndex < pixelCount; ++pixelIndex) {
-        const auto startRatio = static_cast<double>(pixelIndex) / static_cast<double>(pixelCount);
-        const auto endRatio = static_cast<double>(pixelIndex + 1) / static_cast<double>(pixelCount);
-        auto pixelStartSample = fileStart + static_cast<int64>(std::floor(startRatio * rangeSamples));
-        auto pixelEndSample = fileStart + static_cast<int64>(std::floor(endRatio * rangeSamples));
-        if (pixelEndSample <= pixelStartSample) {
-            pixelEndSample = pixelStartSample + 1;
+    // Tiles sit on a grid in file samples, so they line up whatever the scroll position.
+    const auto bucketTileSamples = WaveformTileCache::kTileWidth * WaveformTileCache::getBucketSamplesPerPixel(bucket);
+    const auto firstTile = static_cast<int64>(std::floor(static_cast<double>(fileStart) / bucketTileSamples));
+    const auto endTile = static_cast<int64>(std::ceil(static_cast<double>(fileEnd) / bucketTileSamples));
+    const auto pixelsPerSample = 1.0 / samplesPerPixel;
+
+    const juce::Graphics::ScopedSaveState saveState(g);
+    g.reduceClipRegion(visibleBounds.getSmallestIntegerContainer());
+    for (auto tileIndex = firstTile; tileIndex < endTile; ++tileIndex) {
+        const auto tileStart = WaveformTileCache::getTileStartSample(bucket, tileIndex);
+        const auto tileEnd = WaveformTileCache::getTileStartSample(bucket, tileIndex + 1);
+        // Between bucket centres the tile is stretched slightly to the view resolution.
+        const juce::Rectangle<float> tileBounds(
+            clipBounds.getX() + static_cast<float>(static_cast<double>(tileStart - clip.getFileStartSample()) * pixelsPerSample),
+            clipBounds.getY(),
+            static_cast<float>(static_cast<double>(tileEnd - tileStart) * pixelsPerSample),
+            clipBounds.getHeight());
+
+        key.tileIndex = tileIndex;
+        const auto tile = interactive ? tileCache.peekTile(key, peaks) : tileCache.getTile(key, peaks);
+        if (tile.isValid()) {
+            g.drawImage(tile, tileBounds);
+            continue;
         }
-
-        const auto pixelStartBlock = static_cast<uint64>(pixelStartSample / samplesPerBlock);
-        const auto pixelEndBlock = static_cast<uint64>((pixelEndSample + samplesPerBlock - 1) / samplesPerBlock);
-        const auto clampedStartBlock = std::max<uint64>(pixelStartBlock, startBlock);
-        const auto clampedEndBlock = std::min<uint64>(pixelEndBlock, lastBlock);
-        if (clampedEndBlock <= clampedStartBlock) {
+        if (paintScaledTiles(g, peaks, clip, clipBounds, tileBounds, key, pixelsPerSample, tileStart, tileEnd)) {
+            // Mid-gesture a scaled neighbour is enough; the exact tile is requested once the view settles.
+            waitingForTiles = waitingForTiles || !interactive;
             continue;
         }
+        if (interactive) {
+            tileCache.getTile(key, peaks);
+        }
+        // The range stays blank until its tile lands: rasterising it here would stall input.
+        waitingForTiles = true;
+    }
+}
 
-        float minValue = 1.0f;
-        float maxValue = -1.0f;
-        for (uint64 blockIndex = clampedStartBlock; blockIndex < clampedEndBlock; ++blockIndex) {
-            const auto localIndex = static_cast<size_t>(blockIndex - startBlock);
-            for (uint32 channel = 0; channel < channelCount; ++channel) {
-                const auto& block = blocks[localIndex * channelCount + channel];
-                minValue = std::min(minValue, dequantizePeak(block.min));
-                maxValue = std::max(maxValue, dequantizePeak(block.max));
+bool WaveformPaintStrategy::paintScaledTiles(juce::Graphics& g,
+                                             const std::shared_ptr<PeakSource>& peaks,
+                                             const AudioClip& clip,
+                                             const juce::Rectangle<float>& clipBounds,
+                                             const juce::Rectangle<float>& tileBounds,
+                                             const WaveformTileCache::TileKey& missingKey,
+                                             double pixelsPerSample,
+                                             int64 tileStart,
+                                             int64 tileEnd) {
+    auto& tileCache = WaveformTileCache::get();
+    // Zoom steps are whole octaves, so the previous zoom levels sit one or two octaves away.
+    // Coarser tiles are preferred: they cover the range with fewer lookups.
+    constexpr int kOctaveOffsets[] = { 1, -1, 2, -2 };
+    std::vector<juce::Image> tiles;
+    for (const auto octaves : kOctaveOffsets) {
+        auto key = missingKey;
+        key.samplesPerPixelBucket = missingKey.samplesPerPixelBucket + octaves * WaveformTileCache::kBucketsPerOctave;
+        key.blockSize = peaks->getBestResolution(WaveformTileCache::getBucketSamplesPerPixel(key.samplesPerPixelBucket));
+        if (key.blockSize == 0) {
+            continue;
+        }
+        const auto tileSamples = WaveformTileCache::kTileWidth
+                                 * WaveformTileCache::getBucketSamplesPerPixel(key.samplesPerPixelBucket);
+        const auto first = static_cast<int64>(std::floor(static_cast<double>(tileStart) / tileSamples));
+        const auto end = static_cast<int64>(std::ceil(static_cast<double>(tileEnd) / tileSamples));
+
+        tiles.clear();
+        for (auto index = first; index < end; ++index) {
+            key.tileIndex = index;
+            auto tile = tileCache.peekTile(key, peaks);
+            if (!tile.isValid()) {
+                break;
             }
+            tiles.push_back(std::move(tile));
+        }
+        if (tiles.size() != static_cast<size_t>(end - first)) {
+            continue;
         }
 
-        outPeaks[static_cast<size_t>(pixelIndex)] = { minValue, maxValue, true };
+        const juce::Graphics::ScopedSaveState saveState(g);
+        g.reduceClipRegion(tileBounds.getSmallestIntegerContainer());
+        for (size_t i = 0; i < tiles.size(); ++i) {
+            const auto index = first + static_cast<int64>(i);
+            const auto start = WaveformTileCache::getTileStartSample(key.samplesPerPixelBucket, index);
+            const auto stop = WaveformTileCache::getTileStartSample(key.samplesPerPixelBucket, index + 1);
+            g.drawImage(tiles[i],
+                        { clipBounds.getX() + static_cast<float>(static_cast<double>(start - clip.getFileStartSample()) * pixelsPerSample),
+                          clipBounds.getY(),
+                          static_cast<float>(static_cast<double>(stop - start) * pixelsPerSample),
+                          clipBounds.getHeight() });
+        }
+        return true;
     }
+    return false;
+}
+
+void WaveformPaintStrategy::setInteractive(bool isInteractive) {
+    interactive = isInteractive;
+}
+
+bool WaveformPaintStrategy::isWaitingForData() const {
+    return waitingForTiles;
 }
-} // namespace
 
 void WaveformPaintStrategy::paint(juce::Graphics& g,
                                   const juce::Rectangle<float>& bounds,
@@ -97,6 +143,7 @@ void WaveformPaintStrategy::paint(juce::Graphics& g,
                                   float waveformScale,
                                   int64 viewStartSample,
                                   int64 viewEndSample) {
+    waitingForTiles = false;
     const auto clipStart = clip.getSessionStartSample();
     const auto clipEnd = clip.getSessionEndSample();
     const auto visibleStart = std::max(clipStart, viewStartSample);
@@ -114,7 +161,7 @@ void WaveformPaintStrategy::paint(juce::Graphics& g,
     g.drawRoundedRectangle(clipBounds, 8.0f, 2.0f);
 
     const float midY = clipBounds.getCentreY();
-    const float halfHeight = clipBounds.getHeight() * 0.45f * std::max(0.0f, waveformScale);
+    const float halfHeight = clipBounds.getHeight() * WaveformRenderer::kHalfHeightRatio * std::max(0.0f, waveformScale);
     const float width = clipBounds.getWidth();
     const float visibleX0 = ((static_cast<float>(visibleStart - clipStart)) / static_cast<float>(clipEnd - clipStart)) * width;
     const float visibleX1 = ((static_cast<float>(visibleEnd - clipStart)) / static_cast<float>(clipEnd - clipStart)) * width;
@@ -138,154 +185,44 @@ void WaveformPaintStrategy::paint(juce::Graphics& g,
             }
 
             const auto fileStart = clip.getFileStartSample() + (visibleStart - clipStart);
-            auto fileEnd = clip.getFileStartSample() + (visibleEnd - clipStart);
-            const auto totalSamples = static_cast<int64>(peakFile->getTotalSamples());
-            if (totalSamples > 0 && fileEnd > totalSamples) {
-                fileEnd = totalSamples;
-            }
-            if (fileEnd <= fileStart) {
-                return;
-            }
-
-            std::vector<PeakFile::PeakBlock> blocks;
-            if (!peakFile->readBlocksForRange(static_cast<uint32>(samplesPerBlock),
-                                              static_cast<uint64>(fileStart),
-                                              static_cast<uint64>(fileEnd),
-                                              blocks)) {
-                return;
-            }
-
-            const auto channelCount = peakFile->getChannelCount();
-            juce::Path path;
-            std::vector<juce::Point<float>> minPoints;
-            const int pixelCount = std::max(1, static_cast<int>(std::floor(visibleBounds.getWidth())));
-            minPoints.reserve(static_cast<size_t>(pixelCount));
-
-            std::vector<PixelPeak> pixelPeaks;
-            const auto startBlock = static_cast<uint64>(fileStart / samplesPerBlock);
-            aggregateBlocksToPixels(blocks,
-                                    channelCount,
-                                    startBlock,
-                                    static_cast<uint32>(samplesPerBlock),
-                                    fileStart,
-                                    fileEnd,
-                                    pixelCount,
-                                    pixelPeaks);
-
-            const float xStart = visibleBounds.getX();
-            const float xStep = visibleBounds.getWidth() / static_cast<float>(pixelCount);
-            float previousMin = 0.0f;
-            float previousMax = 0.0f;
-
-            for (int pixelIndex = 0; pixelIndex < pixelCount; ++pixelIndex) {
-                const auto& peak = pixelPeaks[static_cast<size_t>(pixelIndex)];
-                const float minValue = peak.hasValue ? peak.min : previousMin;
-                const float maxValue = peak.hasValue ? peak.max : previousMax;
-                previousMin = minValue;
-                previousMax = maxValue;
-
-                const float x = xStart + xStep * static_cast<float>(pixelIndex);
-
-                const auto mappedMax = applyPerceptualMapping(maxValue);
-                const auto mappedMin = applyPerceptualMapping(minValue);
-                const auto maxY = midY - (mappedMax * halfHeight);
-                const auto minY = midY - (mappedMin * halfHeight);
-
-                if (pixelIndex == 0) {
-                    path.startNewSubPath(x, maxY);
-                } else {
-                    path.lineTo(x, maxY);
-                }
-                minPoints.emplace_back(x, minY);
-            }
-
-            for (auto it = minPoints.rbegin(); it != minPoints.rend(); ++it) {
-                path.lineTo(it->x, it->y);
+            const auto fileEnd = clip.getFileStartSample() + (visibleEnd - clipStart);
+
+            if (!peakFile->isComplete()) {
+                // Peaks still being built change under the tiles; draw them directly.
+                WaveformRenderer::paintPeaks(g,
+                                             *peakFile,
+                                             static_cast<uint32>(samplesPerBlock),
+                                             fileStart,
+                                             fileEnd,
+                                             visibleBounds,
+                                             halfHeight,
+                                             1.0f);
+            } else {
+                paintTiles(g, peakFile, clip, clipBounds, visibleBounds, samplesPerPixel, waveformScale, fileStart, fileEnd);
             }
-
-            const auto waveformColour = juce::Colour(0xFF63A129);
-            g.setColour(waveformColour.withAlpha(0.7f));
-            g.fillPath(path);
-            g.setColour(waveformColour);
-            g.strokePath(path, juce::PathStrokeType(1.0f));
         }
     // use raw sample but as there is still multiple samples per pixel, we need to mean them (still min/max)
     } else if (samplesPerPixel > 1.0f) {
-        const auto clipRelativeStart = visibleStart - clipStart;
-        auto buffer = clip.read(clipRelativeStart, visibleSamples);
-        if (buffer.getNumSamples() < 2) {
-            return;
-        }
-
-        const int pixelCount = std::max(1, static_cast<int>(std::floor(visibleBounds.getWidth())));
-        const float xStart = visibleBounds.getX();
-        const float xStep = visibleBounds.getWidth() / static_cast<float>(pixelCount);
-        const int totalSamples = buffer.getNumSamples();
-        const float samplesPerPixelFloat = static_cast<float>(totalSamples) / static_cast<float>(pixelCount);
-        juce::Path path;
-        std::vector<juce::Point<float>> minPoints;
-        minPoints.reserve(static_cast<size_t>(pixelCount));
-
-        for (int pixelIndex = 0; pixelIndex < pixelCount; ++pixelIndex) {
-            const int startSample = static_cast<int>(std::floor(pixelIndex * samplesPerPixelFloat));
-            const int endSample = static_cast<int>(std::floor((pixelIndex + 1) * samplesPerPixelFloat));
-            const int sampleCount = std::max(1, endSample - startSample);
-            const int clampedStart = std::min(startSample, totalSamples - 1);
-            const int clampedCount = std::min(sampleCount, totalSamples - clampedStart);
-
-            float minValue = 1.0f;
-            float maxValue = -1.0f;
-            for (int channelIndex = 0; channelIndex < buffer.getNumChannels(); ++channelIndex) {
-                const float* samples = buffer.getReadPointer(channelIndex);
-                auto range = juce::FloatVectorOperations::findMinAndMax(samples + clampedStart, clampedCount);
-                minValue = std::min(minValue, range.getStart());
-                maxValue = std::max(maxValue, range.getEnd());
-            }
-
-            const float mappedMax = applyPerceptualMapping(maxValue);
-            const float mappedMin = applyPerceptualMapping(minValue);
-            const float x = xStart + xStep * static_cast<float>(pixelIndex);
-            const float maxY = midY - (mappedMax * halfHeight);
-            const float minY = midY - (mappedMin * halfHeight);
-
-            if (pixelIndex == 0) {
-                path.startNewSubPath(x, maxY);
-            } else {
-                path.lineTo(x, maxY);
-            }
-            minPoints.emplace_back(x, minY);
-        }
-
-        for (auto it = minPoints.rbegin(); it != minPoints.rend(); ++it) {
-            path.lineTo(it->x, it->y);
+        if (auto audioFile = clip.getAudioFile()) {
+            WaveformRenderer::paintSampleEnvelope(g,
+                                                  *audioFile,
+                                                  clip.getFileStartSample() + (visibleStart - clipStart),
+                                                  visibleSamples,
+                                                  visibleBounds,
+                                                  halfHeight,
+                                                  1.0f);
         }
-
-        const auto waveformColour = juce::Colour(0xFF63A129);
-        g.setColour(waveformColour.withAlpha(0.7f));
-        g.fillPath(path);
-        g.setColour(waveformColour);
-        g.strokePath(path, juce::PathStrokeType(1.0f));
     // space between sample is >= than one pixel so we need to draw each sample (no more min/max)
     } else {
-        const auto clipRelativeStart = visibleStart - clipStart;
-        auto buffer = clip.read(clipRelativeStart, visibleSamples);
-        if (buffer.getNumSamples() < 2) {
-            return;
-        }
-
-        juce::Path path;
-        path.preallocateSpace(static_cast<int>(buffer.getNumSamples()));
-        const float xStart = visibleBounds.getX();
-        const float xStep = visibleBounds.getWidth() / static_cast<float>(buffer.getNumSamples() - 1);
-        const float* samples = buffer.getReadPointer(0);
-        path.startNewSubPath(xStart, midY - (applyPerceptualMapping(samples[0]) * halfHeight));
-        for (int i = 1; i < buffer.getNumSamples(); ++i) {
-            const float x = xStart + xStep * static_cast<float>(i);
-            path.lineTo(x, midY - (applyPerceptualMapping(samples[i]) * halfHeight));
+        if (auto audioFile = clip.getAudioFile()) {
+            WaveformRenderer::paintSampleLine(g,
+                                              *audioFile,
+                                              clip.getFileStartSample() + (visibleStart - clipStart),
+                                              visibleSamples,
+                                              visibleBounds,
+                                              halfHeight,
+                                              1.0f);
         }
-
-        g.setColour(juce::Colour(0xFF63A129));
-        g.strokePath(path, juce::PathStrokeType(1.0f));
     }
 
     g.setFont(Fonts::p(10.0f, Fonts::Weight::Regular));
@@ -1,8 +1,11 @@
 #pragma once
 
 #include "AudioClipPaintStrategy.h"
+#include "WaveformTileCache.h"
 
-/// Paints a clip waveform from cached samples.
+class PeakSource;
+
+/// Paints a clip waveform from cached waveform tiles, peaks or samples depending on the zoom.
 class WaveformPaintStrategy : public AudioClipPaintStrategy {
 public:
     void paint(juce::Graphics& g,
@@ -12,4 +15,39 @@ public:
                float waveformScale,
                int64 viewStartSample,
                int64 viewEndSample) override;
+
+    bool isWaitingForData() const override;
+
+    /// While interactive, missing tiles are stood in for by cached tiles of nearby zooms
+    /// instead of being rendered for a zoom level the view may already be leaving.
+    /// @param isInteractive true while a zoom gesture is in progress
+    void setInteractive(bool isInteractive);
+
+private:
+    /// Blit cached waveform tiles over the visible range; missing ones are rendered in the background.
+    void paintTiles(juce::Graphics& g,
+                    const std::shared_ptr<PeakSource>& peaks,
+                    const AudioClip& clip,
+                    const juce::Rectangle<float>& clipBounds,
+                    const juce::Rectangle<float>& visibleBounds,
+                    double samplesPerPixel,
+                    float waveformScale,
+                    int64 fileStart,
+                    int64 fileEnd);
+
+    /// Draw cached tiles of a nearby zoom bucket scaled over a missing tile's range.
+    /// @return true when one bucket had every tile covering the range
+    bool paintScaledTiles(juce::Graphics& g,
+                          const std::shared_ptr<PeakSource>& peaks,
+                          const AudioClip& clip,
+                          const juce::Rectangle<float>& clipBounds,
+                          const juce::Rectangle<float>& tileBounds,
+                          const WaveformTileCache::TileKey& missingKey,
+                          double pixelsPerSample,
+                          int64 tileStart,
+                          int64 tileEnd);
+
+    bool interactive = false;
+    /// True when the last paint drew a range whose tile is still rendering.
+    bool waitingForTiles = false;
 };
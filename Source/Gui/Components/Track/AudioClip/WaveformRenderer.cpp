@@ -0,0 +1,293 @@
+#include "WaveformRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Utils/IO/AudioFile.h"
+#include "Utils/Waveform/PeakFileFormat.h"
+#include "Utils/Waveform/PeakSource.h"
+
+namespace WaveformRenderer {
+namespace {
+constexpr float kPerceptualK = 9.0f;
+constexpr float kInt16ToFloat = 1.0f / 32768.0f;
+
+/// Perceptual height of every Int16 peak, indexed by the peak itself.
+const float* getInt16MappingTable() {
+    static const std::vector<float> table = [] {
+        std::vector<float> values(65536);
+        for (int value = -32768; value < 32768; ++value) {
+            values[static_cast<size_t>(value + 32768)] = applyPerceptualMapping(static_cast<float>(value) * kInt16ToFloat);
+        }
+        return values;
+    }();
+    return table.data() + 32768;
+}
+
+/// Perceptual height of every stored Int8 peak, dequantised as PeakFile does.
+const float* getInt8MappingTable() {
+    static const std::vector<float> table = [] {
+        std::vector<float> values(256);
+        for (int value = -128; value < 128; ++value) {
+            const auto peak = PeakFileFormat::dequantizeInt8(static_cast<int8>(value));
+            values[static_cast<size_t>(value + 128)] = applyPerceptualMapping(static_cast<float>(peak) * kInt16ToFloat);
+        }
+        return values;
+    }();
+    return table.data() + 128;
+}
+
+/// Mapped envelope of one pixel column.
+struct PixelPeak {
+    float min = 0.0f;
+    float max = 0.0f;
+    bool hasValue = false;
+};
+
+/// Folds block runs into per-pixel min/max buckets, a pixel reading every block it overlaps.
+class PixelAggregator {
+public:
+    PixelAggregator(std::vector<PixelPeak>& pixels,
+                    uint32 channelCount,
+                    uint32 samplesPerBlock,
+                    int64 fileStart,
+                    int64 fileEnd)
+        : pixels(pixels),
+          valuesPerBlock(static_cast<size_t>(channelCount) * 2),
+          samplesPerBlock(samplesPerBlock),
+          fileStart(fileStart),
+          rangeSamples(static_cast<double>(fileEnd - fileStart)) {
+    }
+
+    void addRun(const PeakSource::BlockRun& run) {
+        const auto pixelCount = static_cast<int>(pixels.size());
+        const auto runEnd = run.firstBlock + run.blockCount;
+        for (; pixelIndex < pixelCount; ++pixelIndex) {
+            uint64 pixelStartBlock = 0;
+            uint64 pixelEndBlock = 0;
+            getPixelBlocks(pixelIndex, pixelCount, pixelStartBlock, pixelEndBlock);
+            const auto first = std::max(pixelStartBlock, run.firstBlock);
+            const auto last = std::min(pixelEndBlock, runEnd);
+            if (first < last) {
+                const auto offset = static_cast<size_t>(first - run.firstBlock) * valuesPerBlock;
+                const auto count = static_cast<size_t>(last - first) * valuesPerBlock;
+                if (run.int8Values != nullptr) {
+                    fold(run.int8Values + offset, count, getInt8MappingTable(), pixels[static_cast<size_t>(pixelIndex)]);
+                } else {
+                    fold(run.int16Values + offset, count, getInt16MappingTable(), pixels[static_cast<size_t>(pixelIndex)]);
+                }
+            }
+            if (pixelEndBlock > runEnd) {
+                // The pixel continues in the next run.
+                return;
+            }
+        }
+    }
+
+private:
+    void getPixelBlocks(int pixel, int pixelCount, uint64& outStart, uint64& outEnd) const {
+        const auto startSample = fileStart + static_cast<int64>(std::floor(rangeSamples * pixel / pixelCount));
+        auto endSample = fileStart + static_cast<int64>(std::floor(rangeSamples * (pixel + 1) / pixelCount));
+        if (endSample <= startSample) {
+            endSample = startSample + 1;
+        }
+        outStart = static_cast<uint64>(startSample / samplesPerBlock);
+        outEnd = static_cast<uint64>((endSample + samplesPerBlock - 1) / samplesPerBlock);
+    }
+
+    /// Min over the even values and max over the odd ones, mapped once through the table.
+    template <typename Value>
+    static void fold(const Value* values, size_t count, const float* table, PixelPeak& pixel) {
+        auto minValue = values[0];
+        auto maxValue = values[1];
+        for (size_t i = 2; i < count; i += 2) {
+            minValue = std::min(minValue, values[i]);
+            maxValue = std::max(maxValue, values[i + 1]);
+        }
+        // The mapping is monotonic, so mapping the extremes equals the extremes of the mapped values.
+        const auto mappedMin = table[minValue];
+        const auto mappedMax = table[maxValue];
+        pixel.min = pixel.hasValue ? std::min(pixel.min, mappedMin) : mappedMin;
+        pixel.max = pixel.hasValue ? std::max(pixel.max, mappedMax) : mappedMax;
+        pixel.hasValue = true;
+    }
+
+    std::vector<PixelPeak>& pixels;
+    const size_t valuesPerBlock;
+    const uint32 samplesPerBlock;
+    const int64 fileStart;
+    const double rangeSamples;
+    int pixelIndex = 0;
+};
+/// Fill and stroke mapped pixel columns, from the maxima left to right then the minima back.
+void paintEnvelope(juce::Graphics& g,
+                   std::vector<PixelPeak>& pixels,
+                   juce::Rectangle<float> area,
+                   float halfHeight,
+                   float lineThickness) {
+    thread_local juce::Path path;
+    const auto pixelCount = static_cast<int>(pixels.size());
+    // Columns without data repeat their left neighbour.
+    PixelPeak previous { 0.0f, 0.0f, true };
+    for (auto& pixel : pixels) {
+        if (!pixel.hasValue) {
+            pixel = previous;
+        }
+        previous = pixel;
+    }
+
+    const float midY = area.getCentreY();
+    const float xStart = area.getX();
+    const float xStep = area.getWidth() / static_cast<float>(pixelCount);
+    path.clear();
+    path.startNewSubPath(xStart, midY - pixels.front().max * halfHeight);
+    for (int pixelIndex = 1; pixelIndex < pixelCount; ++pixelIndex) {
+        path.lineTo(xStart + xStep * static_cast<float>(pixelIndex), midY - pixels[static_cast<size_t>(pixelIndex)].max * halfHeight);
+    }
+    // Close the last column so adjacent ranges (tiles) join without a gap.
+    path.lineTo(area.getRight(), midY - pixels.back().max * halfHeight);
+    path.lineTo(area.getRight(), midY - pixels.back().min * halfHeight);
+    for (int pixelIndex = pixelCount - 1; pixelIndex >= 0; --pixelIndex) {
+        path.lineTo(xStart + xStep * static_cast<float>(pixelIndex), midY - pixels[static_cast<size_t>(pixelIndex)].min * halfHeight);
+    }
+
+    g.setColour(waveformColour.withAlpha(0.7f));
+    g.fillPath(path);
+    g.setColour(waveformColour);
+    g.strokePath(path, juce::PathStrokeType(lineThickness));
+}
+} // namespace
+
+float applyPerceptualMapping(float value) {
+    const auto absValue = std::abs(value);
+    const auto mapped = std::log1p(kPerceptualK * absValue) / std::log1p(kPerceptualK);
+    return std::copysign(mapped, value);
+}
+
+void paintPeaks(juce::Graphics& g,
+                const PeakSource& peaks,
+                uint32 samplesPerBlock,
+                int64 fileStart,
+                int64 fileEnd,
+                juce::Rectangle<float> area,
+                float halfHeight,
+                float lineThickness) {
+    const auto totalSamples = static_cast<int64>(peaks.getTotalSamples());
+    if (samplesPerBlock == 0 || fileStart < 0 || fileEnd <= fileStart || area.getWidth() <= 0.0f
+        || peaks.getChannelCount() == 0) {
+        return;
+    }
+    if (fileEnd > totalSamples) {
+        // Keep the horizontal scale when the range runs past the end of the file.
+        const auto ratio = static_cast<double>(totalSamples - fileStart) / static_cast<double>(fileEnd - fileStart);
+        area.setWidth(static_cast<float>(area.getWidth() * ratio));
+        fileEnd = totalSamples;
+        if (fileEnd <= fileStart || area.getWidth() <= 0.0f) {
+            return;
+        }
+    }
+
+    // Per-thread scratch: the message thread and the tile workers paint without allocating once warm.
+    thread_local std::vector<PixelPeak> pixels;
+    const int pixelCount = std::max(1, static_cast<int>(std::floor(area.getWidth())));
+    pixels.assign(static_cast<size_t>(pixelCount), PixelPeak {});
+    PixelAggregator aggregator(pixels, peaks.getChannelCount(), samplesPerBlock, fileStart, fileEnd);
+    if (!peaks.visitBlocksForRange(samplesPerBlock,
+                                   static_cast<uint64>(fileStart),
+                                   static_cast<uint64>(fileEnd),
+                                   [&aggregator](const PeakSource::BlockRun& run) { aggregator.addRun(run); })) {
+        return;
+    }
+
+    paintEnvelope(g, pixels, area, halfHeight, lineThickness);
+}
+
+void paintSampleEnvelope(juce::Graphics& g,
+                         const AudioFile& audioFile,
+                         int64 fileStart,
+                         int64 numSamples,
+                         juce::Rectangle<float> area,
+                         float halfHeight,
+                         float lineThickness) {
+    if (numSamples < 2 || area.getWidth() <= 0.0f) {
+        return;
+    }
+
+    thread_local std::vector<PixelPeak> pixels;
+    const int pixelCount = std::max(1, static_cast<int>(std::floor(area.getWidth())));
+    pixels.assign(static_cast<size_t>(pixelCount), PixelPeak { 1.0f, -1.0f, true });
+    const auto samplesPerPixel = static_cast<double>(numSamples) / static_cast<double>(pixelCount);
+    int pixelIndex = 0;
+    const auto visited = audioFile.visitSamples(fileStart, numSamples, [&](const AudioFile::SampleChunk& chunk) {
+        const auto chunkStart = chunk.startSample - fileStart;
+        const auto chunkEnd = chunkStart + chunk.numSamples;
+        for (; pixelIndex < pixelCount; ++pixelIndex) {
+            const auto pixelStart = std::min(static_cast<int64>(std::floor(pixelIndex * samplesPerPixel)), numSamples - 1);
+            const auto pixelEnd = std::min(std::max(pixelStart + 1, static_cast<int64>(std::floor((pixelIndex + 1) * samplesPerPixel))),
+                                           numSamples);
+            const auto first = std::max(pixelStart, chunkStart);
+            const auto last = std::min(pixelEnd, chunkEnd);
+            if (first < last) {
+                auto& pixel = pixels[static_cast<size_t>(pixelIndex)];
+                for (int channelIndex = 0; channelIndex < chunk.numChannels; ++channelIndex) {
+                    const auto range = juce::FloatVectorOperations::findMinAndMax(chunk.channels[channelIndex] + (first - chunkStart),
+                                                                                  static_cast<int>(last - first));
+                    pixel.min = std::min(pixel.min, range.getStart());
+                    pixel.max = std::max(pixel.max, range.getEnd());
+                }
+            }
+            if (pixelEnd > chunkEnd) {
+                // The pixel continues in the next chunk.
+                return;
+            }
+        }
+    });
+    if (!visited) {
+        return;
+    }
+
+    for (auto& pixel : pixels) {
+        pixel.min = applyPerceptualMapping(pixel.min);
+        pixel.max = applyPerceptualMapping(pixel.max);
+    }
+    paintEnvelope(g, pixels, area, halfHeight, lineThickness);
+}
+
+void paintSampleLine(juce::Graphics& g,
+                     const AudioFile& audioFile,
+                     int64 fileStart,
+                     int64 numSamples,
+                     juce::Rectangle<float> area,
+                     float halfHeight,
+                     float lineThickness) {
+    if (numSamples < 2) {
+        return;
+    }
+
+    thread_local juce::Path path;
+    path.clear();
+    const float midY = area.getCentreY();
+    const float xStart = area.getX();
+    const float xStep = area.getWidth() / static_cast<float>(numSamples - 1);
+    const auto visited = audioFile.visitSamples(fileStart, numSamples, [&](const AudioFile::SampleChunk& chunk) {
+        const auto* samples = chunk.channels[0];
+        auto index = chunk.startSample - fileStart;
+        for (int i = 0; i < chunk.numSamples; ++i, ++index) {
+            const auto x = xStart + xStep * static_cast<float>(index);
+            const auto y = midY - (applyPerceptualMapping(samples[i]) * halfHeight);
+            if (index == 0) {
+                path.startNewSubPath(x, y);
+            } else {
+                path.lineTo(x, y);
+            }
+        }
+    });
+    if (!visited) {
+        return;
+    }
+
+    g.setColour(waveformColour);
+    g.strokePath(path, juce::PathStrokeType(lineThickness));
+}
+
+} // namespace WaveformRenderer
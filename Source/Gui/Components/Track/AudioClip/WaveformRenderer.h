@@ -0,0 +1,73 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+class AudioFile;
+class PeakSource;
+
+/// Drawing helpers shared by the waveform painter and the tile renderer.
+/// Safe to call from worker threads when drawing into software images.
+namespace WaveformRenderer {
+
+/// Waveform outline colour (the fill uses it at 70% alpha).
+inline const juce::Colour waveformColour { 0xFF63A129 };
+
+/// Height of a full scale peak above the centre line, relative to the clip height.
+constexpr float kHalfHeightRatio = 0.45f;
+
+/// Log-like amplitude mapping that keeps quiet passages visible.
+/// @param value sample value in [-1, 1]
+float applyPerceptualMapping(float value);
+
+/// Fill and stroke the min/max envelope of a peak range, one column per pixel.
+/// @param g target graphics context
+/// @param peaks peak source to read
+/// @param samplesPerBlock peak resolution to read (one of the source's levels)
+/// @param fileStart first sample in file space
+/// @param fileEnd end sample in file space
+/// @param area extent of the range; the envelope is centred vertically
+/// @param halfHeight height of a full scale peak above the centre line
+/// @param lineThickness outline thickness
+void paintPeaks(juce::Graphics& g,
+                const PeakSource& peaks,
+                uint32 samplesPerBlock,
+                int64 fileStart,
+                int64 fileEnd,
+                juce::Rectangle<float> area,
+                float halfHeight,
+                float lineThickness);
+
+/// Fill and stroke the min/max envelope of raw samples, for zooms with several samples per pixel.
+/// Samples are read in bounded chunks, without allocating a buffer for the range.
+/// @param g target graphics context
+/// @param audioFile audio to read
+/// @param fileStart first sample in file space
+/// @param numSamples number of samples covered by the area
+/// @param area extent of the range; the envelope is centred vertically
+/// @param halfHeight height of a full scale sample above the centre line
+/// @param lineThickness outline thickness
+void paintSampleEnvelope(juce::Graphics& g,
+                         const AudioFile& audioFile,
+                         int64 fileStart,
+                         int64 numSamples,
+                         juce::Rectangle<float> area,
+                         float halfHeight,
+                         float lineThickness);
+
+/// Stroke a line through the samples of the first channel, for zooms with a pixel or more per sample.
+/// @param g target graphics context
+/// @param audioFile audio to read
+/// @param fileStart first sample in file space
+/// @param numSamples number of samples spread across the area
+/// @param area extent of the range; the line is centred vertically
+/// @param halfHeight height of a full scale sample above the centre line
+/// @param lineThickness line thickness
+void paintSampleLine(juce::Graphics& g,
+                     const AudioFile& audioFile,
+                     int64 fileStart,
+                     int64 numSamples,
+                     juce::Rectangle<float> area,
+                     float halfHeight,
+                     float lineThickness);
+
+} // namespace WaveformRenderer
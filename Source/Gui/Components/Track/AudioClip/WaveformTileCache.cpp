@@ -0,0 +1,128 @@
+#include "WaveformTileCache.h"
+
+#include <cmath>
+
+#include "Components/Track/AudioClip/WaveformRenderer.h"
+#include "Utils/Waveform/PeakSource.h"
+
+bool WaveformTileCache::TileKey::operator==(const TileKey& other) const noexcept {
+    return source == other.source
+        && blockSize == other.blockSize
+        && samplesPerPixelBucket == other.samplesPerPixelBucket
+        && tileIndex == other.tileIndex
+        && heightPx == other.heightPx
+        && waveformScaleMilli == other.waveformScaleMilli
+        && pixelScaleMilli == other.pixelScaleMilli;
+}
+
+size_t WaveformTileCache::TileKeyHash::operator()(const TileKey& key) const noexcept {
+    auto hash = std::hash<const PeakSource*> {}(key.source);
+    const auto combine = [&hash](size_t value) {
+        hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    };
+    combine(std::hash<uint32> {}(key.blockSize));
+    combine(std::hash<int> {}(key.samplesPerPixelBucket));
+    combine(std::hash<int64> {}(key.tileIndex));
+    combine(std::hash<int> {}(key.heightPx));
+    combine(std::hash<int> {}(key.waveformScaleMilli));
+    combine(std::hash<int> {}(key.pixelScaleMilli));
+    return hash;
+}
+
+WaveformTileCache::WaveformTileCache()
+    : tiles("WaveformTile",
+            2,
+            kDefaultMemoryBudget,
+            [](const Tile& tile) {
+                return static_cast<size_t>(tile.image.getWidth()) * static_cast<size_t>(tile.image.getHeight()) * 4;
+            },
+            [this] { sendChangeMessage(); }) {
+}
+
+WaveformTileCache& WaveformTileCache::get() {
+    static WaveformTileCache instance;
+    return instance;
+}
+
+WaveformTileCache::~WaveformTileCache() {
+    tiles.clear();
+}
+
+int WaveformTileCache::getSamplesPerPixelBucket(double samplesPerPixel) {
+    if (samplesPerPixel <= 0.0) {
+        // Resolution must be positive.
+        jassert(false);
+        return 0;
+    }
+    return static_cast<int>(std::lround(std::log2(samplesPerPixel) * kBucketsPerOctave));
+}
+
+double WaveformTileCache::getBucketSamplesPerPixel(int bucket) {
+    return std::exp2(static_cast<double>(bucket) / kBucketsPerOctave);
+}
+
+int64 WaveformTileCache::getTileStartSample(int bucket, int64 tileIndex) {
+    return static_cast<int64>(std::llround(static_cast<double>(tileIndex) * kTileWidth * getBucketSamplesPerPixel(bucket)));
+}
+
+juce::Image WaveformTileCache::getTile(const TileKey& key, const std::shared_ptr<PeakSource>& source) {
+    if (source == nullptr || source.get() != key.source) {
+        // Key must describe the source it is requested with.
+        jassert(false);
+        return {};
+    }
+    if (const auto tile = tiles.find(key)) {
+        if (tile->source.lock() == source) {
+            return tile->image;
+        }
+        // Same address, different peaks: the tile belongs to a released source.
+        tiles.erase(key);
+    }
+    tiles.request(key, [key, source]() -> std::optional<Tile> {
+        return Tile { source, render(key, *source) };
+    });
+    return {};
+}
+
+juce::Image WaveformTileCache::peekTile(const TileKey& key, const std::shared_ptr<PeakSource>& source) {
+    const auto tile = tiles.find(key);
+    if (!tile.has_value() || tile->source.lock() != source) {
+        return {};
+    }
+    return tile->image;
+}
+
+void WaveformTileCache::advanceViewGeneration() {
+    tiles.advanceGeneration();
+}
+
+void WaveformTileCache::setMemoryBudget(size_t bytes) {
+    tiles.setMemoryBudget(bytes);
+}
+
+size_t WaveformTileCache::getMemoryUsage() const {
+    return tiles.getMemoryUsage();
+}
+
+void WaveformTileCache::clear() {
+    tiles.clear();
+}
+
+juce::Image WaveformTileCache::render(const TileKey& key, const PeakSource& source) {
+    const auto pixelScale = static_cast<float>(key.pixelScaleMilli) / 1000.0f;
+    const auto width = juce::jmax(1, juce::roundToInt(static_cast<float>(kTileWidth) * pixelScale));
+    const auto height = juce::jmax(1, key.heightPx);
+    // Software images can be drawn into off the message thread.
+    juce::Image image(juce::Image::ARGB, width, height, true, juce::SoftwareImageType());
+    juce::Graphics g(image);
+    const auto waveformScale = static_cast<float>(key.waveformScaleMilli) / 1000.0f;
+    WaveformRenderer::paintPeaks(g,
+                                 source,
+                                 key.blockSize,
+                                 getTileStartSample(key.samplesPerPixelBucket, key.tileIndex),
+                                 getTileStartSample(key.samplesPerPixelBucket, key.tileIndex + 1),
+                                 image.getBounds().toFloat(),
+                                 static_cast<float>(height) * WaveformRenderer::kHalfHeightRatio * waveformScale,
+                                 pixelScale);
+    return image;
+}
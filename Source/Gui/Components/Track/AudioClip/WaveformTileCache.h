@@ -0,0 +1,96 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <memory>
+
+#include "Utils/Cache/GenerationalLruCache.h"
+
+class PeakSource;
+
+/// Rasterised waveform tiles shared by every clip, rendered on a background pool.
+/// A tile covers kTileWidth logical pixels of one peak source at a bucketed zoom, so scrolling only
+/// renders the newly exposed tiles and zooming within a bucket reuses them stretched.
+/// Broadcasts a change message whenever a requested tile becomes available.
+class WaveformTileCache : public juce::ChangeBroadcaster {
+public:
+    /// Tile width in logical pixels.
+    static constexpr int kTileWidth = 256;
+    /// Zoom buckets per doubling of samples per pixel.
+    static constexpr int kBucketsPerOctave = 8;
+    /// Default memory budget for tile images.
+    static constexpr size_t kDefaultMemoryBudget = size_t { 64 } * 1024 * 1024;
+
+    struct TileKey {
+        /// Peak source identity; entries also hold a weak reference to reject reused addresses.
+        const PeakSource* source = nullptr;
+        uint32 blockSize = 0;
+        int samplesPerPixelBucket = 0;
+        int64 tileIndex = 0;
+        /// Tile height in physical pixels.
+        int heightPx = 0;
+        int waveformScaleMilli = 0;
+        int pixelScaleMilli = 0;
+
+        bool operator==(const TileKey& other) const noexcept;
+    };
+
+    /// Shared cache instance.
+    static WaveformTileCache& get();
+
+    ~WaveformTileCache() override;
+
+    /// Zoom bucket for a view resolution.
+    /// @param samplesPerPixel view resolution in samples
+    static int getSamplesPerPixelBucket(double samplesPerPixel);
+
+    /// Resolution tiles of a bucket are rendered at.
+    /// @param bucket zoom bucket from getSamplesPerPixelBucket()
+    static double getBucketSamplesPerPixel(int bucket);
+
+    /// First file sample covered by a tile (the next tile starts where it ends).
+    /// @param bucket zoom bucket
+    /// @param tileIndex tile index from the start of the file
+    static int64 getTileStartSample(int bucket, int64 tileIndex);
+
+    /// Cached tile image, or an invalid image after queuing its render.
+    /// @param key tile to fetch
+    /// @param source peaks to render from (kept alive while the tile renders)
+    juce::Image getTile(const TileKey& key, const std::shared_ptr<PeakSource>& source);
+
+    /// Cached tile image, or an invalid image; never queues a render.
+    /// @param key tile to fetch
+    /// @param source peaks the tile must have been rendered from
+    juce::Image peekTile(const TileKey& key, const std::shared_ptr<PeakSource>& source);
+
+    /// Mark queued renders as stale after a view change; they are skipped unless requested again.
+    void advanceViewGeneration();
+
+    /// Change the memory budget, evicting as needed.
+    /// @param bytes budget for tile images
+    void setMemoryBudget(size_t bytes);
+
+    /// Bytes held by cached tile images.
+    size_t getMemoryUsage() const;
+
+    /// Drop every cached tile and queued render.
+    void clear();
+
+private:
+    struct TileKeyHash {
+        size_t operator()(const TileKey& key) const noexcept;
+    };
+
+    struct Tile {
+        /// Rejects tiles of a released source whose address was reused.
+        std::weak_ptr<PeakSource> source;
+        juce::Image image;
+    };
+
+    WaveformTileCache();
+
+    /// Rasterise a tile (worker thread).
+    static juce::Image render(const TileKey& key, const PeakSource& source);
+
+    GenerationalLruCache<TileKey, Tile, TileKeyHash> tiles;
+};
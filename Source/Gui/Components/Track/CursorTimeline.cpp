@@ -10,40 +10,64 @@ void CursorTimeline::paint(juce::Graphics& g) {
     if (cursorDrawable == nullptr) {
         return;
     }
-
-    const auto mapper = getMapper();
-
     const auto transport = edit.getTransport();
     if (!transport) {
         return;
     }
+    const auto handleBounds = getHandleBounds(transport->getPlayheadSample());
+    if (!handleBounds.has_value()) {
+        return;
+    }
 
-    const auto playheadSample = transport->getPlayheadSample();
-    if (playheadSample < mapper.getViewStartSample() || playheadSample > mapper.getViewEndSample()) {
+    const auto drawableBounds = cursorDrawable->getDrawableBounds();
+    const float scale = drawableBounds.getHeight() > 0.0f
+        ? (handleBounds->getHeight() / drawableBounds.getHeight())
+        : 1.0f;
+    juce::AffineTransform transform = juce::AffineTransform::scale(scale)
+        .translated(handleBounds->getX(), handleBounds->getY());
+    cursorDrawable->draw(g, 1.0f, transform);
+}
+
+void CursorTimeline::updatePlayhead() {
+    std::optional<juce::Rectangle<int>> nextBounds;
+    if (const auto transport = edit.getTransport()) {
+        if (const auto handleBounds = getHandleBounds(transport->getPlayheadSample())) {
+            nextBounds = handleBounds->getSmallestIntegerContainer().expanded(1);
+        }
+    }
+    if (nextBounds == paintedHandleBounds) {
         return;
     }
+    if (paintedHandleBounds.has_value()) {
+        repaint(*paintedHandleBounds);
+    }
+    if (nextBounds.has_value()) {
+        repaint(*nextBounds);
+    }
+    paintedHandleBounds = nextBounds;
+}
 
-    const auto bounds = getLocalBounds();
-    const float x = mapper.sampleToX(playheadSample);
-    const float alignedX = std::floor(x) + 0.5f;
+std::optional<juce::Rectangle<float>> CursorTimeline::getHandleBounds(int64 playheadSample) const {
+    if (cursorDrawable == nullptr) {
+        return std::nullopt;
+    }
+    const auto mapper = getMapper();
+    if (playheadSample < mapper.getViewStartSample() || playheadSample > mapper.getViewEndSample()) {
+        return std::nullopt;
+    }
 
+    const float x = mapper.sampleToX(playheadSample);
     const auto drawableBounds = cursorDrawable->getDrawableBounds();
     const float targetHeight = static_cast<float>(rulerHeight) * (2.0f / 3.0f);
     const float scale = drawableBounds.getHeight() > 0.0f
         ? (targetHeight / drawableBounds.getHeight())
         : 1.0f;
     const float scaledWidth = drawableBounds.getWidth() * scale;
-    const float drawX = (x - scaledWidth * 0.5f);
-    const float drawY = static_cast<float>(rulerHeight) - (drawableBounds.getHeight() * scale);
-
-    if (transport->isPlaying()){
-        g.setColour(juce::Colour::fromRGBA(76, 44, 126, 120));
-        g.drawLine(alignedX, static_cast<float>(rulerHeight), alignedX, static_cast<float>(bounds.getHeight()), 1.0f);
-    }
-
-    juce::AffineTransform transform = juce::AffineTransform::scale(scale)
-        .translated(drawX, drawY);
-    cursorDrawable->draw(g, 1.0f, transform);
+    const float scaledHeight = drawableBounds.getHeight() * scale;
+    return juce::Rectangle<float>(x - scaledWidth * 0.5f,
+                                  static_cast<float>(rulerHeight) - scaledHeight,
+                                  scaledWidth,
+                                  scaledHeight);
 }
 
 bool CursorTimeline::hitTest(int x, int y) {
@@ -2,11 +2,14 @@
 
 #include <JuceHeader.h>
 
+#include <optional>
+
 #include "Core/Edit/Edit.h"
 #include "Gui/Assets/SvgFactory.h"
 #include "Gui/Utils/ViewRangeMapper.h"
 
-/// Transport cursor overlay for the timeline.
+/// Transport cursor handle drawn in the timeline ruler.
+/// The playhead line over the tracks is drawn by TrackIndicatorOverlay.
 class CursorTimeline : public juce::Component {
 public:
     CursorTimeline(const Edit& edit, int rulerHeight);
@@ -35,8 +38,13 @@ public:
     /// @param height new ruler height in pixels
     void setRulerHeight(int height);
 
+    /// Invalidate the old and new handle areas when the playhead moved.
+    void updatePlayhead();
+
 private:
     ViewRangeMapper getMapper() const;
+    /// Area of the cursor handle for a playhead position, when in view.
+    std::optional<juce::Rectangle<float>> getHandleBounds(int64 playheadSample) const;
     const Edit& edit;
     std::unique_ptr<juce::Drawable> cursorDrawable;
     juce::Colour fillColour = juce::Colour::fromRGB(76, 44, 126);
@@ -44,4 +52,5 @@ private:
     bool isDragging = false;
     int64 pointerDownSample = 0;
     int rulerHeight = 0;
+    std::optional<juce::Rectangle<int>> paintedHandleBounds;
 };
@@ -2,149 +2,257 @@
 
 #include <cmath>
 #include <algorithm>
+#include <optional>
 
+#include "AudioEngine/Recording/LiveTakes.h"
 #include "Command/Definitions/EditCommands.h"
+#include "Components/Track/AudioClip/WaveformRenderer.h"
+#include "Components/Track/AudioClip/WaveformTileCache.h"
+#include "Core/AudioClip/AudioClip.h"
 #include "Core/Track/AudioTrack.h"
 #include "Gui/Utils/CursorController.h"
 #include "Gui/Utils/ViewRangeMapper.h"
 #include "TrackContentPanel.h"
+#include "Utils/IO/AudioFile.h"
+#include "Utils/Waveform/PeakCacheManager.h"
 
 // ------------------------ MainComponent Implementation ------------------------
 
 TrackContent::TrackContent(Edit& edit, SelectionManager& selectionManager, std::shared_ptr<Track> track)
     : edit(edit),
-      selectionManager(selectionManager),
-      track(std::move(track)) {
-    audioTrack = std::dynamic_pointer_cast<AudioTrack>(this->track);
-    if (audioTrack) {
-        audioTrack->addListener(this);
-        rebuildClipComponents();
-    }
+      selectionManager(selectionManager) {
     edit.getState().getRoot().addListener(this);
     selectionManager.addListener(this);
-    if (this->track != nullptr) {
-        isSelected = selectionManager.isSelected(this->track->getId());
-    }
-    applyWaveformScale();
+    PeakCacheManager::get().addChangeListener(this);
+    WaveformTileCache::get().addChangeListener(this);
+    LiveTakes::get().addChangeListener(this);
+    waveformScale = edit.getState().getWaveformScale();
+    setTrack(std::move(track));
 }
 
 TrackContent::~TrackContent() {
     edit.getState().getRoot().removeListener(this);
     selectionManager.removeListener(this);
+    PeakCacheManager::get().removeChangeListener(this);
+    WaveformTileCache::get().removeChangeListener(this);
+    LiveTakes::get().removeChangeListener(this);
     if (audioTrack) {
         audioTrack->removeListener(this);
     }
 }
 
+void TrackContent::setTrack(std::shared_ptr<Track> newTrack) {
+    if (newTrack == track) {
+        return;
+    }
+    if (audioTrack) {
+        audioTrack->removeListener(this);
+    }
+    track = std::move(newTrack);
+    audioTrack = std::dynamic_pointer_cast<AudioTrack>(track);
+    selectedClipId.clear();
+    suppressNextCursorClear = false;
+    trimClipId.clear();
+    activeTrimHandle = TrimHandle::None;
+    if (audioTrack) {
+        audioTrack->addListener(this);
+    }
+    rebuildClipIndex();
+    liveTakeBounds = {};
+    isSelected = track != nullptr && selectionManager.isSelected(track->getId());
+    repaint();
+}
+
 void TrackContent::resized() {
     updateLayout();
 }
 
 void TrackContent::updateLayout() {
+    // Clips are laid out while painting, so a view change only needs a repaint.
+    repaint();
+}
+
+void TrackContent::paint(juce::Graphics& g) {
+    if (isSelected) {
+        g.setColour(juce::Colour(0x114C2C7E));
+        g.fillRect(getLocalBounds());
+    }
+    g.setColour(juce::Colour::fromRGBA(0, 0, 0, 80));
+    const auto b = getLocalBounds().toFloat();
+    g.drawLine(b.getX(), b.getBottom() + 0.5f, b.getWidth(), b.getBottom() + 0.5f, 2.0f );
+
     if (!track) {
         return;
     }
-
     const auto viewStart = edit.getViewStartSample();
     const auto viewEnd = edit.getViewEndSample();
     const auto viewLength = viewEnd - viewStart;
-    if (viewLength <= 0) {
+    if (viewLength <= 0 || getWidth() <= 0) {
         return;
     }
 
-    const auto bounds = getLocalBounds();
-    const float width = static_cast<float>(bounds.getWidth());
-    const float height = static_cast<float>(bounds.getHeight());
-    for (auto& clipComponent : clipComponents) {
-        const auto& clip = clipComponent->getClip();
-        const auto clipStart = clip.getSessionStartSample();
-        const auto clipEnd = clip.getSessionEndSample();
-        if (clipEnd <= viewStart || clipStart >= viewEnd) {
-            clipComponent->setVisible(false);
+    // Only clips under the dirty region are visited, so thin overlay repaints stay cheap.
+    const auto dirty = g.getClipBounds();
+    const auto samplesPerPixel = static_cast<double>(viewLength) / static_cast<double>(getWidth());
+    // One pixel of slack covers clips whose rounded bounds reach into the region.
+    const auto dirtyStart = viewStart + static_cast<int64>(std::floor((dirty.getX() - 1) * samplesPerPixel));
+    const auto dirtyEnd = viewStart + static_cast<int64>(std::ceil(dirty.getRight() * samplesPerPixel)) + 1;
+    const auto [first, last] = getClipsInRange(std::max(viewStart, dirtyStart), std::min(viewEnd, dirtyEnd));
+
+    const auto colour = track->getColour();
+    paintStrategy.setInteractive(edit.getState().isViewInteractive());
+    const auto paintClip = [&](ClipSlot& slot) {
+        if (const auto audioFile = slot.clip->getAudioFile()) {
+            slot.lastPaintedPeaks = audioFile->getPeakFile().get();
+        }
+        const auto clipBounds = getClipBounds(slot);
+        const juce::Graphics::ScopedSaveState saveState(g);
+        g.reduceClipRegion(clipBounds);
+        paintStrategy.paint(g, clipBounds.toFloat(), *slot.clip, colour, waveformScale, viewStart, viewEnd);
+        // Partial repaints only refresh the clips they reach, so the others keep their flag.
+        slot.waitingForTiles = paintStrategy.isWaitingForData();
+    };
+    std::optional<size_t> selectedIndex;
+    for (auto index = first; index < last; ++index) {
+        auto& slot = clipSlots[index];
+        if (slot.end <= viewStart || slot.start >= viewEnd) {
             continue;
         }
-
-        // const auto clippedStart = std::max(clipStart, viewStart);
-        // const auto clippedEnd = std::min(clipEnd, viewEnd);
-        const float startX = (static_cast<float>(clipStart - viewStart) / static_cast<float>(viewLength)) * width;
-        const float endX = (static_cast<float>(clipEnd - viewStart) / static_cast<float>(viewLength)) * width;
-        const int clipX = static_cast<int>(std::floor(startX));
-        const int clipWidth = std::max(1, static_cast<int>(std::ceil(endX - startX)));
-        clipComponent->setBounds(clipX, 0, clipWidth, static_cast<int>(height));
-        clipComponent->setViewRange(viewStart, viewEnd);
-        clipComponent->setVisible(true);
+        if (selectedClipId.isNotEmpty() && slot.clip->getId() == selectedClipId) {
+            selectedIndex = index;
+            continue;
+        }
+        paintClip(slot);
     }
+    // The selected clip is drawn last so it stays on top of overlapping clips.
+    if (selectedIndex.has_value()) {
+        auto& slot = clipSlots[*selectedIndex];
+        paintClip(slot);
+        auto clipBounds = getClipBounds(slot).toFloat().reduced(0.0f, 4.0f);
+        g.setColour(juce::Colour::fromString("#99000000"));
+        g.fillRoundedRectangle(clipBounds, 8.0f);
+        g.setColour(juce::Colour(0xFFB400FF));
+        g.drawRoundedRectangle(clipBounds, 8.0f, 2.0f);
+    }
+    paintLiveTake(g, viewStart, viewEnd);
 }
 
-void TrackContent::paint(juce::Graphics& g) {
-    if (isSelected) {
-        g.setColour(juce::Colour(0x114C2C7E));
-        g.fillRect(getLocalBounds());
+void TrackContent::paintLiveTake(juce::Graphics& g, int64 viewStart, int64 viewEnd) const {
+    const auto take = LiveTakes::get().find(track->getId());
+    if (!take.has_value() || take->peaks == nullptr || !take->peaks->isValid()) {
+        return;
     }
-    g.setColour(juce::Colour::fromRGBA(0, 0, 0, 80));
-    const auto b = getLocalBounds().toFloat();
-    g.drawLine(b.getX(), b.getBottom() + 0.5f, b.getWidth(), b.getBottom() + 0.5f, 2.0f );
-
+    const auto takeEnd = take->sessionStart + static_cast<int64>(take->peaks->getTotalSamples());
+    const auto visibleStart = std::max(take->sessionStart, viewStart);
+    const auto visibleEnd = std::min(takeEnd, viewEnd);
+    if (visibleEnd <= visibleStart) {
+        return;
+    }
+    const auto takeBounds = getRangeBounds(take->sessionStart, takeEnd).toFloat().reduced(0.0f, 4.0f);
+    g.setColour(juce::Colour(0xCCC8D9B8));
+    g.fillRoundedRectangle(takeBounds, 8.0f);
+    g.setColour(juce::Colour(0xFFD93A3A));
+    g.drawRoundedRectangle(takeBounds, 8.0f, 2.0f);
+
+    // Like a clip whose peaks are still being built, the growing take is drawn straight from its levels.
+    const auto visibleBounds = getRangeBounds(visibleStart, visibleEnd).toFloat().reduced(0.0f, 4.0f);
+    const auto samplesPerPixel = static_cast<double>(visibleEnd - visibleStart) / std::max(1.0f, visibleBounds.getWidth());
+    const auto samplesPerBlock = take->peaks->getBestResolution(samplesPerPixel);
+    if (samplesPerBlock == 0) {
+        return;
+    }
+    const float halfHeight = takeBounds.getHeight() * WaveformRenderer::kHalfHeightRatio * std::max(0.0f, waveformScale);
+    WaveformRenderer::paintPeaks(g,
+                                 *take->peaks,
+                                 samplesPerBlock,
+                                 visibleStart - take->sessionStart,
+                                 visibleEnd - take->sessionStart,
+                                 visibleBounds,
+                                 halfHeight,
+                                 1.0f);
 }
 
-void TrackContent::paintOverChildren(juce::Graphics& g) {
-    if (!isSelected) {
+void TrackContent::mouseDoubleClick(const juce::MouseEvent& event) {
+    if (!event.mods.isLeftButtonDown()) {
         return;
     }
     const auto mapper = getMapper();
+    const auto relative = event.getEventRelativeTo(this);
+    const auto clickSample = mapper.xToSample(relative.position.x);
+    const auto* slot = findClipAt(relative.position.x);
+    if (slot == nullptr || event.mods.isShiftDown()) {
+        handleDoubleClick(clickSample, event.mods.isShiftDown());
+        return;
+    }
+    // Double-clicking a clip selects exactly its range.
+    setSelectedClipId(slot->clip->getId());
+    suppressNextCursorClear = true;
+    selectionManager.setSelectionRangeFromCommand(slot->start, slot->end);
+}
 
-    const bool hasSelectionRange = edit.getState().hasSelectionRange();
-    bool hasSelection = false;
-    if (hasSelectionRange) {
-        const auto selectionRange = selectionManager.getSelectionRangeSamples();
-        if (!selectionRange.has_value()) {
-            return;
-        }
-        const auto rangeStart = std::min(selectionRange->first, selectionRange->second);
-        const auto rangeEnd = std::max(selectionRange->first, selectionRange->second);
-        const auto [clampedStart, clampedEnd] = mapper.clampRangeToView(rangeStart, rangeEnd);
-        if (clampedEnd > clampedStart) {
-            hasSelection = true;
-            const float startX = mapper.sampleToX(clampedStart);
-            const float endX = mapper.sampleToX(clampedEnd);
-            const auto x = std::min(startX, endX);
-            const auto width = std::max(1.0f, std::abs(endX - startX));
-            g.setColour(juce::Colour::fromString("#99000000"));
-            g.fillRect(x, 0.0f, width, static_cast<float>(getHeight()));
-        }
+void TrackContent::mouseMove(const juce::MouseEvent& event) {
+    if (activeTrimHandle != TrimHandle::None) {
+        return;
+    }
+    const auto x = event.getEventRelativeTo(this).position.x;
+    const auto* slot = findClipAt(x);
+    if (slot != nullptr && getTrimHandleAt(*slot, x) != TrimHandle::None) {
+        setMouseCursor(juce::MouseCursor::LeftRightResizeCursor);
+    } else {
+        setMouseCursor(juce::MouseCursor::NormalCursor);
     }
+}
 
-    const auto transport = edit.getTransport();
-    if (!transport) {
+void TrackContent::mouseExit(const juce::MouseEvent&) {
+    if (activeTrimHandle != TrimHandle::None) {
         return;
     }
-    if (hasSelectionRange && hasSelection) {
+    setMouseCursor(juce::MouseCursor::NormalCursor);
+}
+
+void TrackContent::mouseDown(const juce::MouseEvent& event) {
+    if (event.getNumberOfClicks() > 1) {
         return;
     }
-    const auto cursorSample = edit.getState().getCursorSample();
-    if (cursorSample < mapper.getViewStartSample() || cursorSample > mapper.getViewEndSample()) {
+    const auto x = event.getEventRelativeTo(this).position.x;
+    const auto* slot = findClipAt(x);
+    const auto handle = slot != nullptr ? getTrimHandleAt(*slot, x) : TrimHandle::None;
+    if (handle == TrimHandle::None) {
+        forwardMouseDown(event);
         return;
     }
+    activeTrimHandle = handle;
+    trimClipId = slot->clip->getId();
+    trimRange = { slot->start, slot->end };
+    setMouseCursor(juce::MouseCursor::LeftRightResizeCursor);
+}
 
-    // draw tick
-    const auto tick = juce::Time::getMillisecondCounter() / 350;
-    if ((tick % 2) == 0) {
+void TrackContent::mouseDrag(const juce::MouseEvent& event) {
+    if (activeTrimHandle == TrimHandle::None) {
+        if (auto* panel = findParentComponentOfClass<TrackContentPanel>()) {
+            selectionManager.mouseDrag(event.getEventRelativeTo(panel), panel);
+        }
         return;
     }
-
-    const float x = mapper.sampleToX(cursorSample);
-    g.setColour(juce::Colour::fromString("#FF998893"));
-    g.drawLine(x, 0.0f, x, static_cast<float>(getHeight()), 1.0f);
+    setMouseCursor(juce::MouseCursor::LeftRightResizeCursor);
+    applyTrim(event.getEventRelativeTo(this).position.x, false);
 }
 
-void TrackContent::mouseDoubleClick(const juce::MouseEvent& event) {
-    if (!event.mods.isLeftButtonDown()) {
+void TrackContent::mouseUp(const juce::MouseEvent& event) {
+    if (activeTrimHandle == TrimHandle::None) {
+        if (findParentComponentOfClass<TrackContentPanel>() != nullptr) {
+            selectionManager.mouseUp();
+        }
         return;
     }
-    const auto mapper = getMapper();
-    const auto relative = event.getEventRelativeTo(this);
-    const auto clickSample = mapper.xToSample(relative.position.x);
-    handleDoubleClick(clickSample, event.mods.isShiftDown());
+    applyTrim(event.getEventRelativeTo(this).position.x, true);
+    activeTrimHandle = TrimHandle::None;
+    trimClipId.clear();
+    setMouseCursor(juce::MouseCursor::NormalCursor);
+}
+
+bool TrackContent::isClipAt(juce::Point<float> position) const {
+    return getLocalBounds().toFloat().contains(position) && findClipAt(position.x) != nullptr;
 }
 
 void TrackContent::handleDoubleClick(int64 sample, bool extendSelection) {
@@ -160,11 +268,42 @@ void TrackContent::handleDoubleClick(int64 sample, bool extendSelection) {
 }
 
 void TrackContent::clipsChanged(AudioTrack&) {
-    rebuildClipComponents();
-    updateLayout();
+    rebuildClipIndex();
     repaint();
 }
 
+void TrackContent::changeListenerCallback(juce::ChangeBroadcaster* source) {
+    if (source == &LiveTakes::get()) {
+        // The old bounds cover a take that just finished, the new ones the part that grew.
+        const auto bounds = getLiveTakeBounds();
+        repaint(bounds.getUnion(liveTakeBounds));
+        liveTakeBounds = bounds;
+        return;
+    }
+    if (source == &WaveformTileCache::get()) {
+        const auto [first, last] = getClipsInRange(edit.getViewStartSample(), edit.getViewEndSample());
+        for (auto index = first; index < last; ++index) {
+            if (clipSlots[index].waitingForTiles) {
+                repaint(getClipBounds(clipSlots[index]));
+            }
+        }
+        return;
+    }
+    const auto [first, last] = getClipsInRange(edit.getViewStartSample(), edit.getViewEndSample());
+    for (auto index = first; index < last; ++index) {
+        const auto& slot = clipSlots[index];
+        const auto audioFile = slot.clip->getAudioFile();
+        if (audioFile == nullptr) {
+            continue;
+        }
+        // Also repaints once after the build ends, when getPeakFile() swaps in the finished file.
+        const auto peaks = audioFile->getPeakFile();
+        if (peaks == nullptr || !peaks->isComplete() || peaks.get() != slot.lastPaintedPeaks) {
+            repaint(getClipBounds(slot));
+        }
+    }
+}
+
 void TrackContent::valueTreePropertyChanged(juce::ValueTree&, const juce::Identifier& property) {
     if (property != EditState::kWaveformScaleId) {
         if (property == juce::Identifier("selectionStartSample")
@@ -183,11 +322,11 @@ void TrackContent::valueTreePropertyChanged(juce::ValueTree&, const juce::Identi
     applyWaveformScale();
 }
 
-void TrackContent::rebuildClipComponents() {
-    removeAllChildren();
-    clipComponents.clear();
-
+void TrackContent::rebuildClipIndex() {
+    clipSlots.clear();
+    maxClipEnds.clear();
     if (!audioTrack || !track) {
+        selectedClipId.clear();
         return;
     }
 
@@ -196,86 +335,138 @@ void TrackContent::rebuildClipComponents() {
         if (!clip) {
             continue;
         }
-        auto clipComponent = std::make_unique<AudioClipComponent>(*clip, track->getColour());
-        clipComponent->setSelected(clip->getId() == selectedClipId);
-        if (clipComponent->isSelected()) {
-            hasSelectedClip = true;
-        }
-        clipComponent->onDoubleClick = [this](AudioClipComponent& component, int64 sample, bool extendSelection) {
-            if (extendSelection) {
-                handleDoubleClick(sample, true);
-                return;
-            }
-            setSelectedClipId(component.getClip().getId());
-            suppressNextCursorClear = true;
-            selectionManager.setSelectionRangeFromCommand(component.getClip().getSessionStartSample(),
-                                                          component.getClip().getSessionEndSample());
-        };
-        clipComponent->onMousePassthroughDown = [this](const juce::MouseEvent& event) {
-            auto* panel = findParentComponentOfClass<TrackContentPanel>();
-            if (panel == nullptr) {
-                return;
-            }
-            const auto panelEvent = event.getEventRelativeTo(panel);
-            selectionManager.mouseDown(panelEvent, panel);
-            if (panelEvent.mods.isShiftDown()) {
-                return;
-            }
-            ViewRangeMapper mapper(edit, static_cast<float>(panel->getWidth()));
-            if (!mapper.isValid()) {
-                // View range and width must be valid to map samples.
-                jassert(false);
-                return;
-            }
-            const auto cursorSample = mapper.xToSample(panelEvent.position.x);
-            selectionManager.getCursorController().setCursorSample(cursorSample);
-        };
-        clipComponent->onMousePassthroughDrag = [this](const juce::MouseEvent& event) {
-            auto* panel = findParentComponentOfClass<TrackContentPanel>();
-            if (panel == nullptr) {
-                return;
-            }
-            selectionManager.mouseDrag(event.getEventRelativeTo(panel), panel);
-        };
-        clipComponent->onMousePassthroughUp = [this](const juce::MouseEvent& event) {
-            auto* panel = findParentComponentOfClass<TrackContentPanel>();
-            if (panel == nullptr) {
-                return;
-            }
-            selectionManager.mouseUp();
-        };
-        clipComponent->onTrimDrag = [this](const String& clipId, int64 sample, bool trimHead, bool commit) {
-            if (!audioTrack) {
-                return;
-            }
-            if (commit) {
-                if (trimHead) {
-                    audioTrack->trimClipHead(clipId, sample);
-                } else {
-                    audioTrack->trimClipTail(clipId, sample);
-                }
-                return;
-            }
-            if (trimHead) {
-                audioTrack->previewTrimClipHead(clipId, sample);
-            } else {
-                audioTrack->previewTrimClipTail(clipId, sample);
-            }
-        };
-        addAndMakeVisible(clipComponent.get());
-        clipComponents.push_back(std::move(clipComponent));
+        clipSlots.push_back({ clip.get(), clip->getSessionStartSample(), clip->getSessionEndSample() });
+        hasSelectedClip = hasSelectedClip || clip->getId() == selectedClipId;
+    }
+    std::stable_sort(clipSlots.begin(), clipSlots.end(), [](const ClipSlot& a, const ClipSlot& b) {
+        return a.start < b.start;
+    });
+    maxClipEnds.reserve(clipSlots.size());
+    for (const auto& slot : clipSlots) {
+        maxClipEnds.push_back(maxClipEnds.empty() ? slot.end : std::max(maxClipEnds.back(), slot.end));
     }
     if (!hasSelectedClip) {
         selectedClipId.clear();
     }
-    applyWaveformScale();
 }
 
-void TrackContent::applyWaveformScale() {
-    const float waveformScale = edit.getState().getWaveformScale();
-    for (auto& clipComponent : clipComponents) {
-        clipComponent->setWaveformScale(waveformScale);
+std::pair<size_t, size_t> TrackContent::getClipsInRange(int64 startSample, int64 endSample) const {
+    // First clip whose running end reaches past the start, last clip starting before the end.
+    const auto first = std::upper_bound(maxClipEnds.begin(), maxClipEnds.end(), startSample) - maxClipEnds.begin();
+    const auto last = std::lower_bound(clipSlots.begin(), clipSlots.end(), endSample,
+                                       [](const ClipSlot& slot, int64 sample) { return slot.start < sample; })
+        - clipSlots.begin();
+    return { static_cast<size_t>(first), static_cast<size_t>(std::max(first, last)) };
+}
+
+const TrackContent::ClipSlot* TrackContent::findClipAt(float x) const {
+    if (clipSlots.empty() || getWidth() <= 0) {
+        return nullptr;
+    }
+    // Clip bounds are rounded outwards, so search a pixel either side and test the bounds.
+    const auto mapper = getMapper();
+    const auto [first, last] = getClipsInRange(mapper.xToSample(x - 1.0f), mapper.xToSample(x + 1.0f) + 1);
+    const ClipSlot* hit = nullptr;
+    for (auto index = first; index < last; ++index) {
+        const auto& slot = clipSlots[index];
+        const auto bounds = getClipBounds(slot).toFloat();
+        if (x < bounds.getX() || x >= bounds.getRight()) {
+            continue;
+        }
+        if (selectedClipId.isNotEmpty() && slot.clip->getId() == selectedClipId) {
+            return &slot;
+        }
+        hit = &slot;
     }
+    return hit;
+}
+
+juce::Rectangle<int> TrackContent::getClipBounds(const ClipSlot& slot) const {
+    return getRangeBounds(slot.start, slot.end);
+}
+
+juce::Rectangle<int> TrackContent::getLiveTakeBounds() const {
+    if (!track) {
+        return {};
+    }
+    const auto take = LiveTakes::get().find(track->getId());
+    if (!take.has_value() || take->peaks == nullptr) {
+        return {};
+    }
+    return getRangeBounds(take->sessionStart, take->sessionStart + static_cast<int64>(take->peaks->getTotalSamples()));
+}
+
+juce::Rectangle<int> TrackContent::getRangeBounds(int64 start, int64 end) const {
+    const auto viewStart = edit.getViewStartSample();
+    const auto viewLength = edit.getViewEndSample() - viewStart;
+    if (viewLength <= 0) {
+        return {};
+    }
+    const float width = static_cast<float>(getWidth());
+    const float startX = (static_cast<float>(start - viewStart) / static_cast<float>(viewLength)) * width;
+    const float endX = (static_cast<float>(end - viewStart) / static_cast<float>(viewLength)) * width;
+    const int clipX = static_cast<int>(std::floor(startX));
+    const int clipWidth = std::max(1, static_cast<int>(std::ceil(endX - startX)));
+    return { clipX, 0, clipWidth, getHeight() };
+}
+
+TrackContent::TrimHandle TrackContent::getTrimHandleAt(const ClipSlot& slot, float x) const {
+    const auto bounds = getClipBounds(slot).toFloat();
+    const float handleWidth = 6.0f;
+    if (x <= bounds.getX() + handleWidth) {
+        return TrimHandle::Head;
+    }
+    if (x >= bounds.getRight() - handleWidth) {
+        return TrimHandle::Tail;
+    }
+    return TrimHandle::None;
+}
+
+void TrackContent::applyTrim(float x, bool commit) {
+    if (!audioTrack || trimClipId.isEmpty()) {
+        return;
+    }
+    const auto mapper = getMapper();
+    const auto sample = juce::jlimit(trimRange.getStart(), trimRange.getEnd(), mapper.xToSample(x));
+    const bool trimHead = activeTrimHandle == TrimHandle::Head;
+    if (commit) {
+        if (trimHead) {
+            audioTrack->trimClipHead(trimClipId, sample);
+        } else {
+            audioTrack->trimClipTail(trimClipId, sample);
+        }
+        return;
+    }
+    if (trimHead) {
+        audioTrack->previewTrimClipHead(trimClipId, sample);
+    } else {
+        audioTrack->previewTrimClipTail(trimClipId, sample);
+    }
+}
+
+void TrackContent::forwardMouseDown(const juce::MouseEvent& event) {
+    auto* panel = findParentComponentOfClass<TrackContentPanel>();
+    if (panel == nullptr) {
+        return;
+    }
+    const auto panelEvent = event.getEventRelativeTo(panel);
+    selectionManager.mouseDown(panelEvent, panel);
+    if (panelEvent.mods.isShiftDown()) {
+        return;
+    }
+    ViewRangeMapper mapper(edit, static_cast<float>(panel->getWidth()));
+    if (!mapper.isValid()) {
+        // View range and width must be valid to map samples.
+        jassert(false);
+        return;
+    }
+    const auto cursorSample = mapper.xToSample(panelEvent.position.x);
+    selectionManager.getCursorController().setCursorSample(cursorSample);
+}
+
+void TrackContent::applyWaveformScale() {
+    waveformScale = edit.getState().getWaveformScale();
+    repaint();
 }
 
 void TrackContent::selectionChanged() {
@@ -292,9 +483,7 @@ void TrackContent::selectionChanged() {
 
 void TrackContent::setSelectedClipId(const String& clipId) {
     selectedClipId = clipId;
-    for (auto& clipComponent : clipComponents) {
-        clipComponent->setSelected(clipComponent->getClip().getId() == selectedClipId);
-    }
+    repaint();
 }
 
 void TrackContent::clearSelectedClip() {
@@ -302,9 +491,7 @@ void TrackContent::clearSelectedClip() {
         return;
     }
     selectedClipId.clear();
-    for (auto& clipComponent : clipComponents) {
-        clipComponent->setSelected(false);
-    }
+    repaint();
 }
 
 void TrackContent::updateSelectedClipFromSelection() {
@@ -5,29 +5,81 @@
 #include "Core/Edit/Edit.h"
 #include "Gui/Utils/SelectionManager.h"
 #include "Gui/Utils/ViewRangeMapper.h"
-#include "AudioClipComponent.h"
+#include "Components/Track/AudioClip/WaveformPaintStrategy.h"
 #include "Core/Track/AudioTrack.h"
 
+class PeakSource;
+
+/// One track row of the timeline.
+/// Clips are not components: the row paints the visible ones from a start-sorted index and does
+/// its own hit-testing for trim handles, so zooming a track with thousands of clips costs
+/// O(visible clips) and creates no components.
 class TrackContent : public juce::Component,
                      public juce::ValueTree::Listener,
                      private SelectionManager::Listener,
-                     private AudioTrack::Listener {
+                     private AudioTrack::Listener,
+                     private juce::ChangeListener {
 public:
     TrackContent(Edit& edit, SelectionManager& selectionManager, std::shared_ptr<Track> track);
     ~TrackContent() override;
 
+    /// Show another track in this row, so pooled rows can be reused while scrolling.
+    /// @param track track to display (nullptr detaches the row)
+    void setTrack(std::shared_ptr<Track> track);
+
     void updateLayout();
 
     void resized() override;
     void paint(juce::Graphics& g) override;
-    void paintOverChildren(juce::Graphics& g) override;
     void mouseDoubleClick(const juce::MouseEvent& event) override;
+    void mouseMove(const juce::MouseEvent& event) override;
+    void mouseExit(const juce::MouseEvent& event) override;
+    void mouseDown(const juce::MouseEvent& event) override;
+    void mouseDrag(const juce::MouseEvent& event) override;
+    void mouseUp(const juce::MouseEvent& event) override;
     void handleDoubleClick(int64 sample, bool extendSelection);
     void valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property) override;
 
+    /// True when a position lies on a clip, whose clicks this row handles itself.
+    /// @param position position in local coordinates
+    bool isClipAt(juce::Point<float> position) const;
+
 private:
+    struct ClipSlot {
+        const AudioClip* clip = nullptr;
+        int64 start = 0;
+        int64 end = 0;
+        /// Peaks used by the last paint, to catch the switch to the finished peak file (identity only).
+        const PeakSource* lastPaintedPeaks = nullptr;
+        /// True when the last paint of this clip still missed waveform tiles.
+        bool waitingForTiles = false;
+    };
+
+    enum class TrimHandle {
+        None,
+        Head,
+        Tail
+    };
+
     void clipsChanged(AudioTrack& track) override;
-    void rebuildClipComponents();
+    /// Draw the take recording on this track, if any, over the clips.
+    void paintLiveTake(juce::Graphics& g, int64 viewStart, int64 viewEnd) const;
+    /// Repaint clips whose peaks are still being built or whose waveform tiles are rendering,
+    /// and the take recording on this track.
+    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+    void rebuildClipIndex();
+    /// Half-open range of clip slots overlapping a session sample range.
+    std::pair<size_t, size_t> getClipsInRange(int64 startSample, int64 endSample) const;
+    /// Slot under an x position, preferring the selected clip (nullptr when none).
+    const ClipSlot* findClipAt(float x) const;
+    juce::Rectangle<int> getClipBounds(const ClipSlot& slot) const;
+    /// Bounds of the take recording on this track (empty when none).
+    juce::Rectangle<int> getLiveTakeBounds() const;
+    /// Bounds of a session sample range, rounded outwards to whole pixels.
+    juce::Rectangle<int> getRangeBounds(int64 start, int64 end) const;
+    TrimHandle getTrimHandleAt(const ClipSlot& slot, float x) const;
+    void applyTrim(float x, bool commit);
+    void forwardMouseDown(const juce::MouseEvent& event);
     void applyWaveformScale();
     void selectionChanged() override;
     void setSelectedClipId(const String& clipId);
@@ -39,8 +91,21 @@ private:
     SelectionManager& selectionManager;
     std::shared_ptr<Track> track;
     std::shared_ptr<AudioTrack> audioTrack;
-    std::vector<std::unique_ptr<AudioClipComponent>> clipComponents;
+    /// Clips sorted by session start.
+    std::vector<ClipSlot> clipSlots;
+    /// Largest end among clipSlots[0..i], so a binary search finds the first clip reaching a range
+    /// even while a trim preview makes clips overlap.
+    std::vector<int64> maxClipEnds;
+    /// Shared by every clip of the row; it keeps no per-clip state.
+    WaveformPaintStrategy paintStrategy;
+    float waveformScale = 1.0f;
     bool isSelected = false;
     String selectedClipId;
     bool suppressNextCursorClear = false;
+    String trimClipId;
+    TrimHandle activeTrimHandle = TrimHandle::None;
+    /// Clip range when the trim started; drags are clamped to it.
+    juce::Range<int64> trimRange;
+    /// Bounds of the live take at its last update, so a finished take repaints what it covered.
+    juce::Rectangle<int> liveTakeBounds;
 };
@@ -4,9 +4,20 @@
 #include <cmath>
 
 #include "TrackContent.h"
+#include "Components/Track/AudioClip/WaveformTileCache.h"
+#include "Gui/Video/FilmstripCache.h"
 #include "Gui/Utils/CursorController.h"
 #include "Gui/Utils/ViewRangeMapper.h"
 
+namespace {
+const juce::Identifier kCursorSampleId("cursorSample");
+const juce::Identifier kHasSelectionRangeId("hasSelectionRange");
+const juce::Identifier kSelectionStartSampleId("selectionStartSample");
+const juce::Identifier kSelectionEndSampleId("selectionEndSample");
+const juce::Identifier kViewStartSampleFId("viewStartSampleF");
+const juce::Identifier kSamplesPerPixelId("samplesPerPixel");
+} // namespace
+
 // ------------------------ MainComponent Implementation ------------------------
 
 TrackContentPanel::TrackContentPanel(Edit& edit, SelectionManager& selectionManager)
@@ -15,14 +26,14 @@ TrackContentPanel::TrackContentPanel(Edit& edit, SelectionManager& selectionMana
     const auto rulerHeight = edit.getState().getTimelineHeight();
     timelineRuler = std::make_unique<TimelineRuler>(edit, rulerHeight);
     addAndMakeVisible(timelineRuler.get());
+    filmstrip = std::make_unique<VideoFilmstrip>(edit);
+    addAndMakeVisible(filmstrip.get());
     for (const auto& track : edit.getTracks()) {
-        if (!track) {
-            continue;
+        if (track) {
+            rowTracks.push_back(track);
         }
-        auto trackContent = std::make_shared<TrackContent>(edit, selectionManager, track);
-        addAndMakeVisible(*trackContent);
-        trackContentComponents.emplace(track->getId(), std::move(trackContent));
     }
+    rowLayout.update(edit);
     cursorTimeline = std::make_unique<CursorTimeline>(edit, rulerHeight);
     cursorTimeline->setCallbacks({
         [this](int64 previousSample, int64 newSample) {
@@ -34,6 +45,8 @@ TrackContentPanel::TrackContentPanel(Edit& edit, SelectionManager& selectionMana
         }
     });
     addAndMakeVisible(cursorTimeline.get());
+    indicatorOverlay = std::make_unique<TrackIndicatorOverlay>(edit, selectionManager);
+    addAndMakeVisible(indicatorOverlay.get());
     selectionOverlay = std::make_unique<TrackSelectionOverlay>(edit, selectionManager);
     addAndMakeVisible(selectionOverlay.get());
     edit.getState().getRoot().addListener(this);
@@ -44,6 +57,14 @@ TrackContentPanel::~TrackContentPanel() {
     edit.getState().getRoot().removeListener(this);
 }
 
+void TrackContentPanel::setVisibleSpan(juce::Range<int> span) {
+    if (visibleSpan == span) {
+        return;
+    }
+    visibleSpan = span;
+    updateVisibleRows();
+}
+
 void TrackContentPanel::resized() {
     updateLayout();
 }
@@ -53,31 +74,92 @@ void TrackContentPanel::updateLayout() {
     auto fullBounds = getLocalBounds();
     if (cursorTimeline != nullptr) {
         cursorTimeline->setRulerHeight(rulerHeight);
-        cursorTimeline->setBounds(fullBounds);
+        cursorTimeline->setBounds(fullBounds.withHeight(rulerHeight));
     }
     auto bounds = fullBounds;
     if (timelineRuler != nullptr) {
         timelineRuler->setRulerHeight(rulerHeight);
         timelineRuler->setBounds(bounds.removeFromTop(rulerHeight));
     }
+    if (filmstrip != nullptr) {
+        const auto filmstripHeight = edit.getState().getFilmstripHeight();
+        filmstrip->setBounds(bounds.removeFromTop(filmstripHeight));
+        filmstrip->setVisible(filmstripHeight > 0);
+    }
     const auto viewWidth = std::max(1, bounds.getWidth());
     if (std::abs(edit.getState().getViewWidthPixels() - static_cast<float>(viewWidth)) > 0.5f) {
         edit.getState().setViewWidthPixels(static_cast<float>(viewWidth), nullptr);
     }
+    if (indicatorOverlay != nullptr) {
+        indicatorOverlay->setBounds(bounds);
+    }
     if (selectionOverlay != nullptr) {
         selectionOverlay->setBounds(bounds);
         selectionOverlay->toFront(false);
     }
-    for (const auto& track : edit.getTracks()) {
-        if (!track) {
+    tracksArea = bounds;
+    for (const auto& [rowIndex, row] : activeRows) {
+        row->setBounds(getRowBounds(rowIndex));
+        row->updateLayout();
+    }
+    updateVisibleRows();
+}
+
+juce::Rectangle<int> TrackContentPanel::getRowBounds(int rowIndex) const {
+    return { tracksArea.getX(),
+             tracksArea.getY() + rowLayout.getRowY(rowIndex),
+             tracksArea.getWidth(),
+             rowLayout.getRowHeight(rowIndex) };
+}
+
+void TrackContentPanel::updateVisibleRows() {
+    // Before the viewport reports a span, treat the whole panel as visible.
+    const auto span = visibleSpan.value_or(juce::Range<int>(0, getHeight()));
+    const auto tracksTop = tracksArea.getY();
+    auto visibleRows = rowLayout.getRowsInSpan(span.getStart() - tracksTop, span.getEnd() - tracksTop);
+    if (!visibleRows.isEmpty()) {
+        // One row of overscan each side hides row creation while scrolling.
+        visibleRows = { std::max(0, visibleRows.getStart() - kOverscanRows),
+                        std::min(rowLayout.getNumRows(), visibleRows.getEnd() + kOverscanRows) };
+    }
+
+    for (auto it = activeRows.begin(); it != activeRows.end();) {
+        if (visibleRows.contains(it->first)) {
+            ++it;
             continue;
         }
-        auto it = trackContentComponents.find(track->getId());
-        if (it == trackContentComponents.end()) {
+        auto row = std::move(it->second);
+        it = activeRows.erase(it);
+        row->setVisible(false);
+        row->setTrack(nullptr);
+        rowPool.push_back(std::move(row));
+    }
+
+    std::vector<TrackIndicatorOverlay::TrackRow> overlayRows;
+    for (int rowIndex = visibleRows.getStart(); rowIndex < visibleRows.getEnd(); ++rowIndex) {
+        const auto rowBounds = getRowBounds(rowIndex);
+        const auto& track = rowTracks[static_cast<size_t>(rowIndex)];
+        overlayRows.push_back({ track->getId(), rowBounds.getY() - tracksTop, rowBounds.getHeight() });
+        if (activeRows.find(rowIndex) != activeRows.end()) {
             continue;
         }
-        it->second->setBounds(bounds.removeFromTop(std::max(1, static_cast<int>(track->getHeight()))));
-        it->second->updateLayout();
+        std::unique_ptr<TrackContent> row;
+        if (rowPool.empty()) {
+            row = std::make_unique<TrackContent>(edit, selectionManager, track);
+            // Rows sit behind the cursor and selection layers.
+            addChildComponent(row.get(), 0);
+        } else {
+            row = std::move(rowPool.back());
+            rowPool.pop_back();
+            row->setTrack(track);
+        }
+        row->setBounds(rowBounds);
+        row->updateLayout();
+        row->setVisible(true);
+        activeRows.emplace(rowIndex, std::move(row));
+    }
+    if (indicatorOverlay != nullptr) {
+        indicatorOverlay->setTrackRows(std::move(overlayRows));
     }
 }
 
@@ -157,7 +239,22 @@ void TrackContentPanel::paint(juce::Graphics& g) {
     g.restoreState();
 }
 
-void TrackContentPanel::valueTreePropertyChanged(juce::ValueTree&, const juce::Identifier&) {
+void TrackContentPanel::valueTreePropertyChanged(juce::ValueTree&, const juce::Identifier& property) {
+    // Cursor and selection moves only touch the indicator layer, not the layout.
+    if (property == kCursorSampleId
+        || property == kHasSelectionRangeId
+        || property == kSelectionStartSampleId
+        || property == kSelectionEndSampleId) {
+        if (indicatorOverlay != nullptr) {
+            indicatorOverlay->refresh();
+        }
+        return;
+    }
+    if (property == kViewStartSampleFId || property == kSamplesPerPixelId) {
+        // Tiles and strips queued for the previous view are skipped; the next paint requests what is visible now.
+        WaveformTileCache::get().advanceViewGeneration();
+        FilmstripCache::get().advanceViewGeneration();
+    }
     triggerAsyncUpdate();
 }
 
@@ -173,21 +270,15 @@ void TrackContentPanel::timerCallback() {
         return;
     }
 
-    if (cursorTimeline != nullptr) {
-        cursorTimeline->repaint();
-    }
-
-
     const auto playheadSample = transport->getPlayheadSample();
     selectionManager.getCursorController().onPlaybackTick(playheadSample);
 
-    for (const auto& [trackId, trackContent] : trackContentComponents) {
-        if (!trackContent) {
-            continue;
-        }
-        if (selectionManager.isSelected(trackId)) {
-            trackContent->repaint();
-        }
+    // Only the strips under moved indicators are invalidated; clips repaint from their tile caches.
+    if (cursorTimeline != nullptr) {
+        cursorTimeline->updatePlayhead();
+    }
+    if (indicatorOverlay != nullptr) {
+        indicatorOverlay->refresh();
     }
 }
 
@@ -2,14 +2,25 @@
 
 #include <JuceHeader.h>
 
+#include <map>
+#include <optional>
+
 #include "Core/Edit/Edit.h"
 #include "Core/Edit/EditState.h"
 #include "CursorTimeline.h"
 #include "TimelineRuler.h"
+#include "TrackIndicatorOverlay.h"
 #include "TrackSelectionOverlay.h"
+#include "VideoFilmstrip.h"
 #include "Gui/Utils/SelectionManager.h"
+#include "Gui/Utils/TrackRowLayout.h"
 #include "Gui/Utils/ViewRangeMapper.h"
 
+class TrackContent;
+
+/// Timeline area: ruler, video filmstrip lane, track rows and the overlays drawn above them.
+/// Track rows are virtualised: only rows inside the visible span (plus overscan) get a
+/// TrackContent, taken from a pool of recycled components.
 class TrackContentPanel : public juce::Component,
                           public juce::ValueTree::Listener,
                           private juce::AsyncUpdater,
@@ -22,7 +33,16 @@ public:
     void paint(juce::Graphics& g) override;
     void valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property) override;
 
+    /// Update the part of the panel shown by the enclosing viewport.
+    /// @param span visible vertical range in panel coordinates
+    void setVisibleSpan(juce::Range<int> span);
+
 private:
+    static constexpr int kOverscanRows = 1;
+
+    juce::Rectangle<int> getRowBounds(int rowIndex) const;
+    void updateVisibleRows();
+
     void handleAsyncUpdate() override;
     void timerCallback() override;
     ViewRangeMapper getMapper(float width) const;
@@ -30,9 +50,18 @@ private:
 
     std::unique_ptr<CursorTimeline> cursorTimeline;
     std::unique_ptr<TimelineRuler> timelineRuler;
+    std::unique_ptr<VideoFilmstrip> filmstrip;
+    std::unique_ptr<TrackIndicatorOverlay> indicatorOverlay;
     std::unique_ptr<TrackSelectionOverlay> selectionOverlay;
 
     Edit& edit;
     SelectionManager& selectionManager;
-    std::map<String, std::shared_ptr<class TrackContent>> trackContentComponents;
+    std::vector<std::shared_ptr<Track>> rowTracks;
+    TrackRowLayout rowLayout;
+    juce::Rectangle<int> tracksArea;
+    std::optional<juce::Range<int>> visibleSpan;
+    /// Rows currently shown, keyed by row index.
+    std::map<int, std::unique_ptr<TrackContent>> activeRows;
+    /// Hidden rows ready to be given another track.
+    std::vector<std::unique_ptr<TrackContent>> rowPool;
 };
@@ -10,25 +10,13 @@ TrackHeader::TrackHeader(Track& track,
                          Edit& edit,
                          SelectionManager& selectionManager,
                          TrackCommandManager& trackCommandManager)
-    : track(track),
-      edit(edit),
+    : edit(edit),
       selectionManager(selectionManager),
       trackCommandManager(trackCommandManager) {
-    trackId = track.getId();
-    isSelected = selectionManager.isSelected(trackId);
     selectionManager.addListener(this);
-    // defining properties from track
-    if (const auto outputTrack = track.getOutput().lock())
-        outputTrackName = outputTrack->getName();
-    else
-        outputTrackName = "";
-
-    // trackColour
-    trackColour = track.getColour();
 
     // trackName (editable)
     trackName = std::make_unique<EditableText>("", juce::Colour(0xFFF0EEFA), juce::Colour(0xFF2F2C3F));
-    trackName->setContent(track.getName());
     addAndMakeVisible(trackName.get());
 
     selector = std::make_unique<SelectableList>();
@@ -47,6 +35,10 @@ TrackHeader::TrackHeader(Track& track,
     addAndMakeVisible(soloToggle.get());
     addAndMakeVisible(activeToggle.get());
 
+    meter = std::make_unique<VuMeter>();
+    addAndMakeVisible(meter.get());
+
+    // callbacks read trackId when fired, so they follow setTrack()
     armedToggle->onStateRequested([this](MultiStateToggleButton::StateId) {
         this->trackCommandManager.toggleArmState(trackId);
     });
@@ -66,6 +58,37 @@ TrackHeader::TrackHeader(Track& track,
         this->trackCommandManager.toggleMuteState(trackId);
     });
 
+    setTrack(track);
+
+    // left vertical line defined in paint()
+    // trackOutputName defined in paint()
+}
+
+void TrackHeader::setTrack(Track& newTrack) {
+    if (track == &newTrack) {
+        return;
+    }
+    if (trackStateNode.isValid()) {
+        trackStateNode.removeListener(this);
+    }
+    track = &newTrack;
+    trackId = newTrack.getId();
+    isSelected = selectionManager.isSelected(trackId);
+    // defining properties from track
+    if (const auto outputTrack = newTrack.getOutput().lock())
+        outputTrackName = outputTrack->getName();
+    else
+        outputTrackName = "";
+
+    // trackColour
+    trackColour = newTrack.getColour();
+    trackName->setContent(newTrack.getName());
+
+    // A pooled header must not show the previous track's levels decaying.
+    meterReading = {};
+    meterSilentFor = 0.0;
+    meter->reset();
+
     trackStateNode = edit.getState().getTrackState(trackId);
     if (!trackStateNode.isValid()) {
         edit.getState().ensureTrackState(trackId);
@@ -75,9 +98,7 @@ TrackHeader::TrackHeader(Track& track,
         trackStateNode.addListener(this);
     }
     updateToggleStates();
-
-    // left vertical line defined in paint()
-    // trackOutputName defined in paint()
+    repaint();
 }
 
 TrackHeader::~TrackHeader() {
@@ -88,7 +109,10 @@ TrackHeader::~TrackHeader() {
 }
 
 void TrackHeader::resized() {
-    const auto b = getLocalBounds();
+    auto b = getLocalBounds();
+
+    /// Level meter along the right edge
+    meter->setBounds(b.removeFromRight(kMeterWidth + 6).reduced(0, 8).withTrimmedRight(6));
 
     //////////////////// Top line, with track name and toggles
     /// Top Line
@@ -166,6 +190,28 @@ void TrackHeader::setTrackName(const String &name) const {
     trackName->setName(name);
 }
 
+void TrackHeader::updateMeter(double elapsedSeconds) {
+    // Looked up every tick so a graph rebuild with a new tap is picked up.
+    const auto tap = edit.getMeters()->find(trackId);
+    if (tap != nullptr && tap->read(meterReading)) {
+        meterSilentFor = 0.0;
+    } else {
+        meterSilentFor += elapsedSeconds;
+        if (meterSilentFor > kStaleReadingSeconds) {
+            meterReading = {};
+        }
+    }
+
+    // One bar per track: the loudest channel drives it.
+    float rms = 0.0f;
+    float truePeak = 0.0f;
+    for (int c = 0; c < meterReading.numChannels; ++c) {
+        rms = std::max(rms, meterReading.rms[static_cast<size_t>(c)]);
+        truePeak = std::max(truePeak, meterReading.truePeak[static_cast<size_t>(c)]);
+    }
+    meter->pushLevels(rms, truePeak, elapsedSeconds);
+}
+
 void TrackHeader::valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property) {
     juce::ignoreUnused(property);
     if (trackStateNode.isValid() && tree == trackStateNode) {
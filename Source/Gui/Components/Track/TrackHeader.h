@@ -8,6 +8,7 @@
 #include "Gui/Utils/SelectionManager.h"
 #include "../Common/ui/EditableText.h"
 #include "../Common/ui/SelectableList.h"
+#include "../Common/tools/VuMeter.h"
 #include "HeaderTrackButtons/ArmedToggle.h"
 #include "HeaderTrackButtons/InputMonitoringToggle.h"
 #include "HeaderTrackButtons/MuteToggle.h"
@@ -26,7 +27,18 @@ public:
     void mouseDown(const juce::MouseEvent& event) override;
 
     void setTrackName(const String &name) const;
+
+    /// Show another track in this header, so pooled headers can be reused while scrolling.
+    /// @param track track to display
+    void setTrack(Track& track);
+
+    /// Pull the latest levels of this track's meter tap into the header meter.
+    /// @param elapsedSeconds time since the previous update
+    void updateMeter(double elapsedSeconds);
 private:
+    static constexpr int kMeterWidth = 6;
+    static constexpr double kStaleReadingSeconds = 0.25;
+
     void selectionChanged() override;
     void valueTreePropertyChanged(juce::ValueTree& tree, const juce::Identifier& property) override;
     void updateToggleStates();
@@ -42,12 +54,14 @@ private:
     String outputTrackName;
 
     // track ref
-    Track& track;
+    Track* track = nullptr;
     Edit& edit;
     SelectionManager& selectionManager;
     TrackCommandManager& trackCommandManager;
     bool isSelected = false;
     juce::ValueTree trackStateNode;
+    MeterReading meterReading;
+    double meterSilentFor = 0.0;
 
     // subComponents
     std::unique_ptr<EditableText> trackName;
@@ -56,4 +70,5 @@ private:
     std::unique_ptr<InputMonitoringToggle> inputMonitoringToggle;
     std::unique_ptr<SoloToggle> soloToggle;
     std::unique_ptr<MuteToggle> activeToggle;
+    std::unique_ptr<VuMeter> meter;
 };
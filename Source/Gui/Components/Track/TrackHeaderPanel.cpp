@@ -1,5 +1,7 @@
 #include "TrackHeaderPanel.h"
 
+#include <algorithm>
+
 #include "TrackHeader.h"
 #include "Gui/Style/Font.h"
 
@@ -8,23 +10,85 @@
 TrackHeaderPanel::TrackHeaderPanel(Edit& edit, SelectionManager& selectionManager, TrackCommandManager& trackCommandManager)
     : edit(edit),
       selectionManager(selectionManager),
-      trackCommandManager(trackCommandManager),
-      tracks(edit.getTracks()),
-      trackHeaderComponents(std::map<String, std::shared_ptr<TrackHeader> >()) {
-    for (const auto& track: tracks) {
-        auto trackHeader = std::make_shared<TrackHeader>(*track, edit, selectionManager, trackCommandManager);
-        addAndMakeVisible(*trackHeader);
-        trackHeaderComponents.emplace(track->getId(), std::move(trackHeader));
+      trackCommandManager(trackCommandManager) {
+    for (const auto& track : edit.getTracks()) {
+        if (track) {
+            rowTracks.push_back(track);
+        }
+    }
+    rowLayout.update(edit);
+    lastMeterUpdateMs = juce::Time::getMillisecondCounterHiRes();
+    startTimerHz(kMeterRefreshHz);
+}
+
+TrackHeaderPanel::~TrackHeaderPanel() = default;
+
+void TrackHeaderPanel::timerCallback() {
+    const auto nowMs = juce::Time::getMillisecondCounterHiRes();
+    const auto elapsedSeconds = (nowMs - lastMeterUpdateMs) * 0.001;
+    lastMeterUpdateMs = nowMs;
+    for (const auto& [rowIndex, row] : activeRows) {
+        row->updateMeter(elapsedSeconds);
     }
 }
 
 void TrackHeaderPanel::resized() {
-    auto bounds = getLocalBounds().removeFromLeft(265);
-    const auto rulerHeight = edit.getState().getTimelineHeight();
-    bounds.removeFromTop(rulerHeight);
-    for (const auto& track : tracks) {
-        const auto trackHeader = trackHeaderComponents.at(track->getId());
-        trackHeader->setBounds(bounds.removeFromTop(static_cast<int>(track->getHeight())));
+    for (const auto& [rowIndex, row] : activeRows) {
+        row->setBounds(getRowBounds(rowIndex));
+    }
+    updateVisibleRows();
+}
+
+void TrackHeaderPanel::setVisibleSpan(juce::Range<int> span) {
+    if (visibleSpan == span) {
+        return;
+    }
+    visibleSpan = span;
+    updateVisibleRows();
+}
+
+juce::Rectangle<int> TrackHeaderPanel::getRowBounds(int rowIndex) const {
+    const auto rowsTop = edit.getState().getTrackRowsTop();
+    return { 0, rowsTop + rowLayout.getRowY(rowIndex), std::min(265, getWidth()), rowLayout.getRowHeight(rowIndex) };
+}
+
+void TrackHeaderPanel::updateVisibleRows() {
+    // Before the viewport reports a span, treat the whole panel as visible.
+    const auto span = visibleSpan.value_or(juce::Range<int>(0, getHeight()));
+    const auto rowsTop = edit.getState().getTrackRowsTop();
+    auto visibleRows = rowLayout.getRowsInSpan(span.getStart() - rowsTop, span.getEnd() - rowsTop);
+    if (!visibleRows.isEmpty()) {
+        visibleRows = { std::max(0, visibleRows.getStart() - kOverscanRows),
+                        std::min(rowLayout.getNumRows(), visibleRows.getEnd() + kOverscanRows) };
+    }
+
+    for (auto it = activeRows.begin(); it != activeRows.end();) {
+        if (visibleRows.contains(it->first)) {
+            ++it;
+            continue;
+        }
+        it->second->setVisible(false);
+        rowPool.push_back(std::move(it->second));
+        it = activeRows.erase(it);
+    }
+
+    for (int rowIndex = visibleRows.getStart(); rowIndex < visibleRows.getEnd(); ++rowIndex) {
+        if (activeRows.find(rowIndex) != activeRows.end()) {
+            continue;
+        }
+        auto& track = *rowTracks[static_cast<size_t>(rowIndex)];
+        std::unique_ptr<TrackHeader> row;
+        if (rowPool.empty()) {
+            row = std::make_unique<TrackHeader>(track, edit, selectionManager, trackCommandManager);
+            addChildComponent(row.get());
+        } else {
+            row = std::move(rowPool.back());
+            rowPool.pop_back();
+            row->setTrack(track);
+        }
+        row->setBounds(getRowBounds(rowIndex));
+        row->setVisible(true);
+        activeRows.emplace(rowIndex, std::move(row));
     }
 }
 
@@ -42,4 +106,14 @@ void TrackHeaderPanel::paint(juce::Graphics &g) {
     g.setColour(juce::Colour(0xFFC8A5FF));
     const auto y = static_cast<float>(rulerHeight - 1);
     g.drawLine(0.0f, y, static_cast<float>(getWidth()), y, 1.0f);
+
+    const auto filmstripHeight = edit.getState().getFilmstripHeight();
+    if (filmstripHeight > 0) {
+        auto filmstripBounds = getLocalBounds().removeFromLeft(265).withTrimmedTop(rulerHeight).removeFromTop(filmstripHeight);
+        g.setColour(juce::Colour(0xFF2F2C3F));
+        g.drawText("Video", filmstripBounds.reduced(8, 0), juce::Justification::centredLeft, false);
+        g.setColour(juce::Colour(0xFFC8A5FF));
+        const auto filmstripY = static_cast<float>(filmstripBounds.getBottom() - 1);
+        g.drawLine(0.0f, filmstripY, static_cast<float>(getWidth()), filmstripY, 1.0f);
+    }
 }
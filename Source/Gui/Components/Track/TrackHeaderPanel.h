@@ -1,25 +1,52 @@
 #pragma once
 
 #include <JuceHeader.h>
+
+#include <map>
+#include <optional>
+
 #include "Core/Track/Track.h"
 #include "Core/Edit/Edit.h"
 #include "Command/TrackCommandManager.h"
 #include "Gui/Utils/SelectionManager.h"
+#include "Gui/Utils/TrackRowLayout.h"
 
 class TrackHeader;
 
-class TrackHeaderPanel : public juce::Component {
+/// Column of track headers beside the timeline, virtualised like TrackContentPanel.
+/// One timer refreshes the level meters of the visible headers.
+class TrackHeaderPanel : public juce::Component,
+                         private juce::Timer {
 public:
     TrackHeaderPanel(Edit& edit, SelectionManager& selectionManager, TrackCommandManager& trackCommandManager);
+    ~TrackHeaderPanel() override;
 
     void resized() override;
 
     void paint(juce::Graphics& g) override;
+
+    /// Update the part of the panel shown by the enclosing viewport.
+    /// @param span visible vertical range in panel coordinates
+    void setVisibleSpan(juce::Range<int> span);
 private:
+    static constexpr int kOverscanRows = 1;
+    static constexpr int kMeterRefreshHz = 30;
+
+    void timerCallback() override;
+
+    juce::Rectangle<int> getRowBounds(int rowIndex) const;
+    void updateVisibleRows();
+
     Edit& edit;
     SelectionManager& selectionManager;
     TrackCommandManager& trackCommandManager;
-    std::vector<std::shared_ptr<Track>>& tracks;
+    std::vector<std::shared_ptr<Track>> rowTracks;
+    TrackRowLayout rowLayout;
+    std::optional<juce::Range<int>> visibleSpan;
+    double lastMeterUpdateMs = 0.0;
 
-    std::map<String, std::shared_ptr<TrackHeader>> trackHeaderComponents;
+    /// Headers currently shown, keyed by row index.
+    std::map<int, std::unique_ptr<TrackHeader>> activeRows;
+    /// Hidden headers ready to be given another track.
+    std::vector<std::unique_ptr<TrackHeader>> rowPool;
 };
@@ -0,0 +1,164 @@
+#include "TrackIndicatorOverlay.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+/// Extra pixels invalidated around a line so antialiasing is cleared too.
+constexpr int kLineMargin = 2;
+constexpr uint32 kCursorBlinkMs = 350;
+} // namespace
+
+TrackIndicatorOverlay::TrackIndicatorOverlay(const Edit& edit, SelectionManager& selectionManager)
+    : edit(edit),
+      selectionManager(selectionManager) {
+    setInterceptsMouseClicks(false, false);
+    selectionManager.addListener(this);
+}
+
+TrackIndicatorOverlay::~TrackIndicatorOverlay() {
+    selectionManager.removeListener(this);
+}
+
+void TrackIndicatorOverlay::paint(juce::Graphics& g) {
+    for (const auto& row : indicators.selectedRows) {
+        if (indicators.selectionX.has_value()) {
+            const auto selection = *indicators.selectionX;
+            g.setColour(juce::Colour::fromString("#99000000"));
+            g.fillRect(selection.getStart(), static_cast<float>(row.getStart()),
+                       std::max(1.0f, selection.getLength()), static_cast<float>(row.getLength()));
+        } else if (indicators.cursorX.has_value()) {
+            g.setColour(juce::Colour::fromString("#FF998893"));
+            g.drawLine(*indicators.cursorX, static_cast<float>(row.getStart()),
+                       *indicators.cursorX, static_cast<float>(row.getEnd()), 1.0f);
+        }
+    }
+
+    if (indicators.playheadX.has_value()) {
+        g.setColour(juce::Colour::fromRGBA(76, 44, 126, 120));
+        g.drawLine(*indicators.playheadX, 0.0f, *indicators.playheadX, static_cast<float>(getHeight()), 1.0f);
+    }
+}
+
+void TrackIndicatorOverlay::resized() {
+    indicators = computeIndicators();
+    repaint();
+}
+
+void TrackIndicatorOverlay::setTrackRows(std::vector<TrackRow> newRows) {
+    rows = std::move(newRows);
+    refresh();
+}
+
+void TrackIndicatorOverlay::refresh() {
+    auto next = computeIndicators();
+    if (next == indicators) {
+        return;
+    }
+    if (next.selectedRows != indicators.selectedRows) {
+        // Track selection changed: rare enough to repaint the whole layer.
+        repaint();
+    } else {
+        if (next.cursorX != indicators.cursorX) {
+            repaintColumn(indicators.cursorX);
+            repaintColumn(next.cursorX);
+        }
+        if (next.selectionX != indicators.selectionX) {
+            repaintSelectionChange(indicators.selectionX, next.selectionX);
+        }
+    }
+    if (next.playheadX != indicators.playheadX) {
+        repaintColumn(indicators.playheadX);
+        repaintColumn(next.playheadX);
+    }
+    indicators = std::move(next);
+}
+
+void TrackIndicatorOverlay::selectionChanged() {
+    refresh();
+}
+
+TrackIndicatorOverlay::Indicators TrackIndicatorOverlay::computeIndicators() const {
+    Indicators next;
+    const ViewRangeMapper mapper(edit, static_cast<float>(getWidth()));
+    if (!mapper.isValid()) {
+        return next;
+    }
+    const auto transport = edit.getTransport();
+    if (!transport) {
+        return next;
+    }
+
+    if (transport->isPlaying()) {
+        const auto playheadSample = transport->getPlayheadSample();
+        if (playheadSample >= mapper.getViewStartSample() && playheadSample <= mapper.getViewEndSample()) {
+            next.playheadX = std::floor(mapper.sampleToX(playheadSample)) + 0.5f;
+        }
+    }
+
+    for (const auto& row : rows) {
+        if (selectionManager.isSelected(row.trackId)) {
+            next.selectedRows.emplace_back(row.y, row.y + row.height);
+        }
+    }
+    if (next.selectedRows.empty()) {
+        return next;
+    }
+
+    const auto& state = edit.getState();
+    if (state.hasSelectionRange()) {
+        const auto selectionRange = selectionManager.getSelectionRangeSamples();
+        if (!selectionRange.has_value()) {
+            return next;
+        }
+        const auto rangeStart = std::min(selectionRange->first, selectionRange->second);
+        const auto rangeEnd = std::max(selectionRange->first, selectionRange->second);
+        const auto [clampedStart, clampedEnd] = mapper.clampRangeToView(rangeStart, rangeEnd);
+        if (clampedEnd > clampedStart) {
+            const float startX = mapper.sampleToX(clampedStart);
+            const float endX = mapper.sampleToX(clampedEnd);
+            next.selectionX = juce::Range<float>(std::min(startX, endX), std::max(startX, endX));
+            return next;
+        }
+    }
+
+    const auto cursorSample = state.getCursorSample();
+    if (cursorSample < mapper.getViewStartSample() || cursorSample > mapper.getViewEndSample()) {
+        return next;
+    }
+    // The cursor blinks: it is only shown on odd ticks.
+    const auto tick = juce::Time::getMillisecondCounter() / kCursorBlinkMs;
+    if ((tick % 2) != 0) {
+        next.cursorX = mapper.sampleToX(cursorSample);
+    }
+    return next;
+}
+
+void TrackIndicatorOverlay::repaintColumn(std::optional<float> x) {
+    if (!x.has_value()) {
+        return;
+    }
+    const auto left = static_cast<int>(std::floor(*x)) - kLineMargin;
+    repaint(left, 0, 2 * kLineMargin + 1, getHeight());
+}
+
+void TrackIndicatorOverlay::repaintSelectionChange(std::optional<juce::Range<float>> previous,
+                                                   std::optional<juce::Range<float>> next) {
+    const auto repaintSpan = [this](float start, float end) {
+        const auto left = static_cast<int>(std::floor(std::min(start, end))) - kLineMargin;
+        const auto right = static_cast<int>(std::ceil(std::max(start, end))) + kLineMargin;
+        repaint(left, 0, right - left, getHeight());
+    };
+    if (!previous.has_value() || !next.has_value()) {
+        const auto& span = previous.has_value() ? *previous : *next;
+        repaintSpan(span.getStart(), std::max(span.getEnd(), span.getStart() + 1.0f));
+        return;
+    }
+    // Dragging an edge only changes the strip between its old and new positions.
+    if (previous->getStart() != next->getStart()) {
+        repaintSpan(previous->getStart(), next->getStart());
+    }
+    if (previous->getEnd() != next->getEnd()) {
+        repaintSpan(previous->getEnd(), next->getEnd());
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <optional>
+
+#include "Core/Edit/Edit.h"
+#include "Gui/Utils/SelectionManager.h"
+#include "Gui/Utils/ViewRangeMapper.h"
+
+/// Lightweight layer over the track contents drawing the playhead, edit cursor and selection range.
+/// refresh() compares the indicators with the last painted ones and only invalidates what moved,
+/// so the clips and waveforms underneath repaint in thin strips rather than as a whole.
+class TrackIndicatorOverlay : public juce::Component,
+                              private SelectionManager::Listener {
+public:
+    /// Vertical extent of a track, in overlay coordinates.
+    struct TrackRow {
+        String trackId;
+        int y = 0;
+        int height = 0;
+    };
+
+    TrackIndicatorOverlay(const Edit& edit, SelectionManager& selectionManager);
+    ~TrackIndicatorOverlay() override;
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+    /// Update the track rows the cursor and selection are drawn in.
+    /// @param rows rows in display order
+    void setTrackRows(std::vector<TrackRow> rows);
+
+    /// Recompute the indicators and invalidate the areas that changed.
+    void refresh();
+
+private:
+    struct Indicators {
+        std::optional<float> playheadX;
+        std::optional<float> cursorX;
+        std::optional<juce::Range<float>> selectionX;
+        /// Vertical ranges of the selected tracks.
+        std::vector<juce::Range<int>> selectedRows;
+
+        bool operator==(const Indicators& other) const = default;
+    };
+
+    void selectionChanged() override;
+    Indicators computeIndicators() const;
+    void repaintColumn(std::optional<float> x);
+    void repaintSelectionChange(std::optional<juce::Range<float>> previous, std::optional<juce::Range<float>> next);
+
+    const Edit& edit;
+    SelectionManager& selectionManager;
+    std::vector<TrackRow> rows;
+    /// Indicators as last painted (or about to be).
+    Indicators indicators;
+};
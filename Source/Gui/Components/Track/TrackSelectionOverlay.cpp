@@ -1,7 +1,6 @@
 #include "TrackSelectionOverlay.h"
 
 #include "TrackContent.h"
-#include "AudioClipComponent.h"
 #include "CursorTimeline.h"
 #include "TimelineRuler.h"
 #include "Gui/Utils/CursorController.h"
@@ -19,7 +18,12 @@ bool TrackSelectionOverlay::hitTest(int x, int y) {
     if (underlying == nullptr) {
         return false;
     }
-    return dynamic_cast<AudioClipComponent*>(underlying) == nullptr;
+    if (auto* trackContent = dynamic_cast<TrackContent*>(underlying)) {
+        // Clips are hit-tested by the track row itself, which handles their trims and double-clicks.
+        const auto trackPoint = underlying->getLocalPoint(getParentComponent(), parentPoint);
+        return !trackContent->isClipAt(trackPoint.toFloat());
+    }
+    return true;
 }
 
 void TrackSelectionOverlay::mouseDown(const juce::MouseEvent& event) {
@@ -30,7 +34,8 @@ void TrackSelectionOverlay::mouseDown(const juce::MouseEvent& event) {
     if (findTrackContentAt(parentPoint) == nullptr) {
         return;
     }
-    selectionManager.mouseDown(event, this);
+    // Track rows are located in panel coordinates, below the ruler and the filmstrip lane.
+    selectionManager.mouseDown(event, getParentComponent());
     if (event.mods.isShiftDown()) {
         return;
     }
@@ -45,15 +50,15 @@ void TrackSelectionOverlay::mouseDown(const juce::MouseEvent& event) {
 }
 
 void TrackSelectionOverlay::mouseDrag(const juce::MouseEvent& event) {
-    selectionManager.mouseDrag(event, this);
+    selectionManager.mouseDrag(event, getParentComponent());
 }
 
 void TrackSelectionOverlay::mouseMove(const juce::MouseEvent& event) {
-    selectionManager.mouseMove(event, this);
+    selectionManager.mouseMove(event, getParentComponent());
 }
 
 void TrackSelectionOverlay::mouseEnter(const juce::MouseEvent& event) {
-    selectionManager.mouseEnter(event, this);
+    selectionManager.mouseEnter(event, getParentComponent());
 }
 
 void TrackSelectionOverlay::mouseUp(const juce::MouseEvent&) {
@@ -105,7 +110,10 @@ juce::Component* TrackSelectionOverlay::findUnderlyingComponent(juce::Point<int>
             continue;
         }
         auto localPoint = parentPoint - child->getPosition();
-        return child->getComponentAt(localPoint.x, localPoint.y);
+        // Layers that ignore the mouse, like the indicator overlay, let the search continue below.
+        if (auto* hit = child->getComponentAt(localPoint.x, localPoint.y)) {
+            return hit;
+        }
     }
     return nullptr;
 }
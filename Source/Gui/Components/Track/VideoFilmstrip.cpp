@@ -0,0 +1,106 @@
+#include "VideoFilmstrip.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Gui/Video/FilmstripCache.h"
+
+VideoFilmstrip::VideoFilmstrip(const Edit& edit)
+    : edit(edit) {
+    setOpaque(true);
+    FilmstripCache::get().addChangeListener(this);
+}
+
+VideoFilmstrip::~VideoFilmstrip() {
+    FilmstripCache::get().removeChangeListener(this);
+}
+
+void VideoFilmstrip::paint(juce::Graphics& g) {
+    g.fillAll(juce::Colour(0xFF2F2C3F));
+    waitingForStrips = false;
+    const auto frameRate = static_cast<double>(edit.getFrameRate());
+    if (frameRate <= 0.0 || getWidth() <= 0 || getHeight() <= 0 || edit.getState().getSamplesPerPixel() <= 0.0) {
+        return;
+    }
+    const auto transport = edit.getTransport();
+    const auto sampleRate = transport ? transport->getSampleRate() : 48000.0;
+    for (const auto& clip : edit.getVideo().getClips()) {
+        paintClip(g, clip, sampleRate / frameRate);
+    }
+    g.setColour(juce::Colour(0xFFC8A5FF));
+    const auto y = static_cast<float>(getHeight()) - 0.5f;
+    g.drawLine(0.0f, y, static_cast<float>(getWidth()), y, 1.0f);
+}
+
+void VideoFilmstrip::paintClip(juce::Graphics& g, const VideoClip& clip, double samplesPerFrame) {
+    const auto& file = clip.getFile();
+    if (file == nullptr) {
+        return;
+    }
+    const auto& state = edit.getState();
+    const auto samplesPerPixel = state.getSamplesPerPixel();
+    const auto viewStartSample = state.getViewStartSampleF();
+    const auto viewEndSample = viewStartSample + samplesPerPixel * getWidth();
+    const auto frameToX = [&](int64 timelineFrame) {
+        return static_cast<float>((static_cast<double>(timelineFrame) * samplesPerFrame - viewStartSample) / samplesPerPixel);
+    };
+
+    // Visible part of the clip, in frames from the start of its file.
+    const auto inFrame = clip.getInFrame();
+    auto lastVisibleFrame = static_cast<int64>(std::ceil(viewEndSample / samplesPerFrame));
+    if (clip.getOutFrame() >= 0) {
+        lastVisibleFrame = std::min(lastVisibleFrame, clip.getOutFrame());
+    }
+    const auto firstFrame = std::max(inFrame, static_cast<int64>(std::floor(viewStartSample / samplesPerFrame))) - inFrame;
+    const auto lastFrame = lastVisibleFrame - inFrame;
+    if (lastFrame < firstFrame) {
+        return;
+    }
+
+    const auto height = static_cast<float>(getHeight());
+    const auto thumbnailWidth = height * FilmstripCache::kThumbnailWidth / FilmstripCache::kThumbnailHeight;
+    const auto pixelsPerFrame = static_cast<float>(samplesPerFrame / samplesPerPixel);
+    const auto level = FilmstripCache::getLevelForSpacing(thumbnailWidth / pixelsPerFrame);
+    // Thumbnails are at most a thumbnail width apart; each is cropped to its spacing.
+    const auto drawWidth = std::min(thumbnailWidth, static_cast<float>(int64 { 1 } << level) * pixelsPerFrame);
+    const auto sourceWidth = juce::jmax(1, juce::roundToInt(FilmstripCache::kThumbnailWidth * drawWidth / thumbnailWidth));
+
+    const juce::Graphics::ScopedSaveState saveState(g);
+    const auto clipStartX = frameToX(inFrame + firstFrame);
+    const auto clipEndX = frameToX(inFrame + lastFrame + 1);
+    g.reduceClipRegion(juce::Rectangle<float>(clipStartX, 0.0f, clipEndX - clipStartX, height).getSmallestIntegerContainer());
+
+    auto& cache = FilmstripCache::get();
+    const auto path = file->getFile().getFullPathName();
+    const auto frameRate = static_cast<double>(edit.getFrameRate());
+    // The thumbnail at or before the first visible frame is partly on screen.
+    const auto firstThumbnail = firstFrame >> level;
+    const auto lastThumbnail = lastFrame >> level;
+    for (auto stripIndex = firstThumbnail / FilmstripCache::kFramesPerStrip;
+         stripIndex <= lastThumbnail / FilmstripCache::kFramesPerStrip;
+         ++stripIndex) {
+        const auto strip = cache.getStrip({ path, level, stripIndex }, frameRate);
+        if (!strip.isValid()) {
+            waitingForStrips = true;
+            continue;
+        }
+        const auto stripFirstThumbnail = stripIndex * FilmstripCache::kFramesPerStrip;
+        const auto count = FilmstripCache::getThumbnailCount(strip);
+        for (int slot = 0; slot < count; ++slot) {
+            const auto thumbnail = stripFirstThumbnail + slot;
+            if (thumbnail < firstThumbnail || thumbnail > lastThumbnail) {
+                continue;
+            }
+            const auto x = frameToX(inFrame + (thumbnail << level));
+            g.drawImage(strip,
+                        juce::roundToInt(x), 0, juce::roundToInt(drawWidth), getHeight(),
+                        slot * FilmstripCache::kThumbnailWidth, 0, sourceWidth, FilmstripCache::kThumbnailHeight);
+        }
+    }
+}
+
+void VideoFilmstrip::changeListenerCallback(juce::ChangeBroadcaster*) {
+    if (waitingForStrips) {
+        repaint();
+    }
+}
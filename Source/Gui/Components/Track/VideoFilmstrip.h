@@ -0,0 +1,30 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "Core/Edit/Edit.h"
+
+/// Filmstrip lane under the ruler, showing video clip thumbnails at their timeline position.
+/// Thumbnails are spaced by the FilmstripCache level nearest the zoom, so the lane only draws
+/// prebuilt strips; strips still loading leave their area blank until the cache reports them.
+class VideoFilmstrip : public juce::Component,
+                       private juce::ChangeListener {
+public:
+    explicit VideoFilmstrip(const Edit& edit);
+    ~VideoFilmstrip() override;
+
+    void paint(juce::Graphics& g) override;
+
+private:
+    void changeListenerCallback(juce::ChangeBroadcaster* source) override;
+
+    /// Draw one clip's thumbnails inside the visible range.
+    /// @param g graphics context
+    /// @param clip clip to draw
+    /// @param samplesPerFrame timeline samples per video frame
+    void paintClip(juce::Graphics& g, const VideoClip& clip, double samplesPerFrame);
+
+    const Edit& edit;
+    /// True when the last paint left strips waiting on the cache.
+    bool waitingForStrips = false;
+};
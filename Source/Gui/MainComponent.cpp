@@ -235,6 +235,16 @@ MainComponent::MainComponent()
     trackHorizontalScrollBar = std::make_unique<TrackHorizontalScrollBar>(*edit);
     addAndMakeVisible(trackHorizontalScrollBar.get());
 
+    trackViewport.onVisibleAreaChanged = [this](const juce::Rectangle<int>& visibleArea) {
+        // Both panels sit at the top of the container, so container and panel y match.
+        const auto span = juce::Range<int>(visibleArea.getY(), visibleArea.getBottom());
+        if (trackHeaderPanel != nullptr) {
+            trackHeaderPanel->setVisibleSpan(span);
+        }
+        if (trackContentPanel != nullptr) {
+            trackContentPanel->setVisibleSpan(span);
+        }
+    };
     trackViewport.setViewedComponent(&trackAreaContainer, false);
     trackViewport.setScrollBarsShown(true, false);
     trackViewport.setLookAndFeel(&trackScrollbarLookAndFeel);
@@ -328,7 +338,7 @@ void MainComponent::resized()
         auto trackAreaBounds = bounds;
         trackViewport.setBounds(trackAreaBounds);
         const int contentWidth = std::max(0, trackViewport.getWidth() - headerWidth);
-        int totalHeight = edit != nullptr ? edit->getState().getTimelineHeight() : 0;
+        int totalHeight = edit != nullptr ? edit->getState().getTrackRowsTop() : 0;
         if (edit != nullptr) {
             for (const auto& track : edit->getTracks()) {
                 if (!track) {
@@ -129,6 +129,8 @@ void SelectionManager::mouseDown(const juce::MouseEvent& event, juce::Component*
     }
     forceSelectionCommit = false;
     selectionComponentWidth = relativeTo != nullptr ? relativeTo->getWidth() : 0;
+    // Rebuilt once per gesture; drag and move lookups are then binary searches.
+    rowLayout.update(edit);
     auto relative = event.getEventRelativeTo(relativeTo);
     const int clickedTrackIndex = getTrackIndexAtY(static_cast<int>(relative.position.y));
     if (clickedTrackIndex < 0) {
@@ -410,20 +412,7 @@ void SelectionManager::extendSelectionToTrack(const String& trackId) {
 }
 
 int SelectionManager::getTrackIndexAtY(int y) const {
-    int currentY = edit.getState().getTimelineHeight();
-    int index = 0;
-    for (const auto& track : edit.getTracks()) {
-        if (!track) {
-            continue;
-        }
-        const int height = static_cast<int>(track->getHeight());
-        if (y >= currentY && y < currentY + height) {
-            return index;
-        }
-        currentY += height;
-        ++index;
-    }
-    return -1;
+    return rowLayout.getRowAt(y - edit.getState().getTrackRowsTop());
 }
 
 void SelectionManager::updateSelectionRange(int hoverIndex) {
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "Core/Edit/Edit.h"
+#include "Gui/Utils/TrackRowLayout.h"
 #include "Gui/Utils/ViewRangeMapper.h"
 
 class CursorController;
@@ -128,6 +129,8 @@ private:
     bool forceSelectionCommit = false;
     int lastAnchorTrackIndex = -1;
     std::optional<int64_t> lastAnchorSample;
+    /// Track rows as of the last mouse down.
+    TrackRowLayout rowLayout;
 
     std::optional<int64_t> getSampleAtPosition(const juce::MouseEvent& event,
                                                juce::Component* relativeTo) const;
@@ -0,0 +1,61 @@
+#include "TrackRowLayout.h"
+
+#include <algorithm>
+
+#include "Core/Edit/Edit.h"
+
+void TrackRowLayout::update(const Edit& edit) {
+    std::vector<int> heights;
+    heights.reserve(edit.getTracks().size());
+    for (const auto& track : edit.getTracks()) {
+        if (!track) {
+            continue;
+        }
+        heights.push_back(static_cast<int>(track->getHeight()));
+    }
+    setRowHeights(heights);
+}
+
+void TrackRowLayout::setRowHeights(const std::vector<int>& heights) {
+    rowTops.resize(heights.size() + 1);
+    rowTops[0] = 0;
+    for (size_t i = 0; i < heights.size(); ++i) {
+        rowTops[i + 1] = rowTops[i] + std::max(1, heights[i]);
+    }
+}
+
+int TrackRowLayout::getRowY(int index) const {
+    if (index < 0 || index >= getNumRows()) {
+        // Row index must be within the layout.
+        jassert(false);
+        return 0;
+    }
+    return rowTops[static_cast<size_t>(index)];
+}
+
+int TrackRowLayout::getRowHeight(int index) const {
+    if (index < 0 || index >= getNumRows()) {
+        // Row index must be within the layout.
+        jassert(false);
+        return 0;
+    }
+    return rowTops[static_cast<size_t>(index) + 1] - rowTops[static_cast<size_t>(index)];
+}
+
+int TrackRowLayout::getRowAt(int y) const {
+    if (y < 0 || y >= getTotalHeight()) {
+        return -1;
+    }
+    // First top strictly after y; the row before it contains y.
+    const auto it = std::upper_bound(rowTops.begin(), rowTops.end(), y);
+    return static_cast<int>(std::distance(rowTops.begin(), it)) - 1;
+}
+
+juce::Range<int> TrackRowLayout::getRowsInSpan(int top, int bottom) const {
+    top = std::max(0, top);
+    bottom = std::min(getTotalHeight(), bottom);
+    if (bottom <= top) {
+        return {};
+    }
+    return { getRowAt(top), getRowAt(bottom - 1) + 1 };
+}
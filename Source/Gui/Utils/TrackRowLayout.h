@@ -0,0 +1,51 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <vector>
+
+class Edit;
+
+/// Vertical layout of the track rows, kept as a prefix sum of their heights.
+/// Rows start at y = 0; callers offset by the ruler height. Lookups are O(log n).
+class TrackRowLayout {
+public:
+    /// Rebuild from the edit's tracks, skipping null entries like the rest of the timeline does.
+    /// @param edit edit providing track order and heights
+    void update(const Edit& edit);
+
+    /// Rebuild from explicit row heights.
+    /// @param heights row heights in display order (clamped to at least 1 px)
+    void setRowHeights(const std::vector<int>& heights);
+
+    /// Number of rows.
+    int getNumRows() const noexcept {
+        return static_cast<int>(rowTops.size()) - 1;
+    }
+
+    /// Sum of all row heights.
+    int getTotalHeight() const noexcept {
+        return rowTops.back();
+    }
+
+    /// Top of a row.
+    /// @param index row index
+    int getRowY(int index) const;
+
+    /// Height of a row.
+    /// @param index row index
+    int getRowHeight(int index) const;
+
+    /// Row containing a y position, or -1 when outside every row.
+    /// @param y position relative to the first row
+    int getRowAt(int y) const;
+
+    /// Rows overlapping a vertical span (empty when none).
+    /// @param top first visible pixel
+    /// @param bottom one past the last visible pixel
+    juce::Range<int> getRowsInSpan(int top, int bottom) const;
+
+private:
+    /// rowTops[i] is the top of row i; the last entry is the total height.
+    std::vector<int> rowTops { 0 };
+};
@@ -0,0 +1,67 @@
+#include "ViewNavigator.h"
+
+#include <cmath>
+
+ViewNavigator::ViewNavigator(Edit& edit)
+    : edit(edit) {
+}
+
+ViewNavigator::~ViewNavigator() {
+    stopTimer();
+}
+
+void ViewNavigator::zoom(float ratio, int64 centerSample) {
+    const auto width = static_cast<double>(edit.getState().getViewWidthPixels());
+    const auto next = EditState::computeZoom(getPredictedView(), width, ratio, centerSample);
+    lastZoomMs = juce::Time::getMillisecondCounter();
+    if (!edit.getState().isViewInteractive()) {
+        edit.getState().setViewInteractive(true);
+    }
+    queue(next);
+}
+
+void ViewNavigator::scroll(double viewFraction) {
+    auto next = getPredictedView();
+    const auto viewLength = next.samplesPerPixel * static_cast<double>(edit.getState().getViewWidthPixels());
+    if (viewLength <= 0.0) {
+        // View length must be positive to scroll.
+        jassert(false);
+        return;
+    }
+    // Whole samples, like the view range the scroll used to write.
+    next.startSampleF = std::max(0.0, next.startSampleF + std::round(viewLength * viewFraction));
+    queue(next);
+}
+
+EditState::ViewPosition ViewNavigator::getPredictedView() const {
+    return pendingView.value_or(edit.getState().getViewPosition());
+}
+
+void ViewNavigator::flush() {
+    if (!pendingView.has_value()) {
+        return;
+    }
+    const auto view = *pendingView;
+    pendingView.reset();
+    edit.getActionStore().dispatch(EditAction::makeViewPosition(view));
+}
+
+void ViewNavigator::queue(EditState::ViewPosition position) {
+    pendingView = position;
+    if (!isTimerRunning()) {
+        startTimerHz(kFrameRateHz);
+    }
+}
+
+void ViewNavigator::timerCallback() {
+    flush();
+    const auto sinceZoom = juce::Time::getMillisecondCounter() - lastZoomMs;
+    if (edit.getState().isViewInteractive()) {
+        if (sinceZoom < kSettleMs) {
+            return;
+        }
+        // Listeners repaint on this change and request the tiles for the final zoom.
+        edit.getState().setViewInteractive(false);
+    }
+    stopTimer();
+}
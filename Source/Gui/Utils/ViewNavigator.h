@@ -0,0 +1,47 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <optional>
+
+#include "Core/Edit/Edit.h"
+
+/// Coalesces zoom and scroll gestures into at most one view update per display frame.
+/// Each gesture is applied to a predicted view, so bursts of wheel events compound as if every
+/// one had been written, while the edit state and its listeners only see the frame's result.
+/// Zoom gestures also flag the view as interactive until input settles.
+class ViewNavigator : private juce::Timer {
+public:
+    /// Rate at which pending view changes are flushed.
+    static constexpr int kFrameRateHz = 60;
+    /// Quiet time after the last zoom before the view stops being interactive.
+    static constexpr uint32 kSettleMs = 150;
+
+    /// Create a navigator for the edit view.
+    /// @param edit edit owning the view state
+    explicit ViewNavigator(Edit& edit);
+    ~ViewNavigator() override;
+
+    /// Queue one zoom step.
+    /// @param ratio zoom ratio sign (positive to zoom out, negative to zoom in)
+    /// @param centerSample sample around which to anchor the view
+    void zoom(float ratio, int64 centerSample);
+
+    /// Queue a scroll by a fraction of the view length.
+    /// @param viewFraction signed fraction of the view length to move by
+    void scroll(double viewFraction);
+
+    /// View including queued gestures, or the edit view when nothing is queued.
+    EditState::ViewPosition getPredictedView() const;
+
+    /// Apply queued gestures now.
+    void flush();
+
+private:
+    void timerCallback() override;
+    void queue(EditState::ViewPosition position);
+
+    Edit& edit;
+    std::optional<EditState::ViewPosition> pendingView;
+    uint32 lastZoomMs = 0;
+};
@@ -15,3 +15,9 @@ void WheelForwardingViewport::mouseWheelMove(const juce::MouseEvent& event,
     }
     juce::Viewport::mouseWheelMove(event, details);
 }
+
+void WheelForwardingViewport::visibleAreaChanged(const juce::Rectangle<int>& newVisibleArea) {
+    if (onVisibleAreaChanged) {
+        onVisibleAreaChanged(newVisibleArea);
+    }
+}
@@ -28,6 +28,10 @@ public:
 
     void mouseWheelMove(const juce::MouseEvent& event,
                         const juce::MouseWheelDetails& details) override;
+    void visibleAreaChanged(const juce::Rectangle<int>& newVisibleArea) override;
+
+    /// Called with the visible area of the viewed component after scrolling or resizing.
+    std::function<void(const juce::Rectangle<int>&)> onVisibleAreaChanged;
 
 private:
     Handler* handler = nullptr;
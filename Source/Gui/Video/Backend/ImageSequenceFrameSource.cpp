@@ -0,0 +1,52 @@
+#include "ImageSequenceFrameSource.h"
+
+#include <algorithm>
+#include <utility>
+
+bool ImageSequenceFrameSource::open(const juce::File& file) {
+    frames.clear();
+    const auto name = file.getFileNameWithoutExtension();
+    auto digitsStart = name.length();
+    while (digitsStart > 0 && juce::CharacterFunctions::isDigit(name[digitsStart - 1])) {
+        --digitsStart;
+    }
+    if (digitsStart == name.length()) {
+        // Without a frame number there is no sequence to index.
+        return false;
+    }
+    const auto prefix = name.substring(0, digitsStart);
+    const auto extension = file.getFileExtension();
+
+    std::vector<std::pair<int64_t, juce::File>> numbered;
+    for (const auto& sibling : file.getParentDirectory().findChildFiles(juce::File::findFiles,
+                                                                        false,
+                                                                        prefix + "*" + extension)) {
+        const auto number = sibling.getFileNameWithoutExtension().substring(prefix.length());
+        if (number.isNotEmpty() && number.containsOnly("0123456789")) {
+            numbered.emplace_back(number.getLargeIntValue(), sibling);
+        }
+    }
+    std::sort(numbered.begin(), numbered.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+    frames.reserve(numbered.size());
+    for (auto& [number, frameFile] : numbered) {
+        frames.push_back(std::move(frameFile));
+    }
+    return !frames.empty();
+}
+
+int64_t ImageSequenceFrameSource::getNumFrames() const {
+    return static_cast<int64_t>(frames.size());
+}
+
+double ImageSequenceFrameSource::getNominalFrameRate() const {
+    return 0.0;
+}
+
+juce::Image ImageSequenceFrameSource::readFrame(int64_t frameIndex, juce::Image) {
+    if (frameIndex < 0 || frameIndex >= getNumFrames()) {
+        return {};
+    }
+    return juce::ImageFileFormat::loadFrom(frames[static_cast<size_t>(frameIndex)]);
+}
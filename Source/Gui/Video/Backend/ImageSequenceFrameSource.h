@@ -0,0 +1,27 @@
+#pragma once
+
+#include <juce_graphics/juce_graphics.h>
+
+#include <vector>
+
+#include "VideoFrameSource.h"
+
+/// Frames of a numbered image sequence such as shot_00001.jpg, shot_00002.jpg...
+/// Opening any frame indexes its siblings with the same prefix and extension, ordered by number,
+/// so gaps in the numbering are skipped. Each frame is an intra coded JPEG or PNG.
+class ImageSequenceFrameSource : public VideoFrameSource {
+public:
+    static constexpr const char* kFileExtensions = "jpg;jpeg;png";
+
+    bool open(const juce::File& file) override;
+    int64_t getNumFrames() const override;
+
+    /// Image sequences carry no frame rate; frames follow the edit rate.
+    double getNominalFrameRate() const override;
+
+    /// Image files decode into their own storage, so the recycled image is not used.
+    juce::Image readFrame(int64_t frameIndex, juce::Image recycled) override;
+
+private:
+    std::vector<juce::File> frames;
+};
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 namespace juce {
 class File;
 class Image;
@@ -42,4 +44,10 @@ public:
 
     /// Read the nominal frame rate reported by the backend.
     virtual double getNominalFrameRate() const = 0;
+
+    /// Read how many decoded frames left the buffer without being shown.
+    virtual uint64_t getDroppedFrameCount() const = 0;
+
+    /// Read how many frames were decoded after the playhead had passed them.
+    virtual uint64_t getLateFrameCount() const = 0;
 };
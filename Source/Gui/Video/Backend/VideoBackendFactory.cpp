@@ -1,7 +1,18 @@
 #include "VideoBackendFactory.h"
 
+#include <juce_core/juce_core.h>
+
+#if JUCE_MAC
 #include "VideoBackend_AVAssetReader.h"
+#else
+#include "VideoBackend_Proxy.h"
+#endif
 
 std::unique_ptr<VideoBackend> createVideoBackend() {
+#if JUCE_MAC
     return std::make_unique<VideoBackend_AVAssetReader>();
+#else
+    // Elsewhere only intra-frame proxies can be played.
+    return std::make_unique<VideoBackend_Proxy>();
+#endif
 }
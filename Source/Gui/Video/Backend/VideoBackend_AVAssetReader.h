@@ -23,6 +23,8 @@ public:
     juce::Image getCurrentFrameImage() override;
     int64_t getLastFrameIndex() const override;
     double getNominalFrameRate() const override;
+    uint64_t getDroppedFrameCount() const override;
+    uint64_t getLateFrameCount() const override;
 
 private:
     void run() override;
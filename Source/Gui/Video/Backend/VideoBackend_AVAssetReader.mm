@@ -9,9 +9,10 @@
 #include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <utility>
 
 namespace {
-juce::Image imageFromPixelBuffer(CVPixelBufferRef buffer) {
+juce::Image imageFromPixelBuffer(CVPixelBufferRef buffer, juce::Image recycled) {
     if (buffer == nullptr) {
         return {};
     }
@@ -20,7 +21,13 @@ juce::Image imageFromPixelBuffer(CVPixelBufferRef buffer) {
     const size_t height = CVPixelBufferGetHeight(buffer);
     const size_t bytesPerRow = CVPixelBufferGetBytesPerRow(buffer);
     auto* baseAddress = static_cast<uint8_t*>(CVPixelBufferGetBaseAddress(buffer));
-    juce::Image image(juce::Image::ARGB, static_cast<int>(width), static_cast<int>(height), false);
+    auto image = std::move(recycled);
+    if (!image.isValid()
+        || image.getFormat() != juce::Image::ARGB
+        || image.getWidth() != static_cast<int>(width)
+        || image.getHeight() != static_cast<int>(height)) {
+        image = juce::Image(juce::Image::ARGB, static_cast<int>(width), static_cast<int>(height), false);
+    }
     juce::Image::BitmapData data(image, juce::Image::BitmapData::writeOnly);
     for (size_t y = 0; y < height; ++y) {
         const auto* src = baseAddress + y * bytesPerRow;
@@ -140,6 +147,16 @@ juce::Image VideoBackend_AVAssetReader::getCurrentFrameImage() {
     return lastFrame;
 }
 
+uint64_t VideoBackend_AVAssetReader::getDroppedFrameCount() const {
+    const juce::ScopedLock scopedLock(lock);
+    return frameBuffer.getDroppedFrameCount();
+}
+
+uint64_t VideoBackend_AVAssetReader::getLateFrameCount() const {
+    const juce::ScopedLock scopedLock(lock);
+    return frameBuffer.getLateFrameCount();
+}
+
 int64_t VideoBackend_AVAssetReader::getLastFrameIndex() const {
     const juce::ScopedLock scopedLock(lock);
     return frameBuffer.getLastFrameIndex();
@@ -231,6 +248,12 @@ bool VideoBackend_AVAssetReader::decodeNextFrame() {
     if (!state.reader || !state.output) {
         return false;
     }
+    juce::Image recycled;
+    {
+        // Frames arrive in order, so the next one lands after the last buffered frame.
+        const juce::ScopedLock scopedLock(lock);
+        recycled = frameBuffer.recycleImage(frameBuffer.getLastFrameIndex() + 1);
+    }
     CMSampleBufferRef sample = [state.output copyNextSampleBuffer];
     if (!sample) {
         return false;
@@ -238,7 +261,7 @@ bool VideoBackend_AVAssetReader::decodeNextFrame() {
     const auto presentationTime = CMSampleBufferGetPresentationTimeStamp(sample);
     const auto seconds = CMTimeGetSeconds(presentationTime);
     CVPixelBufferRef buffer = CMSampleBufferGetImageBuffer(sample);
-    auto image = imageFromPixelBuffer(buffer);
+    auto image = imageFromPixelBuffer(buffer, std::move(recycled));
     const auto index = frameIndexForSeconds(seconds);
     {
         const juce::ScopedLock scopedLock(lock);
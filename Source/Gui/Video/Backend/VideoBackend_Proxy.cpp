@@ -0,0 +1,179 @@
+#include "VideoBackend_Proxy.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+VideoBackend_Proxy::VideoBackend_Proxy()
+    : Thread("VideoProxyReader") {
+}
+
+VideoBackend_Proxy::~VideoBackend_Proxy() {
+    stopThread(2000);
+}
+
+void VideoBackend_Proxy::loadFile(const juce::File& file) {
+    // The decode thread owns the source while it runs.
+    stopThread(2000);
+    auto nextSource = openVideoFrameSource(file);
+    {
+        const juce::ScopedLock scopedLock(lock);
+        frameBuffer.clear();
+        lastFrame = {};
+        ++seekGeneration;
+        failedFrame = -1;
+        source = std::move(nextSource);
+        ready = source != nullptr;
+        numFrames = ready ? source->getNumFrames() : 0;
+        nominalFrameRate = ready ? source->getNominalFrameRate() : 0.0;
+    }
+    if (ready) {
+        startThread();
+    }
+}
+
+void VideoBackend_Proxy::setPlayheadSeconds(double seconds) {
+    {
+        const juce::ScopedLock scopedLock(lock);
+        targetSeconds = seconds;
+    }
+    notify();
+}
+
+void VideoBackend_Proxy::setFrameRate(double newFrameRate) {
+    const juce::ScopedLock scopedLock(lock);
+    frameRate = newFrameRate;
+}
+
+double VideoBackend_Proxy::getPlayheadSeconds() const {
+    const juce::ScopedLock scopedLock(lock);
+    return targetSeconds;
+}
+
+void VideoBackend_Proxy::play() {
+    {
+        const juce::ScopedLock scopedLock(lock);
+        if (!ready) {
+            return;
+        }
+        playing = true;
+    }
+    notify();
+}
+
+void VideoBackend_Proxy::stop() {
+    // The decode thread keeps running while paused, so only the lead changes.
+    const juce::ScopedLock scopedLock(lock);
+    playing = false;
+}
+
+bool VideoBackend_Proxy::isReady() const {
+    const juce::ScopedLock scopedLock(lock);
+    return ready;
+}
+
+bool VideoBackend_Proxy::isPlaying() const {
+    const juce::ScopedLock scopedLock(lock);
+    return playing;
+}
+
+juce::Image VideoBackend_Proxy::getCurrentFrameImage() {
+    const juce::ScopedLock scopedLock(lock);
+    if (frameRate <= 0.0) {
+        return lastFrame;
+    }
+    auto frame = frameBuffer.getExactFrame(frameIndexForSeconds(targetSeconds));
+    if (frame.isValid()) {
+        lastFrame = frame;
+    }
+    return lastFrame;
+}
+
+int64_t VideoBackend_Proxy::getLastFrameIndex() const {
+    const juce::ScopedLock scopedLock(lock);
+    return frameBuffer.getLastFrameIndex();
+}
+
+double VideoBackend_Proxy::getNominalFrameRate() const {
+    const juce::ScopedLock scopedLock(lock);
+    return nominalFrameRate;
+}
+
+uint64_t VideoBackend_Proxy::getDroppedFrameCount() const {
+    const juce::ScopedLock scopedLock(lock);
+    return frameBuffer.getDroppedFrameCount();
+}
+
+uint64_t VideoBackend_Proxy::getLateFrameCount() const {
+    const juce::ScopedLock scopedLock(lock);
+    return frameBuffer.getLateFrameCount();
+}
+
+void VideoBackend_Proxy::run() {
+    while (!threadShouldExit()) {
+        int64_t frameIndex = -1;
+        uint32_t generation = 0;
+        juce::Image recycled;
+        {
+            const juce::ScopedLock scopedLock(lock);
+            frameIndex = getNextFrameToDecode();
+            generation = seekGeneration;
+            if (frameIndex >= 0) {
+                recycled = frameBuffer.recycleImage(frameIndex);
+            }
+        }
+        if (frameIndex < 0) {
+            wait(kIdleWaitMs);
+            continue;
+        }
+        // Decoded outside the lock so the message thread never waits on file I/O.
+        const auto image = source->readFrame(frameIndex, std::move(recycled));
+        const juce::ScopedLock scopedLock(lock);
+        if (generation != seekGeneration) {
+            continue;
+        }
+        if (!image.isValid() && !lastFrame.isValid()) {
+            // Nothing to stand in for it; wait for the next seek rather than retrying.
+            juce::Logger::writeToLog("VideoBackend_Proxy: cannot decode frame " + juce::String(frameIndex));
+            failedFrame = frameIndex;
+            continue;
+        }
+        // An unreadable frame repeats the previous one so the buffer keeps moving.
+        frameBuffer.pushFrame(frameIndex, image.isValid() ? image : lastFrame);
+        if (!lastFrame.isValid()) {
+            lastFrame = image;
+        }
+    }
+}
+
+int64_t VideoBackend_Proxy::getNextFrameToDecode() {
+    if (!ready || frameRate <= 0.0 || numFrames <= 0) {
+        return -1;
+    }
+    const auto targetIndex = std::clamp<int64_t>(frameIndexForSeconds(targetSeconds), 0, numFrames - 1);
+    const auto firstIndex = frameBuffer.getFirstFrameIndex();
+    const auto lastIndex = frameBuffer.getLastFrameIndex();
+    if (frameBuffer.size() == 0 || targetIndex < firstIndex || targetIndex > lastIndex + 1) {
+        if (targetIndex == failedFrame) {
+            return -1;
+        }
+        // A seek outside the buffer: restart decoding at the playhead.
+        frameBuffer.clear();
+        ++seekGeneration;
+        failedFrame = -1;
+        return targetIndex;
+    }
+    const auto nextIndex = lastIndex + 1;
+    const auto lead = playing ? kPlayingLead : kPausedLead;
+    if (nextIndex >= numFrames || nextIndex > targetIndex + lead) {
+        return -1;
+    }
+    return nextIndex;
+}
+
+int64_t VideoBackend_Proxy::frameIndexForSeconds(double seconds) const {
+    if (frameRate <= 0.0) {
+        return 0;
+    }
+    return static_cast<int64_t>(std::llround(seconds * frameRate));
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <juce_graphics/juce_graphics.h>
+
+#include "Gui/Video/VideoFrameBuffer.h"
+#include "VideoBackend.h"
+#include "VideoFrameSource.h"
+
+/// Platform independent backend for intra-frame proxies (Y4M, numbered image sequences).
+/// A decode-ahead thread keeps the frame buffer filled from the playhead onwards. Every frame is
+/// indexed, so a seek only restarts decoding at the new frame.
+class VideoBackend_Proxy : public VideoBackend,
+                           private juce::Thread {
+public:
+    VideoBackend_Proxy();
+    ~VideoBackend_Proxy() override;
+
+    void loadFile(const juce::File& file) override;
+    void setPlayheadSeconds(double seconds) override;
+    void setFrameRate(double frameRate) override;
+    double getPlayheadSeconds() const override;
+    void play() override;
+    void stop() override;
+    bool isReady() const override;
+    bool isPlaying() const override;
+    juce::Image getCurrentFrameImage() override;
+    int64_t getLastFrameIndex() const override;
+    double getNominalFrameRate() const override;
+    uint64_t getDroppedFrameCount() const override;
+    uint64_t getLateFrameCount() const override;
+
+private:
+    void run() override;
+
+    /// Next frame for the decode thread, or -1 when the buffer is far enough ahead (call with lock held).
+    int64_t getNextFrameToDecode();
+
+    int64_t frameIndexForSeconds(double seconds) const;
+
+    static constexpr size_t kBufferCapacity = 20;
+    /// Frames decoded past the playhead during playback; the rest of the buffer holds frames behind it.
+    static constexpr int64_t kPlayingLead = 16;
+    /// Frames decoded past the playhead while paused, so playback starts from the buffer.
+    static constexpr int64_t kPausedLead = 4;
+    static constexpr int kIdleWaitMs = 5;
+
+    juce::CriticalSection lock;
+    /// Only read by the decode thread; replaced while the thread is stopped.
+    std::unique_ptr<VideoFrameSource> source;
+    VideoFrameBuffer frameBuffer { kBufferCapacity };
+    juce::Image lastFrame;
+    double targetSeconds = 0.0;
+    double frameRate = 0.0;
+    double nominalFrameRate = 0.0;
+    int64_t numFrames = 0;
+    /// Bumped whenever a seek empties the buffer, so a frame decoded for the old position is dropped.
+    uint32_t seekGeneration = 0;
+    /// Frame that could not be decoded into an empty buffer, retried only after a seek.
+    int64_t failedFrame = -1;
+    bool ready = false;
+    bool playing = false;
+};
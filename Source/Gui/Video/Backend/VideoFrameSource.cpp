@@ -0,0 +1,25 @@
+#include "VideoFrameSource.h"
+
+#include "ImageSequenceFrameSource.h"
+#include "Y4MFrameSource.h"
+
+bool isVideoProxyFile(const juce::File& file) {
+    return file.hasFileExtension(Y4MFrameSource::kFileExtension)
+        || file.hasFileExtension(ImageSequenceFrameSource::kFileExtensions);
+}
+
+std::unique_ptr<VideoFrameSource> openVideoFrameSource(const juce::File& file) {
+    std::unique_ptr<VideoFrameSource> source;
+    if (file.hasFileExtension(Y4MFrameSource::kFileExtension)) {
+        source = std::make_unique<Y4MFrameSource>();
+    } else if (file.hasFileExtension(ImageSequenceFrameSource::kFileExtensions)) {
+        source = std::make_unique<ImageSequenceFrameSource>();
+    } else {
+        return nullptr;
+    }
+    if (!source->open(file)) {
+        juce::Logger::writeToLog("VideoFrameSource: cannot index " + file.getFullPathName());
+        return nullptr;
+    }
+    return source;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <juce_graphics/juce_graphics.h>
+
+#include <memory>
+
+/// Random access to the frames of an intra-frame proxy, for the platform independent backend.
+/// Frames are located through an index built on open, so any frame is one seek away.
+/// Not thread safe: each reading thread opens its own source.
+class VideoFrameSource {
+public:
+    virtual ~VideoFrameSource() = default;
+
+    /// Open a file and build its frame index.
+    /// @param file proxy file to read
+    /// @return false when the file is not a readable proxy
+    virtual bool open(const juce::File& file) = 0;
+
+    /// Number of indexed frames.
+    virtual int64_t getNumFrames() const = 0;
+
+    /// Frame rate stored in the file, or 0 when the format has none.
+    virtual double getNominalFrameRate() const = 0;
+
+    /// Decode one frame.
+    /// @param frameIndex frame to decode, from 0
+    /// @param recycled image to decode into when its size and format fit (may be invalid)
+    /// @return the frame, or an invalid image when out of range or unreadable
+    virtual juce::Image readFrame(int64_t frameIndex, juce::Image recycled) = 0;
+};
+
+/// Check whether a file looks like a supported proxy, from its extension.
+/// @param file file to check
+bool isVideoProxyFile(const juce::File& file);
+
+/// Open a frame source for a proxy file, chosen by extension.
+/// @param file proxy file, or any frame of a numbered image sequence
+/// @return nullptr when the format is not supported or the file cannot be indexed
+std::unique_ptr<VideoFrameSource> openVideoFrameSource(const juce::File& file);
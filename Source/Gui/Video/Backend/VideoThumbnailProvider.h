@@ -17,6 +17,17 @@ public:
     /// @param seconds time in seconds
     virtual juce::Image getFrameAtSeconds(double seconds) = 0;
 
+    /// Read a still frame by index; the default converts the index to seconds.
+    /// @param frameIndex frame index from the start of the file
+    /// @param frameRate frames per second
+    virtual juce::Image getFrameAtIndex(int64_t frameIndex, double frameRate) {
+        return getFrameAtSeconds(static_cast<double>(frameIndex) / frameRate);
+    }
+
+    /// Number of frames in the file, or -1 when unknown.
+    /// @param frameRate frames per second, for providers that only know the duration
+    virtual int64_t getNumFrames(double frameRate) const = 0;
+
     /// Check whether the provider is ready.
     virtual bool isReady() const = 0;
 };
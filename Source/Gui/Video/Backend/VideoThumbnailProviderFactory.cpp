@@ -1,7 +1,17 @@
 #include "VideoThumbnailProviderFactory.h"
 
+#include <juce_core/juce_core.h>
+
+#if JUCE_MAC
 #include "VideoThumbnailProvider_AVFoundation.h"
+#else
+#include "VideoThumbnailProvider_Proxy.h"
+#endif
 
 std::unique_ptr<VideoThumbnailProvider> createVideoThumbnailProvider() {
+#if JUCE_MAC
     return std::make_unique<VideoThumbnailProvider_AVFoundation>();
+#else
+    return std::make_unique<VideoThumbnailProvider_Proxy>();
+#endif
 }
@@ -12,6 +12,7 @@ public:
 
     void setVideoFile(const VideoFile& file) override;
     juce::Image getFrameAtSeconds(double seconds) override;
+    int64_t getNumFrames(double frameRate) const override;
     bool isReady() const override;
 
 private:
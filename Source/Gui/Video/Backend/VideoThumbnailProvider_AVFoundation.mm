@@ -5,6 +5,8 @@
 #include <juce_core/juce_core.h>
 #include <juce_graphics/juce_graphics.h>
 
+#include <cmath>
+
 namespace {
 juce::Image imageFromCGImage(CGImageRef imageRef) {
     if (!imageRef) {
@@ -96,6 +98,19 @@ juce::Image VideoThumbnailProvider_AVFoundation::getFrameAtSeconds(double second
     return image;
 }
 
+int64_t VideoThumbnailProvider_AVFoundation::getNumFrames(double frameRate) const {
+    if (!impl || frameRate <= 0.0) {
+        return -1;
+    }
+    auto* state = (__bridge AVFoundationThumbnailImpl*)impl;
+    const auto duration = state.asset.duration;
+    if (!CMTIME_IS_NUMERIC(duration)) {
+        return -1;
+    }
+    // A frame starting before the end counts, however short.
+    return static_cast<int64_t>(std::ceil(CMTimeGetSeconds(duration) * frameRate - 1.0e-6));
+}
+
 bool VideoThumbnailProvider_AVFoundation::isReady() const {
     if (!impl) {
         return false;
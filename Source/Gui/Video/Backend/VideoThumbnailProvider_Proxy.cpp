@@ -0,0 +1,36 @@
+#include "VideoThumbnailProvider_Proxy.h"
+
+#include <cmath>
+
+void VideoThumbnailProvider_Proxy::setVideoFile(const VideoFile& file) {
+    auto nextSource = openVideoFrameSource(file.getFile());
+    const juce::ScopedLock scopedLock(lock);
+    source = std::move(nextSource);
+}
+
+juce::Image VideoThumbnailProvider_Proxy::getFrameAtSeconds(double seconds) {
+    const juce::ScopedLock scopedLock(lock);
+    if (source == nullptr || source->getNominalFrameRate() <= 0.0) {
+        // Image sequences have no timing of their own; use getFrameAtIndex().
+        return {};
+    }
+    return source->readFrame(static_cast<int64_t>(std::llround(seconds * source->getNominalFrameRate())), {});
+}
+
+juce::Image VideoThumbnailProvider_Proxy::getFrameAtIndex(int64_t frameIndex, double) {
+    const juce::ScopedLock scopedLock(lock);
+    if (source == nullptr) {
+        return {};
+    }
+    return source->readFrame(frameIndex, {});
+}
+
+int64_t VideoThumbnailProvider_Proxy::getNumFrames(double) const {
+    const juce::ScopedLock scopedLock(lock);
+    return source != nullptr ? source->getNumFrames() : -1;
+}
+
+bool VideoThumbnailProvider_Proxy::isReady() const {
+    const juce::ScopedLock scopedLock(lock);
+    return source != nullptr;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <juce_graphics/juce_graphics.h>
+
+#include "VideoFrameSource.h"
+#include "VideoThumbnailProvider.h"
+
+/// Generate thumbnails from intra-frame proxies, on any platform.
+class VideoThumbnailProvider_Proxy : public VideoThumbnailProvider {
+public:
+    void setVideoFile(const VideoFile& file) override;
+    juce::Image getFrameAtSeconds(double seconds) override;
+
+    /// Proxy frames map one to one onto edit frames, so the index is read directly.
+    juce::Image getFrameAtIndex(int64_t frameIndex, double frameRate) override;
+
+    int64_t getNumFrames(double frameRate) const override;
+    bool isReady() const override;
+
+private:
+    mutable juce::CriticalSection lock;
+    std::unique_ptr<VideoFrameSource> source;
+};
@@ -0,0 +1,206 @@
+#include "Y4MFrameSource.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace {
+/// Longest stream or frame header accepted; real headers are well under this.
+constexpr int kMaxHeaderLength = 1024;
+/// Headers are read through a buffer of this size: a frame header costs one small file read
+/// instead of one per byte, without pulling in much of the planes that follow it.
+constexpr int kHeaderBufferSize = 256;
+
+/// Read up to and excluding the next newline (byte by byte, so pass a buffered stream).
+bool readHeaderLine(juce::InputStream& stream, juce::String& line) {
+    juce::MemoryOutputStream bytes;
+    for (int i = 0; i < kMaxHeaderLength; ++i) {
+        char c = 0;
+        if (stream.read(&c, 1) != 1) {
+            return false;
+        }
+        if (c == '\n') {
+            line = bytes.toString();
+            return true;
+        }
+        bytes.writeByte(c);
+    }
+    return false;
+}
+
+uint8_t clampToByte(int value) {
+    return static_cast<uint8_t>(std::clamp(value, 0, 255));
+}
+} // namespace
+
+bool Y4MFrameSource::open(const juce::File& file) {
+    stream = std::make_unique<juce::FileInputStream>(file);
+    frameOffsets.clear();
+    if (stream->failedToOpen()) {
+        stream.reset();
+        return false;
+    }
+    juce::BufferedInputStream headers(*stream, kHeaderBufferSize);
+    juce::String header;
+    if (!readHeaderLine(headers, header) || !parseHeader(header)) {
+        stream.reset();
+        return false;
+    }
+    const auto lumaBytes = static_cast<size_t>(width) * static_cast<size_t>(height);
+    const auto chromaBytes = static_cast<size_t>(getChromaWidth()) * static_cast<size_t>(getChromaHeight());
+    frameBytes = lumaBytes + 2 * chromaBytes;
+    buildIndex(headers);
+    return !frameOffsets.empty();
+}
+
+int64_t Y4MFrameSource::getNumFrames() const {
+    return static_cast<int64_t>(frameOffsets.size());
+}
+
+double Y4MFrameSource::getNominalFrameRate() const {
+    return frameRate;
+}
+
+juce::Image Y4MFrameSource::readFrame(int64_t frameIndex, juce::Image recycled) {
+    if (stream == nullptr || frameIndex < 0 || frameIndex >= getNumFrames()) {
+        return {};
+    }
+    planes.resize(frameBytes);
+    if (!stream->setPosition(frameOffsets[static_cast<size_t>(frameIndex)])
+        || stream->read(planes.data(), static_cast<int>(frameBytes)) != static_cast<int>(frameBytes)) {
+        return {};
+    }
+
+    const auto chromaWidth = getChromaWidth();
+    const auto chromaHeight = getChromaHeight();
+    const auto* lumaPlane = planes.data();
+    const auto* uPlane = lumaPlane + static_cast<size_t>(width) * static_cast<size_t>(height);
+    const auto* vPlane = uPlane + static_cast<size_t>(chromaWidth) * static_cast<size_t>(chromaHeight);
+    const auto hasChroma = chroma != Chroma::mono;
+    const auto xShift = chroma == Chroma::full444 ? 0 : 1;
+    const auto yShift = chroma == Chroma::subsampled420 ? 1 : 0;
+    // Fixed point BT.601, scaled by 256; limited range stretches 16..235 to 0..255.
+    const auto lumaScale = fullRange ? 256 : 298;
+    const auto lumaOffset = fullRange ? 0 : 16;
+
+    auto image = std::move(recycled);
+    if (!image.isValid() || image.getFormat() != juce::Image::ARGB
+        || image.getWidth() != width || image.getHeight() != height) {
+        // Software images can be written off the message thread.
+        image = juce::Image(juce::Image::ARGB, width, height, false, juce::SoftwareImageType());
+    }
+    juce::Image::BitmapData data(image, juce::Image::BitmapData::writeOnly);
+    for (int y = 0; y < height; ++y) {
+        auto* line = reinterpret_cast<juce::PixelARGB*>(data.getLinePointer(y));
+        const auto* lumaRow = lumaPlane + static_cast<size_t>(y) * static_cast<size_t>(width);
+        const auto chromaRow = static_cast<size_t>(y >> yShift) * static_cast<size_t>(chromaWidth);
+        for (int x = 0; x < width; ++x) {
+            const auto c = lumaScale * (static_cast<int>(lumaRow[x]) - lumaOffset);
+            auto d = 0;
+            auto e = 0;
+            if (hasChroma) {
+                const auto chromaIndex = chromaRow + static_cast<size_t>(x >> xShift);
+                d = static_cast<int>(uPlane[chromaIndex]) - 128;
+                e = static_cast<int>(vPlane[chromaIndex]) - 128;
+            }
+            line[x].setARGB(255,
+                            clampToByte((c + 409 * e + 128) >> 8),
+                            clampToByte((c - 100 * d - 208 * e + 128) >> 8),
+                            clampToByte((c + 516 * d + 128) >> 8));
+        }
+    }
+    return image;
+}
+
+bool Y4MFrameSource::parseHeader(const juce::String& header) {
+    const auto tokens = juce::StringArray::fromTokens(header, " ", "");
+    if (tokens.isEmpty() || tokens[0] != "YUV4MPEG2") {
+        return false;
+    }
+    for (const auto& token : tokens) {
+        const auto value = token.substring(1);
+        switch (token[0]) {
+            case 'W':
+                width = value.getIntValue();
+                break;
+            case 'H':
+                height = value.getIntValue();
+                break;
+            case 'F': {
+                const auto numerator = value.upToFirstOccurrenceOf(":", false, false).getDoubleValue();
+                const auto denominator = value.fromFirstOccurrenceOf(":", false, false).getDoubleValue();
+                frameRate = denominator > 0.0 ? numerator / denominator : 0.0;
+                break;
+            }
+            case 'C':
+                // Only 8-bit layouts: the p10/p12/p16 variants use two bytes per sample.
+                if (value == "420" || value == "420jpeg" || value == "420paldv" || value == "420mpeg2") {
+                    chroma = Chroma::subsampled420;
+                } else if (value == "422") {
+                    chroma = Chroma::subsampled422;
+                } else if (value == "444") {
+                    chroma = Chroma::full444;
+                } else if (value == "mono") {
+                    chroma = Chroma::mono;
+                } else {
+                    // High bit depth and alpha layouts are not produced by our proxy presets.
+                    juce::Logger::writeToLog("Y4MFrameSource: unsupported colour space " + value);
+                    return false;
+                }
+                break;
+            case 'X':
+                if (value == "COLORRANGE=FULL") {
+                    fullRange = true;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+    return width > 0 && height > 0;
+}
+
+void Y4MFrameSource::buildIndex(juce::InputStream& headers) {
+    const auto totalLength = headers.getTotalLength();
+    auto position = headers.getPosition();
+    juce::String frameHeader;
+    while (position < totalLength) {
+        if (!headers.setPosition(position)
+            || !readHeaderLine(headers, frameHeader)
+            || !frameHeader.startsWith("FRAME")) {
+            break;
+        }
+        const auto planesStart = headers.getPosition();
+        if (planesStart + static_cast<int64_t>(frameBytes) > totalLength) {
+            // A truncated last frame is left out rather than shown half decoded.
+            break;
+        }
+        frameOffsets.push_back(planesStart);
+        position = planesStart + static_cast<int64_t>(frameBytes);
+    }
+}
+
+int Y4MFrameSource::getChromaWidth() const noexcept {
+    switch (chroma) {
+        case Chroma::subsampled420:
+        case Chroma::subsampled422:
+            return (width + 1) / 2;
+        case Chroma::full444:
+            return width;
+        case Chroma::mono:
+            return 0;
+    }
+    return 0;
+}
+
+int Y4MFrameSource::getChromaHeight() const noexcept {
+    switch (chroma) {
+        case Chroma::subsampled420:
+            return (height + 1) / 2;
+        case Chroma::subsampled422:
+        case Chroma::full444:
+            return height;
+        case Chroma::mono:
+            return 0;
+    }
+    return 0;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+
+#include <vector>
+
+#include "VideoFrameSource.h"
+
+/// Frames of an uncompressed YUV4MPEG2 (.y4m) proxy.
+/// Frame headers may carry parameters, so the index records where each frame's planes start.
+/// Supports 4:2:0, 4:2:2, 4:4:4 and mono 8-bit planes, converted with BT.601 coefficients.
+class Y4MFrameSource : public VideoFrameSource {
+public:
+    static constexpr const char* kFileExtension = "y4m";
+
+    bool open(const juce::File& file) override;
+    int64_t getNumFrames() const override;
+    double getNominalFrameRate() const override;
+    juce::Image readFrame(int64_t frameIndex, juce::Image recycled) override;
+
+    /// Frame width in pixels.
+    int getWidth() const noexcept { return width; }
+
+    /// Frame height in pixels.
+    int getHeight() const noexcept { return height; }
+
+private:
+    enum class Chroma {
+        subsampled420,
+        subsampled422,
+        full444,
+        mono
+    };
+
+    /// Parse the stream header line.
+    bool parseHeader(const juce::String& header);
+
+    /// Scan the frame headers after the stream header.
+    /// @param headers buffered view of the file, positioned after the stream header
+    void buildIndex(juce::InputStream& headers);
+
+    int getChromaWidth() const noexcept;
+    int getChromaHeight() const noexcept;
+
+    std::unique_ptr<juce::FileInputStream> stream;
+    int width = 0;
+    int height = 0;
+    double frameRate = 0.0;
+    Chroma chroma = Chroma::subsampled420;
+    bool fullRange = false;
+    size_t frameBytes = 0;
+    /// Offset of the planes of every frame, past its FRAME header.
+    std::vector<int64_t> frameOffsets;
+    /// Planes of the frame being converted, reused between reads.
+    std::vector<uint8_t> planes;
+};
@@ -0,0 +1,288 @@
+#include "FilmstripCache.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Gui/Video/Backend/VideoFrameSource.h"
+#include "Gui/Video/Backend/VideoThumbnailProviderFactory.h"
+#include "Gui/Video/Backend/VideoThumbnailProvider_Proxy.h"
+
+namespace {
+constexpr float kJpegQuality = 0.8f;
+
+/// Area of a thumbnail slot inside a strip.
+juce::Rectangle<int> getSlotArea(int slot) {
+    return { slot * FilmstripCache::kThumbnailWidth, 0, FilmstripCache::kThumbnailWidth, FilmstripCache::kThumbnailHeight };
+}
+} // namespace
+
+bool FilmstripCache::StripKey::operator==(const StripKey& other) const noexcept {
+    return path == other.path && level == other.level && stripIndex == other.stripIndex;
+}
+
+size_t FilmstripCache::StripKeyHash::operator()(const StripKey& key) const noexcept {
+    auto hash = static_cast<size_t>(key.path.hashCode64());
+    const auto combine = [&hash](size_t value) {
+        hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+    };
+    combine(std::hash<int> {}(key.level));
+    combine(std::hash<int64> {}(key.stripIndex));
+    return hash;
+}
+
+FilmstripCache::FilmstripCache()
+    : strips("FilmstripStrip",
+             1,
+             kDefaultMemoryBudget,
+             [](const juce::Image& strip) {
+                 return static_cast<size_t>(strip.getWidth()) * static_cast<size_t>(strip.getHeight()) * 4;
+             },
+             [this] { sendChangeMessage(); }) {
+}
+
+FilmstripCache& FilmstripCache::get() {
+    static FilmstripCache instance;
+    return instance;
+}
+
+FilmstripCache::~FilmstripCache() {
+    strips.clear();
+    const juce::ScopedLock scopedLock(lock);
+    index.save();
+}
+
+juce::File FilmstripCache::getDefaultCacheDirectory() {
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("AudioVision")
+        .getChildFile("FilmstripCache");
+}
+
+void FilmstripCache::setCacheDirectory(const juce::File& directory) {
+    const juce::ScopedLock scopedLock(lock);
+    if (directory == index.getDirectory()) {
+        return;
+    }
+    index.save();
+    index = ContentCacheIndex(directory, index.getMaxBytes(), ".jpg", kIndexFileName);
+}
+
+juce::File FilmstripCache::getCacheDirectory() const {
+    const juce::ScopedLock scopedLock(lock);
+    return index.getDirectory();
+}
+
+void FilmstripCache::setCacheSizeLimit(int64 maxBytes) {
+    const juce::ScopedLock scopedLock(lock);
+    index.setMaxBytes(maxBytes);
+}
+
+int FilmstripCache::getLevelForSpacing(double framesPerThumbnail) {
+    if (!(framesPerThumbnail > 1.0)) {
+        return 0;
+    }
+    return std::min(kMaxLevel, static_cast<int>(std::floor(std::log2(framesPerThumbnail))));
+}
+
+int64 FilmstripCache::getStripIndexForFrame(int level, int64 frame) {
+    if (frame < 0) {
+        return 0;
+    }
+    return (frame >> level) / kFramesPerStrip;
+}
+
+int64 FilmstripCache::getStripFirstFrame(int level, int64 stripIndex) {
+    return (stripIndex * kFramesPerStrip) << level;
+}
+
+int FilmstripCache::getThumbnailCount(const juce::Image& strip) {
+    return strip.isValid() ? strip.getWidth() / kThumbnailWidth : 0;
+}
+
+juce::Image FilmstripCache::getStrip(const StripKey& key, double frameRate) {
+    if (frameRate <= 0.0 || key.level < 0 || key.level > kMaxLevel || key.stripIndex < 0) {
+        // Strips need a positive frame rate and a level and index inside the pyramid.
+        jassert(false);
+        return {};
+    }
+    if (const auto strip = strips.find(key)) {
+        return *strip;
+    }
+    // Strips past the end of the video are cached invalid; strips that failed to build are not cached.
+    strips.request(key, [this, key, frameRate] { return loadOrBuild(key, frameRate); });
+    return {};
+}
+
+void FilmstripCache::advanceViewGeneration() {
+    strips.advanceGeneration();
+}
+
+bool FilmstripCache::waitForPendingBuilds(int timeoutMs) {
+    return strips.waitForPendingBuilds(timeoutMs);
+}
+
+void FilmstripCache::setMemoryBudget(size_t bytes) {
+    strips.setMemoryBudget(bytes);
+}
+
+size_t FilmstripCache::getMemoryUsage() const {
+    return strips.getMemoryUsage();
+}
+
+void FilmstripCache::clear() {
+    strips.clear();
+}
+
+std::optional<juce::Image> FilmstripCache::loadOrBuild(const StripKey& key, double frameRate) {
+    const auto contentKey = fingerprints.getKey(juce::File(key.path));
+    if (contentKey.isEmpty()) {
+        return std::nullopt;
+    }
+    const auto diskKey = getDiskKey(contentKey, key.level, key.stripIndex);
+    if (auto strip = readStripFile(diskKey); strip.isValid()) {
+        return strip;
+    }
+    std::optional<juce::Image> strip = downsampleFinerLevel(contentKey, key);
+    if (!strip->isValid()) {
+        strip = decodeStrip(contentKey, key, frameRate);
+    }
+    if (strip.has_value() && strip->isValid()) {
+        writeStripFile(diskKey, *strip);
+    }
+    return strip;
+}
+
+juce::Image FilmstripCache::downsampleFinerLevel(const juce::String& contentKey, const StripKey& key) {
+    if (key.level == 0) {
+        return {};
+    }
+    // Thumbnail i of the strip is thumbnail 2i of the two finer strips laid end to end.
+    const auto first = readStripFile(getDiskKey(contentKey, key.level - 1, key.stripIndex * 2));
+    if (!first.isValid()) {
+        return {};
+    }
+    const auto firstCount = getThumbnailCount(first);
+    juce::Image second;
+    if (firstCount == kFramesPerStrip) {
+        second = readStripFile(getDiskKey(contentKey, key.level - 1, key.stripIndex * 2 + 1));
+        if (!second.isValid()) {
+            // Only the end of the video has a single finer strip; here the second one is missing.
+            return {};
+        }
+    }
+    const auto count = (firstCount + getThumbnailCount(second) + 1) / 2;
+    // Software images can be drawn into off the message thread.
+    juce::Image strip(juce::Image::RGB, count * kThumbnailWidth, kThumbnailHeight, true, juce::SoftwareImageType());
+    {
+        juce::Graphics g(strip);
+        for (int slot = 0; slot < count; ++slot) {
+            const auto finerSlot = slot * 2;
+            const auto& source = finerSlot < kFramesPerStrip ? first : second;
+            const auto sourceArea = getSlotArea(finerSlot % kFramesPerStrip);
+            const auto area = getSlotArea(slot);
+            g.drawImage(source,
+                        area.getX(), area.getY(), area.getWidth(), area.getHeight(),
+                        sourceArea.getX(), sourceArea.getY(), sourceArea.getWidth(), sourceArea.getHeight());
+        }
+    }
+    return strip;
+}
+
+std::optional<juce::Image> FilmstripCache::decodeStrip(const juce::String& contentKey, const StripKey& key, double frameRate) {
+    auto& video = openVideos[key.path];
+    if (video.provider == nullptr || video.contentKey != contentKey) {
+        const juce::File file(key.path);
+        // Proxies are read directly on every platform.
+        if (isVideoProxyFile(file)) {
+            video.provider = std::make_unique<VideoThumbnailProvider_Proxy>();
+        } else {
+            video.provider = createVideoThumbnailProvider();
+        }
+        video.contentKey = contentKey;
+        if (video.provider != nullptr) {
+            video.provider->setVideoFile(VideoFile(file, file.getFileName()));
+        }
+    }
+    if (video.provider == nullptr || !video.provider->isReady()) {
+        return std::nullopt;
+    }
+    const auto frameCount = video.provider->getNumFrames(frameRate);
+    if (frameCount < 0) {
+        juce::Logger::writeToLog("FilmstripCache: unknown length for " + key.path);
+        return std::nullopt;
+    }
+    const auto firstFrame = getStripFirstFrame(key.level, key.stripIndex);
+    if (firstFrame >= frameCount) {
+        return juce::Image();
+    }
+    // Thumbnails of the strip that start before the last frame.
+    const auto count = static_cast<int>(std::min<int64>(kFramesPerStrip, ((frameCount - firstFrame - 1) >> key.level) + 1));
+    juce::Image strip(juce::Image::RGB, count * kThumbnailWidth, kThumbnailHeight, true, juce::SoftwareImageType());
+    {
+        juce::Graphics g(strip);
+        g.setImageResamplingQuality(juce::Graphics::mediumResamplingQuality);
+        for (int slot = 0; slot < count; ++slot) {
+            const auto frame = video.provider->getFrameAtIndex(firstFrame + (int64 { slot } << key.level), frameRate);
+            if (!frame.isValid()) {
+                // A frame inside the video failed to decode: a partial strip must not be stored.
+                juce::Logger::writeToLog("FilmstripCache: cannot decode frame "
+                                         + juce::String(firstFrame + (int64 { slot } << key.level)) + " of " + key.path);
+                return std::nullopt;
+            }
+            g.drawImageWithin(frame,
+                              slot * kThumbnailWidth, 0, kThumbnailWidth, kThumbnailHeight,
+                              juce::RectanglePlacement::centred);
+        }
+    }
+    return strip;
+}
+
+juce::Image FilmstripCache::readStripFile(const juce::String& diskKey) {
+    juce::File file;
+    {
+        const juce::ScopedLock scopedLock(lock);
+        if (!index.contains(diskKey)) {
+            return {};
+        }
+        index.touch(diskKey);
+        file = index.getFilePath(diskKey);
+    }
+    auto strip = juce::ImageFileFormat::loadFrom(file);
+    if (!strip.isValid() || strip.getHeight() != kThumbnailHeight || getThumbnailCount(strip) == 0) {
+        // Unreadable or written with another thumbnail size: rebuilt from the video.
+        const juce::ScopedLock scopedLock(lock);
+        index.remove(diskKey);
+        return {};
+    }
+    return strip;
+}
+
+void FilmstripCache::writeStripFile(const juce::String& diskKey, const juce::Image& strip) {
+    juce::File file;
+    {
+        const juce::ScopedLock scopedLock(lock);
+        file = index.getFilePath(diskKey);
+    }
+    juce::JPEGImageFormat format;
+    format.setQuality(kJpegQuality);
+    {
+        // Replaced in one step so a crash never leaves a truncated strip.
+        juce::TemporaryFile temporary(file);
+        {
+            juce::FileOutputStream out(temporary.getFile());
+            if (!out.openedOk() || !format.writeImageToStream(strip, out)) {
+                juce::Logger::writeToLog("FilmstripCache: cannot write " + file.getFullPathName());
+                return;
+            }
+        }
+        if (!temporary.overwriteTargetFileWithTemporary()) {
+            juce::Logger::writeToLog("FilmstripCache: cannot write " + file.getFullPathName());
+            return;
+        }
+    }
+    const juce::ScopedLock scopedLock(lock);
+    index.add(diskKey, file.getSize());
+}
+
+juce::String FilmstripCache::getDiskKey(const juce::String& contentKey, int level, int64 stripIndex) {
+    return contentKey + "-L" + juce::String(level) + "-" + juce::String(stripIndex);
+}
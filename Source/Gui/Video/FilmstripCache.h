@@ -0,0 +1,149 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <memory>
+#include <optional>
+#include <unordered_map>
+
+#include "Gui/Video/Backend/VideoThumbnailProvider.h"
+#include "Utils/Cache/ContentCacheIndex.h"
+#include "Utils/Cache/FingerprintCache.h"
+#include "Utils/Cache/GenerationalLruCache.h"
+
+/// Thumbnail strips for the timeline filmstrip, kept in an on-disk pyramid shared by every view.
+/// Level L holds one thumbnail every 2^L frames, and a strip packs kFramesPerStrip consecutive
+/// thumbnails of one level, so any zoom is drawn from strips of the nearest level and scrolling
+/// only loads the newly exposed ones. Strips are stored as JPEG files in a content-addressed
+/// directory (see ContentCacheIndex), like peak files, so a reel is decoded once per level across
+/// sessions; a missing strip is downsampled from the finer level when that is on disk.
+/// Broadcasts a change message whenever a requested strip becomes available.
+class FilmstripCache : public juce::ChangeBroadcaster {
+public:
+    /// Thumbnails per strip.
+    static constexpr int kFramesPerStrip = 32;
+    /// Stored thumbnail size in pixels; frames are fitted inside keeping their aspect ratio.
+    static constexpr int kThumbnailWidth = 128;
+    static constexpr int kThumbnailHeight = 72;
+    /// Coarsest level (one thumbnail every 2^kMaxLevel frames).
+    static constexpr int kMaxLevel = 20;
+    /// Name of the index file inside the cache directory.
+    static constexpr const char* kIndexFileName = "strips.index";
+    /// Default total size of the strip files.
+    static constexpr int64 kDefaultCacheBytes = int64 { 1 } * 1024 * 1024 * 1024;
+    /// Default memory budget for loaded strips.
+    static constexpr size_t kDefaultMemoryBudget = size_t { 64 } * 1024 * 1024;
+
+    struct StripKey {
+        /// Video file path.
+        juce::String path;
+        int level = 0;
+        int64 stripIndex = 0;
+
+        bool operator==(const StripKey& other) const noexcept;
+    };
+
+    /// Shared cache instance.
+    static FilmstripCache& get();
+
+    ~FilmstripCache() override;
+
+    /// Default cache directory, in the user application data folder.
+    static juce::File getDefaultCacheDirectory();
+
+    /// Move the cache to another directory (strips already stored elsewhere are not moved).
+    /// @param directory cache directory
+    void setCacheDirectory(const juce::File& directory);
+
+    /// Current cache directory.
+    juce::File getCacheDirectory() const;
+
+    /// Change the total size budget, evicting least recently used strip files as needed.
+    /// @param maxBytes size budget in bytes
+    void setCacheSizeLimit(int64 maxBytes);
+
+    /// Level whose thumbnail spacing is the widest not exceeding a thumbnail width.
+    /// @param framesPerThumbnail frames covered by one thumbnail width at the current zoom
+    static int getLevelForSpacing(double framesPerThumbnail);
+
+    /// Strip holding the thumbnail at or before a frame.
+    /// @param level pyramid level
+    /// @param frame frame index from the start of the file
+    static int64 getStripIndexForFrame(int level, int64 frame);
+
+    /// Frame shown by the first thumbnail of a strip.
+    /// @param level pyramid level
+    /// @param stripIndex strip index from the start of the file
+    static int64 getStripFirstFrame(int level, int64 stripIndex);
+
+    /// Number of thumbnails in a strip (the last strip of a file may be shorter).
+    /// @param strip strip image
+    static int getThumbnailCount(const juce::Image& strip);
+
+    /// Cached strip image, or an invalid image after queuing its load or build.
+    /// Strips past the end of the video stay invalid.
+    /// @param key strip to fetch
+    /// @param frameRate frames per second, for providers that seek by time
+    juce::Image getStrip(const StripKey& key, double frameRate);
+
+    /// Mark queued builds as stale after a view change; they are skipped unless requested again.
+    void advanceViewGeneration();
+
+    /// Wait for every queued strip to be loaded or built.
+    /// @param timeoutMs maximum wait in milliseconds
+    /// @return true when no build is left
+    bool waitForPendingBuilds(int timeoutMs);
+
+    /// Change the memory budget, evicting as needed.
+    /// @param bytes budget for strip images
+    void setMemoryBudget(size_t bytes);
+
+    /// Bytes held by loaded strip images.
+    size_t getMemoryUsage() const;
+
+    /// Drop every loaded strip and queued build (strip files stay on disk).
+    void clear();
+
+private:
+    struct StripKeyHash {
+        size_t operator()(const StripKey& key) const noexcept;
+    };
+
+    struct OpenVideo {
+        /// Content key the provider was opened for; a changed file is reopened.
+        juce::String contentKey;
+        std::unique_ptr<VideoThumbnailProvider> provider;
+    };
+
+    FilmstripCache();
+
+    /// Strip from disk, from the finer level on disk, or decoded from the video (worker thread).
+    /// @return the strip, an invalid image past the end of the video, or std::nullopt when it cannot be read
+    std::optional<juce::Image> loadOrBuild(const StripKey& key, double frameRate);
+
+    /// Every other thumbnail of the two finer strips covering a strip, or an invalid image
+    /// when they are not both on disk (worker thread).
+    juce::Image downsampleFinerLevel(const juce::String& contentKey, const StripKey& key);
+
+    /// Decode a strip's frames from the video, up to its last frame (worker thread).
+    /// @return the strip, an invalid image past the end of the video, or std::nullopt when a frame cannot be read
+    std::optional<juce::Image> decodeStrip(const juce::String& contentKey, const StripKey& key, double frameRate);
+
+    /// Load a strip file listed in the index (worker thread).
+    juce::Image readStripFile(const juce::String& diskKey);
+
+    /// Store a strip file and index it (worker thread).
+    void writeStripFile(const juce::String& diskKey, const juce::Image& strip);
+
+    /// File name of a strip in the cache directory, without extension.
+    static juce::String getDiskKey(const juce::String& contentKey, int level, int64 stripIndex);
+
+    mutable juce::CriticalSection lock;
+    ContentCacheIndex index { getDefaultCacheDirectory(), kDefaultCacheBytes, ".jpg", kIndexFileName };
+    FingerprintCache fingerprints;
+    /// Open video per file path (worker thread only).
+    std::unordered_map<juce::String, OpenVideo> openVideos;
+    /// Loaded strips, built by one worker so each video is read by a single provider at a time.
+    /// Declared last so its builds stop before the state they use goes away.
+    GenerationalLruCache<StripKey, juce::Image, StripKeyHash> strips;
+};
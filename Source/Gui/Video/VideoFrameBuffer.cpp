@@ -1,54 +1,137 @@
 #include "VideoFrameBuffer.h"
 
+#include <algorithm>
+#include <utility>
+
 VideoFrameBuffer::VideoFrameBuffer(size_t maxFrames)
-    : maxFrames(maxFrames) {
+    : slots(std::max<size_t>(1, maxFrames)) {
 }
 
 void VideoFrameBuffer::clear() {
-    frames.clear();
+    // A seek discards frames on purpose, so they are not counted as dropped.
+    for (auto& slot : slots) {
+        slot.index = -1;
+        slot.shown = false;
+    }
+    count = 0;
+    firstIndex = -1;
+    lastIndex = -1;
+    lastRequestedIndex = -1;
+}
+
+juce::Image VideoFrameBuffer::recycleImage(int64_t frameIndex) {
+    if (frameIndex < 0) {
+        return {};
+    }
+    auto& slot = slotFor(frameIndex);
+    // The slot holds the only reference, so nobody can be drawing it.
+    if (!slot.image.isValid() || slot.image.getReferenceCount() > 1) {
+        return {};
+    }
+    release(slot);
+    return std::exchange(slot.image, juce::Image());
 }
 
 void VideoFrameBuffer::pushFrame(int64_t frameIndex, const juce::Image& image) {
-    if (!image.isValid()) {
+    if (!image.isValid() || frameIndex < 0) {
         return;
     }
-    if (!frames.empty() && frames.back().index == frameIndex) {
+    const auto capacity = static_cast<int64_t>(slots.size());
+    if (lastIndex >= 0 && frameIndex <= lastIndex - capacity) {
         return;
     }
-    frames.push_back({ frameIndex, image });
-    if (frames.size() > maxFrames) {
-        frames.pop_front();
+    if (frameIndex < lastRequestedIndex) {
+        ++lateFrames;
     }
+    if (frameIndex > lastIndex) {
+        // Frames sliding out of the window are released; at most one pass over the ring.
+        const auto windowStart = frameIndex - capacity + 1;
+        if (count > 0) {
+            const auto releaseEnd = std::min(windowStart, lastIndex + 1);
+            for (auto index = std::max<int64_t>(firstIndex, lastIndex - capacity + 1); index < releaseEnd; ++index) {
+                auto& slot = slotFor(index);
+                if (slot.index == index) {
+                    release(slot);
+                }
+            }
+        }
+        lastIndex = frameIndex;
+        firstIndex = count == 0 ? frameIndex : std::max(firstIndex, windowStart);
+    } else {
+        firstIndex = std::min(firstIndex, frameIndex);
+    }
+
+    auto& slot = slotFor(frameIndex);
+    if (slot.index == frameIndex) {
+        return;
+    }
+    release(slot);
+    slot.index = frameIndex;
+    slot.image = image;
+    slot.shown = false;
+    ++count;
 }
 
-juce::Image VideoFrameBuffer::getExactFrame(int64_t frameIndex) const {
-    for (auto it = frames.rbegin(); it != frames.rend(); ++it) {
-        if (it->index == frameIndex) {
-            return it->image;
-        }
+juce::Image VideoFrameBuffer::getExactFrame(int64_t frameIndex) {
+    if (frameIndex < 0) {
+        return {};
     }
-    return {};
+    lastRequestedIndex = std::max(lastRequestedIndex, frameIndex);
+    auto& slot = slotFor(frameIndex);
+    if (slot.index != frameIndex) {
+        return {};
+    }
+    slot.shown = true;
+    return slot.image;
 }
 
 int64_t VideoFrameBuffer::getLastFrameIndex() const {
-    return frames.empty() ? -1 : frames.back().index;
+    return count == 0 ? -1 : lastIndex;
 }
 
 int64_t VideoFrameBuffer::getFirstFrameIndex() const {
-    return frames.empty() ? -1 : frames.front().index;
+    return count == 0 ? -1 : firstIndex;
 }
 
 juce::String VideoFrameBuffer::getIndexList() const {
     juce::String list;
-    for (size_t i = 0; i < frames.size(); ++i) {
-        if (i > 0) {
+    if (count == 0) {
+        return list;
+    }
+    for (auto index = firstIndex; index <= lastIndex; ++index) {
+        const auto& slot = slots[static_cast<size_t>(index % static_cast<int64_t>(slots.size()))];
+        if (slot.index != index) {
+            continue;
+        }
+        if (list.isNotEmpty()) {
             list << ",";
         }
-        list << frames[i].index;
+        list << index;
     }
     return list;
 }
 
 size_t VideoFrameBuffer::size() const {
-    return frames.size();
+    return count;
+}
+
+void VideoFrameBuffer::resetCounters() noexcept {
+    droppedFrames = 0;
+    lateFrames = 0;
+}
+
+VideoFrameBuffer::Slot& VideoFrameBuffer::slotFor(int64_t frameIndex) {
+    return slots[static_cast<size_t>(frameIndex % static_cast<int64_t>(slots.size()))];
+}
+
+void VideoFrameBuffer::release(Slot& slot) {
+    if (slot.index < 0) {
+        return;
+    }
+    if (!slot.shown) {
+        ++droppedFrames;
+    }
+    slot.index = -1;
+    slot.shown = false;
+    --count;
 }
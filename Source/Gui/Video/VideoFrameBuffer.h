@@ -2,30 +2,42 @@
 
 #include <juce_graphics/juce_graphics.h>
 
-#include <deque>
+#include <vector>
 
-/// Store decoded video frames by index.
+/// Store decoded video frames by index in a fixed ring of slots.
+/// A frame lives in slot frameIndex % capacity, so lookups are O(1) and the buffer holds the
+/// latest capacity frame numbers. Slot images are handed back to the decoder for reuse, so
+/// steady playback does not allocate a frame per decode.
+/// Not thread safe; owners guard it with their own lock.
 class VideoFrameBuffer {
 public:
-    /// @param maxFrames maximum stored frames
+    /// @param maxFrames number of slots
     explicit VideoFrameBuffer(size_t maxFrames);
 
-    /// Clear all buffered frames.
+    /// Clear all buffered frames, keeping their images for reuse.
     void clear();
 
+    /// Take the image of the slot a frame will be stored in, for the decoder to write into.
+    /// The frame held there leaves the buffer now. Images still referenced elsewhere, for
+    /// example by the display, are never handed out.
+    /// @param frameIndex frame about to be decoded
+    /// @return a reusable image (any size), or an invalid image when the decoder must allocate
+    juce::Image recycleImage(int64_t frameIndex);
+
     /// Push a new frame into the buffer.
+    /// Frames older than the buffer window are ignored.
     /// @param frameIndex decoded frame index
     /// @param image decoded frame image
     void pushFrame(int64_t frameIndex, const juce::Image& image);
 
-    /// Fetch an exact frame if present.
+    /// Fetch an exact frame if present, marking it as shown.
     /// @param frameIndex frame index to find
-    juce::Image getExactFrame(int64_t frameIndex) const;
+    juce::Image getExactFrame(int64_t frameIndex);
 
     /// Read the last frame index in the buffer.
     int64_t getLastFrameIndex() const;
 
-    /// Read the first frame index in the buffer.
+    /// Read the first frame index the buffer window covers.
     int64_t getFirstFrameIndex() const;
 
     /// Build a comma-separated list of buffered frame indices for diagnostics.
@@ -34,12 +46,33 @@ public:
     /// Read the number of buffered frames.
     size_t size() const;
 
+    /// Number of frames that left the buffer without ever being shown.
+    uint64_t getDroppedFrameCount() const noexcept { return droppedFrames; }
+
+    /// Number of frames pushed after a later frame had already been asked for.
+    uint64_t getLateFrameCount() const noexcept { return lateFrames; }
+
+    /// Reset the dropped and late frame counters.
+    void resetCounters() noexcept;
+
 private:
-    struct Entry {
+    struct Slot {
         int64_t index = -1;
         juce::Image image;
+        bool shown = false;
     };
 
-    size_t maxFrames = 0;
-    std::deque<Entry> frames;
+    Slot& slotFor(int64_t frameIndex);
+
+    /// Empty a slot, counting its frame as dropped when it was never shown.
+    void release(Slot& slot);
+
+    std::vector<Slot> slots;
+    size_t count = 0;
+    int64_t firstIndex = -1;
+    int64_t lastIndex = -1;
+    /// Latest frame asked for through getExactFrame().
+    int64_t lastRequestedIndex = -1;
+    uint64_t droppedFrames = 0;
+    uint64_t lateFrames = 0;
 };
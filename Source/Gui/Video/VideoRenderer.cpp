@@ -68,6 +68,14 @@ double VideoRenderer::getNominalFrameRate() const {
     return backend ? backend->getNominalFrameRate() : 0.0;
 }
 
+uint64_t VideoRenderer::getDroppedFrameCount() const {
+    return backend ? backend->getDroppedFrameCount() : 0;
+}
+
+uint64_t VideoRenderer::getLateFrameCount() const {
+    return backend ? backend->getLateFrameCount() : 0;
+}
+
 void VideoRenderer::setPreviewFrame(const juce::Image& frame) {
     if (!frame.isValid()) {
         return;
@@ -51,6 +51,12 @@ public:
     /// Read the nominal frame rate reported by the backend.
     double getNominalFrameRate() const;
 
+    /// Read how many decoded frames were never shown.
+    uint64_t getDroppedFrameCount() const;
+
+    /// Read how many frames were decoded after the playhead had passed them.
+    uint64_t getLateFrameCount() const;
+
     /// Override the displayed frame with a preview image.
     /// @param frame still image to display
     void setPreviewFrame(const juce::Image& frame);
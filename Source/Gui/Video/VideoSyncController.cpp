@@ -70,6 +70,8 @@ void VideoSyncController::update() {
         thumbnailCache.cancelPending();
         pendingPausedFrame = false;
         lastPausedFrame = std::numeric_limits<int64_t>::min();
+        lastScrubFrame = std::numeric_limits<int64_t>::min();
+        scrubVelocity = 0.0;
     } else if (!isPlaying && wasPlaying) {
         lastPausedFrame = std::numeric_limits<int64_t>::min();
     }
@@ -121,10 +123,26 @@ void VideoSyncController::update() {
                     }
                 });
         }
+        updateScrubPrefetch(frame, frameRate);
     }
     wasPlaying = isPlaying;
 }
 
+void VideoSyncController::updateScrubPrefetch(int64 frame, double frameRate) {
+    const auto delta = lastScrubFrame == std::numeric_limits<int64_t>::min()
+                           ? 0.0
+                           : static_cast<double>(frame - lastScrubFrame);
+    // Smoothed so a single jump does not swing the prefetch window.
+    scrubVelocity = 0.5 * scrubVelocity + 0.5 * delta;
+    if (frame == lastScrubFrame) {
+        return;
+    }
+    lastScrubFrame = frame;
+    const auto outFrame = activeClip->getOutFrame();
+    const auto frameCount = outFrame < 0 ? int64_t { -1 } : outFrame - activeClip->getInFrame() + 1;
+    thumbnailCache.prefetchAround(frame - activeClip->getInFrame(), frameRate, scrubVelocity, frameCount);
+}
+
 void VideoSyncController::updatePendingInitialFrame(double frameRate) {
     if (!thumbnailCache.isReady()) {
         return;
@@ -21,6 +21,7 @@ public:
 
 private:
     void updatePendingInitialFrame(double frameRate);
+    void updateScrubPrefetch(int64 frame, double frameRate);
     const VideoClip* resolveClipForFrame(int64 frame) const;
 
     Edit& edit;
@@ -33,6 +34,10 @@ private:
     juce::File pendingInitialFrameFile;
     int64_t lastPausedFrame = std::numeric_limits<int64_t>::min();
     bool pendingPausedFrame = false;
+    /// Last paused frame seen, to estimate scrub direction and speed for prefetching.
+    int64_t lastScrubFrame = std::numeric_limits<int64_t>::min();
+    /// Smoothed scrub speed in frames per update.
+    double scrubVelocity = 0.0;
     bool checkedNominalFrameRate = false;
     bool wasPlaying = false;
 
@@ -1,28 +1,35 @@
 #include "VideoThumbnailCache.h"
 
+#include <algorithm>
+#include <cmath>
+
 VideoThumbnailCache::RequestJob::RequestJob(VideoThumbnailCache& cache,
                                             int64_t key,
-                                            double seconds,
+                                            double frameRate,
                                             uint32_t generation)
     : ThreadPoolJob("VideoThumbnailRequest"),
       cache(cache),
       key(key),
-      seconds(seconds),
+      frameRate(frameRate),
       generation(generation) {
 }
 
 juce::ThreadPoolJob::JobStatus VideoThumbnailCache::RequestJob::runJob() {
-    if (shouldExit()) {
+    if (shouldExit() || !cache.shouldFetch(key, generation)) {
         return jobHasFinished;
     }
     juce::Image frame;
     if (cache.provider && cache.provider->isReady()) {
-        frame = cache.provider->getFrameAtSeconds(seconds);
+        frame = cache.scaleToDisplay(cache.provider->getFrameAtIndex(key, frameRate));
     }
     cache.dispatchResult(key, generation, frame);
     return jobHasFinished;
 }
 
+VideoThumbnailCache::VideoThumbnailCache(std::unique_ptr<VideoThumbnailProvider> provider)
+    : provider(std::move(provider)) {
+}
+
 VideoThumbnailCache::~VideoThumbnailCache() {
     cancelPending();
 }
@@ -35,7 +42,7 @@ void VideoThumbnailCache::setVideoFile(const VideoFile& file) {
     cancelPending();
     {
         const juce::ScopedLock scopedLock(lock);
-        cache.clear();
+        thumbnails.clear();
         pending.clear();
         currentFile = nextFile;
         ++generation;
@@ -45,6 +52,16 @@ void VideoThumbnailCache::setVideoFile(const VideoFile& file) {
     }
 }
 
+void VideoThumbnailCache::setDisplaySize(int maxWidth, int maxHeight) {
+    const juce::ScopedLock scopedLock(lock);
+    if (maxWidth == displayWidth && maxHeight == displayHeight) {
+        return;
+    }
+    displayWidth = std::max(0, maxWidth);
+    displayHeight = std::max(0, maxHeight);
+    thumbnails.clear();
+}
+
 void VideoThumbnailCache::requestFrameIndex(int64_t frameIndex,
                                             double frameRate,
                                             std::function<void(const juce::Image&)> callback) {
@@ -56,22 +73,17 @@ void VideoThumbnailCache::requestFrameIndex(int64_t frameIndex,
         jassert(false);
         return;
     }
-    const double seconds = static_cast<double>(frameIndex) / frameRate;
     const auto key = frameIndex;
     juce::Image cachedFrame;
     bool shouldQueue = false;
     {
         const juce::ScopedLock scopedLock(lock);
-        const auto cachedIt = cache.find(key);
-        if (cachedIt != cache.end()) {
-            cachedFrame = cachedIt->second;
-        } else {
-            auto& entry = pending[key];
-            if (entry.callbacks.empty()) {
-                entry.seconds = seconds;
-                shouldQueue = true;
-            }
-            entry.callbacks.push_back(std::move(callback));
+        cachedFrame = thumbnails.find(key).value_or(juce::Image());
+        if (!cachedFrame.isValid()) {
+            // A queued prefetch for the same frame is reused; the callback keeps it from being skipped.
+            const auto [pendingIt, inserted] = pending.try_emplace(key);
+            shouldQueue = inserted;
+            pendingIt->second.callbacks.push_back(std::move(callback));
         }
     }
     if (cachedFrame.isValid()) {
@@ -81,10 +93,97 @@ void VideoThumbnailCache::requestFrameIndex(int64_t frameIndex,
         return;
     }
     if (shouldQueue) {
-        pool.addJob(new RequestJob(*this, key, seconds, generation.load()), true);
+        pool.addJob(new RequestJob(*this, key, frameRate, generation.load()), true);
     }
 }
 
+void VideoThumbnailCache::prefetchAround(int64_t frameIndex,
+                                         double frameRate,
+                                         double framesPerTick,
+                                         int64_t frameCount) {
+    if (!provider) {
+        return;
+    }
+    if (frameRate <= 0.0) {
+        // Frame rate must be positive to compute thumbnail time.
+        jassert(false);
+        return;
+    }
+    std::vector<int64_t> toQueue;
+    {
+        const juce::ScopedLock scopedLock(lock);
+        const auto round = ++prefetchRound;
+        for (const auto frame : getPrefetchFrames(frameIndex, framesPerTick, frameCount)) {
+            if (thumbnails.find(frame).has_value()) {
+                continue;
+            }
+            const auto [pendingIt, inserted] = pending.try_emplace(frame);
+            pendingIt->second.prefetchRound = round;
+            if (inserted) {
+                toQueue.push_back(frame);
+            }
+        }
+    }
+    const auto requestGeneration = generation.load();
+    for (const auto frame : toQueue) {
+        pool.addJob(new RequestJob(*this, frame, frameRate, requestGeneration), true);
+    }
+}
+
+std::vector<int64_t> VideoThumbnailCache::getPrefetchFrames(int64_t frameIndex,
+                                                            double framesPerTick,
+                                                            int64_t frameCount) {
+    const auto speed = std::abs(framesPerTick);
+    const auto isScrubbing = speed >= 0.5;
+    const auto stride = std::max<int64_t>(1, static_cast<int64_t>(std::llround(speed)));
+    const int64_t direction = framesPerTick < 0.0 ? -1 : 1;
+    const auto ahead = isScrubbing ? kPrefetchAhead : kPrefetchBehind;
+
+    std::vector<int64_t> frames;
+    frames.reserve(static_cast<size_t>(kPrefetchAhead + kPrefetchBehind));
+    const auto addFrame = [&frames, frameCount](int64_t frame) {
+        if (frame >= 0 && (frameCount < 0 || frame < frameCount)) {
+            frames.push_back(frame);
+        }
+    };
+    for (int step = 1; step <= std::max(ahead, kPrefetchBehind); ++step) {
+        if (step <= ahead) {
+            addFrame(frameIndex + direction * stride * step);
+        }
+        // Frames behind a scrub were likely just shown; only the nearest are kept warm for a reversal.
+        if (step <= kPrefetchBehind) {
+            addFrame(frameIndex - direction * step);
+        }
+    }
+    return frames;
+}
+
+void VideoThumbnailCache::setMemoryBudget(size_t bytes) {
+    const juce::ScopedLock scopedLock(lock);
+    thumbnails.setMemoryBudget(bytes);
+}
+
+size_t VideoThumbnailCache::getMemoryUsage() const {
+    const juce::ScopedLock scopedLock(lock);
+    return thumbnails.getMemoryUsage();
+}
+
+bool VideoThumbnailCache::isCached(int64_t frameIndex) const {
+    const juce::ScopedLock scopedLock(lock);
+    return thumbnails.contains(frameIndex);
+}
+
+bool VideoThumbnailCache::waitForPendingRequests(int timeoutMs) {
+    const auto deadline = juce::Time::getMillisecondCounter() + static_cast<uint32_t>(timeoutMs);
+    while (pool.getNumJobs() > 0) {
+        if (juce::Time::getMillisecondCounter() >= deadline) {
+            return false;
+        }
+        juce::Thread::sleep(5);
+    }
+    return true;
+}
+
 bool VideoThumbnailCache::isReady() const {
     return provider && provider->isReady();
 }
@@ -96,6 +195,47 @@ void VideoThumbnailCache::cancelPending() {
     ++generation;
 }
 
+bool VideoThumbnailCache::shouldFetch(int64_t key, uint32_t requestGeneration) {
+    const juce::ScopedLock scopedLock(lock);
+    if (requestGeneration != generation.load()) {
+        return false;
+    }
+    const auto pendingIt = pending.find(key);
+    if (pendingIt == pending.end()) {
+        return false;
+    }
+    if (pendingIt->second.callbacks.empty() && pendingIt->second.prefetchRound != prefetchRound) {
+        // Nobody waits for it and the latest prefetch no longer wants it.
+        pending.erase(pendingIt);
+        return false;
+    }
+    return true;
+}
+
+juce::Image VideoThumbnailCache::scaleToDisplay(const juce::Image& frame) const {
+    if (!frame.isValid()) {
+        return frame;
+    }
+    int maxWidth = 0;
+    int maxHeight = 0;
+    {
+        const juce::ScopedLock scopedLock(lock);
+        maxWidth = displayWidth;
+        maxHeight = displayHeight;
+    }
+    if (maxWidth <= 0 || maxHeight <= 0) {
+        return frame;
+    }
+    const auto scale = std::min(static_cast<double>(maxWidth) / frame.getWidth(),
+                                static_cast<double>(maxHeight) / frame.getHeight());
+    if (scale >= 1.0) {
+        return frame;
+    }
+    return frame.rescaled(std::max(1, juce::roundToInt(frame.getWidth() * scale)),
+                          std::max(1, juce::roundToInt(frame.getHeight() * scale)),
+                          juce::Graphics::mediumResamplingQuality);
+}
+
 void VideoThumbnailCache::dispatchResult(int64_t key, uint32_t requestGeneration,
                                          const juce::Image& frame) {
     std::vector<std::function<void(const juce::Image&)>> callbacks;
@@ -111,7 +251,7 @@ void VideoThumbnailCache::dispatchResult(int64_t key, uint32_t requestGeneration
             pending.erase(pendingIt);
         }
         if (frame.isValid()) {
-            cache[key] = frame;
+            thumbnails.add(key, frame);
         }
     }
     if (callbacks.empty()) {
@@ -6,19 +6,40 @@
 #include "Core/Video/VideoFile.h"
 #include "Gui/Video/Backend/VideoThumbnailProvider.h"
 #include "Gui/Video/Backend/VideoThumbnailProviderFactory.h"
+#include "Utils/Cache/LruCache.h"
 
+#include <atomic>
 #include <functional>
 #include <unordered_map>
+#include <vector>
 
 /// Cache video thumbnails asynchronously for UI usage.
+/// Frames are scaled down to the display size before caching and kept in a least recently used
+/// list under a memory budget, so a long scrubbing session stays bounded.
 class VideoThumbnailCache {
 public:
+    /// Default memory budget for cached thumbnails.
+    static constexpr size_t kDefaultMemoryBudget = size_t { 128 } * 1024 * 1024;
+    /// Frames prefetched in the scrub direction.
+    static constexpr int kPrefetchAhead = 6;
+    /// Frames prefetched against the scrub direction, or on each side of a still playhead.
+    static constexpr int kPrefetchBehind = 2;
+
+    /// Create a cache reading frames through a provider.
+    /// @param provider frame source (the platform provider by default)
+    explicit VideoThumbnailCache(std::unique_ptr<VideoThumbnailProvider> provider = createVideoThumbnailProvider());
     ~VideoThumbnailCache();
 
     /// Request a thumbnail for the given file.
     /// @param file video file to read
     void setVideoFile(const VideoFile& file);
 
+    /// Bound thumbnails to the display size; larger frames are scaled down keeping their aspect ratio.
+    /// Changing the size drops cached thumbnails.
+    /// @param maxWidth width in physical pixels (0 keeps the source size)
+    /// @param maxHeight height in physical pixels (0 keeps the source size)
+    void setDisplaySize(int maxWidth, int maxHeight);
+
     /// Request a still frame at a given frame index.
     /// @param frameIndex frame index to fetch
     /// @param frameRate frames per second
@@ -27,6 +48,37 @@ public:
                            double frameRate,
                            std::function<void(const juce::Image&)> callback);
 
+    /// Queue frames around a scrub position, replacing the previous prefetch.
+    /// Prefetched frames that have not started yet are skipped once the scrub moves on.
+    /// @param frameIndex frame under the playhead
+    /// @param frameRate frames per second
+    /// @param framesPerTick signed scrub speed in frames per update
+    /// @param frameCount frames in the clip, or -1 when unbounded
+    void prefetchAround(int64_t frameIndex, double frameRate, double framesPerTick, int64_t frameCount);
+
+    /// Frames to prefetch around a scrub position, nearest first.
+    /// Frames ahead are spaced by the scrub speed, so a fast scrub looks further ahead.
+    /// @param frameIndex frame under the playhead
+    /// @param framesPerTick signed scrub speed in frames per update
+    /// @param frameCount frames in the clip, or -1 when unbounded
+    static std::vector<int64_t> getPrefetchFrames(int64_t frameIndex, double framesPerTick, int64_t frameCount);
+
+    /// Change the memory budget, evicting as needed.
+    /// @param bytes budget for thumbnail images
+    void setMemoryBudget(size_t bytes);
+
+    /// Bytes held by cached thumbnails.
+    size_t getMemoryUsage() const;
+
+    /// True when a frame's thumbnail is cached; unlike a request it does not mark it as used.
+    /// @param frameIndex frame index to look up
+    bool isCached(int64_t frameIndex) const;
+
+    /// Wait for every queued frame to be fetched.
+    /// @param timeoutMs maximum wait in milliseconds
+    /// @return true when no request is left
+    bool waitForPendingRequests(int timeoutMs);
+
     /// Check whether the provider is ready.
     bool isReady() const;
 
@@ -35,7 +87,8 @@ public:
 
 private:
     struct PendingRequest {
-        double seconds = 0.0;
+        /// Prefetch round that last wanted the frame.
+        uint32_t prefetchRound = 0;
         std::vector<std::function<void(const juce::Image&)>> callbacks;
     };
 
@@ -43,7 +96,7 @@ private:
     public:
         RequestJob(VideoThumbnailCache& cache,
                    int64_t key,
-                   double seconds,
+                   double frameRate,
                    uint32_t generation);
 
         JobStatus runJob() override;
@@ -51,17 +104,29 @@ private:
     private:
         VideoThumbnailCache& cache;
         int64_t key = 0;
-        double seconds = 0.0;
+        double frameRate = 0.0;
         uint32_t generation = 0;
     };
 
+    /// False for cancelled requests and prefetches the scrub has moved past (worker thread).
+    bool shouldFetch(int64_t key, uint32_t generation);
+
+    /// Scale a decoded frame down to the display size (worker thread).
+    juce::Image scaleToDisplay(const juce::Image& frame) const;
+
     void dispatchResult(int64_t key, uint32_t generation, const juce::Image& frame);
 
     juce::ThreadPool pool { 1 };
-    std::unique_ptr<VideoThumbnailProvider> provider = createVideoThumbnailProvider();
+    std::unique_ptr<VideoThumbnailProvider> provider;
     juce::File currentFile;
     std::atomic<uint32_t> generation { 0 };
     mutable juce::CriticalSection lock;
-    std::unordered_map<int64_t, juce::Image> cache;
+    int displayWidth = 0;
+    int displayHeight = 0;
+    uint32_t prefetchRound = 0;
+    /// Thumbnails by frame index, guarded by lock.
+    LruCache<int64_t, juce::Image> thumbnails { kDefaultMemoryBudget, [](const juce::Image& image) {
+        return static_cast<size_t>(image.getWidth()) * static_cast<size_t>(image.getHeight()) * 4;
+    } };
     std::unordered_map<int64_t, PendingRequest> pending;
 };
@@ -1,13 +1,29 @@
 #include "VideoView.h"
 
+#include "Utils/DebugWatchRegistry.h"
+
 VideoView::VideoView(Edit& edit)
     : edit(edit),
       syncController(edit, renderer, thumbnailCache) {
     addAndMakeVisible(renderer);
     startTimerHz(60);
+    DebugWatchRegistry::get().setWatch("VideoDroppedFrames",
+                                       &renderer,
+                                       [](const void* target) {
+                                           const auto* videoRenderer = static_cast<const VideoRenderer*>(target);
+                                           return juce::String(videoRenderer->getDroppedFrameCount());
+                                       });
+    DebugWatchRegistry::get().setWatch("VideoLateFrames",
+                                       &renderer,
+                                       [](const void* target) {
+                                           const auto* videoRenderer = static_cast<const VideoRenderer*>(target);
+                                           return juce::String(videoRenderer->getLateFrameCount());
+                                       });
 }
 
 VideoView::~VideoView() {
+    DebugWatchRegistry::get().clearWatch("VideoDroppedFrames");
+    DebugWatchRegistry::get().clearWatch("VideoLateFrames");
     thumbnailCache.cancelPending();
 }
 
@@ -17,6 +33,10 @@ void VideoView::onActiveClipChanged(std::function<void(const juce::String&)> cal
 
 void VideoView::resized() {
     renderer.setBounds(getLocalBounds());
+    // Thumbnails only need the pixels the view can show.
+    const auto scale = juce::Component::getApproximateScaleFactorForComponent(this);
+    thumbnailCache.setDisplaySize(juce::roundToInt(static_cast<float>(getWidth()) * scale),
+                                  juce::roundToInt(static_cast<float>(getHeight()) * scale));
 }
 
 void VideoView::timerCallback() {
@@ -0,0 +1,125 @@
+#include "ContentCacheIndex.h"
+
+namespace {
+/// Still named after the first cache that used it, so existing indexes keep loading.
+constexpr const char* kIndexHeader = "AudioVisionPeakIndex 1";
+} // namespace
+
+ContentCacheIndex::ContentCacheIndex(const juce::File& directory,
+                                     int64 maxBytes,
+                                     juce::String fileExtension,
+                                     juce::String indexFileName)
+    : directory(directory),
+      fileExtension(std::move(fileExtension)),
+      indexFileName(std::move(indexFileName)),
+      maxBytes(maxBytes) {
+    if (!directory.isDirectory() && !directory.createDirectory().wasOk()) {
+        juce::Logger::writeToLog("ContentCacheIndex: cannot create " + directory.getFullPathName());
+    }
+    load();
+}
+
+juce::File ContentCacheIndex::getFilePath(const juce::String& key) const {
+    return directory.getChildFile(key + fileExtension);
+}
+
+bool ContentCacheIndex::contains(const juce::String& key) const {
+    return entriesByKey.find(key) != entriesByKey.end();
+}
+
+void ContentCacheIndex::touch(const juce::String& key) {
+    const auto it = entriesByKey.find(key);
+    if (it != entriesByKey.end()) {
+        entries.splice(entries.begin(), entries, it->second);
+    }
+}
+
+void ContentCacheIndex::add(const juce::String& key,
+                         int64 sizeBytes,
+                         const std::function<bool(const juce::String&)>& isInUse) {
+    const auto it = entriesByKey.find(key);
+    if (it != entriesByKey.end()) {
+        totalBytes -= it->second->sizeBytes;
+        entries.erase(it->second);
+    }
+    entries.push_front({ key, sizeBytes });
+    entriesByKey[key] = entries.begin();
+    totalBytes += sizeBytes;
+    // The new entry is in use by whoever just wrote it.
+    evict([&key, &isInUse](const juce::String& candidate) {
+        return candidate == key || (isInUse && isInUse(candidate));
+    });
+    save();
+}
+
+void ContentCacheIndex::remove(const juce::String& key) {
+    const auto it = entriesByKey.find(key);
+    if (it == entriesByKey.end()) {
+        return;
+    }
+    totalBytes -= it->second->sizeBytes;
+    entries.erase(it->second);
+    entriesByKey.erase(it);
+    getFilePath(key).deleteFile();
+    save();
+}
+
+void ContentCacheIndex::setMaxBytes(int64 newMaxBytes, const std::function<bool(const juce::String&)>& isInUse) {
+    maxBytes = newMaxBytes;
+    evict(isInUse);
+    save();
+}
+
+bool ContentCacheIndex::save() const {
+    juce::String text(kIndexHeader);
+    text << "\n";
+    for (const auto& entry : entries) {
+        text << entry.key << " " << entry.sizeBytes << "\n";
+    }
+    // Replaced in one step so a crash never leaves a truncated index.
+    juce::TemporaryFile temporary(directory.getChildFile(indexFileName));
+    if (!temporary.getFile().replaceWithText(text) || !temporary.overwriteTargetFileWithTemporary()) {
+        juce::Logger::writeToLog("ContentCacheIndex: cannot write the index in " + directory.getFullPathName());
+        return false;
+    }
+    return true;
+}
+
+void ContentCacheIndex::load() {
+    entries.clear();
+    entriesByKey.clear();
+    totalBytes = 0;
+    juce::StringArray lines;
+    directory.getChildFile(indexFileName).readLines(lines);
+    if (lines.isEmpty() || lines[0] != kIndexHeader) {
+        // No index (or an unknown one): the directory is treated as empty and files are rebuilt on demand.
+        return;
+    }
+    for (int line = 1; line < lines.size(); ++line) {
+        const auto key = lines[line].upToFirstOccurrenceOf(" ", false, false);
+        const auto sizeBytes = lines[line].fromFirstOccurrenceOf(" ", false, false).getLargeIntValue();
+        if (key.isEmpty() || sizeBytes <= 0 || contains(key)) {
+            continue;
+        }
+        entries.push_back({ key, sizeBytes });
+        entriesByKey[key] = std::prev(entries.end());
+        totalBytes += sizeBytes;
+    }
+}
+
+void ContentCacheIndex::evict(const std::function<bool(const juce::String&)>& isInUse) {
+    for (auto it = entries.end(); totalBytes > maxBytes && it != entries.begin();) {
+        --it;
+        if (isInUse && isInUse(it->key)) {
+            continue;
+        }
+        // A file still mapped elsewhere may refuse deletion; it stays listed and is retried later.
+        const auto file = getFilePath(it->key);
+        if (file.existsAsFile() && !file.deleteFile()) {
+            continue;
+        }
+        totalBytes -= it->sizeBytes;
+        entriesByKey.erase(it->key);
+        it = entries.erase(it);
+    }
+}
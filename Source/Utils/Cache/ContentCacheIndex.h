@@ -0,0 +1,86 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <functional>
+#include <list>
+#include <unordered_map>
+
+/// Content-addressed store of derived media files in one directory, with a size budget.
+/// Files are named after a fingerprint of the source content (see FingerprintCache), so copies of the same media at
+/// different paths share one file. An index file lists the entries from most to least recently used,
+/// so the cache is known at startup without listing or stat-ing the directory.
+/// Not thread safe: its owner serialises access.
+class ContentCacheIndex {
+public:
+    /// Load the index of a cache directory, creating the directory when missing.
+    /// @param directory cache directory
+    /// @param maxBytes total size budget for the cached files
+    /// @param fileExtension extension of the cached files, including the dot
+    /// @param indexFileName name of the index file inside the directory
+    ContentCacheIndex(const juce::File& directory, int64 maxBytes, juce::String fileExtension, juce::String indexFileName);
+
+    /// Cache directory.
+    const juce::File& getDirectory() const noexcept { return directory; }
+
+    /// Cached file path for a key (whether or not it is cached).
+    /// @param key cache key
+    juce::File getFilePath(const juce::String& key) const;
+
+    /// True when the index lists a file for the key.
+    /// @param key cache key
+    bool contains(const juce::String& key) const;
+
+    /// Mark an entry as most recently used.
+    /// @param key cache key
+    void touch(const juce::String& key);
+
+    /// Record a file written at getFilePath(key), then evict down to the budget.
+    /// @param key cache key
+    /// @param sizeBytes size of the file
+    /// @param isInUse entries it returns true for are never evicted
+    void add(const juce::String& key,
+             int64 sizeBytes,
+             const std::function<bool(const juce::String&)>& isInUse = {});
+
+    /// Forget an entry and delete its file.
+    /// @param key cache key
+    void remove(const juce::String& key);
+
+    /// Change the size budget, evicting as needed.
+    /// @param newMaxBytes total size budget
+    /// @param isInUse entries it returns true for are never evicted
+    void setMaxBytes(int64 newMaxBytes, const std::function<bool(const juce::String&)>& isInUse = {});
+
+    /// Size budget in bytes.
+    int64 getMaxBytes() const noexcept { return maxBytes; }
+
+    /// Total size of the indexed files.
+    int64 getTotalBytes() const noexcept { return totalBytes; }
+
+    /// Number of indexed files.
+    size_t getNumEntries() const noexcept { return entries.size(); }
+
+    /// Write the index file.
+    bool save() const;
+
+private:
+    struct Entry {
+        juce::String key;
+        int64 sizeBytes = 0;
+    };
+
+    void load();
+
+    /// Drop least recently used entries until the total fits the budget.
+    void evict(const std::function<bool(const juce::String&)>& isInUse);
+
+    juce::File directory;
+    juce::String fileExtension;
+    juce::String indexFileName;
+    int64 maxBytes = 0;
+    int64 totalBytes = 0;
+    /// Most recently used first.
+    std::list<Entry> entries;
+    std::unordered_map<juce::String, std::list<Entry>::iterator> entriesByKey;
+};
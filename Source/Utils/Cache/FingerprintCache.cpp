@@ -0,0 +1,143 @@
+#include "FingerprintCache.h"
+
+#include <cstring>
+
+namespace {
+/// Bytes hashed at each end of the file, where headers and trailing chunks live.
+constexpr int64 kEdgeBytes = 65536;
+/// Evenly spaced samples hashed between the edges.
+constexpr int kSampleCount = 16;
+constexpr int64 kSampleBytes = 4096;
+
+constexpr uint64 kPrime1 = 11400714785074694791ull;
+constexpr uint64 kPrime2 = 14029467366897019727ull;
+constexpr uint64 kPrime3 = 1609587929392839161ull;
+constexpr uint64 kPrime4 = 9650029242287828579ull;
+constexpr uint64 kPrime5 = 2870177450012600261ull;
+
+uint64 rotateLeft(uint64 value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+uint64 read64(const uint8* data) {
+    uint64 value = 0;
+    std::memcpy(&value, data, sizeof(value));
+    return juce::ByteOrder::swapIfBigEndian(value);
+}
+
+uint32 read32(const uint8* data) {
+    uint32 value = 0;
+    std::memcpy(&value, data, sizeof(value));
+    return juce::ByteOrder::swapIfBigEndian(value);
+}
+
+uint64 hashRound(uint64 accumulator, uint64 input) {
+    accumulator += input * kPrime2;
+    return rotateLeft(accumulator, 31) * kPrime1;
+}
+
+uint64 mergeRound(uint64 accumulator, uint64 value) {
+    accumulator ^= hashRound(0, value);
+    return accumulator * kPrime1 + kPrime4;
+}
+
+/// Append size bytes read at a position, stopping short at the end of the stream.
+bool appendRange(juce::InputStream& input, int64 position, int64 size, juce::MemoryOutputStream& output) {
+    if (!input.setPosition(position)) {
+        return false;
+    }
+    return output.writeFromInputStream(input, size) == size;
+}
+} // namespace
+
+juce::String FingerprintCache::computeKey(const juce::File& file) {
+    juce::FileInputStream input(file);
+    if (!input.openedOk()) {
+        return {};
+    }
+    const auto size = input.getTotalLength();
+    juce::MemoryOutputStream sampled;
+    bool ok = true;
+    if (size <= 2 * kEdgeBytes + kSampleCount * kSampleBytes) {
+        ok = appendRange(input, 0, size, sampled);
+    } else {
+        ok = appendRange(input, 0, kEdgeBytes, sampled);
+        const auto spacing = (size - 2 * kEdgeBytes - kSampleBytes) / (kSampleCount - 1);
+        for (int sample = 0; ok && sample < kSampleCount; ++sample) {
+            ok = appendRange(input, kEdgeBytes + sample * spacing, kSampleBytes, sampled);
+        }
+        ok = ok && appendRange(input, size - kEdgeBytes, kEdgeBytes, sampled);
+    }
+    if (!ok) {
+        return {};
+    }
+    const auto hash = hash64(sampled.getData(), sampled.getDataSize(), static_cast<uint64>(size));
+    return juce::String::toHexString(size) + "-" + juce::String::toHexString(static_cast<juce::int64>(hash));
+}
+
+uint64 FingerprintCache::hash64(const void* data, size_t size, uint64 seed) {
+    const auto* input = static_cast<const uint8*>(data);
+    const auto* end = input + size;
+    uint64 hash = 0;
+    if (size >= 32) {
+        auto v1 = seed + kPrime1 + kPrime2;
+        auto v2 = seed + kPrime2;
+        auto v3 = seed;
+        auto v4 = seed - kPrime1;
+        for (; input + 32 <= end; input += 32) {
+            v1 = hashRound(v1, read64(input));
+            v2 = hashRound(v2, read64(input + 8));
+            v3 = hashRound(v3, read64(input + 16));
+            v4 = hashRound(v4, read64(input + 24));
+        }
+        hash = rotateLeft(v1, 1) + rotateLeft(v2, 7) + rotateLeft(v3, 12) + rotateLeft(v4, 18);
+        hash = mergeRound(hash, v1);
+        hash = mergeRound(hash, v2);
+        hash = mergeRound(hash, v3);
+        hash = mergeRound(hash, v4);
+    } else {
+        hash = seed + kPrime5;
+    }
+    hash += static_cast<uint64>(size);
+
+    for (; input + 8 <= end; input += 8) {
+        hash ^= hashRound(0, read64(input));
+        hash = rotateLeft(hash, 27) * kPrime1 + kPrime4;
+    }
+    if (input + 4 <= end) {
+        hash ^= static_cast<uint64>(read32(input)) * kPrime1;
+        hash = rotateLeft(hash, 23) * kPrime2 + kPrime3;
+        input += 4;
+    }
+    for (; input < end; ++input) {
+        hash ^= *input * kPrime5;
+        hash = rotateLeft(hash, 11) * kPrime1;
+    }
+
+    hash ^= hash >> 33;
+    hash *= kPrime2;
+    hash ^= hash >> 29;
+    hash *= kPrime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+juce::String FingerprintCache::getKey(const juce::File& file) {
+    const auto path = file.getFullPathName();
+    const auto modificationTime = file.getLastModificationTime();
+    const auto size = file.getSize();
+    {
+        const juce::ScopedLock scopedLock(lock);
+        const auto it = fingerprints.find(path);
+        if (it != fingerprints.end() && it->second.modificationTime == modificationTime && it->second.size == size) {
+            return it->second.key;
+        }
+    }
+    // Hashing reads a few hundred kilobytes, so it runs outside the lock.
+    auto key = computeKey(file);
+    if (key.isNotEmpty()) {
+        const juce::ScopedLock scopedLock(lock);
+        fingerprints[path] = { modificationTime, size, key };
+    }
+    return key;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <unordered_map>
+
+/// Content fingerprints of files, used as keys of content-addressed caches.
+/// A fingerprint is recomputed only when a file's size or modification time changes.
+/// Thread safe.
+class FingerprintCache {
+public:
+    /// Fingerprint of a file: its size and an xxHash64 of its header, tail and evenly spaced samples.
+    /// @param file file to read
+    /// @return the key, or an empty string when the file cannot be read
+    static juce::String computeKey(const juce::File& file);
+
+    /// xxHash64 of a memory block.
+    /// @param data bytes to hash
+    /// @param size number of bytes
+    /// @param seed hash seed
+    static uint64 hash64(const void* data, size_t size, uint64 seed = 0);
+
+    /// Fingerprint of a file, from the last computation while the file is unchanged.
+    /// @param file file to read
+    /// @return the key, or an empty string when the file cannot be read
+    juce::String getKey(const juce::File& file);
+
+private:
+    struct Fingerprint {
+        juce::Time modificationTime;
+        int64 size = 0;
+        juce::String key;
+    };
+
+    juce::CriticalSection lock;
+    /// Keyed by file path.
+    std::unordered_map<juce::String, Fingerprint> fingerprints;
+};
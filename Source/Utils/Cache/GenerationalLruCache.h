@@ -0,0 +1,201 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <atomic>
+#include <functional>
+#include <optional>
+#include <unordered_map>
+
+#include "LruCache.h"
+
+/// Least recently used values under a memory budget (see LruCache), built on demand by a background pool.
+/// Builds are tagged with the view generation they were requested in and skipped once the view
+/// has moved on, so a fast zoom or scroll does not leave the pool busy with values nobody will draw.
+/// A failed build caches nothing, so the value is built again on its next request.
+/// Thread safe.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class GenerationalLruCache {
+public:
+    /// Builds a value on a worker thread; std::nullopt when it cannot be built.
+    using Builder = std::function<std::optional<Value>()>;
+
+    /// Create an empty cache.
+    /// @param jobName name of the build jobs
+    /// @param numThreads workers building values
+    /// @param memoryBudget budget for cached values, in bytes
+    /// @param sizeOf bytes held by a value
+    /// @param onValueAdded called on the worker thread after a built value is cached
+    GenerationalLruCache(juce::String jobName,
+                         int numThreads,
+                         size_t memoryBudget,
+                         std::function<size_t(const Value&)> sizeOf,
+                         std::function<void()> onValueAdded)
+        : jobName(std::move(jobName)),
+          pool(numThreads),
+          values(memoryBudget, std::move(sizeOf)),
+          onValueAdded(std::move(onValueAdded))
+    {
+    }
+
+    ~GenerationalLruCache()
+    {
+        pool.removeAllJobs(true, 10000);
+    }
+
+    /// Cached value, marked as most recently used.
+    /// @param key value to look up
+    std::optional<Value> find(const Key& key)
+    {
+        const juce::ScopedLock scopedLock(lock);
+        return values.find(key);
+    }
+
+    /// Drop a cached value.
+    /// @param key value to drop
+    void erase(const Key& key)
+    {
+        const juce::ScopedLock scopedLock(lock);
+        values.erase(key);
+    }
+
+    /// Queue a build unless one was already requested in the current generation.
+    /// A request from an older view is re-queued; its stale job will skip itself.
+    /// @param key value to build
+    /// @param build called on a worker thread unless the build goes stale first
+    void request(const Key& key, Builder build)
+    {
+        const juce::ScopedLock scopedLock(lock);
+        const auto current = generation.load();
+        const auto [pendingIt, inserted] = pending.try_emplace(key, current);
+        if (!inserted && pendingIt->second == current) {
+            return;
+        }
+        pendingIt->second = current;
+        pool.addJob(new BuildJob(*this, key, std::move(build), current), true);
+    }
+
+    /// Mark queued builds as stale after a view change; they are skipped unless requested again.
+    void advanceGeneration()
+    {
+        ++generation;
+    }
+
+    /// Wait for every queued build to finish.
+    /// @param timeoutMs maximum wait in milliseconds
+    /// @return true when no build is left
+    bool waitForPendingBuilds(int timeoutMs)
+    {
+        const auto deadline = juce::Time::getMillisecondCounter() + static_cast<uint32>(timeoutMs);
+        while (pool.getNumJobs() > 0) {
+            if (juce::Time::getMillisecondCounter() >= deadline) {
+                return false;
+            }
+            juce::Thread::sleep(5);
+        }
+        return true;
+    }
+
+    /// Change the memory budget, evicting as needed.
+    /// @param bytes budget for cached values
+    void setMemoryBudget(size_t bytes)
+    {
+        const juce::ScopedLock scopedLock(lock);
+        values.setMemoryBudget(bytes);
+    }
+
+    /// Bytes held by cached values.
+    size_t getMemoryUsage() const
+    {
+        const juce::ScopedLock scopedLock(lock);
+        return values.getMemoryUsage();
+    }
+
+    /// Drop every cached value and queued build.
+    void clear()
+    {
+        pool.removeAllJobs(true, 10000);
+        const juce::ScopedLock scopedLock(lock);
+        values.clear();
+        pending.clear();
+        ++generation;
+    }
+
+private:
+    class BuildJob : public juce::ThreadPoolJob {
+    public:
+        BuildJob(GenerationalLruCache& cache, const Key& key, Builder build, uint32 generation)
+            : ThreadPoolJob(cache.jobName),
+              cache(cache),
+              key(key),
+              build(std::move(build)),
+              generation(generation)
+        {
+        }
+
+        JobStatus runJob() override
+        {
+            if (shouldExit() || !cache.shouldBuild(key, generation)) {
+                return jobHasFinished;
+            }
+            cache.add(key, generation, build());
+            return jobHasFinished;
+        }
+
+    private:
+        GenerationalLruCache& cache;
+        Key key;
+        Builder build;
+        uint32 generation = 0;
+    };
+
+    /// True when a queued build is still wanted; drops its pending entry otherwise (worker thread).
+    bool shouldBuild(const Key& key, uint32 requestGeneration)
+    {
+        const juce::ScopedLock scopedLock(lock);
+        const auto it = pending.find(key);
+        if (it == pending.end() || it->second != requestGeneration) {
+            // Cleared, or superseded by a newer request that builds it instead.
+            return false;
+        }
+        if (requestGeneration != generation.load() || values.contains(key)) {
+            // The view moved on, or a build finishing late already cached it.
+            pending.erase(it);
+            return false;
+        }
+        return true;
+    }
+
+    /// Cache a built value (worker thread).
+    void add(const Key& key, uint32 requestGeneration, std::optional<Value> value)
+    {
+        {
+            const juce::ScopedLock scopedLock(lock);
+            const auto it = pending.find(key);
+            if (it == pending.end()) {
+                // Cleared while building.
+                return;
+            }
+            // A newer request for the same value keeps its entry and skips itself once this lands.
+            if (it->second == requestGeneration) {
+                pending.erase(it);
+            }
+            if (!value.has_value() || values.contains(key)) {
+                return;
+            }
+            values.add(key, std::move(*value));
+        }
+        if (onValueAdded) {
+            onValueAdded();
+        }
+    }
+
+    const juce::String jobName;
+    juce::ThreadPool pool;
+    mutable juce::CriticalSection lock;
+    LruCache<Key, Value, Hash> values;
+    std::function<void()> onValueAdded;
+    std::atomic<uint32> generation { 0 };
+    /// Queued or building values, with the generation of their latest request.
+    std::unordered_map<Key, uint32, Hash> pending;
+};
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <functional>
+#include <list>
+#include <optional>
+#include <unordered_map>
+
+/// Least recently used values under a memory budget.
+/// Adding a value evicts the oldest ones until the total fits; the newest value always stays.
+/// Not thread safe: its owner serialises access.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LruCache {
+public:
+    /// Create an empty cache.
+    /// @param memoryBudget budget for cached values, in bytes
+    /// @param sizeOf bytes held by a value
+    LruCache(size_t memoryBudget, std::function<size_t(const Value&)> sizeOf)
+        : memoryBudget(memoryBudget),
+          sizeOf(std::move(sizeOf))
+    {
+    }
+
+    /// Cached value, marked as most recently used.
+    /// @param key value to look up
+    std::optional<Value> find(const Key& key)
+    {
+        const auto it = entriesByKey.find(key);
+        if (it == entriesByKey.end()) {
+            return std::nullopt;
+        }
+        entries.splice(entries.begin(), entries, it->second);
+        return it->second->value;
+    }
+
+    /// True when a value is cached; unlike find() it does not mark it as used.
+    /// @param key value to look up
+    bool contains(const Key& key) const
+    {
+        return entriesByKey.find(key) != entriesByKey.end();
+    }
+
+    /// Cache a value as the most recently used one unless the key is already cached, then evict.
+    /// @param key key of the value
+    /// @param value value to cache
+    void add(const Key& key, Value value)
+    {
+        if (contains(key)) {
+            return;
+        }
+        const auto bytes = sizeOf(value);
+        entries.push_front({ key, std::move(value), bytes });
+        entriesByKey[key] = entries.begin();
+        memoryUsage += bytes;
+        evict();
+    }
+
+    /// Drop a cached value.
+    /// @param key value to drop
+    void erase(const Key& key)
+    {
+        const auto it = entriesByKey.find(key);
+        if (it == entriesByKey.end()) {
+            return;
+        }
+        memoryUsage -= it->second->bytes;
+        entries.erase(it->second);
+        entriesByKey.erase(it);
+    }
+
+    /// Change the memory budget, evicting as needed.
+    /// @param bytes budget for cached values
+    void setMemoryBudget(size_t bytes)
+    {
+        memoryBudget = bytes;
+        evict();
+    }
+
+    /// Bytes held by cached values.
+    size_t getMemoryUsage() const noexcept { return memoryUsage; }
+
+    /// Drop every cached value.
+    void clear()
+    {
+        entries.clear();
+        entriesByKey.clear();
+        memoryUsage = 0;
+    }
+
+private:
+    struct Entry {
+        Key key;
+        Value value;
+        size_t bytes = 0;
+    };
+
+    /// Drop least recently used values until the total fits the budget.
+    void evict()
+    {
+        // The newest value stays even when it alone exceeds the budget.
+        while (memoryUsage > memoryBudget && entries.size() > 1) {
+            const auto& oldest = entries.back();
+            memoryUsage -= oldest.bytes;
+            entriesByKey.erase(oldest.key);
+            entries.pop_back();
+        }
+    }
+
+    size_t memoryBudget = 0;
+    size_t memoryUsage = 0;
+    std::function<size_t(const Value&)> sizeOf;
+    /// Most recently used first.
+    std::list<Entry> entries;
+    std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> entriesByKey;
+};
@@ -69,6 +69,33 @@ juce::AudioBuffer<float> AudioFile::read(juce::int64 startSample, juce::int64 nu
     return buffer;
 }
 
+bool AudioFile::visitSamples(juce::int64 startSample,
+                             juce::int64 numberOfSamples,
+                             const std::function<void(const SampleChunk&)>& visitor) const {
+    if (!reader) {
+        // Audio reader must be initialized before reading samples.
+        jassert(false);
+        return false;
+    }
+    const auto numChannels = ChannelCount(format);
+    thread_local std::vector<float> scratch;
+    thread_local std::vector<float*> channels;
+    scratch.resize(static_cast<size_t>(numChannels) * kSampleChunkSize);
+    channels.resize(static_cast<size_t>(numChannels));
+    for (int channelIndex = 0; channelIndex < numChannels; ++channelIndex) {
+        channels[static_cast<size_t>(channelIndex)] = scratch.data() + static_cast<size_t>(channelIndex) * kSampleChunkSize;
+    }
+
+    for (juce::int64 offset = 0; offset < numberOfSamples; offset += kSampleChunkSize) {
+        const auto count = static_cast<int>(std::min<juce::int64>(kSampleChunkSize, numberOfSamples - offset));
+        if (!reader->read(channels.data(), numChannels, startSample + offset, count)) {
+            return false;
+        }
+        visitor({ channels.data(), numChannels, startSample + offset, count });
+    }
+    return true;
+}
+
 void AudioFile::readWholeFileInCache() {
     AudioFormatManager formatManager;
     formatManager.registerBasicFormats();
@@ -80,11 +107,24 @@ void AudioFile::readWholeFileInCache() {
     );
     reader->mapEntireFile();
 
+    // Missing peaks are built in the background so loading never waits on a full read of the file.
     const auto file = juce::File(filePath);
-    peakFile = PeakCacheManager::get().getOrBuildPeakFile(file, *reader);
+    peakFile = PeakCacheManager::get().findPeakFile(file, *reader);
+    if (peakFile == nullptr) {
+        pendingPeaks = PeakCacheManager::get().buildPeakFileAsync(file, *reader);
+    }
 }
 
-std::shared_ptr<PeakFile> AudioFile::getPeakFile() const {
+std::shared_ptr<PeakSource> AudioFile::getPeakFile() const {
+    if (pendingPeaks != nullptr) {
+        // Switch to the mapped file once written, releasing the in-memory levels.
+        if (auto finished = pendingPeaks->getFinishedFile()) {
+            peakFile = std::move(finished);
+            pendingPeaks.reset();
+        } else {
+            return pendingPeaks;
+        }
+    }
     if (peakFile == nullptr) {
         // Peak cache must be created during file load to avoid painting without data.
         jassert(false);
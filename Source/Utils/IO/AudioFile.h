@@ -3,17 +3,32 @@
 #include <JuceHeader.h>
 #include <Utils/Format.h>
 #include <Utils/Channel.h>
+#include <functional>
 #include <vector>
 #include <spdlog/spdlog.h>
 
 #include "juce_graphics/fonts/harfbuzz/hb-cplusplus.hh"
 
 class PeakFile;
+class PeakSource;
+class PendingPeakFile;
 
 /// Read audio data from disk with low-latency access.
 /// TODO: handle multi-mono files.
 class AudioFile {
 public:
+    /// Samples decoded per chunk by visitSamples.
+    static constexpr int kSampleChunkSize = 4096;
+
+    /// Window of decoded samples handed out by visitSamples.
+    struct SampleChunk {
+        const float* const* channels = nullptr;
+        int numChannels = 0;
+        /// First sample of the chunk in the whole file.
+        int64 startSample = 0;
+        int numSamples = 0;
+    };
+
     /// Create an audio file reader from a path.
     /// @param filePath file path to load
     explicit AudioFile(String filePath);
@@ -43,13 +58,23 @@ public:
     /// @see juce::MemoryMappedAudioFormatReader
     juce::AudioBuffer<float> read(juce::int64 startSample, juce::int64 numberOfSamples) const;
 
+    /// Walk a sample range in chunks of at most kSampleChunkSize samples, decoded from the mapped file into
+    /// per-thread scratch, so drawing from samples costs no allocation however long the range is.
+    /// Samples past the end of the file read as silence, as with read().
+    /// @param startSample sample position in the whole file
+    /// @param numberOfSamples number of samples to visit
+    /// @param visitor called once per chunk, in order; the chunk is only valid during the call
+    bool visitSamples(juce::int64 startSample,
+                      juce::int64 numberOfSamples,
+                      const std::function<void(const SampleChunk&)>& visitor) const;
+
     /// Used to read the whole file in order to be able to access it with low latency (RAM access)
     /// Called at initialization, another call is only needed if the file content has changed.
     /// Todo : Make optimized reader that allow to read only parts of the files that are used.
     void readWholeFileInCache();
 
-    /// Access the waveform peak cache.
-    std::shared_ptr<PeakFile> getPeakFile() const;
+    /// Access the waveform peaks: the peak file, or the partial peaks while it is being built.
+    std::shared_ptr<PeakSource> getPeakFile() const;
 
     /// Total number of samples in the file.
     int64 getLengthInSamples() const;
@@ -62,5 +87,7 @@ private:
     int64 originalTimeReference;
     Channel channel;
     ChannelsFormat format;
-    std::shared_ptr<PeakFile> peakFile;
+    mutable std::shared_ptr<PeakFile> peakFile;
+    /// Background build running while no up-to-date peak file exists.
+    mutable std::shared_ptr<PendingPeakFile> pendingPeaks;
 };
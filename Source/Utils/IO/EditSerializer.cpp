@@ -65,6 +65,9 @@ bool EditSerializer::exportToFile(const Edit& edit, const juce::File& directory)
         trackObj->setProperty("armed", track->isAudioTrack()
             ? std::dynamic_pointer_cast<AudioTrack>(track)->isArmed()
             : false);
+        if (const auto recordTrack = std::dynamic_pointer_cast<RecordTrack>(track)) {
+            trackObj->setProperty("inputChannel", recordTrack->getInputChannel());
+        }
         auto parentFolder = track->getParentFolder();
         if (parentFolder != nullptr) {
             const auto& allTracks = tracks;
@@ -140,6 +143,9 @@ bool EditSerializer::exportToFile(const Edit& edit, const juce::File& directory)
             }
             auto sendObj = std::make_unique<juce::DynamicObject>();
             sendObj->setProperty("destinationIndex", destIndex);
+            sendObj->setProperty("type", send->getType() == SendType::PreFader ? "pre" : "post");
+            sendObj->setProperty("level", send->getLevel());
+            sendObj->setProperty("pan", send->getPan());
             sendsArray.add(juce::var(sendObj.release()));
         }
         trackObj->setProperty("sends", sendsArray);
@@ -244,6 +250,9 @@ std::shared_ptr<Edit> EditSerializer::importFromFile(const juce::File& file)
             if (auto audioTrack = std::dynamic_pointer_cast<AudioTrack>(track)) {
                 audioTrack->setArmed(static_cast<bool>(trackObj->getProperty("armed")));
             }
+            if (auto recordTrack = std::dynamic_pointer_cast<RecordTrack>(track)) {
+                recordTrack->setInputChannel(static_cast<int>(trackObj->getProperty("inputChannel")));
+            }
 
             createdTracks.push_back(track);
             edit->addTrack(track);
@@ -320,7 +329,18 @@ std::shared_ptr<Edit> EditSerializer::importFromFile(const juce::File& file)
                     int destIndex = (int)sendObj->getProperty("destinationIndex");
                     if (destIndex >= 0 && destIndex < (int)createdTracks.size()) {
                         auto dest = createdTracks[static_cast<size_t>(destIndex)];
-                        track->addSend(Send::create(dest));
+                        auto send = Send::create(dest);
+                        // Sessions saved before send types existed routed every send after the fader.
+                        send->setType(sendObj->getProperty("type").toString() == "pre"
+                                          ? SendType::PreFader
+                                          : SendType::PostFader);
+                        if (sendObj->hasProperty("level")) {
+                            send->setLevel(static_cast<float>(static_cast<double>(sendObj->getProperty("level"))));
+                        }
+                        if (sendObj->hasProperty("pan")) {
+                            send->setPan(static_cast<float>(static_cast<double>(sendObj->getProperty("pan"))));
+                        }
+                        track->addSend(std::move(send));
                     }
                 }
             }
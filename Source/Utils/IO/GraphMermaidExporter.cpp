@@ -53,8 +53,13 @@ juce::String GraphMermaidExporter::exportMermaid(const GraphDescription& descrip
         auto key = connection.inputId + "->" + connection.outputId;
         auto countIt = edgeChannelCounts.find(key);
         auto count = countIt != edgeChannelCounts.end() ? countIt->second : 1;
-        output << "  " << inputIt->second << " -- \""
-               << count << "\" --> " << outputIt->second << "\n";
+        if (connection.type == GraphConnectionType::Send) {
+            output << "  " << inputIt->second << " -. \"send "
+                   << count << "\" .-> " << outputIt->second << "\n";
+        } else {
+            output << "  " << inputIt->second << " -- \""
+                   << count << "\" --> " << outputIt->second << "\n";
+        }
     }
 
     return output;
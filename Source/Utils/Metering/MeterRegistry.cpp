@@ -0,0 +1,24 @@
+#include "MeterRegistry.h"
+
+std::shared_ptr<MeterTap> MeterRegistry::getOrCreate(const juce::String& trackId, int numChannels)
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+    auto& tap = taps[trackId];
+    if (tap == nullptr || tap->getNumChannels() != juce::jlimit(0, MeterReading::maxChannels, numChannels)) {
+        tap = std::make_shared<MeterTap>(numChannels);
+    }
+    return tap;
+}
+
+std::shared_ptr<MeterTap> MeterRegistry::find(const juce::String& trackId) const
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+    const auto it = taps.find(trackId);
+    return it != taps.end() ? it->second : nullptr;
+}
+
+void MeterRegistry::clear()
+{
+    const std::lock_guard<std::mutex> lock(mutex);
+    taps.clear();
+}
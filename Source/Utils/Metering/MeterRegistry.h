@@ -0,0 +1,30 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "MeterTap.h"
+
+/// Meter taps shared between the audio graph (producer) and the UI (consumer), keyed by track id.
+/// Lookups happen on graph build and UI refresh only; the audio thread holds its tap directly.
+class MeterRegistry {
+public:
+    /// Get the tap for a track, creating or resizing it when needed.
+    /// @param trackId track id owning the tap
+    /// @param numChannels channels the tap analyses
+    std::shared_ptr<MeterTap> getOrCreate(const juce::String& trackId, int numChannels);
+
+    /// Find the tap for a track (null if the track is not metered).
+    /// @param trackId track id owning the tap
+    std::shared_ptr<MeterTap> find(const juce::String& trackId) const;
+
+    /// Drop every tap (nodes and views keep theirs alive until released).
+    void clear();
+
+private:
+    mutable std::mutex mutex;
+    std::map<juce::String, std::shared_ptr<MeterTap>> taps;
+};
@@ -0,0 +1,166 @@
+#include "MeterTap.h"
+
+#include <juce_dsp/juce_dsp.h>
+
+#include <cmath>
+
+MeterTap::MeterTap(int numChannels)
+    : numChannels(juce::jlimit(0, MeterReading::maxChannels, numChannels))
+{
+    // Blackman-windowed sinc split into polyphase branches, each normalised to unity DC gain.
+    // The even length puts every branch between input samples, so all four are evaluated.
+    constexpr int length = oversampling * tapsPerPhase;
+    const auto centre = static_cast<double>(length - 1) * 0.5;
+    for (int phase = 0; phase < oversampling; ++phase) {
+        double sum = 0.0;
+        for (int tap = 0; tap < tapsPerPhase; ++tap) {
+            const auto index = tap * oversampling + phase;
+            const auto x = (static_cast<double>(index) - centre) / oversampling;
+            const auto sinc = std::abs(x) < 1.0e-9 ? 1.0 : std::sin(juce::MathConstants<double>::pi * x)
+                                                         / (juce::MathConstants<double>::pi * x);
+            const auto window = 0.42 - 0.5 * std::cos(juce::MathConstants<double>::twoPi * index / (length - 1))
+                                + 0.08 * std::cos(2.0 * juce::MathConstants<double>::twoPi * index / (length - 1));
+            phases[static_cast<size_t>(phase)][static_cast<size_t>(tap)] = static_cast<float>(sinc * window);
+            sum += sinc * window;
+        }
+        for (auto& coefficient : phases[static_cast<size_t>(phase)]) {
+            coefficient = static_cast<float>(coefficient / sum);
+        }
+    }
+}
+
+void MeterTap::prepare(double sampleRate)
+{
+    windowLength = juce::jmax(1, juce::roundToInt(sampleRate * windowSeconds));
+    windowPosition = 0;
+    channels = {};
+}
+
+void MeterTap::process(const juce::AudioBuffer<float>& buffer, int numSamples) noexcept
+{
+    const auto channelsToRead = juce::jmin(numChannels, buffer.getNumChannels());
+    numSamples = juce::jmin(numSamples, buffer.getNumSamples());
+    if (channelsToRead == 0 || numSamples <= 0) {
+        return;
+    }
+
+    for (int c = 0; c < channelsToRead; ++c) {
+        auto& state = channels[static_cast<size_t>(c)];
+        const auto* samples = buffer.getReadPointer(c);
+        double squares = 0.0;
+        const auto peak = analyseBlock(samples, numSamples, squares);
+        const auto truePeak = juce::jmax(peak, oversampledPeak(samples, numSamples, state));
+        updateHistory(samples, numSamples, state);
+        state.windowPeak = juce::jmax(state.windowPeak, peak);
+        state.windowTruePeak = juce::jmax(state.windowTruePeak, truePeak);
+        state.windowSquares += squares;
+    }
+
+    windowPosition += numSamples;
+    const auto windowComplete = windowPosition >= windowLength;
+
+    auto& reading = readings.getWriteSlot();
+    reading.numChannels = channelsToRead;
+    for (int c = 0; c < channelsToRead; ++c) {
+        auto& state = channels[static_cast<size_t>(c)];
+        if (windowComplete) {
+            state.previousRms = static_cast<float>(std::sqrt(state.windowSquares / windowPosition));
+        }
+        const auto index = static_cast<size_t>(c);
+        reading.peak[index] = juce::jmax(state.previousPeak, state.windowPeak);
+        reading.truePeak[index] = juce::jmax(state.previousTruePeak, state.windowTruePeak);
+        reading.rms[index] = state.previousRms;
+        if (windowComplete) {
+            state.previousPeak = state.windowPeak;
+            state.previousTruePeak = state.windowTruePeak;
+            state.windowPeak = 0.0f;
+            state.windowTruePeak = 0.0f;
+            state.windowSquares = 0.0;
+        }
+    }
+    if (windowComplete) {
+        windowPosition = 0;
+    }
+    readings.publish();
+}
+
+float MeterTap::analyseBlock(const float* samples, int numSamples, double& sumOfSquares) noexcept
+{
+    using Register = juce::dsp::SIMDRegister<float>;
+    constexpr auto width = static_cast<int>(Register::SIMDNumElements);
+
+    float peak = 0.0f;
+    float squares = 0.0f;
+    const auto addScalar = [&](float sample) noexcept {
+        peak = juce::jmax(peak, std::abs(sample));
+        squares += sample * sample;
+    };
+
+    int i = 0;
+    const auto head = juce::jmin(numSamples, static_cast<int>(Register::getNextSIMDAlignedPtr(samples) - samples));
+    for (; i < head; ++i) {
+        addScalar(samples[i]);
+    }
+
+    // Two register pairs hide the add/max latency.
+    auto peakA = Register::expand(0.0f);
+    auto peakB = peakA;
+    auto squaresA = peakA;
+    auto squaresB = peakA;
+    for (; i + 2 * width <= numSamples; i += 2 * width) {
+        const auto a = Register::fromRawArray(samples + i);
+        const auto b = Register::fromRawArray(samples + i + width);
+        peakA = Register::max(peakA, Register::abs(a));
+        peakB = Register::max(peakB, Register::abs(b));
+        squaresA += a * a;
+        squaresB += b * b;
+    }
+    for (; i < numSamples; ++i) {
+        addScalar(samples[i]);
+    }
+
+    const auto peaks = Register::max(peakA, peakB);
+    for (size_t lane = 0; lane < Register::SIMDNumElements; ++lane) {
+        peak = juce::jmax(peak, peaks.get(lane));
+    }
+    sumOfSquares = static_cast<double>(squares) + (squaresA + squaresB).sum();
+    return peak;
+}
+
+float MeterTap::oversampledPeak(const float* samples, int numSamples, const ChannelState& state) const noexcept
+{
+    // Each chunk is laid out after the samples preceding it, so tap k of every output reads
+    // input[historyLength - k + n] and a whole branch is tapsPerPhase multiply-adds.
+    std::array<float, historyLength + oversamplingChunk> input;
+    std::array<float, oversamplingChunk> output;
+    std::copy(state.history.begin(), state.history.end(), input.begin());
+
+    float peak = 0.0f;
+    for (int start = 0; start < numSamples; start += oversamplingChunk) {
+        const auto length = juce::jmin(oversamplingChunk, numSamples - start);
+        std::copy(samples + start, samples + start + length, input.begin() + historyLength);
+        for (const auto& coefficients : phases) {
+            juce::FloatVectorOperations::multiply(output.data(), input.data() + historyLength,
+                                                  coefficients[0], length);
+            for (int tap = 1; tap < tapsPerPhase; ++tap) {
+                juce::FloatVectorOperations::addWithMultiply(output.data(), input.data() + historyLength - tap,
+                                                             coefficients[static_cast<size_t>(tap)], length);
+            }
+            const auto range = juce::FloatVectorOperations::findMinAndMax(output.data(), length);
+            peak = juce::jmax(peak, -range.getStart(), range.getEnd());
+        }
+        // The last input samples of this chunk precede the next one.
+        std::copy(input.begin() + length, input.begin() + length + historyLength, input.begin());
+    }
+    return peak;
+}
+
+void MeterTap::updateHistory(const float* samples, int numSamples, ChannelState& state) noexcept
+{
+    if (numSamples >= historyLength) {
+        std::copy(samples + numSamples - historyLength, samples + numSamples, state.history.begin());
+        return;
+    }
+    std::move(state.history.begin() + numSamples, state.history.end(), state.history.begin());
+    std::copy(samples, samples + numSamples, state.history.end() - numSamples);
+}
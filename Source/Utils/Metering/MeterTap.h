@@ -0,0 +1,91 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <array>
+
+#include "TripleBuffer.h"
+
+/// Levels published by a meter tap (linear gain values).
+struct MeterReading {
+    static constexpr int maxChannels = 8;
+
+    int numChannels = 0;
+    /// Highest absolute sample value over the publish window.
+    std::array<float, maxChannels> peak {};
+    /// RMS over the last complete window.
+    std::array<float, maxChannels> rms {};
+    /// Highest 4x oversampled value over the publish window.
+    std::array<float, maxChannels> truePeak {};
+};
+
+/// Audio-thread level analyser publishing peak, RMS and true peak to the UI without locks.
+///
+/// A window of windowSeconds is accumulated; every block publishes the max of the current
+/// and the previous window so a reader polling faster than the window never misses a peak.
+/// The oversampled true-peak pass runs on every block, one polyphase branch at a time over
+/// chunks of oversamplingChunk samples, so each tap is a vector multiply-add.
+class MeterTap {
+public:
+    static constexpr double windowSeconds = 0.05;
+    static constexpr int oversampling = 4;
+    static constexpr int tapsPerPhase = 12;
+    static constexpr int oversamplingChunk = 256;
+
+    /// Create a tap for a channel count (clamped to MeterReading::maxChannels).
+    /// @param numChannels channels to analyse
+    explicit MeterTap(int numChannels);
+
+    /// Reset the analysis state for a new rate (call before processing).
+    /// @param sampleRate processing sample rate
+    void prepare(double sampleRate);
+
+    /// Analyse a block and publish the updated levels (audio thread).
+    /// @param buffer block to analyse
+    /// @param numSamples samples to analyse
+    void process(const juce::AudioBuffer<float>& buffer, int numSamples) noexcept;
+
+    /// Copy the latest levels if new ones were published (UI thread).
+    /// @param destination receives the latest levels
+    /// @return true when new levels were copied
+    bool read(MeterReading& destination) noexcept { return readings.read(destination); }
+
+    /// Number of analysed channels.
+    [[nodiscard]] int getNumChannels() const noexcept { return numChannels; }
+
+    /// Highest absolute value and sum of squares of a block, using lane-parallel accumulators.
+    /// @param samples input samples
+    /// @param numSamples sample count
+    /// @param sumOfSquares receives the sum of squared samples
+    /// @return highest absolute sample value
+    static float analyseBlock(const float* samples, int numSamples, double& sumOfSquares) noexcept;
+
+private:
+    static constexpr int historyLength = tapsPerPhase - 1;
+
+    struct ChannelState {
+        std::array<float, historyLength> history {};
+        float windowPeak = 0.0f;
+        float windowTruePeak = 0.0f;
+        double windowSquares = 0.0;
+        float previousPeak = 0.0f;
+        float previousTruePeak = 0.0f;
+        float previousRms = 0.0f;
+    };
+
+    /// Highest 4x oversampled absolute value of a block, continuing from the channel history.
+    /// @param samples input samples
+    /// @param numSamples sample count
+    /// @param state channel whose history precedes the block
+    float oversampledPeak(const float* samples, int numSamples, const ChannelState& state) const noexcept;
+
+    /// Keep the last input samples for the next block's interpolation.
+    static void updateHistory(const float* samples, int numSamples, ChannelState& state) noexcept;
+
+    int numChannels;
+    int windowLength = 2400;
+    int windowPosition = 0;
+    std::array<ChannelState, MeterReading::maxChannels> channels {};
+    std::array<std::array<float, tapsPerPhase>, oversampling> phases {};
+    TripleBuffer<MeterReading> readings;
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+/// Lock-free single-producer/single-consumer triple buffer.
+/// The producer always owns one slot, the consumer another, and the third is exchanged
+/// atomically so neither side ever waits and the consumer always sees the latest value.
+template <typename T>
+class TripleBuffer {
+public:
+    /// Slot the producer may fill before calling publish() (producer thread only).
+    T& getWriteSlot() noexcept
+    {
+        return slots[static_cast<size_t>(writeIndex)];
+    }
+
+    /// Hand the write slot to the consumer (producer thread only).
+    void publish() noexcept
+    {
+        const auto previous = shared.exchange(writeIndex | dirtyFlag, std::memory_order_acq_rel);
+        writeIndex = previous & indexMask;
+    }
+
+    /// Copy the latest published value if a new one arrived (consumer thread only).
+    /// @param destination receives the latest value
+    /// @return true when a value newer than the previous read was copied
+    bool read(T& destination) noexcept
+    {
+        if ((shared.load(std::memory_order_relaxed) & dirtyFlag) == 0) {
+            return false;
+        }
+        const auto previous = shared.exchange(readIndex, std::memory_order_acq_rel);
+        readIndex = previous & indexMask;
+        destination = slots[static_cast<size_t>(readIndex)];
+        return true;
+    }
+
+private:
+    static constexpr int indexMask = 0x3;
+    static constexpr int dirtyFlag = 0x4;
+
+    std::array<T, 3> slots {};
+    std::atomic<int> shared { 1 };
+    int writeIndex = 0;
+    int readIndex = 2;
+};
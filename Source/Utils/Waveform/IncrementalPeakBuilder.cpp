@@ -0,0 +1,154 @@
+#include "IncrementalPeakBuilder.h"
+
+#include "PeakKernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+void IncrementalPeakBuilder::reset(int numChannels, double newSampleRate, int64) {
+    const juce::ScopedLock scopedLock(lock);
+    channelCount = static_cast<uint32>(std::max(0, numChannels));
+    sampleRate = newSampleRate;
+    totalSamples = 0;
+    levels.clear();
+    for (const auto blockSize : PeakFileBuilder::getLevelBlockSizes()) {
+        levels.push_back({ blockSize, {} });
+    }
+    blockMin.assign(channelCount, std::numeric_limits<float>::max());
+    blockMax.assign(channelCount, std::numeric_limits<float>::lowest());
+    blockSamplesFilled = 0;
+    completedBaseBlocks = 0;
+}
+
+void IncrementalPeakBuilder::addBlock(int64 sampleNumberInSource,
+                                      const juce::AudioBuffer<float>& newData,
+                                      int startOffset,
+                                      int numSamples) {
+    const juce::ScopedLock scopedLock(lock);
+    if (levels.empty() || numSamples <= 0) {
+        return;
+    }
+    // The writer hands over the stream in order; a gap would shift every later block.
+    jassert(static_cast<uint64>(sampleNumberInSource) == totalSamples);
+    juce::ignoreUnused(sampleNumberInSource);
+
+    const auto channelsToRead = std::min<uint32>(channelCount, static_cast<uint32>(newData.getNumChannels()));
+    const auto baseBlockSize = levels.front().blockSize;
+    int offset = 0;
+    while (offset < numSamples) {
+        const auto count = static_cast<int>(std::min<int64>(baseBlockSize - blockSamplesFilled, numSamples - offset));
+        for (uint32 channel = 0; channel < channelsToRead; ++channel) {
+            const auto range = juce::FloatVectorOperations::findMinAndMax(
+                newData.getReadPointer(static_cast<int>(channel), startOffset + offset), count);
+            blockMin[channel] = std::min(blockMin[channel], range.getStart());
+            blockMax[channel] = std::max(blockMax[channel], range.getEnd());
+        }
+        blockSamplesFilled += static_cast<uint32>(count);
+        offset += count;
+        if (blockSamplesFilled == baseBlockSize) {
+            completeBlock();
+        }
+    }
+    totalSamples += static_cast<uint64>(numSamples);
+}
+
+void IncrementalPeakBuilder::completeBlock() {
+    const auto valuesPerBlock = static_cast<size_t>(channelCount) * 2;
+    auto& base = levels.front();
+    for (uint32 channel = 0; channel < channelCount; ++channel) {
+        // Channels missing from the incoming buffer stay silent.
+        const auto hasData = blockMin[channel] <= blockMax[channel];
+        base.values.push_back(hasData ? PeakFileFormat::quantizeInt16(blockMin[channel]) : int16 { 0 });
+        base.values.push_back(hasData ? PeakFileFormat::quantizeInt16(blockMax[channel]) : int16 { 0 });
+        blockMin[channel] = std::numeric_limits<float>::max();
+        blockMax[channel] = std::numeric_limits<float>::lowest();
+    }
+    const auto* completed = base.values.data() + base.values.size() - valuesPerBlock;
+
+    // A coarser block opens with its first child and absorbs the following ones as they complete.
+    for (size_t levelIndex = 1; levelIndex < levels.size(); ++levelIndex) {
+        auto& level = levels[levelIndex];
+        const auto blockRatio = level.blockSize / base.blockSize;
+        if (completedBaseBlocks % blockRatio == 0) {
+            level.values.insert(level.values.end(), completed, completed + valuesPerBlock);
+            continue;
+        }
+        PeakKernels::mergeBlock(level.values.data() + level.values.size() - valuesPerBlock, completed, valuesPerBlock);
+    }
+    blockSamplesFilled = 0;
+    ++completedBaseBlocks;
+}
+
+bool IncrementalPeakBuilder::isValid() const {
+    const juce::ScopedLock scopedLock(lock);
+    return channelCount > 0 && !levels.empty();
+}
+
+bool IncrementalPeakBuilder::readBlocksForRange(uint32 samplesPerBlock,
+                                                uint64 startSample,
+                                                uint64 endSample,
+                                                std::vector<PeakBlock>& outBlocks) const {
+    const juce::ScopedLock scopedLock(lock);
+    const auto level = std::find_if(levels.begin(), levels.end(), [samplesPerBlock](const auto& candidate) {
+        return candidate.blockSize == samplesPerBlock;
+    });
+    if (level == levels.end() || channelCount == 0 || endSample <= startSample) {
+        return false;
+    }
+
+    // Nothing past the last completed block exists yet; a live take simply reads short.
+    const auto valuesPerBlock = static_cast<uint64>(channelCount) * 2;
+    const auto availableBlocks = level->values.size() / valuesPerBlock;
+    const auto startBlock = startSample / samplesPerBlock;
+    const auto endBlock = std::min<uint64>((endSample + samplesPerBlock - 1) / samplesPerBlock, availableBlocks);
+    if (startBlock >= endBlock) {
+        return false;
+    }
+
+    outBlocks.resize(static_cast<size_t>((endBlock - startBlock) * channelCount));
+    const auto* values = level->values.data() + startBlock * valuesPerBlock;
+    for (auto& block : outBlocks) {
+        block.min = *values++;
+        block.max = *values++;
+    }
+    return true;
+}
+
+uint32 IncrementalPeakBuilder::getChannelCount() const noexcept {
+    const juce::ScopedLock scopedLock(lock);
+    return channelCount;
+}
+
+uint64 IncrementalPeakBuilder::getTotalSamples() const noexcept {
+    const juce::ScopedLock scopedLock(lock);
+    return totalSamples;
+}
+
+uint32 IncrementalPeakBuilder::getSampleRate() const noexcept {
+    const juce::ScopedLock scopedLock(lock);
+    return static_cast<uint32>(std::lround(sampleRate));
+}
+
+size_t IncrementalPeakBuilder::getNumLevels() const noexcept {
+    const juce::ScopedLock scopedLock(lock);
+    return levels.size();
+}
+
+uint32 IncrementalPeakBuilder::getLevelBlockSize(size_t levelIndex) const noexcept {
+    const juce::ScopedLock scopedLock(lock);
+    return levels[levelIndex].blockSize;
+}
+
+bool IncrementalPeakBuilder::writePeakFile(const juce::File& peakFilePath,
+                                           const PeakFileBuilder::BuildOptions& options) {
+    const juce::ScopedLock scopedLock(lock);
+    if (totalSamples == 0 || levels.empty()) {
+        return false;
+    }
+    if (blockSamplesFilled > 0) {
+        completeBlock();
+    }
+    return PeakFileBuilder::writePeakFile(peakFilePath, sampleRate, channelCount, totalSamples,
+                                          levels, options);
+}
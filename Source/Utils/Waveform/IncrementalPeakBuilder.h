@@ -0,0 +1,74 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "PeakFile.h"
+#include "PeakFileBuilder.h"
+#include "PeakSource.h"
+
+/// Builds peak levels from audio as it streams to disk.
+/// Attached to a recorder's threaded writer, it receives every block after it is written, so a take
+/// can be drawn while recording and its peak file written at stop without reading the audio back.
+/// Blocks arrive on the writer thread; reads may come from any thread.
+class IncrementalPeakBuilder : public PeakSource,
+                               public juce::AudioFormatWriter::ThreadedWriter::IncomingDataReceiver {
+public:
+    /// Discard the built levels and start over.
+    /// @param numChannels channels per block
+    /// @param sampleRate sample rate of the incoming audio
+    /// @param totalSamplesInSource expected length (unused, takes grow while recording)
+    void reset(int numChannels, double sampleRate, int64 totalSamplesInSource) override;
+
+    /// Append samples written by the threaded writer (writer thread).
+    /// @param sampleNumberInSource position of the first sample in the file
+    /// @param newData buffer holding the samples
+    /// @param startOffset first sample to read in newData
+    /// @param numSamples number of samples to read
+    void addBlock(int64 sampleNumberInSource,
+                  const juce::AudioBuffer<float>& newData,
+                  int startOffset,
+                  int numSamples) override;
+
+    bool isValid() const override;
+
+    /// A take keeps growing until its peak file is written.
+    bool isComplete() const override { return false; }
+
+    /// Only completed blocks are read, so a range reaching past them reads short.
+    bool readBlocksForRange(uint32 samplesPerBlock,
+                            uint64 startSample,
+                            uint64 endSample,
+                            std::vector<PeakBlock>& outBlocks) const override;
+
+    uint32 getChannelCount() const noexcept override;
+
+    /// Number of samples received so far.
+    uint64 getTotalSamples() const noexcept override;
+
+    uint32 getSampleRate() const noexcept override;
+
+    /// Close the pending block and write the peak file (call once the writer is drained).
+    /// @param peakFilePath output .peak file
+    /// @param options build configuration
+    bool writePeakFile(const juce::File& peakFilePath,
+                       const PeakFileBuilder::BuildOptions& options = {});
+
+protected:
+    size_t getNumLevels() const noexcept override;
+
+    uint32 getLevelBlockSize(size_t levelIndex) const noexcept override;
+
+private:
+    /// Quantize the pending base block and merge it into every coarser level.
+    void completeBlock();
+
+    mutable juce::CriticalSection lock;
+    uint32 channelCount = 0;
+    double sampleRate = 0.0;
+    uint64 totalSamples = 0;
+    std::vector<PeakFileBuilder::LevelData> levels;
+    std::vector<float> blockMin;
+    std::vector<float> blockMax;
+    uint32 blockSamplesFilled = 0;
+    uint64 completedBaseBlocks = 0;
+};
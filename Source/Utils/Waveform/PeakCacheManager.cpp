@@ -1,70 +1,234 @@
 #include "PeakCacheManager.h"
 
+#include <algorithm>
 #include <cmath>
 
+PeakCacheManager::ChunkJob::ChunkJob(PeakCacheManager& manager,
+                                     juce::File audioFile,
+                                     juce::String key,
+                                     std::shared_ptr<PendingPeakFile> pending,
+                                     int chunkIndex)
+    : ThreadPoolJob("PeakChunk"),
+      manager(manager),
+      audioFile(std::move(audioFile)),
+      key(std::move(key)),
+      pending(std::move(pending)),
+      chunkIndex(chunkIndex) {
+}
+
+juce::ThreadPoolJob::JobStatus PeakCacheManager::ChunkJob::runJob() {
+    if (shouldExit()) {
+        return jobHasFinished;
+    }
+    auto reader = std::unique_ptr<juce::AudioFormatReader>(manager.formatManager.createReaderFor(audioFile));
+    if (reader == nullptr) {
+        juce::Logger::writeToLog("PeakCacheManager: cannot read " + audioFile.getFullPathName());
+        return jobHasFinished;
+    }
+    if (pending->buildChunk(chunkIndex, *reader)) {
+        manager.buildFinished(key, pending->finish(manager.getBuildOptions()));
+    }
+    manager.sendChangeMessage();
+    return jobHasFinished;
+}
+
+PeakCacheManager::PeakCacheManager() {
+    formatManager.registerBasicFormats();
+}
+
+PeakCacheManager::~PeakCacheManager() {
+    pool.removeAllJobs(true, 10000);
+    const juce::ScopedLock scopedLock(lock);
+    index.save();
+}
+
 PeakCacheManager& PeakCacheManager::get() {
     static PeakCacheManager instance;
     return instance;
 }
 
-std::shared_ptr<PeakFile> PeakCacheManager::getOrBuildPeakFile(const juce::File& audioFile,
-                                                               juce::AudioFormatReader& reader) {
-    const auto key = audioFile.getFullPathName();
+juce::File PeakCacheManager::getDefaultCacheDirectory() {
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory)
+        .getChildFile("AudioVision")
+        .getChildFile("PeakCache");
+}
+
+void PeakCacheManager::setCacheDirectory(const juce::File& directory) {
+    const juce::ScopedLock scopedLock(lock);
+    if (directory == index.getDirectory()) {
+        return;
+    }
+    index.save();
+    index = ContentCacheIndex(directory, index.getMaxBytes(), ".peak", kIndexFileName);
+    // Open peak files stay valid for their holders but no longer belong to the cache.
+    cache.clear();
+}
+
+juce::File PeakCacheManager::getCacheDirectory() const {
+    const juce::ScopedLock scopedLock(lock);
+    return index.getDirectory();
+}
+
+void PeakCacheManager::setCacheSizeLimit(int64 maxBytes) {
+    const juce::ScopedLock scopedLock(lock);
+    index.setMaxBytes(maxBytes, [this](const juce::String& key) { return isInUse(key); });
+}
+
+std::shared_ptr<PeakFile> PeakCacheManager::findPeakFile(const juce::File& audioFile,
+                                                         const juce::AudioFormatReader& reader) {
+    const auto key = fingerprints.getKey(audioFile);
+    if (key.isEmpty()) {
+        return nullptr;
+    }
+    juce::File peakFilePath;
     {
         const juce::ScopedLock scopedLock(lock);
         auto it = cache.find(key);
         if (it != cache.end()) {
             if (auto cached = it->second.lock()) {
+                index.touch(key);
                 return cached;
             }
         }
+        // The index answers without touching the disk; only listed files are opened.
+        if (!index.contains(key)) {
+            return nullptr;
+        }
+        peakFilePath = index.getFilePath(key);
     }
 
-    const auto peakFilePath = getPeakFilePath(audioFile);
-    const auto audioModified = audioFile.getLastModificationTime();
-    bool shouldBuild = !peakFilePath.existsAsFile()
-                       || peakFilePath.getLastModificationTime() < audioModified;
-
-    std::shared_ptr<PeakFile> peakFile;
-    if (!shouldBuild) {
-        peakFile = PeakFile::open(peakFilePath);
-        if (peakFile != nullptr) {
-            const auto expectedSamples = static_cast<uint64>(reader.lengthInSamples);
-            const auto expectedChannels = static_cast<uint32>(reader.numChannels);
-            const auto expectedRate = static_cast<uint32>(std::lround(reader.sampleRate));
-            if (peakFile->getTotalSamples() != expectedSamples
-                || peakFile->getChannelCount() != expectedChannels
-                || peakFile->getSampleRate() != expectedRate
-                || peakFile->getBaseBlockSize() != PeakFileBuilder::getMinSamplesPerBlock()) {
-                peakFile.reset();
-                shouldBuild = true;
-            }
-        } else {
-            shouldBuild = true;
-        }
+    auto peakFile = PeakFile::open(peakFilePath);
+    if (peakFile == nullptr) {
+        // Deleted or damaged behind the index's back: drop it so it gets rebuilt.
+        const juce::ScopedLock scopedLock(lock);
+        index.remove(key);
+        return nullptr;
+    }
+    const auto expectedSamples = static_cast<uint64>(reader.lengthInSamples);
+    const auto expectedChannels = static_cast<uint32>(reader.numChannels);
+    const auto expectedRate = static_cast<uint32>(std::lround(reader.sampleRate));
+    if (peakFile->getTotalSamples() != expectedSamples
+        || peakFile->getChannelCount() != expectedChannels
+        || peakFile->getSampleRate() != expectedRate
+        || peakFile->getBaseBlockSize() != PeakFileBuilder::getMinSamplesPerBlock()) {
+        return nullptr;
     }
 
-    if (shouldBuild) {
-        PeakFileBuilder::BuildOptions options;
-        if (!builder.build(reader, peakFilePath, options)) {
+    const juce::ScopedLock scopedLock(lock);
+    cache[key] = peakFile;
+    index.touch(key);
+    return peakFile;
+}
+
+std::shared_ptr<PendingPeakFile> PeakCacheManager::buildPeakFileAsync(const juce::File& audioFile,
+                                                                      const juce::AudioFormatReader& reader) {
+    const auto key = fingerprints.getKey(audioFile);
+    if (key.isEmpty()) {
+        return nullptr;
+    }
+    std::shared_ptr<PendingPeakFile> pending;
+    {
+        const juce::ScopedLock scopedLock(lock);
+        if (auto running = pendingBuilds[key].lock()) {
+            return running;
+        }
+        pending = std::make_shared<PendingPeakFile>(index.getFilePath(key),
+                                                    static_cast<uint32>(reader.numChannels),
+                                                    static_cast<uint64>(std::max<int64>(0, reader.lengthInSamples)),
+                                                    reader.sampleRate);
+        if (!pending->isValid()) {
+            pendingBuilds.erase(key);
             return nullptr;
         }
-        peakFile = PeakFile::open(peakFilePath);
+        pendingBuilds[key] = pending;
     }
 
-    if (peakFile == nullptr) {
-        return nullptr;
+    for (int chunkIndex = 0; chunkIndex < pending->getNumChunks(); ++chunkIndex) {
+        pool.addJob(new ChunkJob(*this, audioFile, key, pending, chunkIndex), true);
     }
+    return pending;
+}
 
-    {
+std::shared_ptr<PeakFile> PeakCacheManager::getOrBuildPeakFile(const juce::File& audioFile,
+                                                               juce::AudioFormatReader& reader) {
+    if (auto peakFile = findPeakFile(audioFile, reader)) {
+        return peakFile;
+    }
+
+    const auto key = fingerprints.getKey(audioFile);
+    if (key.isEmpty()) {
+        return nullptr;
+    }
+    const auto peakFilePath = getPeakFilePath(audioFile);
+    if (!builder.build(reader, peakFilePath, getBuildOptions())) {
+        return nullptr;
+    }
+    auto peakFile = PeakFile::open(peakFilePath);
+    if (peakFile != nullptr) {
         const juce::ScopedLock scopedLock(lock);
         cache[key] = peakFile;
+        addToIndex(key);
     }
-
     return peakFile;
 }
 
-juce::File PeakCacheManager::getPeakFilePath(const juce::File& audioFile) const {
-    const auto extension = audioFile.getFileExtension() + ".peak";
-    return audioFile.withFileExtension(extension);
+bool PeakCacheManager::waitForPendingBuilds(int timeoutMs) {
+    const auto deadline = juce::Time::getMillisecondCounter() + static_cast<uint32>(timeoutMs);
+    while (pool.getNumJobs() > 0) {
+        if (juce::Time::getMillisecondCounter() >= deadline) {
+            return false;
+        }
+        juce::Thread::sleep(5);
+    }
+    return true;
+}
+
+void PeakCacheManager::buildFinished(const juce::String& key, const std::shared_ptr<PeakFile>& peakFile) {
+    const juce::ScopedLock scopedLock(lock);
+    pendingBuilds.erase(key);
+    if (peakFile != nullptr) {
+        cache[key] = peakFile;
+        addToIndex(key);
+    }
+}
+
+void PeakCacheManager::addPeakFile(const juce::File& audioFile) {
+    const auto key = fingerprints.getKey(audioFile);
+    if (key.isEmpty()) {
+        return;
+    }
+    const juce::ScopedLock scopedLock(lock);
+    addToIndex(key);
+}
+
+void PeakCacheManager::addToIndex(const juce::String& key) {
+    const auto size = index.getFilePath(key).getSize();
+    if (size > 0) {
+        index.add(key, size, [this](const juce::String& candidate) { return isInUse(candidate); });
+    }
+}
+
+bool PeakCacheManager::isInUse(const juce::String& key) const {
+    const auto open = cache.find(key);
+    if (open != cache.end() && !open->second.expired()) {
+        return true;
+    }
+    const auto building = pendingBuilds.find(key);
+    return building != pendingBuilds.end() && !building->second.expired();
+}
+
+PeakFileBuilder::BuildOptions PeakCacheManager::getBuildOptions() const {
+    PeakFileBuilder::BuildOptions options;
+    options.compressionHook = PeakFileBuilder::createCompressionHook(PeakFileFormat::Compression::Rice,
+                                                                     PeakFileFormat::DeltaEncoding::MinMaxPairs);
+    return options;
+}
+
+juce::File PeakCacheManager::getPeakFilePath(const juce::File& audioFile) {
+    const auto key = fingerprints.getKey(audioFile);
+    if (key.isEmpty()) {
+        return {};
+    }
+    const juce::ScopedLock scopedLock(lock);
+    return index.getFilePath(key);
 }
@@ -4,27 +4,117 @@
 
 #include <unordered_map>
 
+#include "Utils/Cache/ContentCacheIndex.h"
+#include "Utils/Cache/FingerprintCache.h"
 #include "PeakFile.h"
 #include "PeakFileBuilder.h"
+#include "PendingPeakFile.h"
 
 /// Manages on-disk peak caches for audio files.
-class PeakCacheManager {
+/// Peak files live in one cache directory, keyed by a fingerprint of the audio content (see
+/// ContentCacheIndex), so media on read-only volumes gets peaks too and copies share them.
+/// Missing caches are built on a background pool, a file split into chunks across workers;
+/// a change message is sent whenever a chunk lands so waveforms can fill in progressively.
+class PeakCacheManager : public juce::ChangeBroadcaster {
 public:
+    /// Name of the index file inside the cache directory.
+    static constexpr const char* kIndexFileName = "peaks.index";
+    /// Default total size of the peak files.
+    static constexpr int64 kDefaultCacheBytes = int64 { 2 } * 1024 * 1024 * 1024;
+
+    ~PeakCacheManager() override;
+
     /// Access the shared peak cache manager.
     static PeakCacheManager& get();
 
-    /// Get or build a peak file for an audio reader.
+    /// Default cache directory, in the user application data folder.
+    static juce::File getDefaultCacheDirectory();
+
+    /// Move the cache to another directory (peak files already built elsewhere are not moved).
+    /// @param directory cache directory
+    void setCacheDirectory(const juce::File& directory);
+
+    /// Current cache directory.
+    juce::File getCacheDirectory() const;
+
+    /// Change the total size budget, evicting least recently used peak files as needed.
+    /// @param maxBytes size budget in bytes
+    void setCacheSizeLimit(int64 maxBytes);
+
+    /// Open an up-to-date peak file for an audio file, without building one.
+    /// @param audioFile audio file path
+    /// @param reader audio reader for the file, to validate the cache
+    /// @return the peak file, or nullptr when it is missing or stale
+    std::shared_ptr<PeakFile> findPeakFile(const juce::File& audioFile,
+                                           const juce::AudioFormatReader& reader);
+
+    /// Start building peaks in the background, or join the build already running for the file.
+    /// @param audioFile audio file path
+    /// @param reader audio reader for the file, for its format
+    std::shared_ptr<PendingPeakFile> buildPeakFileAsync(const juce::File& audioFile,
+                                                        const juce::AudioFormatReader& reader);
+
+    /// Get or build a peak file for an audio reader, blocking until it is built.
     /// @param audioFile audio file path
     /// @param reader audio reader for the file
     std::shared_ptr<PeakFile> getOrBuildPeakFile(const juce::File& audioFile,
                                                  juce::AudioFormatReader& reader);
 
+    /// Wait for every queued chunk to be built.
+    /// @param timeoutMs maximum wait in milliseconds
+    /// @return true when no build is left
+    bool waitForPendingBuilds(int timeoutMs);
+
+    /// Options used for every peak file written by the cache (Rice-compressed version 2).
+    PeakFileBuilder::BuildOptions getBuildOptions() const;
+
+    /// Location of the peak file for an audio file's content.
+    /// @param audioFile audio file path
+    /// @return the peak file path, or an invalid file when the audio cannot be read
+    juce::File getPeakFilePath(const juce::File& audioFile);
+
+    /// Record a peak file written at getPeakFilePath() in the cache, evicting as needed.
+    /// @param audioFile audio file the peaks were built from
+    void addPeakFile(const juce::File& audioFile);
+
 private:
-    PeakCacheManager() = default;
+    /// Builds one chunk of a pending peak file with its own reader.
+    class ChunkJob : public juce::ThreadPoolJob {
+    public:
+        ChunkJob(PeakCacheManager& manager,
+                 juce::File audioFile,
+                 juce::String key,
+                 std::shared_ptr<PendingPeakFile> pending,
+                 int chunkIndex);
+
+        JobStatus runJob() override;
+
+    private:
+        PeakCacheManager& manager;
+        juce::File audioFile;
+        juce::String key;
+        std::shared_ptr<PendingPeakFile> pending;
+        int chunkIndex = 0;
+    };
+
+    PeakCacheManager();
+
+    /// Publish a finished build in the cache.
+    void buildFinished(const juce::String& key, const std::shared_ptr<PeakFile>& peakFile);
+
+    /// Index the peak file of a key (call with the lock held).
+    void addToIndex(const juce::String& key);
 
-    juce::File getPeakFilePath(const juce::File& audioFile) const;
+    /// True while a peak file is open or being built (call with the lock held).
+    bool isInUse(const juce::String& key) const;
 
-    juce::CriticalSection lock;
+    mutable juce::CriticalSection lock;
+    ContentCacheIndex index { getDefaultCacheDirectory(), kDefaultCacheBytes, ".peak", kIndexFileName };
+    FingerprintCache fingerprints;
+    /// Keyed by content key.
     std::unordered_map<String, std::weak_ptr<PeakFile>> cache;
+    std::unordered_map<String, std::weak_ptr<PendingPeakFile>> pendingBuilds;
     PeakFileBuilder builder;
+    juce::AudioFormatManager formatManager;
+    juce::ThreadPool pool { juce::jmax(1, juce::SystemStats::getNumCpus() - 1) };
 };
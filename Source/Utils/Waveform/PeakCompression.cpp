@@ -0,0 +1,175 @@
+#include "PeakCompression.h"
+
+#include <bit>
+#include <limits>
+
+namespace {
+/// Quotients from here on are written as raw values.
+constexpr uint32 kEscapeQuotient = 24;
+/// Bits of a raw value: the zigzag of any Int16 difference fits.
+constexpr int kRawBits = 17;
+constexpr uint32 kMaxRiceParameter = 16;
+
+uint32 zigzag(int32 value) {
+    return (static_cast<uint32>(value) << 1) ^ static_cast<uint32>(value >> 31);
+}
+
+int32 unzigzag(uint32 value) {
+    return static_cast<int32>(value >> 1) ^ -static_cast<int32>(value & 1);
+}
+
+class BitWriter {
+public:
+    explicit BitWriter(juce::OutputStream& output) : output(output) {}
+
+    void write(uint32 value, int numBits) {
+        accumulator |= static_cast<uint64>(value) << bitCount;
+        bitCount += numBits;
+        while (bitCount >= 8) {
+            output.writeByte(static_cast<char>(accumulator & 0xff));
+            accumulator >>= 8;
+            bitCount -= 8;
+        }
+    }
+
+    bool flush() {
+        if (bitCount > 0) {
+            output.writeByte(static_cast<char>(accumulator & 0xff));
+        }
+        accumulator = 0;
+        bitCount = 0;
+        return output.getStatus().wasOk();
+    }
+
+private:
+    juce::OutputStream& output;
+    uint64 accumulator = 0;
+    int bitCount = 0;
+};
+
+class BitReader {
+public:
+    BitReader(const uint8* data, size_t size) : data(data), size(size) {}
+
+    uint32 read(int numBits) {
+        refill();
+        const auto value = static_cast<uint32>(accumulator & ((uint64 { 1 } << numBits) - 1));
+        consume(numBits);
+        return value;
+    }
+
+    /// Count ones up to the terminating zero (consumed), stopping after limit ones.
+    uint32 readUnary(uint32 limit) {
+        refill();
+        // Bits past the data read as zero, so the count never runs beyond the available bits.
+        const auto ones = std::min(static_cast<uint32>(std::countr_one(accumulator)), limit);
+        consume(static_cast<int>(ones));
+        if (ones < limit) {
+            consume(1);
+        }
+        return ones;
+    }
+
+    /// True when no read went past the end of the data.
+    bool isValid() const { return bitsPastEnd <= 0; }
+
+private:
+    void refill() {
+        while (bitCount <= 56 && position < size) {
+            accumulator |= static_cast<uint64>(data[position++]) << bitCount;
+            bitCount += 8;
+        }
+    }
+
+    void consume(int numBits) {
+        if (numBits > bitCount) {
+            bitsPastEnd += numBits - bitCount;
+            accumulator = 0;
+            bitCount = 0;
+            return;
+        }
+        accumulator >>= numBits;
+        bitCount -= numBits;
+    }
+
+    const uint8* data = nullptr;
+    size_t size = 0;
+    size_t position = 0;
+    uint64 accumulator = 0;
+    int bitCount = 0;
+    int bitsPastEnd = 0;
+};
+} // namespace
+
+bool RicePeakCompression::compress(juce::OutputStream& output,
+                                   const int16* values,
+                                   size_t valueCount,
+                                   size_t valuesPerBlock) {
+    if (valuesPerBlock == 0 || valueCount % valuesPerBlock != 0) {
+        // Chunks hold whole blocks.
+        jassert(false);
+        return false;
+    }
+
+    std::vector<uint32> residuals(valueCount);
+    for (size_t index = 0; index < valueCount; ++index) {
+        const auto previous = index >= valuesPerBlock ? static_cast<int32>(values[index - valuesPerBlock]) : 0;
+        residuals[index] = zigzag(static_cast<int32>(values[index]) - previous);
+    }
+
+    // Pick the parameter with the smallest exact output size.
+    uint32 bestParameter = 0;
+    auto bestBits = std::numeric_limits<uint64>::max();
+    for (uint32 parameter = 0; parameter <= kMaxRiceParameter; ++parameter) {
+        uint64 bits = 0;
+        for (const auto residual : residuals) {
+            const auto quotient = residual >> parameter;
+            bits += quotient >= kEscapeQuotient ? kEscapeQuotient + kRawBits : quotient + 1 + parameter;
+        }
+        if (bits < bestBits) {
+            bestBits = bits;
+            bestParameter = parameter;
+        }
+    }
+
+    output.writeByte(static_cast<char>(bestParameter));
+    BitWriter writer(output);
+    for (const auto residual : residuals) {
+        const auto quotient = residual >> bestParameter;
+        if (quotient >= kEscapeQuotient) {
+            writer.write((1u << kEscapeQuotient) - 1, static_cast<int>(kEscapeQuotient));
+            writer.write(residual, kRawBits);
+            continue;
+        }
+        // Ones then a terminating zero.
+        writer.write((1u << quotient) - 1, static_cast<int>(quotient + 1));
+        if (bestParameter > 0) {
+            writer.write(residual & ((1u << bestParameter) - 1), static_cast<int>(bestParameter));
+        }
+    }
+    return writer.flush();
+}
+
+bool RicePeakCompression::decompress(const uint8* data,
+                                     size_t sizeBytes,
+                                     int16* values,
+                                     size_t valueCount,
+                                     size_t valuesPerBlock) const {
+    if (sizeBytes < 1 || valuesPerBlock == 0 || data[0] > kMaxRiceParameter) {
+        return false;
+    }
+    const auto parameter = static_cast<int>(data[0]);
+    BitReader reader(data + 1, sizeBytes - 1);
+    for (size_t index = 0; index < valueCount; ++index) {
+        const auto quotient = reader.readUnary(kEscapeQuotient);
+        uint32 residual = 0;
+        if (quotient >= kEscapeQuotient) {
+            residual = reader.read(kRawBits);
+        } else {
+            residual = (quotient << parameter) | (parameter > 0 ? reader.read(parameter) : 0);
+        }
+        const auto previous = index >= valuesPerBlock ? static_cast<int32>(values[index - valuesPerBlock]) : 0;
+        values[index] = static_cast<int16>(previous + unzigzag(residual));
+    }
+    return reader.isValid();
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include "PeakFileBuilder.h"
+
+/// Delta + Rice coder for peak chunks.
+/// Neighbouring blocks have close peaks, so each min and max is stored as the zigzagged
+/// difference to the previous block of the same channel. Differences are Rice coded with one
+/// parameter per chunk, picked from the mean magnitude; unusually large ones escape to raw bits.
+class RicePeakCompression : public PeakFileBuilder::CompressionHook {
+public:
+    PeakFileFormat::Compression getCompression() const override {
+        return PeakFileFormat::Compression::Rice;
+    }
+
+    PeakFileFormat::DeltaEncoding getDeltaEncoding() const override {
+        return PeakFileFormat::DeltaEncoding::MinMaxPairs;
+    }
+
+    bool compress(juce::OutputStream& output,
+                  const int16* values,
+                  size_t valueCount,
+                  size_t valuesPerBlock) override;
+
+    bool decompress(const uint8* data,
+                    size_t sizeBytes,
+                    int16* values,
+                    size_t valueCount,
+                    size_t valuesPerBlock) const override;
+};
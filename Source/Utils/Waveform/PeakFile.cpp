@@ -47,6 +47,14 @@ bool readHeader(const uint8* data, size_t size, PeakFileFormat::Header& header)
     }
     header.deltaEncoding = static_cast<PeakFileFormat::DeltaEncoding>(data[offset]);
     offset += 1;
+    if (!PeakFileFormat::readUint16LE(data, size, offset, header.blocksPerChunk)) {
+        return false;
+    }
+    if (offset + 1 > size) {
+        return false;
+    }
+    header.int8LevelMask = data[offset];
+    offset += 1;
     if (offset + sizeof(header.reserved) > size) {
         return false;
     }
@@ -111,17 +119,35 @@ bool PeakFile::load() {
     if (!readHeader(rawData, static_cast<size_t>(fileSize), header)) {
         return false;
     }
-    if (header.magic != PeakFileFormat::kMagic || header.version != PeakFileFormat::kVersion) {
+    if (header.magic != PeakFileFormat::kMagic) {
         return false;
     }
     if (header.headerSize != PeakFileFormat::kHeaderSize) {
         return false;
     }
-    if (header.compression != PeakFileFormat::Compression::None
-        || header.deltaEncoding != PeakFileFormat::DeltaEncoding::None) {
+    if (header.version == PeakFileFormat::kVersion1) {
+        if (header.compression != PeakFileFormat::Compression::None
+            || header.deltaEncoding != PeakFileFormat::DeltaEncoding::None) {
+            return false;
+        }
+    } else if (header.version == PeakFileFormat::kVersion2) {
+        compressionHook = PeakFileBuilder::createCompressionHook(header.compression, header.deltaEncoding);
+        if (compressionHook == nullptr || header.blocksPerChunk == 0) {
+            return false;
+        }
+        blocksPerChunk = header.blocksPerChunk;
+    } else {
         return false;
     }
-    if (header.sampleFormat != PeakFileFormat::SampleFormat::Int16) {
+    if (header.sampleFormat == PeakFileFormat::SampleFormat::Int16) {
+        if (header.int8LevelMask != 0) {
+            return false;
+        }
+    } else if (header.sampleFormat == PeakFileFormat::SampleFormat::Int8) {
+        if (header.levelCount < 8 && (header.int8LevelMask >> header.levelCount) != 0) {
+            return false;
+        }
+    } else {
         return false;
     }
 
@@ -133,7 +159,16 @@ bool PeakFile::load() {
         if (!readLevelInfo(rawData, static_cast<size_t>(fileSize), offset, info)) {
             return false;
         }
-        levels.push_back({ info.offset, info.blockSize, info.blockCount });
+        if (compressionHook != nullptr) {
+            // The whole chunk index must lie within the file.
+            const auto chunkCount = (static_cast<uint64>(info.blockCount) + blocksPerChunk - 1) / blocksPerChunk;
+            if (info.offset + (chunkCount + 1) * sizeof(uint64) > static_cast<uint64>(fileSize)) {
+                return false;
+            }
+        }
+        const auto levelFormat = i < 8 && (header.int8LevelMask & (1u << i)) != 0 ? PeakFileFormat::SampleFormat::Int8
+                                                                                  : PeakFileFormat::SampleFormat::Int16;
+        levels.push_back({ info.offset, info.blockSize, info.blockCount, levelFormat });
     }
 
     sampleFormat = header.sampleFormat;
@@ -148,39 +183,20 @@ bool PeakFile::isValid() const {
     return mappedFile != nullptr && !levels.empty();
 }
 
-uint32 PeakFile::getBestResolution(double samplesPerPixel) const {
-    if (levels.empty()) {
-        // Peak levels must be available before selecting.
-        jassert(false);
-        return 0;
-    }
-
-    const auto target = std::max(1.0, samplesPerPixel);
-    auto bestIndex = static_cast<size_t>(0);
-    auto bestDiff = std::abs(static_cast<double>(levels.front().blockSize) - target);
-    for (size_t index = 1; index < levels.size(); ++index) {
-        const auto diff = std::abs(static_cast<double>(levels[index].blockSize) - target);
-        if (diff < bestDiff) {
-            bestDiff = diff;
-            bestIndex = index;
-        }
-    }
-    return levels[bestIndex].blockSize;
-}
-
-bool PeakFile::readBlocksForRange(uint32 samplesPerBlock,
-                                  uint64 startSample,
-                                  uint64 endSample,
-                                  std::vector<PeakBlock>& outBlocks) const {
+const PeakFile::LevelInfo* PeakFile::findBlocks(uint32 samplesPerBlock,
+                                                uint64 startSample,
+                                                uint64 endSample,
+                                                uint64& outStartBlock,
+                                                uint32& outBlockCount) const {
     if (!isValid()) {
         // should be valid
         jassert(false);
-        return false;
+        return nullptr;
     }
     if (samplesPerBlock == 0 || endSample <= startSample) {
         // should be in range
         jassert(false);
-        return false;
+        return nullptr;
     }
     const LevelInfo* level = nullptr;
     for (const auto& info : levels) {
@@ -192,14 +208,14 @@ bool PeakFile::readBlocksForRange(uint32 samplesPerBlock,
     if (level == nullptr) {
         // level should have been found
         jassert(false);
-        return false;
+        return nullptr;
     }
 
     const auto clampedEnd = std::min<uint64>(endSample, totalSamples);
     if (clampedEnd <= startSample) {
         // should be clamped
         jassert(false);
-        return false;
+        return nullptr;
     }
 
     const auto startBlock = static_cast<uint64>(startSample / level->blockSize);
@@ -208,26 +224,77 @@ bool PeakFile::readBlocksForRange(uint32 samplesPerBlock,
     if (startBlock >= level->blockCount) {
         // should be clamped
         jassert(false);
-        return false;
+        return nullptr;
     }
 
-    const auto clampedBlockCount = std::min<uint32>(blockCount,
-                                                    static_cast<uint32>(level->blockCount - startBlock));
+    outStartBlock = startBlock;
+    outBlockCount = std::min<uint32>(blockCount, static_cast<uint32>(level->blockCount - startBlock));
+    return level;
+}
+
+const uint8* PeakFile::getLevelData(const LevelInfo& level, uint64 startBlock, uint32 blockCount) const {
     const auto valuesPerBlock = static_cast<size_t>(channelCount) * 2;
-    const auto bytesPerBlock = valuesPerBlock * sizeof(int16);
-    const auto byteOffset = level->offset + startBlock * bytesPerBlock;
-    const auto byteCount = static_cast<uint64>(clampedBlockCount) * bytesPerBlock;
+    const auto isInt8 = level.sampleFormat == PeakFileFormat::SampleFormat::Int8;
+    const auto bytesPerBlock = valuesPerBlock * (isInt8 ? sizeof(int8) : sizeof(int16));
+    const auto byteOffset = level.offset + startBlock * bytesPerBlock;
+    const auto byteCount = static_cast<uint64>(blockCount) * bytesPerBlock;
     const auto fileSize = static_cast<uint64>(mappedFile->getSize());
     if (byteOffset + byteCount > fileSize) {
         // should be clamped
         jassert(false);
+        return nullptr;
+    }
+    return static_cast<const uint8*>(mappedFile->getData()) + byteOffset;
+}
+
+bool PeakFile::readBlocksForRange(uint32 samplesPerBlock,
+                                  uint64 startSample,
+                                  uint64 endSample,
+                                  std::vector<PeakBlock>& outBlocks) const {
+    uint64 startBlock = 0;
+    uint32 clampedBlockCount = 0;
+    const auto* level = findBlocks(samplesPerBlock, startSample, endSample, startBlock, clampedBlockCount);
+    if (level == nullptr) {
         return false;
     }
 
-    const auto* rawData = static_cast<const uint8*>(mappedFile->getData());
-    const auto* blockData = rawData + byteOffset;
+    const auto valuesPerBlock = static_cast<size_t>(channelCount) * 2;
+    if (compressionHook != nullptr) {
+        const auto levelIndex = static_cast<size_t>(level - levels.data());
+        outBlocks.resize(static_cast<size_t>(clampedBlockCount) * channelCount);
+        auto* out = outBlocks.data();
+        const juce::ScopedLock scopedLock(chunkCacheLock);
+        for (auto blockIndex = startBlock; blockIndex < startBlock + clampedBlockCount;) {
+            const auto chunkIndex = blockIndex / blocksPerChunk;
+            const auto* chunk = getChunk(levelIndex, chunkIndex);
+            if (chunk == nullptr) {
+                return false;
+            }
+            const auto chunkEnd = std::min<uint64>((chunkIndex + 1) * blocksPerChunk, startBlock + clampedBlockCount);
+            const auto* values = chunk->data() + (blockIndex - chunkIndex * blocksPerChunk) * valuesPerBlock;
+            for (; blockIndex < chunkEnd; ++blockIndex) {
+                for (uint32 channel = 0; channel < channelCount; ++channel, ++out) {
+                    out->min = *values++;
+                    out->max = *values++;
+                }
+            }
+        }
+        return true;
+    }
+    const auto* blockData = getLevelData(*level, startBlock, clampedBlockCount);
+    if (blockData == nullptr) {
+        return false;
+    }
 
     outBlocks.resize(static_cast<size_t>(clampedBlockCount) * channelCount);
+    if (level->sampleFormat == PeakFileFormat::SampleFormat::Int8) {
+        const auto* values = reinterpret_cast<const int8*>(blockData);
+        for (auto& block : outBlocks) {
+            block.min = PeakFileFormat::dequantizeInt8(*values++);
+            block.max = PeakFileFormat::dequantizeInt8(*values++);
+        }
+        return true;
+    }
     size_t dataOffset = 0;
     for (uint32 blockIndex = 0; blockIndex < clampedBlockCount; ++blockIndex) {
         for (uint32 channel = 0; channel < channelCount; ++channel) {
@@ -240,3 +307,101 @@ bool PeakFile::readBlocksForRange(uint32 samplesPerBlock,
     }
     return true;
 }
+
+bool PeakFile::visitBlocksForRange(uint32 samplesPerBlock,
+                                   uint64 startSample,
+                                   uint64 endSample,
+                                   const std::function<void(const BlockRun&)>& visitor) const {
+    uint64 startBlock = 0;
+    uint32 blockCount = 0;
+    const auto* level = findBlocks(samplesPerBlock, startSample, endSample, startBlock, blockCount);
+    if (level == nullptr) {
+        return false;
+    }
+
+    BlockRun run;
+    if (compressionHook != nullptr) {
+        // One run per decoded chunk; the lock keeps the chunk cached while it is visited.
+        const auto levelIndex = static_cast<size_t>(level - levels.data());
+        const auto valuesPerBlock = static_cast<size_t>(channelCount) * 2;
+        const juce::ScopedLock scopedLock(chunkCacheLock);
+        for (auto blockIndex = startBlock; blockIndex < startBlock + blockCount;) {
+            const auto chunkIndex = blockIndex / blocksPerChunk;
+            const auto* chunk = getChunk(levelIndex, chunkIndex);
+            if (chunk == nullptr) {
+                return false;
+            }
+            const auto chunkEnd = std::min<uint64>((chunkIndex + 1) * blocksPerChunk, startBlock + blockCount);
+            run.int16Values = chunk->data() + (blockIndex - chunkIndex * blocksPerChunk) * valuesPerBlock;
+            run.firstBlock = blockIndex;
+            run.blockCount = static_cast<uint32>(chunkEnd - blockIndex);
+            visitor(run);
+            blockIndex = chunkEnd;
+        }
+        return true;
+    }
+
+    const auto* blockData = getLevelData(*level, startBlock, blockCount);
+    if (blockData == nullptr) {
+        return false;
+    }
+    if (level->sampleFormat == PeakFileFormat::SampleFormat::Int8) {
+        run.int8Values = reinterpret_cast<const int8*>(blockData);
+    } else {
+#if JUCE_LITTLE_ENDIAN
+        // Stored little-endian and 2-byte aligned, so the mapping is already in memory order.
+        run.int16Values = reinterpret_cast<const int16*>(blockData);
+#else
+        return PeakSource::visitBlocksForRange(samplesPerBlock, startSample, endSample, visitor);
+#endif
+    }
+    run.firstBlock = startBlock;
+    run.blockCount = blockCount;
+    visitor(run);
+    return true;
+}
+
+const std::vector<int16>* PeakFile::getChunk(size_t levelIndex, uint64 chunkIndex) const {
+    for (auto it = chunkCache.begin(); it != chunkCache.end(); ++it) {
+        if (it->levelIndex == levelIndex && it->chunkIndex == chunkIndex) {
+            chunkCache.splice(chunkCache.begin(), chunkCache, it);
+            return &chunkCache.front().values;
+        }
+    }
+
+    const auto& level = levels[levelIndex];
+    const auto* rawData = static_cast<const uint8*>(mappedFile->getData());
+    const auto fileSize = static_cast<size_t>(mappedFile->getSize());
+    auto indexOffset = static_cast<size_t>(level.offset + chunkIndex * sizeof(uint64));
+    uint64 chunkStart = 0;
+    uint64 chunkEnd = 0;
+    if (!PeakFileFormat::readUint64LE(rawData, fileSize, indexOffset, chunkStart)
+        || !PeakFileFormat::readUint64LE(rawData, fileSize, indexOffset, chunkEnd)
+        || chunkEnd < chunkStart || chunkEnd > fileSize) {
+        // The chunk index should point inside the file.
+        jassert(false);
+        return nullptr;
+    }
+
+    const auto valuesPerBlock = static_cast<size_t>(channelCount) * 2;
+    const auto firstBlock = chunkIndex * blocksPerChunk;
+    const auto blockCount = std::min<uint64>(blocksPerChunk, level.blockCount - firstBlock);
+    CachedChunk chunk { levelIndex, chunkIndex, std::vector<int16>(static_cast<size_t>(blockCount) * valuesPerBlock) };
+    if (!compressionHook->decompress(rawData + chunkStart, static_cast<size_t>(chunkEnd - chunkStart),
+                                     chunk.values.data(), chunk.values.size(), valuesPerBlock)) {
+        // Corrupt chunk.
+        jassert(false);
+        return nullptr;
+    }
+    if (level.sampleFormat == PeakFileFormat::SampleFormat::Int8) {
+        for (auto& value : chunk.values) {
+            value = PeakFileFormat::dequantizeInt8(static_cast<int8>(value));
+        }
+    }
+
+    if (chunkCache.size() >= kChunkCacheSize) {
+        chunkCache.pop_back();
+    }
+    chunkCache.push_front(std::move(chunk));
+    return &chunkCache.front().values;
+}
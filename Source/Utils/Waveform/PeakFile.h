@@ -2,26 +2,27 @@
 
 #include <JuceHeader.h>
 
+#include <list>
+
+#include "PeakFileBuilder.h"
 #include "PeakFileFormat.h"
+#include "PeakSource.h"
 
 /// Read-only access to a waveform peak cache.
-class PeakFile {
+/// Version 1 levels are read straight from the mapping. Version 2 chunks are located through each
+/// level's offset index and decoded into a small LRU cache, so scrolling reuses recent chunks.
+/// Levels stored as Int8 are widened to Int16 on read.
+class PeakFile : public PeakSource {
 public:
-    struct PeakBlock {
-        int16 min = 0;
-        int16 max = 0;
-    };
+    /// Decoded chunks kept per file.
+    static constexpr size_t kChunkCacheSize = 64;
 
     /// Open a peak cache file.
     /// @param peakFilePath cache file path
     static std::shared_ptr<PeakFile> open(const juce::File& peakFilePath);
 
     /// True when the file is ready for reading.
-    bool isValid() const;
-
-    /// Best resolution for a given samples-per-pixel ratio.
-    /// @param samplesPerPixel view resolution in samples
-    uint32 getBestResolution(double samplesPerPixel) const;
+    bool isValid() const override;
 
     /// Read blocks for a sample range at a resolution.
     /// @param samplesPerBlock resolution to read
@@ -31,20 +32,26 @@ public:
     bool readBlocksForRange(uint32 samplesPerBlock,
                             uint64 startSample,
                             uint64 endSample,
-                            std::vector<PeakBlock>& outBlocks) const;
+                            std::vector<PeakBlock>& outBlocks) const override;
+
+    /// Visit blocks without copying: version 1 runs point into the mapping, version 2 runs into decoded chunks.
+    bool visitBlocksForRange(uint32 samplesPerBlock,
+                             uint64 startSample,
+                             uint64 endSample,
+                             const std::function<void(const BlockRun&)>& visitor) const override;
 
     /// Number of channels in the cached audio.
-    uint32 getChannelCount() const noexcept {
+    uint32 getChannelCount() const noexcept override {
         return channelCount;
     }
 
-    /// Total samples in the cached audio.®
-    uint64 getTotalSamples() const noexcept {
+    /// Total samples in the cached audio.
+    uint64 getTotalSamples() const noexcept override {
         return totalSamples;
     }
 
     /// Sample rate stored in the cache.
-    uint32 getSampleRate() const noexcept {
+    uint32 getSampleRate() const noexcept override {
         return sampleRate;
     }
 
@@ -53,19 +60,54 @@ public:
         return baseBlockSize;
     }
 
+protected:
+    size_t getNumLevels() const noexcept override {
+        return levels.size();
+    }
+
+    uint32 getLevelBlockSize(size_t levelIndex) const noexcept override {
+        return levels[levelIndex].blockSize;
+    }
+
 private:
     explicit PeakFile(const juce::File& peakFilePath);
 
     bool load();
 
-    juce::File peakFilePath;
-    std::unique_ptr<juce::MemoryMappedFile> mappedFile;
     struct LevelInfo {
         uint64 offset = 0;
         uint32 blockSize = 0;
         uint32 blockCount = 0;
+        PeakFileFormat::SampleFormat sampleFormat = PeakFileFormat::SampleFormat::Int16;
     };
+
+    /// Level and block span of a read, clamped to the stored blocks (nullptr when out of range).
+    const LevelInfo* findBlocks(uint32 samplesPerBlock,
+                                uint64 startSample,
+                                uint64 endSample,
+                                uint64& outStartBlock,
+                                uint32& outBlockCount) const;
+
+    /// Mapped bytes of a version 1 block span (nullptr when outside the file).
+    const uint8* getLevelData(const LevelInfo& level, uint64 startBlock, uint32 blockCount) const;
+
+    /// Decoded values of a compressed chunk, from the cache or the mapping (call with chunkCacheLock held).
+    const std::vector<int16>* getChunk(size_t levelIndex, uint64 chunkIndex) const;
+
+    struct CachedChunk {
+        size_t levelIndex = 0;
+        uint64 chunkIndex = 0;
+        std::vector<int16> values;
+    };
+
+    juce::File peakFilePath;
+    std::unique_ptr<juce::MemoryMappedFile> mappedFile;
     std::vector<LevelInfo> levels;
+    std::shared_ptr<PeakFileBuilder::CompressionHook> compressionHook;
+    uint32 blocksPerChunk = 0;
+    mutable juce::CriticalSection chunkCacheLock;
+    /// Most recently used first.
+    mutable std::list<CachedChunk> chunkCache;
     PeakFileFormat::SampleFormat sampleFormat = PeakFileFormat::SampleFormat::Int16;
     uint32 sampleRate = 0;
     uint32 channelCount = 0;
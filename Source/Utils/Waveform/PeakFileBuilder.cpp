@@ -1,27 +1,15 @@
 #include "PeakFileBuilder.h"
 
+#include "PeakCompression.h"
+#include "PeakKernels.h"
+
 #include <algorithm>
-#include <array>
 #include <cmath>
-#include <limits>
 
 namespace {
 constexpr uint32 kMinSamplesPerBlock = 128;
-constexpr uint32 kMidSamplesPerBlock = 1024;
-constexpr uint32 kMaxSamplesPerBlock = 65536;
-
-constexpr float kFloatToInt16 = 32767.0f;
-
-int16 quantizePeak(float value) {
-    const auto clamped = juce::jlimit(-1.0f, 1.0f, value);
-    const auto scaled = std::lround(clamped * kFloatToInt16);
-    return static_cast<int16>(juce::jlimit(-32767L, 32767L, scaled));
-}
-
-struct LevelBuildInfo {
-    PeakFileFormat::LevelInfo info;
-    std::vector<int16> data;
-};
+constexpr uint32 kLevelStep = 4;
+constexpr size_t kLevelCount = 6;
 
 void writeInt16VectorLE(juce::OutputStream& output, const std::vector<int16>& data) {
     if (data.empty()) {
@@ -41,19 +29,19 @@ void writeInt16VectorLE(juce::OutputStream& output, const std::vector<int16>& da
     output.write(swapped.data(), static_cast<int>(swapped.size() * sizeof(int16)));
 }
 
-std::vector<PeakFileFormat::LevelInfo> buildLevelInfos(uint64 totalSamples) {
-    static constexpr std::array<uint32, 3> kFixedLevels = {
-        kMinSamplesPerBlock,
-        kMidSamplesPerBlock,
-        kMaxSamplesPerBlock
-    };
-    std::vector<PeakFileFormat::LevelInfo> infos;
-    infos.reserve(kFixedLevels.size());
-    for (const auto blockSize : kFixedLevels) {
-        const auto blockCount = static_cast<uint32>(std::max<uint64>(1, (totalSamples + blockSize - 1) / blockSize));
-        infos.push_back({ 0, blockSize, blockCount });
+/// Int8 values of a level, kept in Int16 storage so the codecs handle both formats.
+std::vector<int16> quantizeLevelToInt8(const std::vector<int16>& values) {
+    std::vector<int16> quantized(values.size());
+    for (size_t index = 0; index + 1 < values.size(); index += 2) {
+        quantized[index] = PeakFileFormat::quantizeInt8Min(values[index]);
+        quantized[index + 1] = PeakFileFormat::quantizeInt8Max(values[index + 1]);
     }
-    return infos;
+    return quantized;
+}
+
+void writeInt8Vector(juce::OutputStream& output, const std::vector<int16>& data) {
+    std::vector<int8> bytes(data.begin(), data.end());
+    output.write(bytes.data(), bytes.size());
 }
 } // namespace
 
@@ -61,52 +49,181 @@ uint32 PeakFileBuilder::getMinSamplesPerBlock() {
     return kMinSamplesPerBlock;
 }
 
+std::shared_ptr<PeakFileBuilder::CompressionHook> PeakFileBuilder::createCompressionHook(
+    PeakFileFormat::Compression compression,
+    PeakFileFormat::DeltaEncoding deltaEncoding) {
+    if (compression == PeakFileFormat::Compression::Rice
+        && deltaEncoding == PeakFileFormat::DeltaEncoding::MinMaxPairs) {
+        return std::make_shared<RicePeakCompression>();
+    }
+    return nullptr;
+}
+
+const std::vector<uint32>& PeakFileBuilder::getLevelBlockSizes() {
+    // 128 to 131072 samples in x4 steps, so a pixel never needs more than four blocks of the right level.
+    static const std::vector<uint32> blockSizes = [] {
+        std::vector<uint32> sizes { kMinSamplesPerBlock };
+        while (sizes.size() < kLevelCount) {
+            sizes.push_back(sizes.back() * kLevelStep);
+        }
+        return sizes;
+    }();
+    return blockSizes;
+}
+
 bool PeakFileBuilder::build(juce::AudioFormatReader& reader,
                             const juce::File& peakFilePath,
                             const BuildOptions& options) {
-    if (options.compressionHook) {
-        // Compression is not implemented yet.
-        jassert(false);
-        return false;
-    }
     const auto totalSamples = static_cast<uint64>(reader.lengthInSamples);
     const auto channelCount = static_cast<uint32>(reader.numChannels);
     if (channelCount == 0 || totalSamples == 0) {
         return false;
     }
 
-    const auto levelInfos = buildLevelInfos(totalSamples);
-    const auto levelCount = static_cast<uint32>(levelInfos.size());
-    if (levelCount == 0) {
+    const auto valuesPerBlock = static_cast<int>(channelCount) * 2;
+    LevelData baseLevel;
+    baseLevel.blockSize = kMinSamplesPerBlock;
+    const auto baseBlockCount = (totalSamples + kMinSamplesPerBlock - 1) / kMinSamplesPerBlock;
+    baseLevel.values.resize(static_cast<size_t>(baseBlockCount) * valuesPerBlock);
+
+    const int64 blockSize = baseLevel.blockSize;
+    const int64 maxChunkSamples = blockSize * 256;
+    juce::AudioBuffer<float> buffer(static_cast<int>(channelCount),
+                                    static_cast<int>(maxChunkSamples));
+
+    // Reads start on block boundaries, so only the final read ends on a partial block.
+    int64 samplePosition = 0;
+    while (samplePosition < static_cast<int64>(totalSamples)) {
+        const auto remaining = static_cast<int64>(totalSamples) - samplePosition;
+        const auto samplesToRead = static_cast<int>(std::min<int64>(remaining, maxChunkSamples));
+        reader.read(&buffer, 0, samplesToRead, samplePosition, true, true);
+        PeakKernels::buildBlocks(buffer.getArrayOfReadPointers(), channelCount, samplesToRead, baseLevel.blockSize,
+                                 baseLevel.values.data() + (samplePosition / blockSize) * valuesPerBlock);
+        samplePosition += samplesToRead;
+    }
+
+    std::vector<LevelData> levels;
+    levels.push_back(std::move(baseLevel));
+    const auto& blockSizes = getLevelBlockSizes();
+    for (size_t levelIndex = 1; levelIndex < blockSizes.size(); ++levelIndex) {
+        levels.push_back(foldLevel(levels.back(), blockSizes[levelIndex], channelCount));
+    }
+
+    return writePeakFile(peakFilePath, reader.sampleRate, channelCount, totalSamples, levels, options);
+}
+
+PeakFileBuilder::LevelData PeakFileBuilder::foldLevel(const LevelData& source,
+                                                      uint32 blockSize,
+                                                      uint32 channelCount) {
+    LevelData level;
+    level.blockSize = blockSize;
+    const auto valuesPerBlock = static_cast<size_t>(channelCount) * 2;
+    if (source.blockSize == 0 || valuesPerBlock == 0 || (blockSize % source.blockSize) != 0) {
+        // Level sizes must be divisible to aggregate peaks safely.
+        jassert(false);
+        return level;
+    }
+
+    const auto blockRatio = static_cast<size_t>(blockSize / source.blockSize);
+    const auto childCount = source.values.size() / valuesPerBlock;
+    const auto blockCount = (childCount + blockRatio - 1) / blockRatio;
+    level.values.resize(blockCount * valuesPerBlock);
+    PeakKernels::foldBlocks(source.values.data(), childCount, blockRatio, valuesPerBlock, level.values.data());
+    return level;
+}
+
+bool PeakFileBuilder::writePeakFile(const juce::File& peakFilePath,
+                                    double sampleRate,
+                                    uint32 channelCount,
+                                    uint64 totalSamples,
+                                    const std::vector<LevelData>& levels,
+                                    const BuildOptions& options) {
+    if (channelCount == 0 || totalSamples == 0 || levels.empty()) {
         return false;
     }
 
+    const auto& hook = options.compressionHook;
+    const auto valuesPerBlock = static_cast<size_t>(channelCount) * 2;
+    const auto levelCount = static_cast<uint32>(levels.size());
+    const auto levelTableSize = static_cast<uint64>(levelCount) * PeakFileFormat::kLevelInfoSize;
+    uint64 dataOffset = PeakFileFormat::kHeaderSize + levelTableSize;
+
+    std::vector<PeakFileFormat::LevelInfo> resolvedInfos;
+    resolvedInfos.reserve(levels.size());
+    std::vector<juce::MemoryBlock> compressedLevels;
+    std::vector<std::vector<int16>> int8Levels(levels.size());
+    uint8 int8LevelMask = 0;
+    for (size_t levelIndex = 0; levelIndex < levels.size(); ++levelIndex) {
+        const auto& level = levels[levelIndex];
+        const auto expectedBlocks = std::max<uint64>(1, (totalSamples + level.blockSize - 1) / level.blockSize);
+        if (level.blockSize == 0 || level.values.size() != expectedBlocks * channelCount * 2) {
+            // Every level must cover the whole source.
+            jassert(false);
+            return false;
+        }
+        const auto format = level.blockSize >= options.coarseBlockSize ? options.coarseSampleFormat
+                                                                       : options.sampleFormat;
+        if (format == PeakFileFormat::SampleFormat::Int8) {
+            // The mask has one bit per level.
+            jassert(levelIndex < 8);
+            int8LevelMask |= static_cast<uint8>(1u << levelIndex);
+            int8Levels[levelIndex] = quantizeLevelToInt8(level.values);
+        }
+        const auto& values = int8Levels[levelIndex].empty() ? level.values : int8Levels[levelIndex];
+        resolvedInfos.push_back({ dataOffset, level.blockSize, static_cast<uint32>(expectedBlocks) });
+        if (hook == nullptr) {
+            const auto bytesPerValue = int8Levels[levelIndex].empty() ? sizeof(int16) : sizeof(int8);
+            dataOffset += static_cast<uint64>(values.size()) * bytesPerValue;
+            continue;
+        }
+
+        // Version 2: a chunk offset index (one entry per chunk plus the end) followed by the chunks.
+        const auto chunkCount = (expectedBlocks + PeakFileFormat::kBlocksPerChunk - 1) / PeakFileFormat::kBlocksPerChunk;
+        const auto indexSize = (chunkCount + 1) * sizeof(uint64);
+        juce::MemoryOutputStream chunks;
+        juce::MemoryOutputStream payload;
+        for (uint64 chunk = 0; chunk < chunkCount; ++chunk) {
+            PeakFileFormat::writeUint64LE(payload, dataOffset + indexSize + chunks.getDataSize());
+            const auto firstBlock = chunk * PeakFileFormat::kBlocksPerChunk;
+            const auto blockCount = std::min<uint64>(PeakFileFormat::kBlocksPerChunk, expectedBlocks - firstBlock);
+            if (!hook->compress(chunks,
+                                values.data() + firstBlock * valuesPerBlock,
+                                static_cast<size_t>(blockCount) * valuesPerBlock,
+                                valuesPerBlock)) {
+                return false;
+            }
+        }
+        PeakFileFormat::writeUint64LE(payload, dataOffset + indexSize + chunks.getDataSize());
+        payload.write(chunks.getData(), chunks.getDataSize());
+        dataOffset += payload.getDataSize();
+        compressedLevels.push_back(payload.getMemoryBlock());
+    }
+
     PeakFileFormat::Header header;
-    header.sampleRate = static_cast<uint32>(std::lround(reader.sampleRate));
+    header.sampleRate = static_cast<uint32>(std::lround(sampleRate));
     header.channelCount = channelCount;
     header.totalSamples = totalSamples;
-    header.baseBlockSize = levelInfos.front().blockSize;
+    header.baseBlockSize = levels.front().blockSize;
     header.levelCount = levelCount;
-    header.sampleFormat = options.sampleFormat;
+    // Readers that only know Int16 reject files with Int8 levels.
+    header.sampleFormat = int8LevelMask != 0 ? PeakFileFormat::SampleFormat::Int8 : PeakFileFormat::SampleFormat::Int16;
+    header.int8LevelMask = int8LevelMask;
     header.compression = PeakFileFormat::Compression::None;
     header.deltaEncoding = PeakFileFormat::DeltaEncoding::None;
     header.levelTableOffset = PeakFileFormat::kHeaderSize;
+    if (hook != nullptr) {
+        header.version = PeakFileFormat::kVersion2;
+        header.compression = hook->getCompression();
+        header.deltaEncoding = hook->getDeltaEncoding();
+        header.blocksPerChunk = PeakFileFormat::kBlocksPerChunk;
+    }
 
     auto outputStream = peakFilePath.createOutputStream();
     if (outputStream == nullptr) {
         return false;
     }
-
-    const auto levelTableSize = static_cast<uint64>(levelCount) * PeakFileFormat::kLevelInfoSize;
-    uint64 dataOffset = PeakFileFormat::kHeaderSize + levelTableSize;
-
-    std::vector<PeakFileFormat::LevelInfo> resolvedInfos = levelInfos;
-    for (auto& info : resolvedInfos) {
-        info.offset = dataOffset;
-        const auto bytesPerBlock = static_cast<uint64>(channelCount) * sizeof(int16) * 2;
-        const auto levelBytes = bytesPerBlock * info.blockCount;
-        dataOffset += levelBytes;
-    }
+    outputStream->setPosition(0);
+    outputStream->truncate();
 
     PeakFileFormat::writeUint32LE(*outputStream, header.magic);
     PeakFileFormat::writeUint16LE(*outputStream, header.version);
@@ -119,6 +236,8 @@ bool PeakFileBuilder::build(juce::AudioFormatReader& reader,
     outputStream->writeByte(static_cast<char>(header.sampleFormat));
     outputStream->writeByte(static_cast<char>(header.compression));
     outputStream->writeByte(static_cast<char>(header.deltaEncoding));
+    PeakFileFormat::writeUint16LE(*outputStream, header.blocksPerChunk);
+    outputStream->writeByte(static_cast<char>(header.int8LevelMask));
     outputStream->write(header.reserved, sizeof(header.reserved));
     PeakFileFormat::writeUint64LE(*outputStream, header.levelTableOffset);
 
@@ -128,108 +247,15 @@ bool PeakFileBuilder::build(juce::AudioFormatReader& reader,
         PeakFileFormat::writeUint32LE(*outputStream, info.blockCount);
     }
 
-    const auto valuesPerBlock = static_cast<int>(channelCount) * 2;
-    LevelBuildInfo currentLevel;
-    currentLevel.info = resolvedInfos.front();
-    currentLevel.data.resize(static_cast<size_t>(currentLevel.info.blockCount) * valuesPerBlock);
-
-    const int64 blockSize = currentLevel.info.blockSize;
-    const int64 maxChunkSamples = blockSize * 256;
-    juce::AudioBuffer<float> buffer(static_cast<int>(channelCount),
-                                    static_cast<int>(maxChunkSamples));
-
-    std::vector<float> blockMin(channelCount, std::numeric_limits<float>::max());
-    std::vector<float> blockMax(channelCount, std::numeric_limits<float>::lowest());
-    uint64 currentBlockIndex = 0;
-    int64 blockSamplesFilled = 0;
-    int64 samplePosition = 0;
-    while (samplePosition < static_cast<int64>(totalSamples)) {
-        const auto remaining = static_cast<int64>(totalSamples) - samplePosition;
-        const auto samplesToRead = static_cast<int>(std::min<int64>(remaining, maxChunkSamples));
-        reader.read(&buffer, 0, samplesToRead, samplePosition, true, true);
-
-        int64 localOffset = 0;
-        while (localOffset < samplesToRead) {
-            const int64 globalSample = samplePosition + localOffset;
-            const int64 blockOffset = globalSample % blockSize;
-            const int64 samplesInBlock = std::min<int64>(blockSize - blockOffset,
-                                                         samplesToRead - localOffset);
-            for (uint32 channel = 0; channel < channelCount; ++channel) {
-                const float* channelData = buffer.getReadPointer(static_cast<int>(channel));
-                auto range = juce::FloatVectorOperations::findMinAndMax(channelData + localOffset,
-                                                                        static_cast<int>(samplesInBlock));
-                blockMin[channel] = std::min(blockMin[channel], range.getStart());
-                blockMax[channel] = std::max(blockMax[channel], range.getEnd());
-            }
-            blockSamplesFilled += samplesInBlock;
-            localOffset += samplesInBlock;
-
-            const bool blockComplete = blockSamplesFilled >= blockSize
-                                       || (globalSample + samplesInBlock) >= static_cast<int64>(totalSamples);
-            if (!blockComplete) {
-                continue;
-            }
-
-            const auto blockIndex = static_cast<size_t>(currentBlockIndex);
-            auto writeOffset = blockIndex * valuesPerBlock;
-            for (uint32 channel = 0; channel < channelCount; ++channel) {
-                currentLevel.data[writeOffset++] = quantizePeak(blockMin[channel]);
-                currentLevel.data[writeOffset++] = quantizePeak(blockMax[channel]);
-                blockMin[channel] = std::numeric_limits<float>::max();
-                blockMax[channel] = std::numeric_limits<float>::lowest();
-            }
-            ++currentBlockIndex;
-            blockSamplesFilled = 0;
-        }
-
-        samplePosition += samplesToRead;
-    }
-
-    outputStream->setPosition(static_cast<int64>(currentLevel.info.offset));
-    writeInt16VectorLE(*outputStream, currentLevel.data);
-
-    LevelBuildInfo previousLevel = std::move(currentLevel);
-    for (size_t levelIndex = 1; levelIndex < resolvedInfos.size(); ++levelIndex) {
-        LevelBuildInfo nextLevel;
-        nextLevel.info = resolvedInfos[levelIndex];
-        nextLevel.data.resize(static_cast<size_t>(nextLevel.info.blockCount) * valuesPerBlock);
-
-        const auto blockRatio = nextLevel.info.blockSize / previousLevel.info.blockSize;
-        if (blockRatio == 0 || (nextLevel.info.blockSize % previousLevel.info.blockSize) != 0) {
-            // Level sizes must be divisible to aggregate peaks safely.
-            jassert(false);
-            return false;
+    for (size_t levelIndex = 0; levelIndex < levels.size(); ++levelIndex) {
+        outputStream->setPosition(static_cast<int64>(resolvedInfos[levelIndex].offset));
+        if (hook != nullptr) {
+            outputStream->write(compressedLevels[levelIndex].getData(), compressedLevels[levelIndex].getSize());
+        } else if (!int8Levels[levelIndex].empty()) {
+            writeInt8Vector(*outputStream, int8Levels[levelIndex]);
+        } else {
+            writeInt16VectorLE(*outputStream, levels[levelIndex].values);
         }
-
-        for (uint32 blockIndex = 0; blockIndex < nextLevel.info.blockCount; ++blockIndex) {
-            const auto firstChild = static_cast<size_t>(blockIndex) * blockRatio;
-            if (firstChild >= previousLevel.info.blockCount) {
-                // Each parent block should map to at least one child block.
-                jassert(false);
-                break;
-            }
-            const auto lastChild = std::min<size_t>(firstChild + blockRatio,
-                                                    static_cast<size_t>(previousLevel.info.blockCount));
-
-            auto writeOffset = static_cast<size_t>(blockIndex) * valuesPerBlock;
-            for (uint32 channel = 0; channel < channelCount; ++channel) {
-                auto minValue = previousLevel.data[firstChild * valuesPerBlock + channel * 2];
-                auto maxValue = previousLevel.data[firstChild * valuesPerBlock + channel * 2 + 1];
-                for (size_t childIndex = firstChild + 1; childIndex < lastChild; ++childIndex) {
-                    const auto childMin = previousLevel.data[childIndex * valuesPerBlock + channel * 2];
-                    const auto childMax = previousLevel.data[childIndex * valuesPerBlock + channel * 2 + 1];
-                    minValue = std::min(minValue, childMin);
-                    maxValue = std::max(maxValue, childMax);
-                }
-                nextLevel.data[writeOffset++] = minValue;
-                nextLevel.data[writeOffset++] = maxValue;
-            }
-        }
-
-        outputStream->setPosition(static_cast<int64>(nextLevel.info.offset));
-        writeInt16VectorLE(*outputStream, nextLevel.data);
-
-        previousLevel = std::move(nextLevel);
     }
 
     outputStream->flush();
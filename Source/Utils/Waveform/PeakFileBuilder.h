@@ -11,25 +11,88 @@ public:
     static uint32 getMinSamplesPerBlock();
 
     /// Hook for optional compression.
+    /// A hook encodes one chunk at a time, so each chunk must decode without its neighbours.
     class CompressionHook {
     public:
         virtual ~CompressionHook() = default;
 
-        /// Compress a block of peak data.
+        /// Codec identifier stored in the header.
+        virtual PeakFileFormat::Compression getCompression() const = 0;
+
+        /// Delta scheme applied by the codec, stored in the header.
+        virtual PeakFileFormat::DeltaEncoding getDeltaEncoding() const = 0;
+
+        /// Compress a chunk of peak data.
         /// @param output destination stream
-        /// @param data raw data
-        /// @param sizeBytes size in bytes
+        /// @param values min/max pairs, block by block
+        /// @param valueCount number of values
+        /// @param valuesPerBlock values per block (two per channel)
         virtual bool compress(juce::OutputStream& output,
-                              const void* data,
-                              size_t sizeBytes) = 0;
+                              const int16* values,
+                              size_t valueCount,
+                              size_t valuesPerBlock) = 0;
+
+        /// Decompress a chunk written by compress().
+        /// @param data compressed bytes
+        /// @param sizeBytes size in bytes
+        /// @param values receives valueCount values
+        /// @param valueCount number of values in the chunk
+        /// @param valuesPerBlock values per block (two per channel)
+        virtual bool decompress(const uint8* data,
+                                size_t sizeBytes,
+                                int16* values,
+                                size_t valueCount,
+                                size_t valuesPerBlock) const = 0;
     };
 
+    /// Codec matching a header, for reading compressed files.
+    /// @param compression codec identifier
+    /// @param deltaEncoding delta scheme
+    /// @return the codec, or nullptr when unsupported
+    static std::shared_ptr<CompressionHook> createCompressionHook(PeakFileFormat::Compression compression,
+                                                                  PeakFileFormat::DeltaEncoding deltaEncoding);
+
     /// Build configuration for a peak file.
     struct BuildOptions {
         PeakFileFormat::SampleFormat sampleFormat = PeakFileFormat::SampleFormat::Int16;
+        /// Format of the levels whose blocks span at least coarseBlockSize samples.
+        /// Those only draw zoomed-out views, where 8 bits are finer than a pixel.
+        PeakFileFormat::SampleFormat coarseSampleFormat = PeakFileFormat::SampleFormat::Int8;
+        uint32 coarseBlockSize = 8192;
         std::shared_ptr<CompressionHook> compressionHook;
     };
 
+    /// Min/max pairs of one resolution, block by block and channel by channel.
+    struct LevelData {
+        uint32 blockSize = 0;
+        std::vector<int16> values;
+    };
+
+    /// Block sizes of the levels stored in every peak file, finest first.
+    /// Sizes grow geometrically and each divides the next, so coarser levels fold from finer ones.
+    static const std::vector<uint32>& getLevelBlockSizes();
+
+    /// Fold a level into a coarser one by merging whole child blocks.
+    /// @param source finer level
+    /// @param blockSize coarser block size (a multiple of the source block size)
+    /// @param channelCount channels per block
+    static LevelData foldLevel(const LevelData& source, uint32 blockSize, uint32 channelCount);
+
+    /// Write prepared levels to a peak file.
+    /// Files are written as version 1, or version 2 when the options carry a compression hook.
+    /// @param peakFilePath output .peak file
+    /// @param sampleRate sample rate of the source audio
+    /// @param channelCount channels per block
+    /// @param totalSamples length of the source audio
+    /// @param levels levels matching getLevelBlockSizes()
+    /// @param options build configuration
+    static bool writePeakFile(const juce::File& peakFilePath,
+                              double sampleRate,
+                              uint32 channelCount,
+                              uint64 totalSamples,
+                              const std::vector<LevelData>& levels,
+                              const BuildOptions& options);
+
     /// Build a peak file from an audio reader.
     /// @param reader source audio reader
     /// @param peakFilePath output .peak file
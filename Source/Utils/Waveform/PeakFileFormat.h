@@ -2,29 +2,42 @@
 
 #include <JuceHeader.h>
 
+#include <cmath>
 #include <cstring>
 
 namespace PeakFileFormat {
 constexpr uint32 kMagic = 0x5045414B; // 'PEAK'
-constexpr uint16 kVersion = 1;
+/// Uncompressed levels, one contiguous block array per level.
+constexpr uint16 kVersion1 = 1;
+/// Levels split into independently compressed chunks, each level starting with a chunk offset index.
+constexpr uint16 kVersion2 = 2;
 constexpr uint16 kHeaderSize = 48;
 constexpr uint64 kLevelInfoSize = 16;
 
 enum class SampleFormat : uint8 {
-    Int16 = 0
+    Int16 = 0,
+    /// Some levels are stored as Int8, those flagged in Header::int8LevelMask.
+    Int8 = 1
 };
 
 enum class Compression : uint8 {
-    None = 0
+    None = 0,
+    /// Rice codes with one parameter per chunk.
+    Rice = 1
 };
 
 enum class DeltaEncoding : uint8 {
-    None = 0
+    None = 0,
+    /// Each min and max is stored relative to the same value of the previous block and channel.
+    MinMaxPairs = 1
 };
 
+/// Blocks per compressed chunk in version 2 files.
+constexpr uint16 kBlocksPerChunk = 256;
+
 struct Header {
     uint32 magic = kMagic;
-    uint16 version = kVersion;
+    uint16 version = kVersion1;
     uint16 headerSize = kHeaderSize;
     uint32 sampleRate = 0;
     uint32 channelCount = 0;
@@ -34,7 +47,11 @@ struct Header {
     SampleFormat sampleFormat = SampleFormat::Int16;
     Compression compression = Compression::None;
     DeltaEncoding deltaEncoding = DeltaEncoding::None;
-    uint8 reserved[5] = { 0 };
+    /// Blocks per compressed chunk (version 2, zero in version 1).
+    uint16 blocksPerChunk = 0;
+    /// Bit n set when level n is stored as Int8 (requires sampleFormat Int8).
+    uint8 int8LevelMask = 0;
+    uint8 reserved[2] = { 0 };
     uint64 levelTableOffset = kHeaderSize;
 };
 
@@ -44,6 +61,29 @@ struct LevelInfo {
     uint32 blockCount = 0;
 };
 
+/// Quantize a peak value to the Int16 sample format.
+/// Rounds half to even, like the vector conversions in PeakKernels.
+inline int16 quantizeInt16(float value) {
+    const auto clamped = juce::jlimit(-1.0f, 1.0f, value);
+    const auto scaled = std::lrint(clamped * 32767.0f);
+    return static_cast<int16>(juce::jlimit(-32767L, 32767L, scaled));
+}
+
+/// Int8 storage of an Int16 minimum, rounded down so a coarse level never shrinks a peak.
+inline int8 quantizeInt8Min(int16 value) {
+    return static_cast<int8>(std::floor(value * (127.0 / 32767.0)));
+}
+
+/// Int8 storage of an Int16 maximum, rounded up so a coarse level never shrinks a peak.
+inline int8 quantizeInt8Max(int16 value) {
+    return static_cast<int8>(std::ceil(value * (127.0 / 32767.0)));
+}
+
+/// Int16 value of an Int8 stored peak.
+inline int16 dequantizeInt8(int8 value) {
+    return static_cast<int16>(std::lround(value * (32767.0 / 127.0)));
+}
+
 inline void writeUint16LE(juce::OutputStream& out, uint16 value) {
     out.writeShort(static_cast<short>(juce::ByteOrder::swapIfBigEndian(value)));
 }
@@ -0,0 +1,290 @@
+#include "PeakKernels.h"
+
+#include "PeakFileFormat.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+ #define PEAK_KERNELS_SSE2 1
+ #include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+ #define PEAK_KERNELS_NEON 1
+ #include <arm_neon.h>
+#endif
+
+namespace PeakKernels {
+namespace {
+
+/// Float values quantized per batch in buildBlocks.
+constexpr size_t kBatchValues = 512;
+
+/// Min and max of a non-empty run of samples.
+void minMax(const float* samples, int numSamples, float& outMin, float& outMax) noexcept {
+    auto minValue = samples[0];
+    auto maxValue = samples[0];
+    int i = 0;
+#if PEAK_KERNELS_SSE2
+    if (numSamples >= 8) {
+        // Two register pairs hide the min/max latency.
+        auto minA = _mm_loadu_ps(samples);
+        auto minB = _mm_loadu_ps(samples + 4);
+        auto maxA = minA;
+        auto maxB = minB;
+        for (i = 8; i + 8 <= numSamples; i += 8) {
+            const auto a = _mm_loadu_ps(samples + i);
+            const auto b = _mm_loadu_ps(samples + i + 4);
+            minA = _mm_min_ps(minA, a);
+            minB = _mm_min_ps(minB, b);
+            maxA = _mm_max_ps(maxA, a);
+            maxB = _mm_max_ps(maxB, b);
+        }
+        auto mins = _mm_min_ps(minA, minB);
+        auto maxs = _mm_max_ps(maxA, maxB);
+        mins = _mm_min_ps(mins, _mm_movehl_ps(mins, mins));
+        maxs = _mm_max_ps(maxs, _mm_movehl_ps(maxs, maxs));
+        minValue = _mm_cvtss_f32(_mm_min_ss(mins, _mm_shuffle_ps(mins, mins, 1)));
+        maxValue = _mm_cvtss_f32(_mm_max_ss(maxs, _mm_shuffle_ps(maxs, maxs, 1)));
+    }
+#elif PEAK_KERNELS_NEON
+    if (numSamples >= 8) {
+        auto minA = vld1q_f32(samples);
+        auto minB = vld1q_f32(samples + 4);
+        auto maxA = minA;
+        auto maxB = minB;
+        for (i = 8; i + 8 <= numSamples; i += 8) {
+            const auto a = vld1q_f32(samples + i);
+            const auto b = vld1q_f32(samples + i + 4);
+            minA = vminq_f32(minA, a);
+            minB = vminq_f32(minB, b);
+            maxA = vmaxq_f32(maxA, a);
+            maxB = vmaxq_f32(maxB, b);
+        }
+        minValue = vminvq_f32(vminq_f32(minA, minB));
+        maxValue = vmaxvq_f32(vmaxq_f32(maxA, maxB));
+    }
+#endif
+    for (; i < numSamples; ++i) {
+        minValue = std::min(minValue, samples[i]);
+        maxValue = std::max(maxValue, samples[i]);
+    }
+    outMin = minValue;
+    outMax = maxValue;
+}
+
+#if PEAK_KERNELS_SSE2
+/// Int16 peak values per register.
+constexpr size_t kPairLanes = 8;
+using Pairs = __m128i;
+
+Pairs loadPairs(const int16* values) noexcept {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(values));
+}
+
+void storePairs(int16* values, Pairs pairs) noexcept {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(values), pairs);
+}
+
+/// Lower of the even (min) lanes and higher of the odd (max) lanes.
+Pairs mergePairs(Pairs a, Pairs b) noexcept {
+    const auto minLanes = _mm_set_epi16(0, -1, 0, -1, 0, -1, 0, -1);
+    return _mm_or_si128(_mm_and_si128(minLanes, _mm_min_epi16(a, b)),
+                        _mm_andnot_si128(minLanes, _mm_max_epi16(a, b)));
+}
+
+/// Merge the upper half of the lanes into the lower half.
+Pairs foldHalves(Pairs pairs) noexcept {
+    return mergePairs(pairs, _mm_srli_si128(pairs, 8));
+}
+
+/// Merge the second quarter of the lanes into the first.
+Pairs foldQuarters(Pairs pairs) noexcept {
+    return mergePairs(pairs, _mm_srli_si128(pairs, 4));
+}
+#elif PEAK_KERNELS_NEON
+constexpr size_t kPairLanes = 8;
+using Pairs = int16x8_t;
+
+Pairs loadPairs(const int16* values) noexcept {
+    return vld1q_s16(values);
+}
+
+void storePairs(int16* values, Pairs pairs) noexcept {
+    vst1q_s16(values, pairs);
+}
+
+Pairs mergePairs(Pairs a, Pairs b) noexcept {
+    static constexpr uint16 minLaneBits[8] = { 0xffff, 0, 0xffff, 0, 0xffff, 0, 0xffff, 0 };
+    return vbslq_s16(vld1q_u16(minLaneBits), vminq_s16(a, b), vmaxq_s16(a, b));
+}
+
+Pairs foldHalves(Pairs pairs) noexcept {
+    return mergePairs(pairs, vextq_s16(pairs, pairs, 4));
+}
+
+Pairs foldQuarters(Pairs pairs) noexcept {
+    return mergePairs(pairs, vextq_s16(pairs, pairs, 2));
+}
+#endif
+
+#if PEAK_KERNELS_SSE2 || PEAK_KERNELS_NEON
+/// foldBlocks for mono and stereo blocks, which are narrower than a register: each step merges
+/// several consecutive children at once, and the packed blocks are folded together per parent.
+void foldNarrowBlocks(const int16* source,
+                      size_t childCount,
+                      size_t blockRatio,
+                      size_t valuesPerBlock,
+                      int16* out) noexcept {
+    const auto blocksPerRegister = kPairLanes / valuesPerBlock;
+    for (size_t firstChild = 0; firstChild < childCount; firstChild += blockRatio, out += valuesPerBlock) {
+        const auto lastChild = std::min(firstChild + blockRatio, childCount);
+        auto child = firstChild;
+        if (lastChild - firstChild >= blocksPerRegister) {
+            auto merged = loadPairs(source + child * valuesPerBlock);
+            for (child += blocksPerRegister; child + blocksPerRegister <= lastChild; child += blocksPerRegister) {
+                merged = mergePairs(merged, loadPairs(source + child * valuesPerBlock));
+            }
+            merged = foldHalves(merged);
+            if (valuesPerBlock == 2) {
+                merged = foldQuarters(merged);
+            }
+            std::array<int16, kPairLanes> lanes;
+            storePairs(lanes.data(), merged);
+            std::memcpy(out, lanes.data(), valuesPerBlock * sizeof(int16));
+        } else {
+            std::memcpy(out, source + child * valuesPerBlock, valuesPerBlock * sizeof(int16));
+            ++child;
+        }
+        // Children left over after the last full register.
+        for (; child < lastChild; ++child) {
+            mergeBlock(out, source + child * valuesPerBlock, valuesPerBlock);
+        }
+    }
+}
+#endif
+} // namespace
+
+void buildBlocks(const float* const* channels,
+                 uint32 channelCount,
+                 int numSamples,
+                 uint32 blockSize,
+                 int16* out) noexcept {
+    if (channelCount == 0 || blockSize == 0) {
+        return;
+    }
+    // Peaks gather in a small float batch so quantization runs over long vectors.
+    std::array<float, kBatchValues> batch;
+    size_t batchSize = 0;
+    for (int offset = 0; offset < numSamples; offset += static_cast<int>(blockSize)) {
+        const auto count = std::min(static_cast<int>(blockSize), numSamples - offset);
+        for (uint32 channel = 0; channel < channelCount; ++channel) {
+            minMax(channels[channel] + offset, count, batch[batchSize], batch[batchSize + 1]);
+            batchSize += 2;
+            if (batchSize == batch.size()) {
+                quantizeInt16(batch.data(), out, batchSize);
+                out += batchSize;
+                batchSize = 0;
+            }
+        }
+    }
+    quantizeInt16(batch.data(), out, batchSize);
+}
+
+void findBlockMinMax(const float* const* channels,
+                     uint32 channelCount,
+                     int numSamples,
+                     uint32 blockSize,
+                     float* out) noexcept {
+    if (blockSize == 0) {
+        return;
+    }
+    for (int offset = 0; offset < numSamples; offset += static_cast<int>(blockSize)) {
+        const auto count = std::min(static_cast<int>(blockSize), numSamples - offset);
+        for (uint32 channel = 0; channel < channelCount; ++channel) {
+            minMax(channels[channel] + offset, count, out[0], out[1]);
+            out += 2;
+        }
+    }
+}
+
+void quantizeInt16(const float* values, int16* out, size_t count) noexcept {
+    size_t i = 0;
+#if PEAK_KERNELS_SSE2
+    // Conversion rounds half to even, like std::lrint in PeakFileFormat::quantizeInt16.
+    const auto lower = _mm_set1_ps(-1.0f);
+    const auto upper = _mm_set1_ps(1.0f);
+    const auto scale = _mm_set1_ps(32767.0f);
+    for (; i + 8 <= count; i += 8) {
+        const auto a = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(values + i), lower), upper), scale);
+        const auto b = _mm_mul_ps(_mm_min_ps(_mm_max_ps(_mm_loadu_ps(values + i + 4), lower), upper), scale);
+        const auto packed = _mm_packs_epi32(_mm_cvtps_epi32(a), _mm_cvtps_epi32(b));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+    }
+#elif PEAK_KERNELS_NEON
+    const auto lower = vdupq_n_f32(-1.0f);
+    const auto upper = vdupq_n_f32(1.0f);
+    for (; i + 8 <= count; i += 8) {
+        const auto a = vmulq_n_f32(vminq_f32(vmaxq_f32(vld1q_f32(values + i), lower), upper), 32767.0f);
+        const auto b = vmulq_n_f32(vminq_f32(vmaxq_f32(vld1q_f32(values + i + 4), lower), upper), 32767.0f);
+        vst1q_s16(out + i, vcombine_s16(vqmovn_s32(vcvtnq_s32_f32(a)), vqmovn_s32(vcvtnq_s32_f32(b))));
+    }
+#endif
+    for (; i < count; ++i) {
+        out[i] = PeakFileFormat::quantizeInt16(values[i]);
+    }
+}
+
+void mergeBlock(int16* accumulated, const int16* block, size_t valuesPerBlock) noexcept {
+    size_t i = 0;
+#if PEAK_KERNELS_SSE2 || PEAK_KERNELS_NEON
+    // Blocks hold whole min/max pairs, so even lanes are mins at every step.
+    for (; i + kPairLanes <= valuesPerBlock; i += kPairLanes) {
+        storePairs(accumulated + i, mergePairs(loadPairs(accumulated + i), loadPairs(block + i)));
+    }
+#endif
+    for (; i < valuesPerBlock; i += 2) {
+        accumulated[i] = std::min(accumulated[i], block[i]);
+        accumulated[i + 1] = std::max(accumulated[i + 1], block[i + 1]);
+    }
+}
+
+void foldBlocks(const int16* source,
+                size_t childCount,
+                size_t blockRatio,
+                size_t valuesPerBlock,
+                int16* out) noexcept {
+    if (blockRatio == 0) {
+        return;
+    }
+#if PEAK_KERNELS_SSE2 || PEAK_KERNELS_NEON
+    if (valuesPerBlock == 2 || valuesPerBlock == 4) {
+        foldNarrowBlocks(source, childCount, blockRatio, valuesPerBlock, out);
+        return;
+    }
+#endif
+    for (size_t firstChild = 0; firstChild < childCount; firstChild += blockRatio, out += valuesPerBlock) {
+        const auto lastChild = std::min(firstChild + blockRatio, childCount);
+        std::memcpy(out, source + firstChild * valuesPerBlock, valuesPerBlock * sizeof(int16));
+        for (auto child = firstChild + 1; child < lastChild; ++child) {
+            mergeBlock(out, source + child * valuesPerBlock, valuesPerBlock);
+        }
+    }
+}
+
+void buildBlocksScalarReference(const float* const* channels,
+                                uint32 channelCount,
+                                int numSamples,
+                                uint32 blockSize,
+                                int16* out) noexcept {
+    for (int offset = 0; offset < numSamples; offset += static_cast<int>(blockSize)) {
+        const auto count = std::min(static_cast<int>(blockSize), numSamples - offset);
+        for (uint32 channel = 0; channel < channelCount; ++channel) {
+            const auto range = juce::FloatVectorOperations::findMinAndMax(channels[channel] + offset, count);
+            *out++ = PeakFileFormat::quantizeInt16(range.getStart());
+            *out++ = PeakFileFormat::quantizeInt16(range.getEnd());
+        }
+    }
+}
+
+} // namespace PeakKernels
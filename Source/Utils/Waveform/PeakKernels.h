@@ -0,0 +1,66 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+/// Vectorised kernels building peak levels.
+/// Blocks are laid out as in peak files: block by block, then channel by channel, min before max.
+/// SSE2 and NEON paths are selected at compile time; other targets use the scalar loops.
+namespace PeakKernels {
+
+/// Min and max of every channel over consecutive blocks, quantized to Int16.
+/// @param channels channel pointers
+/// @param channelCount number of channels
+/// @param numSamples samples to scan from the channel pointers (the last block may be partial)
+/// @param blockSize samples per block
+/// @param out receives 2 * channelCount values per block
+void buildBlocks(const float* const* channels,
+                 uint32 channelCount,
+                 int numSamples,
+                 uint32 blockSize,
+                 int16* out) noexcept;
+
+/// Min and max of every channel over consecutive blocks, as floats.
+/// @param channels channel pointers
+/// @param channelCount number of channels
+/// @param numSamples samples to scan (the last block may be partial)
+/// @param blockSize samples per block
+/// @param out receives 2 * channelCount values per block
+void findBlockMinMax(const float* const* channels,
+                     uint32 channelCount,
+                     int numSamples,
+                     uint32 blockSize,
+                     float* out) noexcept;
+
+/// Quantize peak values to Int16, rounding like PeakFileFormat::quantizeInt16.
+/// @param values peak values
+/// @param out receives count values
+/// @param count number of values
+void quantizeInt16(const float* values, int16* out, size_t count) noexcept;
+
+/// Merge a block into another: mins keep the lower value, maxes the higher one.
+/// @param accumulated block updated in place
+/// @param block block to merge
+/// @param valuesPerBlock values per block (two per channel)
+void mergeBlock(int16* accumulated, const int16* block, size_t valuesPerBlock) noexcept;
+
+/// Fold consecutive blocks into coarser ones, blockRatio children per parent (the last may be partial).
+/// @param source finer blocks
+/// @param childCount number of finer blocks
+/// @param blockRatio children per parent
+/// @param valuesPerBlock values per block (two per channel)
+/// @param out receives ceil(childCount / blockRatio) blocks
+void foldBlocks(const int16* source,
+                size_t childCount,
+                size_t blockRatio,
+                size_t valuesPerBlock,
+                int16* out) noexcept;
+
+/// Scalar reference for buildBlocks: one findMinAndMax call and one quantization per value.
+/// Kept so tests can check the kernels against it.
+void buildBlocksScalarReference(const float* const* channels,
+                                uint32 channelCount,
+                                int numSamples,
+                                uint32 blockSize,
+                                int16* out) noexcept;
+
+} // namespace PeakKernels
@@ -0,0 +1,41 @@
+#include "PeakSource.h"
+
+uint32 PeakSource::getBestResolution(double samplesPerPixel) const {
+    if (getNumLevels() == 0) {
+        // Peak levels must be available before selecting.
+        jassert(false);
+        return 0;
+    }
+
+    // The finest level within the block budget keeps paint work proportional to the pixel count.
+    for (size_t index = 0; index < getNumLevels(); ++index) {
+        if (samplesPerPixel <= static_cast<double>(getLevelBlockSize(index)) * kMaxBlocksPerPixel) {
+            return getLevelBlockSize(index);
+        }
+    }
+    return getLevelBlockSize(getNumLevels() - 1);
+}
+
+bool PeakSource::visitBlocksForRange(uint32 samplesPerBlock,
+                                     uint64 startSample,
+                                     uint64 endSample,
+                                     const std::function<void(const BlockRun&)>& visitor) const {
+    // Per-thread scratch keeps repeated paints free of allocations.
+    thread_local std::vector<PeakBlock> blocks;
+    thread_local std::vector<int16> values;
+    if (!readBlocksForRange(samplesPerBlock, startSample, endSample, blocks) || getChannelCount() == 0) {
+        return false;
+    }
+    values.resize(blocks.size() * 2);
+    auto* out = values.data();
+    for (const auto& block : blocks) {
+        *out++ = block.min;
+        *out++ = block.max;
+    }
+    BlockRun run;
+    run.int16Values = values.data();
+    run.firstBlock = startSample / samplesPerBlock;
+    run.blockCount = static_cast<uint32>(blocks.size() / getChannelCount());
+    visitor(run);
+    return true;
+}
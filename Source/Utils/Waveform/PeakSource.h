@@ -0,0 +1,78 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <functional>
+
+/// Read access to waveform peaks, whether loaded from a peak file or still being built.
+class PeakSource {
+public:
+    struct PeakBlock {
+        int16 min = 0;
+        int16 max = 0;
+    };
+
+    /// Consecutive blocks of one resolution, values interleaved as min, max per channel.
+    /// Exactly one of the value pointers is set; Int8 values are the stored peaks, see PeakFileFormat::dequantizeInt8.
+    struct BlockRun {
+        const int16* int16Values = nullptr;
+        const int8* int8Values = nullptr;
+        uint64 firstBlock = 0;
+        uint32 blockCount = 0;
+    };
+
+    virtual ~PeakSource() = default;
+
+    /// True when the source can be read.
+    virtual bool isValid() const = 0;
+
+    /// True once every block holds its final value.
+    virtual bool isComplete() const { return true; }
+
+    /// Most blocks read per pixel by getBestResolution().
+    static constexpr double kMaxBlocksPerPixel = 4.0;
+
+    /// Finest resolution needing at most kMaxBlocksPerPixel blocks per pixel (the coarsest when none does).
+    /// @param samplesPerPixel view resolution in samples
+    uint32 getBestResolution(double samplesPerPixel) const;
+
+    /// Read blocks for a sample range at a resolution.
+    /// Blocks that are not built yet read as silence.
+    /// @param samplesPerBlock resolution to read
+    /// @param startSample first sample in file space
+    /// @param endSample last sample in file space
+    /// @param outBlocks output blocks (per channel)
+    virtual bool readBlocksForRange(uint32 samplesPerBlock,
+                                    uint64 startSample,
+                                    uint64 endSample,
+                                    std::vector<PeakBlock>& outBlocks) const = 0;
+
+    /// Visit the blocks of a sample range in runs pointing straight at the stored peaks.
+    /// Runs arrive in block order and are only valid during the callback, which may hold a lock.
+    /// The default implementation copies through readBlocksForRange.
+    /// @param samplesPerBlock resolution to read
+    /// @param startSample first sample in file space
+    /// @param endSample last sample in file space
+    /// @param visitor called once per run
+    virtual bool visitBlocksForRange(uint32 samplesPerBlock,
+                                     uint64 startSample,
+                                     uint64 endSample,
+                                     const std::function<void(const BlockRun&)>& visitor) const;
+
+    /// Number of channels in the source audio.
+    virtual uint32 getChannelCount() const noexcept = 0;
+
+    /// Total samples in the source audio.
+    virtual uint64 getTotalSamples() const noexcept = 0;
+
+    /// Sample rate of the source audio.
+    virtual uint32 getSampleRate() const noexcept = 0;
+
+protected:
+    /// Number of stored resolutions.
+    virtual size_t getNumLevels() const noexcept = 0;
+
+    /// Samples per block of a stored resolution.
+    /// @param levelIndex resolution index, finest first
+    virtual uint32 getLevelBlockSize(size_t levelIndex) const noexcept = 0;
+};
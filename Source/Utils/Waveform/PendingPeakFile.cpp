@@ -0,0 +1,137 @@
+#include "PendingPeakFile.h"
+
+#include "PeakKernels.h"
+
+#include <algorithm>
+
+namespace {
+constexpr int kSamplesPerRead = 32768;
+} // namespace
+
+PendingPeakFile::PendingPeakFile(const juce::File& peakFilePath,
+                                 uint32 channelCount,
+                                 uint64 totalSamples,
+                                 double sampleRate)
+    : peakFilePath(peakFilePath),
+      channelCount(channelCount),
+      totalSamples(totalSamples),
+      sampleRate(sampleRate) {
+    if (channelCount == 0 || totalSamples == 0) {
+        return;
+    }
+    const auto valuesPerBlock = static_cast<size_t>(channelCount) * 2;
+    for (const auto blockSize : PeakFileBuilder::getLevelBlockSizes()) {
+        // Chunks must hold whole blocks of every level for their slices to line up.
+        jassert(samplesPerChunk % blockSize == 0);
+        const auto blockCount = (totalSamples + blockSize - 1) / blockSize;
+        levels.push_back({ blockSize, std::vector<int16>(static_cast<size_t>(blockCount) * valuesPerBlock) });
+    }
+    numChunks = static_cast<int>((totalSamples + samplesPerChunk - 1) / samplesPerChunk);
+    chunkReady.reset(new std::atomic<bool>[static_cast<size_t>(numChunks)]());
+}
+
+bool PendingPeakFile::buildChunk(int chunkIndex, juce::AudioFormatReader& reader) {
+    if (chunkIndex < 0 || chunkIndex >= numChunks) {
+        // Chunk indices come from getNumChunks().
+        jassert(false);
+        return false;
+    }
+    const auto chunkStart = static_cast<uint64>(chunkIndex) * samplesPerChunk;
+    const auto chunkEnd = std::min(totalSamples, chunkStart + samplesPerChunk);
+    const auto valuesPerBlock = static_cast<size_t>(channelCount) * 2;
+
+    auto& base = levels.front();
+    juce::AudioBuffer<float> buffer(static_cast<int>(channelCount), kSamplesPerRead);
+    for (auto position = chunkStart; position < chunkEnd; position += kSamplesPerRead) {
+        const auto samplesToRead = static_cast<int>(std::min<uint64>(kSamplesPerRead, chunkEnd - position));
+        if (!reader.read(&buffer, 0, samplesToRead, static_cast<int64>(position), true, true)) {
+            failed = true;
+        }
+        // Reads are block aligned, so every base block lies within one read.
+        PeakKernels::buildBlocks(buffer.getArrayOfReadPointers(), channelCount, samplesToRead, base.blockSize,
+                                 base.values.data() + (position / base.blockSize) * valuesPerBlock);
+    }
+
+    // Fold each coarser level from the previous one, within this chunk's slice only.
+    for (size_t levelIndex = 1; levelIndex < levels.size(); ++levelIndex) {
+        const auto& source = levels[levelIndex - 1];
+        auto& level = levels[levelIndex];
+        const auto blockRatio = static_cast<size_t>(level.blockSize / source.blockSize);
+        const auto firstParent = static_cast<size_t>(chunkStart / level.blockSize);
+        const auto firstChild = firstParent * blockRatio;
+        const auto childEnd = static_cast<size_t>((chunkEnd + source.blockSize - 1) / source.blockSize);
+        PeakKernels::foldBlocks(source.values.data() + firstChild * valuesPerBlock, childEnd - firstChild,
+                                blockRatio, valuesPerBlock, level.values.data() + firstParent * valuesPerBlock);
+    }
+
+    chunkReady[static_cast<size_t>(chunkIndex)].store(true, std::memory_order_release);
+    return chunksBuilt.fetch_add(1, std::memory_order_acq_rel) + 1 == numChunks;
+}
+
+std::shared_ptr<PeakFile> PendingPeakFile::finish(const PeakFileBuilder::BuildOptions& options) {
+    if (!isComplete() || failed) {
+        juce::Logger::writeToLog("PendingPeakFile: incomplete build for " + peakFilePath.getFullPathName());
+        return nullptr;
+    }
+    if (!PeakFileBuilder::writePeakFile(peakFilePath, sampleRate, channelCount, totalSamples,
+                                        levels, options)) {
+        juce::Logger::writeToLog("PendingPeakFile: cannot write " + peakFilePath.getFullPathName());
+        return nullptr;
+    }
+    auto peakFile = PeakFile::open(peakFilePath);
+    const juce::ScopedLock scopedLock(finishedLock);
+    finishedFile = peakFile;
+    return peakFile;
+}
+
+std::shared_ptr<PeakFile> PendingPeakFile::getFinishedFile() const {
+    const juce::ScopedLock scopedLock(finishedLock);
+    return finishedFile;
+}
+
+float PendingPeakFile::getProgress() const noexcept {
+    return numChunks > 0 ? static_cast<float>(chunksBuilt.load()) / static_cast<float>(numChunks) : 1.0f;
+}
+
+bool PendingPeakFile::isComplete() const {
+    return chunksBuilt.load(std::memory_order_acquire) == numChunks;
+}
+
+bool PendingPeakFile::readBlocksForRange(uint32 samplesPerBlock,
+                                         uint64 startSample,
+                                         uint64 endSample,
+                                         std::vector<PeakBlock>& outBlocks) const {
+    const auto level = std::find_if(levels.begin(), levels.end(), [samplesPerBlock](const auto& candidate) {
+        return candidate.blockSize == samplesPerBlock;
+    });
+    if (level == levels.end() || endSample <= startSample) {
+        return false;
+    }
+
+    const auto valuesPerBlock = static_cast<uint64>(channelCount) * 2;
+    const auto blockCount = level->values.size() / valuesPerBlock;
+    const auto startBlock = startSample / samplesPerBlock;
+    const auto endBlock = std::min<uint64>((std::min(endSample, totalSamples) + samplesPerBlock - 1) / samplesPerBlock,
+                                           blockCount);
+    if (startBlock >= endBlock) {
+        return false;
+    }
+
+    outBlocks.resize(static_cast<size_t>((endBlock - startBlock) * channelCount));
+    auto* out = outBlocks.data();
+    const auto blocksPerChunk = samplesPerChunk / samplesPerBlock;
+    for (auto blockIndex = startBlock; blockIndex < endBlock; ++blockIndex) {
+        // The acquire load makes the chunk's slice visible before it is read.
+        if (!chunkReady[static_cast<size_t>(blockIndex / blocksPerChunk)].load(std::memory_order_acquire)) {
+            std::fill(out, out + channelCount, PeakBlock {});
+            out += channelCount;
+            continue;
+        }
+        const auto* values = level->values.data() + blockIndex * valuesPerBlock;
+        for (uint32 channel = 0; channel < channelCount; ++channel, ++out) {
+            out->min = *values++;
+            out->max = *values++;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <JuceHeader.h>
+
+#include <atomic>
+
+#include "PeakFile.h"
+#include "PeakFileBuilder.h"
+#include "PeakSource.h"
+
+/// Peak file being built in the background, readable while chunks complete.
+/// The audio is split into chunks aligned to the coarsest level, so every chunk fills its own
+/// slice of each level and the pyramid is merged by placing slices side by side. Chunks that
+/// are not built yet read as silence; the finished file is written once the last one lands.
+class PendingPeakFile : public PeakSource {
+public:
+    /// Samples per chunk, a multiple of every level block size.
+    static constexpr uint64 samplesPerChunk = 65536 * 8;
+
+    /// Allocate the levels for an audio file.
+    /// @param peakFilePath peak file written when every chunk is built
+    /// @param channelCount channels in the audio
+    /// @param totalSamples length of the audio
+    /// @param sampleRate sample rate of the audio
+    PendingPeakFile(const juce::File& peakFilePath,
+                    uint32 channelCount,
+                    uint64 totalSamples,
+                    double sampleRate);
+
+    /// Number of chunks to build.
+    int getNumChunks() const noexcept { return numChunks; }
+
+    /// Build the levels of one chunk (worker thread, one call per chunk).
+    /// @param chunkIndex chunk to build
+    /// @param reader reader owned by the calling thread
+    /// @return true when this was the last chunk to complete
+    bool buildChunk(int chunkIndex, juce::AudioFormatReader& reader);
+
+    /// Write the peak file and open it (call once buildChunk returned true).
+    /// @param options build configuration
+    /// @return the finished peak file, or nullptr when writing failed
+    std::shared_ptr<PeakFile> finish(const PeakFileBuilder::BuildOptions& options);
+
+    /// The finished peak file, once written.
+    std::shared_ptr<PeakFile> getFinishedFile() const;
+
+    /// Fraction of chunks built (0 to 1).
+    float getProgress() const noexcept;
+
+    bool isValid() const override { return numChunks > 0; }
+
+    bool isComplete() const override;
+
+    bool readBlocksForRange(uint32 samplesPerBlock,
+                            uint64 startSample,
+                            uint64 endSample,
+                            std::vector<PeakBlock>& outBlocks) const override;
+
+    uint32 getChannelCount() const noexcept override { return channelCount; }
+
+    uint64 getTotalSamples() const noexcept override { return totalSamples; }
+
+    uint32 getSampleRate() const noexcept override { return static_cast<uint32>(std::lround(sampleRate)); }
+
+protected:
+    size_t getNumLevels() const noexcept override { return levels.size(); }
+
+    uint32 getLevelBlockSize(size_t levelIndex) const noexcept override { return levels[levelIndex].blockSize; }
+
+private:
+    juce::File peakFilePath;
+    uint32 channelCount = 0;
+    uint64 totalSamples = 0;
+    double sampleRate = 0.0;
+    int numChunks = 0;
+    /// Pre-sized levels; each chunk writes only its own slice.
+    std::vector<PeakFileBuilder::LevelData> levels;
+    std::unique_ptr<std::atomic<bool>[]> chunkReady;
+    std::atomic<int> chunksBuilt { 0 };
+    std::atomic<bool> failed { false };
+    mutable juce::CriticalSection finishedLock;
+    std::shared_ptr<PeakFile> finishedFile;
+};
@@ -0,0 +1,132 @@
+#include <JuceHeader.h>
+
+#include <Gui/Video/FilmstripCache.h>
+
+class FilmstripCacheTests : public juce::UnitTest
+{
+public:
+    FilmstripCacheTests() : juce::UnitTest("FilmstripCache", "Video") {}
+
+    void runTest() override
+    {
+        beginTest("Level spacing never exceeds a thumbnail width");
+        {
+            expectEquals(FilmstripCache::getLevelForSpacing(0.25), 0);
+            expectEquals(FilmstripCache::getLevelForSpacing(1.0), 0);
+            expectEquals(FilmstripCache::getLevelForSpacing(3.9), 1);
+            expectEquals(FilmstripCache::getLevelForSpacing(4.0), 2);
+            expectEquals(FilmstripCache::getLevelForSpacing(1.0e12), FilmstripCache::kMaxLevel);
+        }
+
+        beginTest("Strips cover kFramesPerStrip thumbnails of their level");
+        {
+            expectEquals(FilmstripCache::getStripIndexForFrame(0, 31), int64 { 0 });
+            expectEquals(FilmstripCache::getStripIndexForFrame(0, 32), int64 { 1 });
+            expectEquals(FilmstripCache::getStripIndexForFrame(3, 255), int64 { 0 });
+            expectEquals(FilmstripCache::getStripIndexForFrame(3, 256), int64 { 1 });
+            expectEquals(FilmstripCache::getStripFirstFrame(3, 2), int64 { 512 });
+        }
+
+        beginTest("Strips are stored on disk and coarser levels reuse them");
+        {
+            juce::TemporaryFile y4m(".y4m");
+            writeY4M(y4m.getFile(), 40);
+            const auto directory = juce::File::createTempFile("filmstrips");
+            auto& cache = FilmstripCache::get();
+            const auto previousDirectory = cache.getCacheDirectory();
+            cache.clear();
+            cache.setCacheDirectory(directory);
+
+            const auto path = y4m.getFile().getFullPathName();
+            expect(!cache.getStrip({ path, 0, 0 }, 25.0).isValid());
+            expect(!cache.getStrip({ path, 0, 1 }, 25.0).isValid());
+            expect(cache.waitForPendingBuilds(10000));
+            const auto first = cache.getStrip({ path, 0, 0 }, 25.0);
+            const auto last = cache.getStrip({ path, 0, 1 }, 25.0);
+            expectEquals(FilmstripCache::getThumbnailCount(first), FilmstripCache::kFramesPerStrip);
+            expectEquals(FilmstripCache::getThumbnailCount(last), 8);
+            expectGrey(first, 5, 5);
+            expectGrey(last, 7, 39);
+            expectEquals(directory.getNumberOfChildFiles(juce::File::findFiles, "*.jpg"), 2);
+
+            // Level 1 is built from the two level 0 strips: every other frame, up to frame 38.
+            cache.clear();
+            expect(!cache.getStrip({ path, 1, 0 }, 25.0).isValid());
+            expect(cache.waitForPendingBuilds(10000));
+            const auto coarse = cache.getStrip({ path, 1, 0 }, 25.0);
+            expectEquals(FilmstripCache::getThumbnailCount(coarse), 20);
+            expectGrey(coarse, 3, 6);
+            expectGrey(coarse, 19, 38);
+
+            // Past the end of the video, strips stay empty.
+            expect(!cache.getStrip({ path, 0, 2 }, 25.0).isValid());
+            expect(cache.waitForPendingBuilds(10000));
+            expect(!cache.getStrip({ path, 0, 2 }, 25.0).isValid());
+
+            cache.clear();
+            cache.setCacheDirectory(previousDirectory);
+            directory.deleteRecursively();
+        }
+
+        beginTest("Strips that fail to build are neither stored nor kept");
+        {
+            juce::TemporaryFile y4m(".y4m");
+            expect(y4m.getFile().replaceWithText("not a video"));
+            const auto directory = juce::File::createTempFile("filmstrips");
+            auto& cache = FilmstripCache::get();
+            const auto previousDirectory = cache.getCacheDirectory();
+            cache.clear();
+            cache.setCacheDirectory(directory);
+
+            const FilmstripCache::StripKey key { y4m.getFile().getFullPathName(), 0, 0 };
+            expect(!cache.getStrip(key, 25.0).isValid());
+            expect(cache.waitForPendingBuilds(10000));
+            expect(!cache.getStrip(key, 25.0).isValid());
+            expect(cache.waitForPendingBuilds(10000));
+            expectEquals(directory.getNumberOfChildFiles(juce::File::findFiles, "*.jpg"), 0);
+
+            // Once the file can be read, the next request builds the strip.
+            writeY4M(y4m.getFile(), 4);
+            expect(!cache.getStrip(key, 25.0).isValid());
+            expect(cache.waitForPendingBuilds(10000));
+            const auto strip = cache.getStrip(key, 25.0);
+            expectEquals(FilmstripCache::getThumbnailCount(strip), 4);
+            expectGrey(strip, 3, 3);
+
+            cache.clear();
+            cache.setCacheDirectory(previousDirectory);
+            directory.deleteRecursively();
+        }
+    }
+
+private:
+    /// Square grey frames whose limited range luma rises by 5 per frame.
+    static void writeY4M(const juce::File& file, int frameCount)
+    {
+        constexpr int size = 8;
+        file.deleteFile();
+        juce::FileOutputStream out(file);
+        out.writeText("YUV4MPEG2 W8 H8 F25:1 Ip A1:1 C420jpeg\n", false, false, nullptr);
+        for (int frame = 0; frame < frameCount; ++frame) {
+            out.writeText("FRAME\n", false, false, nullptr);
+            std::vector<uint8_t> planes(size * size, static_cast<uint8_t>(16 + 5 * frame));
+            planes.insert(planes.end(), 2 * (size / 2) * (size / 2), 128);
+            out.write(planes.data(), planes.size());
+        }
+    }
+
+    void expectGrey(const juce::Image& strip, int slot, int frame)
+    {
+        expect(slot < FilmstripCache::getThumbnailCount(strip));
+        if (slot >= FilmstripCache::getThumbnailCount(strip)) {
+            return;
+        }
+        const auto pixel = strip.getPixelAt(slot * FilmstripCache::kThumbnailWidth + FilmstripCache::kThumbnailWidth / 2,
+                                            FilmstripCache::kThumbnailHeight / 2);
+        // Limited range luma stretched to full range, within JPEG error.
+        const auto expected = juce::jlimit(0, 255, (298 * 5 * frame + 128) >> 8);
+        expectWithinAbsoluteError(static_cast<int>(pixel.getRed()), expected, 8);
+    }
+};
+
+static FilmstripCacheTests filmstripCacheTests;
@@ -0,0 +1,90 @@
+#include <JuceHeader.h>
+
+#include <Utils/Cache/GenerationalLruCache.h>
+
+class GenerationalLruCacheTests : public juce::UnitTest
+{
+public:
+    GenerationalLruCacheTests() : juce::UnitTest("GenerationalLruCache", "Engine") {}
+
+    void runTest() override
+    {
+        beginTest("Least recently used values are evicted first");
+        {
+            Cache cache(30);
+            for (const auto key : { 1, 2, 3 }) {
+                build(cache, key, 10);
+            }
+            // Finding 1 makes it the most recent, leaving 2 the oldest.
+            expect(cache.find(1).has_value());
+            build(cache, 4, 10);
+            expect(cache.find(1).has_value() && cache.find(3).has_value() && cache.find(4).has_value());
+            expect(!cache.find(2).has_value());
+            expectEquals((int) cache.getMemoryUsage(), 30);
+
+            // The newest value stays even when it alone is over budget.
+            cache.setMemoryBudget(1);
+            expectEquals((int) cache.getMemoryUsage(), 10);
+            expect(cache.find(4).has_value());
+        }
+
+        beginTest("Failed builds cache nothing and run again on request");
+        {
+            Cache cache(100);
+            std::atomic<int> attempts { 0 };
+            const auto failing = [&attempts]() -> std::optional<int> {
+                ++attempts;
+                return std::nullopt;
+            };
+            cache.request(1, failing);
+            expect(cache.waitForPendingBuilds(10000));
+            expect(!cache.find(1).has_value());
+            cache.request(1, failing);
+            expect(cache.waitForPendingBuilds(10000));
+            expectEquals(attempts.load(), 2);
+            expectEquals((int) cache.getMemoryUsage(), 0);
+        }
+
+        beginTest("Builds requested for an older view are skipped");
+        {
+            Cache cache(100);
+            juce::WaitableEvent release;
+            // Keeps the single worker busy so the next request is still queued when the view moves.
+            cache.request(1, [&release]() -> std::optional<int> {
+                release.wait(10000);
+                return 10;
+            });
+            std::atomic<bool> staleBuilt { false };
+            cache.request(2, [&staleBuilt]() -> std::optional<int> {
+                staleBuilt = true;
+                return 10;
+            });
+            cache.advanceGeneration();
+            release.signal();
+            expect(cache.waitForPendingBuilds(10000));
+            expect(!staleBuilt.load());
+            expect(!cache.find(2).has_value());
+
+            // Requested again in the new view, it is built.
+            build(cache, 2, 10);
+            expect(cache.find(2).has_value());
+        }
+    }
+
+private:
+    /// Values are their own size in bytes.
+    struct Cache : GenerationalLruCache<int, int> {
+        explicit Cache(size_t budget)
+            : GenerationalLruCache<int, int>("Test", 1, budget, [](const int& value) { return static_cast<size_t>(value); }, {})
+        {
+        }
+    };
+
+    void build(Cache& cache, int key, int value)
+    {
+        cache.request(key, [value]() -> std::optional<int> { return value; });
+        expect(cache.waitForPendingBuilds(10000));
+    }
+};
+
+static GenerationalLruCacheTests generationalLruCacheTests;
@@ -0,0 +1,88 @@
+#include <JuceHeader.h>
+
+#include <Utils/Metering/MeterTap.h>
+#include <Utils/Metering/TripleBuffer.h>
+
+class MeteringTests : public juce::UnitTest
+{
+public:
+    MeteringTests() : juce::UnitTest("Metering", "Engine") {}
+
+    void runTest() override
+    {
+        beginTest("Triple buffer hands over the latest value once");
+        {
+            TripleBuffer<int> buffer;
+            int value = 0;
+            expect(!buffer.read(value));
+            buffer.getWriteSlot() = 1;
+            buffer.publish();
+            buffer.getWriteSlot() = 2;
+            buffer.publish();
+            expect(buffer.read(value));
+            expectEquals(value, 2);
+            expect(!buffer.read(value));
+        }
+
+        beginTest("Peak, RMS and true peak of a quarter-rate sine");
+        {
+            // Samples land at +-45 degrees, so the sample peak is 0.707 while the waveform reaches 1.
+            constexpr double sampleRate = 48000.0;
+            juce::AudioBuffer<float> buffer(1, 480);
+            for (int i = 0; i < buffer.getNumSamples(); ++i) {
+                buffer.setSample(0, i, static_cast<float>(std::sin(juce::MathConstants<double>::halfPi * i
+                                                                   + juce::MathConstants<double>::pi * 0.25)));
+            }
+            MeterTap tap(1);
+            tap.prepare(sampleRate);
+            for (int block = 0; block < 10; ++block) {
+                tap.process(buffer, buffer.getNumSamples());
+            }
+            MeterReading reading;
+            expect(tap.read(reading));
+            expectEquals(reading.numChannels, 1);
+            expectWithinAbsoluteError(reading.peak[0], 0.7071f, 1.0e-3f);
+            expectWithinAbsoluteError(reading.rms[0], 0.7071f, 1.0e-3f);
+            expectWithinAbsoluteError(reading.truePeak[0], 1.0f, 0.02f);
+        }
+
+        beginTest("Peaks stay visible for a full window after they pass");
+        {
+            MeterTap tap(1);
+            tap.prepare(48000.0);
+            juce::AudioBuffer<float> buffer(1, 256);
+            buffer.clear();
+            buffer.setSample(0, 10, 0.25f);
+            tap.process(buffer, 256);
+            buffer.clear();
+            for (int block = 0; block < 10; ++block) {
+                tap.process(buffer, 256);
+            }
+            MeterReading reading;
+            expect(tap.read(reading));
+            expectWithinAbsoluteError(reading.peak[0], 0.25f, 1.0e-6f);
+        }
+
+        beginTest("True peak is measured on quiet signals across chunk boundaries");
+        {
+            // Same quarter-rate sine at -12 dBFS, in blocks that are not a multiple of the chunk.
+            constexpr float amplitude = 0.25f;
+            juce::AudioBuffer<float> buffer(1, 1000);
+            for (int i = 0; i < buffer.getNumSamples(); ++i) {
+                buffer.setSample(0, i, amplitude * static_cast<float>(std::sin(juce::MathConstants<double>::halfPi * i
+                                                                               + juce::MathConstants<double>::pi * 0.25)));
+            }
+            MeterTap tap(1);
+            tap.prepare(48000.0);
+            for (int block = 0; block < 5; ++block) {
+                tap.process(buffer, buffer.getNumSamples());
+            }
+            MeterReading reading;
+            expect(tap.read(reading));
+            expectWithinAbsoluteError(reading.peak[0], amplitude * 0.7071f, 1.0e-3f);
+            expectWithinAbsoluteError(reading.truePeak[0], amplitude, 0.005f);
+        }
+    }
+};
+
+static MeteringTests meteringTests;
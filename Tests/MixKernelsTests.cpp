@@ -0,0 +1,178 @@
+#include <JuceHeader.h>
+
+#include <AudioEngine/Mixing/MixKernels.h>
+
+class MixKernelsTests : public juce::UnitTest
+{
+public:
+    MixKernelsTests() : juce::UnitTest("MixKernels", "Engine") {}
+
+    void runTest() override
+    {
+        beginTest("Add kernel matches the scalar path");
+        {
+            for (const auto& pair : { std::pair{ 1, 1 }, std::pair{ 2, 2 }, std::pair{ 1, 2 }, std::pair{ 6, 6 }, std::pair{ 6, 2 }, std::pair{ 8, 1 } }) {
+                auto source = makeNoise(pair.first, 512);
+                juce::AudioBuffer<float> expected(pair.second, 512);
+                juce::AudioBuffer<float> actual(pair.second, 512);
+                expected.clear();
+                actual.clear();
+
+                MixKernels::addScalarReference(source, expected, 17, 400);
+                MixKernels::select(pair.first, pair.second).add(
+                    source.getArrayOfReadPointers(), actual.getArrayOfWritePointers(), 17, 400, 1.0f, 1.0f);
+                expect(buffersMatch(expected, actual),
+                       "mismatch for " + juce::String(pair.first) + " -> " + juce::String(pair.second));
+            }
+        }
+
+        beginTest("Downmix folds every source channel");
+        {
+            juce::AudioBuffer<float> source(2, 64);
+            juce::FloatVectorOperations::fill(source.getWritePointer(0), 1.0f, 64);
+            juce::FloatVectorOperations::fill(source.getWritePointer(1), 0.5f, 64);
+            juce::AudioBuffer<float> mono(1, 64);
+            MixKernels::select(2, 1).copy(
+                source.getArrayOfReadPointers(), mono.getArrayOfWritePointers(), 0, 64, 1.0f, 1.0f);
+            expectWithinAbsoluteError(mono.getSample(0, 10), 1.5f * 0.70710678f, 1.0e-6f);
+        }
+
+        beginTest("5.1 downmix splits the centre at -3 dB and drops the LFE");
+        {
+            juce::AudioBuffer<float> source(6, 64);
+            source.clear();
+            // L R C LFE Ls Rs
+            juce::FloatVectorOperations::fill(source.getWritePointer(2), 1.0f, 64);
+            juce::FloatVectorOperations::fill(source.getWritePointer(3), 1.0f, 64);
+            juce::FloatVectorOperations::fill(source.getWritePointer(4), 0.5f, 64);
+            juce::AudioBuffer<float> stereo(2, 64);
+            MixKernels::select(6, 2).copy(
+                source.getArrayOfReadPointers(), stereo.getArrayOfWritePointers(), 0, 64, 1.0f, 1.0f);
+            expectWithinAbsoluteError(stereo.getSample(0, 10), 1.5f * 0.70710678f, 1.0e-6f);
+            expectWithinAbsoluteError(stereo.getSample(1, 10), 0.70710678f, 1.0e-6f);
+        }
+
+        beginTest("Mono feeds the centre of wider layouts");
+        {
+            expectEquals(MixKernels::getRouteGain(1, 6, 0, 2), 1.0f);
+            expectEquals(MixKernels::getRouteGain(1, 6, 0, 0), 0.0f);
+            expectEquals(MixKernels::getRouteGain(1, 4, 0, 1), 1.0f);
+            // Quad surrounds land on the 5.0 surrounds, not on the centre.
+            expectEquals(MixKernels::getRouteGain(4, 5, 2, 3), 1.0f);
+            expectEquals(MixKernels::getRouteGain(4, 5, 2, 2), 0.0f);
+            expect(MixKernels::isUnityRouting(2, 8));
+            expect(!MixKernels::isUnityRouting(3, 2));
+        }
+
+        beginTest("Gain and ramp kernels");
+        {
+            juce::AudioBuffer<float> source(1, 100);
+            juce::FloatVectorOperations::fill(source.getWritePointer(0), 1.0f, 100);
+            juce::AudioBuffer<float> destination(1, 100);
+            destination.clear();
+            MixKernels::select(1, 1).addWithGain(
+                source.getArrayOfReadPointers(), destination.getArrayOfWritePointers(), 0, 100, 0.5f, 0.5f);
+            expectWithinAbsoluteError(destination.getSample(0, 99), 0.5f, 1.0e-6f);
+
+            destination.clear();
+            MixKernels::select(1, 1).addWithRamp(
+                source.getArrayOfReadPointers(), destination.getArrayOfWritePointers(), 0, 100, 0.0f, 1.0f);
+            expectWithinAbsoluteError(destination.getSample(0, 0), 0.0f, 1.0e-6f);
+            expectWithinAbsoluteError(destination.getSample(0, 50), 0.5f, 1.0e-4f);
+        }
+
+        beginTest("Per-channel ramps pan a mono send onto a stereo bus");
+        {
+            juce::AudioBuffer<float> source(1, 100);
+            juce::FloatVectorOperations::fill(source.getWritePointer(0), 1.0f, 100);
+            juce::AudioBuffer<float> bus(2, 100);
+            bus.clear();
+            const float startGains[] = { 1.0f, 0.0f };
+            const float endGains[] = { 1.0f, 1.0f };
+            MixKernels::select(1, 2).addWithChannelRamps(
+                source.getArrayOfReadPointers(), bus.getArrayOfWritePointers(), 0, 100, startGains, endGains);
+            expectWithinAbsoluteError(bus.getSample(0, 50), 1.0f, 1.0e-6f);
+            expectWithinAbsoluteError(bus.getSample(1, 0), 0.0f, 1.0e-6f);
+            expectWithinAbsoluteError(bus.getSample(1, 50), 0.5f, 1.0e-4f);
+        }
+
+        beginTest("Every kernel matches the scalar path for every channel pair");
+        {
+            constexpr int blockSize = 512;
+            for (int src = 1; src <= MixKernels::maxChannels; ++src) {
+                for (int dst = 1; dst <= MixKernels::maxChannels; ++dst) {
+                    const auto source = makeNoise(src, blockSize);
+                    const auto& kernels = MixKernels::select(src, dst);
+                    const auto pair = juce::String(src) + " -> " + juce::String(dst);
+
+                    // Summation order can differ by a rounding step. The destination starts with
+                    // content so add and copy are told apart.
+                    auto background = makeNoise(dst, blockSize, 7);
+                    auto expected = background;
+                    MixKernels::addScalarReference(source, expected, 0, blockSize);
+                    auto actual = background;
+                    kernels.add(source.getArrayOfReadPointers(), actual.getArrayOfWritePointers(),
+                                0, blockSize, 1.0f, 1.0f);
+                    expect(buffersMatch(expected, actual, 1.0e-5f), "add mismatch for " + pair);
+
+                    juce::AudioBuffer<float> mapped(dst, blockSize);
+                    mapped.clear();
+                    MixKernels::addScalarReference(source, mapped, 0, blockSize);
+                    actual = background;
+                    kernels.copy(source.getArrayOfReadPointers(), actual.getArrayOfWritePointers(),
+                                 0, blockSize, 1.0f, 1.0f);
+                    expect(buffersMatch(mapped, actual, 1.0e-5f), "copy mismatch for " + pair);
+
+                    expected = background;
+                    for (int c = 0; c < dst; ++c) {
+                        expected.addFrom(c, 0, mapped, c, 0, blockSize, 0.25f);
+                    }
+                    actual = background;
+                    kernels.addWithGain(source.getArrayOfReadPointers(), actual.getArrayOfWritePointers(),
+                                        0, blockSize, 0.25f, 0.25f);
+                    expect(buffersMatch(expected, actual, 1.0e-5f), "gain mismatch for " + pair);
+
+                    expected = background;
+                    for (int c = 0; c < dst; ++c) {
+                        expected.addFromWithRamp(c, 0, mapped.getReadPointer(c), blockSize, 0.0f, 1.0f);
+                    }
+                    actual = background;
+                    kernels.addWithRamp(source.getArrayOfReadPointers(), actual.getArrayOfWritePointers(),
+                                        0, blockSize, 0.0f, 1.0f);
+                    expect(buffersMatch(expected, actual, 1.0e-4f), "ramp mismatch for " + pair);
+                }
+            }
+        }
+    }
+
+private:
+    static juce::AudioBuffer<float> makeNoise(int numChannels, int numSamples, int64 seed = 42)
+    {
+        juce::Random random(seed);
+        juce::AudioBuffer<float> buffer(numChannels, numSamples);
+        for (int c = 0; c < numChannels; ++c) {
+            for (int i = 0; i < numSamples; ++i) {
+                buffer.setSample(c, i, random.nextFloat() * 2.0f - 1.0f);
+            }
+        }
+        return buffer;
+    }
+
+    static bool buffersMatch(const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b,
+                             float tolerance = 1.0e-6f)
+    {
+        if (a.getNumChannels() != b.getNumChannels() || a.getNumSamples() != b.getNumSamples()) {
+            return false;
+        }
+        for (int c = 0; c < a.getNumChannels(); ++c) {
+            for (int i = 0; i < a.getNumSamples(); ++i) {
+                if (std::abs(a.getSample(c, i) - b.getSample(c, i)) > tolerance) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+};
+
+static MixKernelsTests mixKernelsTests;
@@ -0,0 +1,448 @@
+#include <JuceHeader.h>
+
+#include <Utils/Cache/ContentCacheIndex.h>
+#include <Utils/Cache/FingerprintCache.h>
+#include <Utils/Waveform/IncrementalPeakBuilder.h>
+#include <Utils/Waveform/PeakFile.h>
+#include <Utils/Waveform/PeakFileBuilder.h>
+#include <Utils/Waveform/PeakKernels.h>
+#include <Utils/Waveform/PendingPeakFile.h>
+
+class PeakFileTests : public juce::UnitTest
+{
+public:
+    PeakFileTests() : juce::UnitTest("PeakFile", "Engine") {}
+
+    void runTest() override
+    {
+        beginTest("Incremental peaks match the offline builder");
+        {
+            // Not a multiple of any block size, so every level ends on a partial block.
+            constexpr int totalSamples = 70000;
+            auto audio = makeNoise(2, totalSamples);
+
+            juce::TemporaryFile offlinePeaks(".peak");
+            {
+                juce::AudioFormatManager formatManager;
+                formatManager.registerBasicFormats();
+                juce::TemporaryFile wav(".wav");
+                writeWav(wav.getFile(), audio);
+                auto reader = std::unique_ptr<juce::AudioFormatReader>(formatManager.createReaderFor(wav.getFile()));
+                expect(reader != nullptr);
+                PeakFileBuilder builder;
+                expect(builder.build(*reader, offlinePeaks.getFile()));
+            }
+
+            IncrementalPeakBuilder incremental;
+            incremental.reset(2, 48000.0, 0);
+            juce::Random random(3);
+            for (int position = 0; position < totalSamples;) {
+                const auto count = juce::jmin(totalSamples - position, 1 + random.nextInt(700));
+                incremental.addBlock(position, audio, position, count);
+                position += count;
+            }
+            expectEquals(incremental.getTotalSamples(), (uint64) totalSamples);
+
+            // Read while recording through PeakSource, the way a live take is drawn.
+            const PeakSource& liveSource = incremental;
+            expect(liveSource.isValid() && !liveSource.isComplete());
+            std::vector<PeakSource::PeakBlock> live;
+            expect(liveSource.readBlocksForRange(2048, 0, 8192, live));
+            expectEquals((int) live.size(), 4 * 2);
+
+            juce::TemporaryFile incrementalPeaks(".peak");
+            expect(incremental.writePeakFile(incrementalPeaks.getFile()));
+
+            juce::MemoryBlock expected;
+            juce::MemoryBlock actual;
+            offlinePeaks.getFile().loadFileAsData(expected);
+            incrementalPeaks.getFile().loadFileAsData(actual);
+            expect(expected.getSize() > 0);
+            expect(expected == actual);
+
+            auto peakFile = PeakFile::open(incrementalPeaks.getFile());
+            expect(peakFile != nullptr);
+            if (peakFile != nullptr) {
+                std::vector<PeakFile::PeakBlock> blocks;
+                expect(peakFile->readBlocksForRange(2048, 0, 8192, blocks));
+                expectEquals((int) blocks.size(), (int) live.size());
+                expectEquals((int) blocks[3].max, (int) live[3].max);
+            }
+        }
+
+        beginTest("Chunks built out of order merge into the offline pyramid");
+        {
+            // Three chunks, the last one partial.
+            const auto totalSamples = static_cast<int>(PendingPeakFile::samplesPerChunk * 2 + 5000);
+            auto audio = makeNoise(1, totalSamples);
+            juce::AudioFormatManager formatManager;
+            formatManager.registerBasicFormats();
+            juce::TemporaryFile wav(".wav");
+            writeWav(wav.getFile(), audio);
+            auto reader = std::unique_ptr<juce::AudioFormatReader>(formatManager.createReaderFor(wav.getFile()));
+            expect(reader != nullptr);
+            if (reader == nullptr) {
+                return;
+            }
+
+            juce::TemporaryFile offlinePeaks(".peak");
+            PeakFileBuilder builder;
+            expect(builder.build(*reader, offlinePeaks.getFile()));
+
+            juce::TemporaryFile chunkedPeaks(".peak");
+            PendingPeakFile pending(chunkedPeaks.getFile(), 1, static_cast<uint64>(totalSamples), 48000.0);
+            expectEquals(pending.getNumChunks(), 3);
+            expect(!pending.buildChunk(2, *reader));
+
+            // Unbuilt chunks read as silence while built ones are already final.
+            std::vector<PeakSource::PeakBlock> blocks;
+            expect(pending.readBlocksForRange(32768, 0, static_cast<uint64>(totalSamples), blocks));
+            expectEquals((int) blocks.size(), 33);
+            expectEquals((int) blocks.front().max, 0);
+            expect(blocks.back().max > 0);
+            expect(!pending.isComplete());
+
+            expect(!pending.buildChunk(0, *reader));
+            expect(pending.buildChunk(1, *reader));
+            expect(pending.isComplete());
+            expect(pending.finish({}) != nullptr);
+
+            juce::MemoryBlock expected;
+            juce::MemoryBlock actual;
+            offlinePeaks.getFile().loadFileAsData(expected);
+            chunkedPeaks.getFile().loadFileAsData(actual);
+            expect(expected == actual);
+        }
+
+        beginTest("Compressed version 2 files read back like version 1");
+        {
+            constexpr int totalSamples = 48000 * 20 + 77;
+            juce::AudioBuffer<float> audio(2, totalSamples);
+            juce::Random random(5);
+            for (int c = 0; c < 2; ++c) {
+                for (int i = 0; i < totalSamples; ++i) {
+                    audio.setSample(c, i, std::sin(static_cast<float>(i) * 0.0003f) * (random.nextFloat() - 0.5f));
+                }
+            }
+            juce::AudioFormatManager formatManager;
+            formatManager.registerBasicFormats();
+            juce::TemporaryFile wav(".wav");
+            writeWav(wav.getFile(), audio);
+            auto reader = std::unique_ptr<juce::AudioFormatReader>(formatManager.createReaderFor(wav.getFile()));
+            expect(reader != nullptr);
+            if (reader == nullptr) {
+                return;
+            }
+
+            juce::TemporaryFile version1(".peak");
+            juce::TemporaryFile version2(".peak");
+            PeakFileBuilder builder;
+            PeakFileBuilder::BuildOptions options;
+            options.compressionHook = PeakFileBuilder::createCompressionHook(PeakFileFormat::Compression::Rice,
+                                                                             PeakFileFormat::DeltaEncoding::MinMaxPairs);
+            expect(builder.build(*reader, version1.getFile()));
+            expect(builder.build(*reader, version2.getFile(), options));
+            expect(version2.getFile().getSize() < version1.getFile().getSize());
+
+            auto uncompressed = PeakFile::open(version1.getFile());
+            auto compressed = PeakFile::open(version2.getFile());
+            expect(uncompressed != nullptr && compressed != nullptr);
+            if (uncompressed == nullptr || compressed == nullptr) {
+                return;
+            }
+            for (const auto samplesPerBlock : PeakFileBuilder::getLevelBlockSizes()) {
+                for (int range = 0; range < 20; ++range) {
+                    const auto start = static_cast<uint64>(random.nextInt(totalSamples - 1));
+                    const auto end = std::min<uint64>(totalSamples, start + 1 + static_cast<uint64>(random.nextInt(300000)));
+                    std::vector<PeakSource::PeakBlock> expected;
+                    std::vector<PeakSource::PeakBlock> actual;
+                    expect(uncompressed->readBlocksForRange(samplesPerBlock, start, end, expected));
+                    expect(compressed->readBlocksForRange(samplesPerBlock, start, end, actual));
+                    expect(std::equal(expected.begin(), expected.end(), actual.begin(), actual.end(),
+                                      [](const auto& a, const auto& b) { return a.min == b.min && a.max == b.max; }),
+                           "blocks differ at " + juce::String(samplesPerBlock));
+                    expect(readThroughRuns(*uncompressed, samplesPerBlock, start, end) == flatten(expected),
+                           "mapped runs differ at " + juce::String(samplesPerBlock));
+                    expect(readThroughRuns(*compressed, samplesPerBlock, start, end) == flatten(expected),
+                           "chunk runs differ at " + juce::String(samplesPerBlock));
+                }
+            }
+        }
+
+        beginTest("Int8 coarse levels enclose the Int16 peaks");
+        {
+            constexpr int totalSamples = 48000 * 10;
+            auto audio = makeNoise(1, totalSamples);
+            audio.applyGain(0.37f);
+            juce::AudioFormatManager formatManager;
+            formatManager.registerBasicFormats();
+            juce::TemporaryFile wav(".wav");
+            writeWav(wav.getFile(), audio);
+            auto reader = std::unique_ptr<juce::AudioFormatReader>(formatManager.createReaderFor(wav.getFile()));
+            expect(reader != nullptr);
+            if (reader == nullptr) {
+                return;
+            }
+
+            juce::TemporaryFile int16Peaks(".peak");
+            juce::TemporaryFile int8Peaks(".peak");
+            PeakFileBuilder builder;
+            PeakFileBuilder::BuildOptions int16Options;
+            int16Options.coarseSampleFormat = PeakFileFormat::SampleFormat::Int16;
+            expect(builder.build(*reader, int16Peaks.getFile(), int16Options));
+            expect(builder.build(*reader, int8Peaks.getFile()));
+            expect(int8Peaks.getFile().getSize() < int16Peaks.getFile().getSize());
+
+            auto exact = PeakFile::open(int16Peaks.getFile());
+            auto coarse = PeakFile::open(int8Peaks.getFile());
+            expect(exact != nullptr && coarse != nullptr);
+            if (exact == nullptr || coarse == nullptr) {
+                return;
+            }
+            for (const auto samplesPerBlock : PeakFileBuilder::getLevelBlockSizes()) {
+                std::vector<PeakSource::PeakBlock> expected;
+                std::vector<PeakSource::PeakBlock> actual;
+                expect(exact->readBlocksForRange(samplesPerBlock, 0, totalSamples, expected));
+                expect(coarse->readBlocksForRange(samplesPerBlock, 0, totalSamples, actual));
+                expectEquals((int) actual.size(), (int) expected.size());
+                for (size_t i = 0; i < std::min(expected.size(), actual.size()); ++i) {
+                    // One Int8 step is 258 Int16 steps.
+                    expect(actual[i].min <= expected[i].min && actual[i].min > expected[i].min - 259);
+                    expect(actual[i].max >= expected[i].max && actual[i].max < expected[i].max + 259);
+                }
+            }
+
+            // At most four blocks per pixel, from the finest level that allows it.
+            expectEquals((int) coarse->getBestResolution(1.0), 128);
+            expectEquals((int) coarse->getBestResolution(512.0), 128);
+            expectEquals((int) coarse->getBestResolution(513.0), 512);
+            expectEquals((int) coarse->getBestResolution(30000.0), 8192);
+            expectEquals((int) coarse->getBestResolution(1.0e7), 131072);
+        }
+
+        beginTest("Peak kernels match the scalar path");
+        {
+            for (const auto channelCount : { 1u, 2u, 6u, 8u }) {
+                // Odd offsets and lengths exercise unaligned loads and partial blocks.
+                constexpr int numSamples = 128 * 37 + 45;
+                auto audio = makeNoise(static_cast<int>(channelCount), numSamples + 3);
+                audio.setSample(0, 700, 1.5f);
+                audio.setSample(0, 900, 0.5f / 32767.0f);
+                std::vector<const float*> channels;
+                for (uint32 channel = 0; channel < channelCount; ++channel) {
+                    channels.push_back(audio.getReadPointer(static_cast<int>(channel), 3));
+                }
+                const auto valuesPerBlock = static_cast<size_t>(channelCount) * 2;
+                std::vector<int16> expected(38 * valuesPerBlock);
+                std::vector<int16> actual(expected.size());
+                PeakKernels::buildBlocksScalarReference(channels.data(), channelCount, numSamples, 128, expected.data());
+                PeakKernels::buildBlocks(channels.data(), channelCount, numSamples, 128, actual.data());
+                expect(expected == actual, "blocks differ for " + juce::String(channelCount) + " channels");
+
+                PeakFileBuilder::LevelData base { 128, expected };
+                const auto folded = PeakFileBuilder::foldLevel(base, 512, channelCount);
+                expectEquals((int) folded.values.size(), (int) (10 * valuesPerBlock));
+                for (size_t value = 0; value < valuesPerBlock; value += 2) {
+                    // The last parent holds two children.
+                    const auto lastChild = 37 * valuesPerBlock + value;
+                    expectEquals((int) folded.values[9 * valuesPerBlock + value],
+                                 (int) std::min(expected[lastChild - valuesPerBlock], expected[lastChild]));
+                    expectEquals((int) folded.values[9 * valuesPerBlock + value + 1],
+                                 (int) std::max(expected[lastChild - valuesPerBlock + 1], expected[lastChild + 1]));
+                }
+            }
+        }
+
+        beginTest("Cache keys follow content, not paths");
+        {
+            expect(FingerprintCache::hash64("", 0) == 0xef46db3751d8e999ull);
+            expect(FingerprintCache::hash64("abc", 3) == 0x44bc2cf5ad770999ull);
+
+            const auto directory = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                       .getNonexistentChildFile("PeakCacheKeys", "");
+            expect(directory.createDirectory().wasOk());
+            juce::MemoryBlock content(600000);
+            juce::Random random(7);
+            random.fillBitsRandomly(content.getData(), content.getSize());
+            const auto original = directory.getChildFile("take.wav");
+            const auto copy = directory.getChildFile("archive").getChildFile("copy.wav");
+            expect(copy.getParentDirectory().createDirectory().wasOk());
+            expect(original.replaceWithData(content.getData(), content.getSize()));
+            expect(copy.replaceWithData(content.getData(), content.getSize()));
+            const auto key = FingerprintCache::computeKey(original);
+            expect(key.isNotEmpty());
+            expectEquals(FingerprintCache::computeKey(copy), key);
+
+            // A header edit and a trimmed tail both change the key.
+            static_cast<char*>(content.getData())[20] ^= 1;
+            expect(copy.replaceWithData(content.getData(), content.getSize()));
+            expect(FingerprintCache::computeKey(copy) != key);
+            expect(copy.replaceWithData(content.getData(), content.getSize() - 1));
+            expect(FingerprintCache::computeKey(copy) != key);
+            expect(FingerprintCache::computeKey(directory.getChildFile("missing.wav")).isEmpty());
+            directory.deleteRecursively();
+        }
+
+        beginTest("Cache index evicts the least recently used peak files");
+        {
+            const auto directory = juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                       .getNonexistentChildFile("ContentCacheIndex", "");
+            {
+                ContentCacheIndex index(directory, 250, ".peak", "peaks.index");
+                for (const auto* key : { "a", "b", "c" }) {
+                    expect(index.getFilePath(key).replaceWithText(juce::String::repeatedString("x", 100)));
+                }
+                index.add("a", 100);
+                index.add("b", 100);
+                index.touch("a");
+                index.add("c", 100);
+                expect(index.contains("a") && index.contains("c"));
+                expect(!index.contains("b"));
+                expect(!index.getFilePath("b").existsAsFile());
+                expectEquals(index.getTotalBytes(), (int64) 200);
+
+                // Open files are never evicted, even over budget.
+                index.setMaxBytes(50, [](const juce::String& key) { return key == "a"; });
+                expect(index.contains("a") && !index.contains("c"));
+                index.setMaxBytes(250);
+            }
+
+            expect(directory.getChildFile("peaks.index").existsAsFile());
+            // The index reloads without scanning the directory.
+            ContentCacheIndex reloaded(directory, 250, ".peak", "peaks.index");
+            expectEquals((int) reloaded.getNumEntries(), 1);
+            expect(reloaded.contains("a"));
+            expectEquals(reloaded.getTotalBytes(), (int64) 100);
+            directory.deleteRecursively();
+        }
+
+        beginTest("Every peak level matches a scalar fold of the base blocks");
+        {
+            for (const auto channelCount : { 1u, 2u, 3u, 8u }) {
+                // Enough base blocks for the coarsest level, with a partial block and parent at the end.
+                constexpr int numSamples = 131072 * 2 + 128 * 5 + 17;
+                auto audio = makeNoise(static_cast<int>(channelCount), numSamples, 23);
+                const auto valuesPerBlock = static_cast<size_t>(channelCount) * 2;
+                const auto baseBlocks = static_cast<size_t>((numSamples + 127) / 128);
+
+                std::vector<int16> expected(baseBlocks * valuesPerBlock);
+                PeakKernels::buildBlocksScalarReference(audio.getArrayOfReadPointers(), channelCount, numSamples, 128, expected.data());
+
+                std::vector<float> minMax(expected.size());
+                std::vector<int16> quantized(expected.size());
+                PeakKernels::findBlockMinMax(audio.getArrayOfReadPointers(), channelCount, numSamples, 128, minMax.data());
+                PeakKernels::quantizeInt16(minMax.data(), quantized.data(), minMax.size());
+                expect(quantized == expected, "min/max blocks differ for " + juce::String(channelCount) + " channels");
+
+                auto level = PeakFileBuilder::LevelData { 128, expected };
+                for (const auto blockSize : PeakFileBuilder::getLevelBlockSizes()) {
+                    if (blockSize <= level.blockSize) {
+                        continue;
+                    }
+                    // Each parent is the plain min and max of the base blocks it covers.
+                    const auto blockRatio = static_cast<size_t>(blockSize / 128);
+                    std::vector<int16> scalar;
+                    for (size_t first = 0; first < baseBlocks; first += blockRatio) {
+                        const auto last = std::min(baseBlocks, first + blockRatio);
+                        for (size_t value = 0; value < valuesPerBlock; value += 2) {
+                            auto low = expected[first * valuesPerBlock + value];
+                            auto high = expected[first * valuesPerBlock + value + 1];
+                            for (auto child = first + 1; child < last; ++child) {
+                                low = std::min(low, expected[child * valuesPerBlock + value]);
+                                high = std::max(high, expected[child * valuesPerBlock + value + 1]);
+                            }
+                            scalar.push_back(low);
+                            scalar.push_back(high);
+                        }
+                    }
+                    level = PeakFileBuilder::foldLevel(level, blockSize, channelCount);
+                    expect(level.values == scalar, "level " + juce::String(blockSize) + " differs for "
+                                                       + juce::String(channelCount) + " channels");
+                }
+            }
+        }
+
+        beginTest("Benchmark peak kernels against the scalar path");
+        {
+            // One minute of 8 channel 96 kHz audio, on one core; logged only, timings vary by machine.
+            constexpr uint32 channelCount = 8;
+            constexpr int numSamples = 96000 * 60;
+            auto audio = makeNoise(static_cast<int>(channelCount), numSamples);
+            const auto blockCount = static_cast<size_t>((numSamples + 127) / 128);
+            std::vector<int16> base(blockCount * channelCount * 2);
+            const auto megabytes = static_cast<double>(numSamples) * channelCount * sizeof(float) / (1024.0 * 1024.0);
+            const auto rate = [megabytes](juce::int64 ticks) {
+                return juce::String(megabytes / juce::Time::highResolutionTicksToSeconds(ticks), 0) + " MB/s";
+            };
+
+            const auto scalarStart = juce::Time::getHighResolutionTicks();
+            PeakKernels::buildBlocksScalarReference(audio.getArrayOfReadPointers(), channelCount, numSamples, 128, base.data());
+            const auto scalarTicks = juce::Time::getHighResolutionTicks() - scalarStart;
+
+            const auto kernelStart = juce::Time::getHighResolutionTicks();
+            PeakKernels::buildBlocks(audio.getArrayOfReadPointers(), channelCount, numSamples, 128, base.data());
+            auto level = PeakFileBuilder::LevelData { 128, std::move(base) };
+            for (const auto blockSize : PeakFileBuilder::getLevelBlockSizes()) {
+                if (blockSize > level.blockSize) {
+                    level = PeakFileBuilder::foldLevel(level, blockSize, channelCount);
+                }
+            }
+            const auto kernelTicks = juce::Time::getHighResolutionTicks() - kernelStart;
+
+            juce::Logger::writeToLog("PeakKernels " + juce::String(channelCount) + " channels: scalar base level "
+                                     + rate(scalarTicks) + ", kernel pyramid " + rate(kernelTicks) + " per core");
+        }
+    }
+
+private:
+    static juce::AudioBuffer<float> makeNoise(int numChannels, int numSamples, int64 seed = 11)
+    {
+        juce::Random random(seed);
+        juce::AudioBuffer<float> buffer(numChannels, numSamples);
+        for (int c = 0; c < numChannels; ++c) {
+            for (int i = 0; i < numSamples; ++i) {
+                buffer.setSample(c, i, random.nextFloat() * 2.0f - 1.0f);
+            }
+        }
+        return buffer;
+    }
+
+    static std::vector<int16> flatten(const std::vector<PeakSource::PeakBlock>& blocks)
+    {
+        std::vector<int16> values;
+        for (const auto& block : blocks) {
+            values.push_back(block.min);
+            values.push_back(block.max);
+        }
+        return values;
+    }
+
+    /// Values seen through visitBlocksForRange, checking the runs follow each other.
+    static std::vector<int16> readThroughRuns(const PeakSource& peaks, uint32 samplesPerBlock, uint64 start, uint64 end)
+    {
+        std::vector<int16> values;
+        auto nextBlock = start / samplesPerBlock;
+        bool contiguous = true;
+        peaks.visitBlocksForRange(samplesPerBlock, start, end, [&](const PeakSource::BlockRun& run) {
+            contiguous = contiguous && run.firstBlock == nextBlock;
+            nextBlock = run.firstBlock + run.blockCount;
+            const auto count = static_cast<size_t>(run.blockCount) * peaks.getChannelCount() * 2;
+            for (size_t i = 0; i < count; ++i) {
+                values.push_back(run.int8Values != nullptr ? PeakFileFormat::dequantizeInt8(run.int8Values[i])
+                                                           : run.int16Values[i]);
+            }
+        });
+        return contiguous ? values : std::vector<int16> {};
+    }
+
+    static void writeWav(const juce::File& file, const juce::AudioBuffer<float>& audio)
+    {
+        juce::WavAudioFormat format;
+        auto writer = std::unique_ptr<juce::AudioFormatWriter>(
+            format.createWriterFor(file.createOutputStream().release(), 48000.0,
+                                   static_cast<unsigned int>(audio.getNumChannels()), 32, {}, 0));
+        writer->writeFromAudioSampleBuffer(audio, 0, audio.getNumSamples());
+    }
+};
+
+static PeakFileTests peakFileTests;
@@ -0,0 +1,104 @@
+#include <JuceHeader.h>
+
+#include <AudioEngine/Recording/InputRouter.h>
+#include <AudioEngine/Recording/Recorder.h>
+
+class RecorderTests : public juce::UnitTest
+{
+public:
+    RecorderTests() : juce::UnitTest("Recorder", "Engine") {}
+
+    void runTest() override
+    {
+        juce::TimeSliceThread writerThread("Recorder test writer");
+        writerThread.startThread();
+
+        for (const auto sampleFormat : { Recorder::SampleFormat::Int24, Recorder::SampleFormat::Float32 }) {
+            const auto isFloat = sampleFormat == Recorder::SampleFormat::Float32;
+            beginTest(juce::String("Streams a take longer than the FIFO as ") + (isFloat ? "32-bit float" : "24-bit"));
+
+            juce::TemporaryFile temporaryFile(".wav");
+            constexpr double sampleRate = 8000.0;
+            constexpr int blockSize = 256;
+            // Three times the FIFO: only possible if the writer thread keeps draining.
+            const auto totalSamples = static_cast<int>(sampleRate * Recorder::fifoSeconds * 3.0);
+
+            juce::AudioBuffer<float> block(2, blockSize);
+            for (int i = 0; i < blockSize; ++i) {
+                block.setSample(0, i, 0.5f);
+                block.setSample(1, i, -0.25f);
+            }
+
+            {
+                Recorder recorder(temporaryFile.getFile(), 2, sampleRate, sampleFormat, writerThread);
+                expect(recorder.isOpen());
+                int pushed = 0;
+                for (; pushed < totalSamples; pushed += blockSize) {
+                    recorder.pushBuffer(block, blockSize);
+                    juce::Thread::sleep(1);
+                }
+                recorder.close();
+                expectEquals(recorder.getNumSamplesDropped(), (int64) 0);
+                expectEquals(recorder.getNumSamplesRecorded(), (int64) pushed);
+            }
+
+            juce::WavAudioFormat format;
+            auto reader = std::unique_ptr<juce::AudioFormatReader>(
+                format.createReaderFor(temporaryFile.getFile().createInputStream().release(), true));
+            expect(reader != nullptr);
+            if (reader != nullptr) {
+                expectEquals((int) reader->bitsPerSample, isFloat ? 32 : 24);
+                expectEquals(reader->usesFloatingPointData, isFloat);
+                expect(reader->lengthInSamples >= totalSamples);
+                juce::AudioBuffer<float> readBack(2, 16);
+                reader->read(&readBack, 0, 16, 1000, true, true);
+                expectWithinAbsoluteError(readBack.getSample(0, 3), 0.5f, 1.0e-4f);
+                expectWithinAbsoluteError(readBack.getSample(1, 3), -0.25f, 1.0e-4f);
+            }
+        }
+
+        beginTest("Input router captures the mapped device inputs");
+        {
+            juce::TemporaryFile temporaryFile(".wav");
+            InputRouter router;
+            router.setRoutes({ { "track", {}, 1, 1 } });
+            expectEquals(router.getRequiredInputChannels(), 2);
+            expectEquals(router.getRouteChannelCount("track"), 1);
+            expectEquals(router.getRouteChannelCount("other"), 0);
+            router.prepare(nullptr, 64);
+
+            juce::AudioBuffer<float> inputs(2, 64);
+            juce::FloatVectorOperations::fill(inputs.getWritePointer(0), 0.1f, 64);
+            juce::FloatVectorOperations::fill(inputs.getWritePointer(1), 0.6f, 64);
+            juce::AudioBuffer<float> output(2, 64);
+            output.clear();
+
+            {
+                Recorder recorder(temporaryFile.getFile(), 1, 8000.0, Recorder::SampleFormat::Float32, writerThread);
+                router.setRecorder("track", &recorder);
+                router.process(inputs.getArrayOfReadPointers(), 2, output, 64, 1200);
+                router.process(inputs.getArrayOfReadPointers(), 2, output, 64, 1264);
+                router.setRecorder("track", nullptr);
+                recorder.close();
+                expectEquals(recorder.getNumSamplesRecorded(), (int64) 128);
+                expectEquals(recorder.getTimelineStartSample(), (int64) 1200);
+            }
+            // Without a monitoring track nothing reaches the output.
+            expectEquals(output.getMagnitude(0, 64), 0.0f);
+
+            juce::WavAudioFormat format;
+            auto reader = std::unique_ptr<juce::AudioFormatReader>(
+                format.createReaderFor(temporaryFile.getFile().createInputStream().release(), true));
+            expect(reader != nullptr);
+            if (reader != nullptr) {
+                juce::AudioBuffer<float> readBack(1, 8);
+                reader->read(&readBack, 0, 8, 0, true, false);
+                expectWithinAbsoluteError(readBack.getSample(0, 4), 0.6f, 1.0e-6f);
+            }
+        }
+
+        writerThread.stopThread(1000);
+    }
+};
+
+static RecorderTests recorderTests;
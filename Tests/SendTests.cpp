@@ -0,0 +1,97 @@
+#include <JuceHeader.h>
+
+#include <AudioEngine/Nodes/SendBus.h>
+#include <AudioEngine/Nodes/SendNode.h>
+#include <AudioEngine/Nodes/VolumeNode.h>
+
+#include "Core/Edit/Edit.h"
+#include "Core/Track/Send.h"
+#include "Core/Track/Track.h"
+#include "Utils/IO/EditSerializer.h"
+
+class SendTests : public juce::UnitTest
+{
+public:
+    SendTests() : juce::UnitTest("Sends", "Engine") {}
+
+    void runTest() override
+    {
+        beginTest("Legacy sessions without a send type import post-fader sends");
+        {
+            juce::TemporaryFile session(".json");
+            session.getFile().replaceWithText(R"({
+                "tracks": [
+                    { "type": "Audio", "name": "Source", "sends": [
+                        { "destinationIndex": 1 },
+                        { "destinationIndex": 1, "type": "pre" },
+                        { "destinationIndex": 1, "type": "post" }
+                    ] },
+                    { "type": "Aux", "name": "Reverb" }
+                ]
+            })");
+            const auto edit = EditSerializer::importFromFile(session.getFile());
+            expect(edit != nullptr);
+            if (edit != nullptr) {
+                std::shared_ptr<Track> source;
+                for (const auto& track : edit->getTracks()) {
+                    if (track->getName() == "Source") {
+                        source = track;
+                    }
+                }
+                expect(source != nullptr);
+                if (source != nullptr) {
+                    const auto& sends = source->getSends();
+                    expectEquals(static_cast<int>(sends.size()), 3);
+                    if (sends.size() == 3) {
+                        expect(sends[0]->getType() == SendType::PostFader);
+                        expect(sends[1]->getType() == SendType::PreFader);
+                        expect(sends[2]->getType() == SendType::PostFader);
+                    }
+                }
+            }
+        }
+
+        beginTest("The fader scales post-fader sends only");
+        {
+            constexpr int blockSize = 256;
+            // Wired like GraphManager::buildSendTap: the pre-fader tap reads the signal before the
+            // VolumeNode, the post-fader tap reads its output.
+            std::atomic<float> fader { 0.25f };
+            VolumeNode volumeNode({}, nullptr, {}, { { ParameterKey::Volume, &fader } });
+            volumeNode.prepareToPlay(48000.0, blockSize);
+
+            Send preSend(std::weak_ptr<Track> {});
+            Send postSend(std::weak_ptr<Track> {});
+            preSend.setType(SendType::PreFader);
+            postSend.setType(SendType::PostFader);
+            SendBus preBus, postBus;
+            preBus.prepare(2, blockSize);
+            postBus.prepare(2, blockSize);
+            SendNode preNode(&preSend, {}, nullptr, &preBus, {});
+            SendNode postNode(&postSend, {}, nullptr, &postBus, {});
+            preNode.prepareToPlay(48000.0, blockSize);
+            postNode.prepareToPlay(48000.0, blockSize);
+
+            juce::AudioBuffer<float> track(2, blockSize);
+            juce::FloatVectorOperations::fill(track.getWritePointer(0), 1.0f, blockSize);
+            juce::FloatVectorOperations::fill(track.getWritePointer(1), 1.0f, blockSize);
+            juce::MidiBuffer midi;
+            auto preTap = track;
+            preNode.processBlock(preTap, midi);
+            volumeNode.processBlock(track, midi);
+            postNode.processBlock(track, midi);
+
+            juce::AudioBuffer<float> preAux(2, blockSize), postAux(2, blockSize);
+            preAux.clear();
+            postAux.clear();
+            preBus.drainInto(preAux, blockSize);
+            postBus.drainInto(postAux, blockSize);
+            expectWithinAbsoluteError(preAux.getSample(0, blockSize - 1), 1.0f, 1.0e-6f);
+            expectWithinAbsoluteError(preAux.getSample(1, blockSize - 1), 1.0f, 1.0e-6f);
+            expectWithinAbsoluteError(postAux.getSample(0, blockSize - 1), 0.25f, 1.0e-6f);
+            expectWithinAbsoluteError(postAux.getSample(1, blockSize - 1), 0.25f, 1.0e-6f);
+        }
+    }
+};
+
+static SendTests sendTests;
@@ -0,0 +1,67 @@
+#include <JuceHeader.h>
+
+#include <Gui/Utils/TrackRowLayout.h>
+
+class TrackRowLayoutTests : public juce::UnitTest
+{
+public:
+    TrackRowLayoutTests() : juce::UnitTest("TrackRowLayout", "Gui") {}
+
+    void runTest() override
+    {
+        beginTest("Rows stack from the prefix sum of their heights");
+        {
+            TrackRowLayout layout;
+            layout.setRowHeights({ 100, 40, 0, 60 });
+            expectEquals(layout.getNumRows(), 4);
+            expectEquals(layout.getTotalHeight(), 201);
+            expectEquals(layout.getRowY(1), 100);
+            expectEquals(layout.getRowY(3), 141);
+            expectEquals(layout.getRowHeight(2), 1);
+        }
+
+        beginTest("Row lookup matches a linear scan");
+        {
+            juce::Random random(7);
+            std::vector<int> heights;
+            for (int i = 0; i < 400; ++i) {
+                heights.push_back(20 + random.nextInt(120));
+            }
+            TrackRowLayout layout;
+            layout.setRowHeights(heights);
+
+            auto mismatches = 0;
+            for (int y = -5; y < layout.getTotalHeight() + 5; y += 3) {
+                if (layout.getRowAt(y) != findRowLinear(heights, y)) {
+                    ++mismatches;
+                }
+            }
+            expectEquals(mismatches, 0);
+        }
+
+        beginTest("Visible span covers partially shown rows only");
+        {
+            TrackRowLayout layout;
+            layout.setRowHeights({ 100, 100, 100, 100 });
+            expect(layout.getRowsInSpan(150, 250) == juce::Range<int>(1, 3));
+            expect(layout.getRowsInSpan(100, 200) == juce::Range<int>(1, 2));
+            expect(layout.getRowsInSpan(-50, 1000) == juce::Range<int>(0, 4));
+            expect(layout.getRowsInSpan(400, 500).isEmpty());
+        }
+    }
+
+private:
+    static int findRowLinear(const std::vector<int>& heights, int y)
+    {
+        auto top = 0;
+        for (size_t i = 0; i < heights.size(); ++i) {
+            if (y >= top && y < top + heights[i]) {
+                return static_cast<int>(i);
+            }
+            top += heights[i];
+        }
+        return -1;
+    }
+};
+
+static TrackRowLayoutTests trackRowLayoutTests;
@@ -0,0 +1,74 @@
+#include <JuceHeader.h>
+
+#include <Gui/Video/VideoFrameBuffer.h>
+
+class VideoFrameBufferTests : public juce::UnitTest
+{
+public:
+    VideoFrameBufferTests() : juce::UnitTest("VideoFrameBuffer", "Video") {}
+
+    void runTest() override
+    {
+        beginTest("Ring keeps the latest frames and finds them by index");
+        {
+            VideoFrameBuffer buffer(4);
+            for (int64_t i = 0; i < 6; ++i) {
+                buffer.pushFrame(i, makeFrame());
+            }
+            expectEquals(static_cast<int>(buffer.size()), 4);
+            expectEquals(buffer.getFirstFrameIndex(), int64_t { 2 });
+            expectEquals(buffer.getLastFrameIndex(), int64_t { 5 });
+            expect(!buffer.getExactFrame(1).isValid());
+            expect(buffer.getExactFrame(3).isValid());
+            expectEquals(buffer.getIndexList(), juce::String("2,3,4,5"));
+        }
+
+        beginTest("Only images nobody else holds are recycled");
+        {
+            VideoFrameBuffer buffer(2);
+            buffer.pushFrame(0, makeFrame());
+            buffer.pushFrame(1, makeFrame());
+            const auto shown = buffer.getExactFrame(1);
+
+            // Frame 2 goes into frame 0's slot, whose image only the buffer holds.
+            const auto recycled = buffer.recycleImage(2);
+            expect(recycled.isValid());
+            expect(!buffer.getExactFrame(0).isValid());
+            expectEquals(static_cast<int>(buffer.size()), 1);
+            // Frame 1 is still referenced by the display.
+            expect(!buffer.recycleImage(3).isValid());
+        }
+
+        beginTest("Dropped and late frames are counted");
+        {
+            VideoFrameBuffer buffer(2);
+            buffer.pushFrame(0, makeFrame());
+            buffer.getExactFrame(0);
+            buffer.pushFrame(1, makeFrame());
+            buffer.pushFrame(2, makeFrame());
+            buffer.pushFrame(3, makeFrame());
+            // Frame 0 was shown, frame 1 left unseen.
+            expectEquals(static_cast<int>(buffer.getDroppedFrameCount()), 1);
+
+            // Frame 4 arrives after frame 5 was asked for, and pushes frame 2 out unseen.
+            buffer.getExactFrame(5);
+            buffer.pushFrame(4, makeFrame());
+            expectEquals(static_cast<int>(buffer.getLateFrameCount()), 1);
+            expectEquals(static_cast<int>(buffer.getDroppedFrameCount()), 2);
+
+            // A seek discards frames without counting them.
+            buffer.clear();
+            expectEquals(static_cast<int>(buffer.getDroppedFrameCount()), 2);
+            buffer.resetCounters();
+            expectEquals(static_cast<int>(buffer.getLateFrameCount()), 0);
+        }
+    }
+
+private:
+    static juce::Image makeFrame()
+    {
+        return juce::Image(juce::Image::ARGB, 4, 2, true, juce::SoftwareImageType());
+    }
+};
+
+static VideoFrameBufferTests videoFrameBufferTests;
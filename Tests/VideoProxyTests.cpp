@@ -0,0 +1,164 @@
+#include <JuceHeader.h>
+
+#include <Gui/Video/Backend/ImageSequenceFrameSource.h>
+#include <Gui/Video/Backend/VideoBackend_Proxy.h>
+#include <Gui/Video/Backend/Y4MFrameSource.h>
+
+#include <array>
+#include <functional>
+
+class VideoProxyTests : public juce::UnitTest
+{
+public:
+    VideoProxyTests() : juce::UnitTest("VideoProxy", "Video") {}
+
+    void runTest() override
+    {
+        beginTest("Y4M frames are indexed and converted from YUV");
+        {
+            juce::TemporaryFile y4m(".y4m");
+            // Black, mid grey, white and red in limited range BT.601.
+            writeY4M(y4m.getFile(), 6, 4, { { 16, 128, 128 }, { 126, 128, 128 }, { 235, 128, 128 }, { 81, 90, 240 } }, true);
+
+            Y4MFrameSource source;
+            expect(source.open(y4m.getFile()));
+            expectEquals(source.getNumFrames(), int64_t { 4 });
+            expectWithinAbsoluteError(source.getNominalFrameRate(), 25.0, 1.0e-9);
+
+            // Out of order reads go straight to the indexed frame.
+            expectColour(source.readFrame(2, {}), 255, 255, 255);
+            expectColour(source.readFrame(0, {}), 0, 0, 0);
+            expectColour(source.readFrame(1, {}), 128, 128, 128);
+            expectColour(source.readFrame(3, {}), 255, 0, 0);
+            expect(!source.readFrame(4, {}).isValid());
+        }
+
+        beginTest("High bit depth Y4M streams are rejected");
+        {
+            juce::TemporaryFile y4m(".y4m");
+            writeY4M(y4m.getFile(), 6, 4, { { 16, 128, 128 } }, false, "420p10");
+
+            Y4MFrameSource source;
+            expect(!source.open(y4m.getFile()));
+        }
+
+        beginTest("Image sequences are indexed by frame number");
+        {
+            const auto directory = juce::File::createTempFile("sequence");
+            expect(directory.createDirectory().wasOk());
+            writePng(directory.getChildFile("shot_0001.png"), juce::Colours::red);
+            writePng(directory.getChildFile("shot_0002.png"), juce::Colours::lime);
+            writePng(directory.getChildFile("shot_0004.png"), juce::Colours::blue);
+            writePng(directory.getChildFile("other_0003.png"), juce::Colours::white);
+            directory.getChildFile("shot_0003.txt").replaceWithText("not a frame");
+
+            ImageSequenceFrameSource source;
+            expect(source.open(directory.getChildFile("shot_0002.png")));
+            expectEquals(source.getNumFrames(), int64_t { 3 });
+            expectColour(source.readFrame(0, {}), 255, 0, 0);
+            expectColour(source.readFrame(2, {}), 0, 0, 255);
+            directory.deleteRecursively();
+        }
+
+        beginTest("Decode-ahead fills the buffer from the playhead");
+        {
+            juce::TemporaryFile y4m(".y4m");
+            std::vector<std::array<uint8_t, 3>> frames;
+            for (int i = 0; i < 30; ++i) {
+                frames.push_back({ static_cast<uint8_t>(16 + 7 * i), 128, 128 });
+            }
+            writeY4M(y4m.getFile(), 8, 8, frames, false);
+
+            VideoBackend_Proxy backend;
+            backend.setFrameRate(25.0);
+            backend.setPlayheadSeconds(0.4);
+            backend.loadFile(y4m.getFile());
+            expect(backend.isReady());
+
+            // Paused, a few frames past the playhead are decoded so playback starts from the buffer.
+            expect(waitFor([&backend] { return backend.getLastFrameIndex() >= 14; }));
+            expectColour(backend.getCurrentFrameImage(), greyForFrame(10), greyForFrame(10), greyForFrame(10));
+
+            backend.play();
+            expect(waitFor([&backend] { return backend.getLastFrameIndex() >= 26; }));
+
+            // A seek outside the buffer restarts decoding at the new playhead.
+            backend.setPlayheadSeconds(0.0);
+            expect(waitFor([&backend] {
+                const auto frame = backend.getCurrentFrameImage();
+                return frame.isValid() && frame.getPixelAt(0, 0).getRed() == greyForFrame(0);
+            }));
+            backend.stop();
+        }
+    }
+
+private:
+    static void writeY4M(const juce::File& file,
+                         int width,
+                         int height,
+                         const std::vector<std::array<uint8_t, 3>>& frames,
+                         bool withTruncatedTail,
+                         const juce::String& colourSpace = "420jpeg")
+    {
+        file.deleteFile();
+        juce::FileOutputStream out(file);
+        out.writeText("YUV4MPEG2 W" + juce::String(width) + " H" + juce::String(height)
+                          + " F25:1 Ip A1:1 C" + colourSpace + "\n",
+                      false, false, nullptr);
+        const auto lumaBytes = static_cast<size_t>(width * height);
+        const auto chromaBytes = static_cast<size_t>(((width + 1) / 2) * ((height + 1) / 2));
+        for (size_t i = 0; i < frames.size(); ++i) {
+            // Frame headers may carry parameters.
+            out.writeText(i % 2 == 0 ? "FRAME\n" : "FRAME Ixyz\n", false, false, nullptr);
+            std::vector<uint8_t> planes(lumaBytes, frames[i][0]);
+            planes.insert(planes.end(), chromaBytes, frames[i][1]);
+            planes.insert(planes.end(), chromaBytes, frames[i][2]);
+            out.write(planes.data(), planes.size());
+        }
+        if (withTruncatedTail) {
+            out.writeText("FRAME\n", false, false, nullptr);
+            std::vector<uint8_t> partial(lumaBytes / 2, 16);
+            out.write(partial.data(), partial.size());
+        }
+    }
+
+    static void writePng(const juce::File& file, juce::Colour colour)
+    {
+        juce::Image image(juce::Image::RGB, 4, 4, false);
+        image.clear(image.getBounds(), colour);
+        juce::FileOutputStream out(file);
+        juce::PNGImageFormat().writeImageToStream(image, out);
+    }
+
+    static uint8_t greyForFrame(int frame)
+    {
+        // Limited range luma 16 + 7 * frame stretched to full range.
+        return static_cast<uint8_t>(juce::jlimit(0, 255, (298 * 7 * frame + 128) >> 8));
+    }
+
+    static bool waitFor(const std::function<bool()>& condition)
+    {
+        const auto deadline = juce::Time::getMillisecondCounter() + 5000;
+        while (!condition()) {
+            if (juce::Time::getMillisecondCounter() > deadline) {
+                return false;
+            }
+            juce::Thread::sleep(2);
+        }
+        return true;
+    }
+
+    void expectColour(const juce::Image& image, int red, int green, int blue)
+    {
+        expect(image.isValid());
+        if (!image.isValid()) {
+            return;
+        }
+        const auto pixel = image.getPixelAt(image.getWidth() / 2, image.getHeight() / 2);
+        expectWithinAbsoluteError(static_cast<int>(pixel.getRed()), red, 1);
+        expectWithinAbsoluteError(static_cast<int>(pixel.getGreen()), green, 1);
+        expectWithinAbsoluteError(static_cast<int>(pixel.getBlue()), blue, 1);
+    }
+};
+
+static VideoProxyTests videoProxyTests;
@@ -0,0 +1,117 @@
+#include <JuceHeader.h>
+
+#include <Gui/Video/VideoThumbnailCache.h>
+
+class VideoThumbnailCacheTests : public juce::UnitTest
+{
+public:
+    VideoThumbnailCacheTests() : juce::UnitTest("VideoThumbnailCache", "Video") {}
+
+    void runTest() override
+    {
+        beginTest("Still playhead prefetches evenly on both sides");
+        {
+            const auto frames = VideoThumbnailCache::getPrefetchFrames(100, 0.0, -1);
+            expect(frames == std::vector<int64_t>({ 101, 99, 102, 98 }));
+        }
+
+        beginTest("Scrub prefetch looks ahead by the scrub speed");
+        {
+            const auto frames = VideoThumbnailCache::getPrefetchFrames(100, 3.0, -1);
+            expect(frames == std::vector<int64_t>({ 103, 99, 106, 98, 109, 112, 115, 118 }));
+        }
+
+        beginTest("Prefetch stays within the clip");
+        {
+            const auto backwards = VideoThumbnailCache::getPrefetchFrames(1, -2.0, -1);
+            expect(backwards == std::vector<int64_t>({ 2, 3 }));
+            const auto forwards = VideoThumbnailCache::getPrefetchFrames(100, 1.0, 104);
+            expect(forwards == std::vector<int64_t>({ 101, 99, 102, 98, 103 }));
+        }
+
+        beginTest("Thumbnails are scaled down to the display size");
+        {
+            juce::ScopedJuceInitialiser_GUI juceInit;
+            VideoThumbnailCache cache(std::make_unique<SolidFrameProvider>(640, 360));
+            cache.setDisplaySize(160, 160);
+            request(cache, 0);
+            // Aspect ratio is kept: 640x360 fits 160x160 as 160x90.
+            expectEquals((int) cache.getMemoryUsage(), 160 * 90 * 4);
+
+            cache.setDisplaySize(1280, 720);
+            expectEquals((int) cache.getMemoryUsage(), 0);
+            request(cache, 1);
+            // Smaller frames are never scaled up.
+            expectEquals((int) cache.getMemoryUsage(), 640 * 360 * 4);
+        }
+
+        beginTest("Least recently used thumbnails are evicted first");
+        {
+            juce::ScopedJuceInitialiser_GUI juceInit;
+            constexpr size_t thumbnailBytes = 160 * 90 * 4;
+            VideoThumbnailCache cache(std::make_unique<SolidFrameProvider>(640, 360));
+            cache.setDisplaySize(160, 90);
+            cache.setMemoryBudget(thumbnailBytes * 3);
+            for (const auto frame : { 0, 1, 2 }) {
+                request(cache, frame);
+            }
+            // A cache hit makes frame 0 the most recent, leaving frame 1 the oldest.
+            request(cache, 0);
+            request(cache, 3);
+            expect(cache.isCached(0) && cache.isCached(2) && cache.isCached(3));
+            expect(!cache.isCached(1));
+            expectEquals(cache.getMemoryUsage(), thumbnailBytes * 3);
+        }
+
+        beginTest("Lowering the memory budget evicts down to it");
+        {
+            juce::ScopedJuceInitialiser_GUI juceInit;
+            constexpr size_t thumbnailBytes = 160 * 90 * 4;
+            VideoThumbnailCache cache(std::make_unique<SolidFrameProvider>(160, 90));
+            for (const auto frame : { 0, 1, 2, 3 }) {
+                request(cache, frame);
+            }
+            expectEquals(cache.getMemoryUsage(), thumbnailBytes * 4);
+
+            cache.setMemoryBudget(thumbnailBytes * 2);
+            expectEquals(cache.getMemoryUsage(), thumbnailBytes * 2);
+            expect(cache.isCached(2) && cache.isCached(3));
+            expect(!cache.isCached(0) && !cache.isCached(1));
+
+            // The newest thumbnail stays even when it alone is over budget.
+            cache.setMemoryBudget(1);
+            expectEquals(cache.getMemoryUsage(), thumbnailBytes);
+            expect(cache.isCached(3));
+        }
+    }
+
+private:
+    /// Returns blank frames of a fixed size.
+    class SolidFrameProvider : public VideoThumbnailProvider {
+    public:
+        SolidFrameProvider(int width, int height) : width(width), height(height) {}
+
+        void setVideoFile(const VideoFile&) override {}
+
+        juce::Image getFrameAtSeconds(double) override
+        {
+            return juce::Image(juce::Image::ARGB, width, height, true);
+        }
+
+        int64_t getNumFrames(double) const override { return -1; }
+
+        bool isReady() const override { return true; }
+
+    private:
+        int width = 0;
+        int height = 0;
+    };
+
+    void request(VideoThumbnailCache& cache, int64_t frameIndex)
+    {
+        cache.requestFrameIndex(frameIndex, 25.0, [](const juce::Image&) {});
+        expect(cache.waitForPendingRequests(10000));
+    }
+};
+
+static VideoThumbnailCacheTests videoThumbnailCacheTests;